@@ -1,6 +1,7 @@
 // Copyright (c) 2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
 #include "AfterImageFxManager.h"
 
+#include "Options.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
 
@@ -49,8 +50,15 @@ void createAfterImage(const Node* node, const Color3B& color, const float durati
 }  // namespace
 
 void AfterImageFxManager::update(const float delta) {
+  const Options::EffectQuality effectQuality = Options::the().getEffectQuality();
+  if (effectQuality == Options::EffectQuality::LOW) {
+    return;
+  }
+
+  // Half as many after images on medium quality.
+  const float intervalScale = (effectQuality == Options::EffectQuality::MEDIUM) ? 2.0f : 1.0f;
   for (auto& [node, afterImageFxData] : _entries) {
-    if (afterImageFxData.timerInSec < afterImageFxData.intervalInSec) {
+    if (afterImageFxData.timerInSec < afterImageFxData.intervalInSec * intervalScale) {
       afterImageFxData.timerInSec += delta;
       continue;
     }
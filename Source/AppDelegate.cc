@@ -14,6 +14,10 @@ extern "C" {
 #include "Assets.h"
 #include "Audio.h"
 #include "Constants.h"
+#include "FrameLimiter.h"
+#include "Localization.h"
+#include "Options.h"
+#include "input/ActionMapper.h"
 #include "scene/SceneManager.h"
 #include "scene/MainMenuScene.h"
 
@@ -57,14 +61,17 @@ bool AppDelegate::applicationDidFinishLaunching() {
 
   glview->setDesignResolutionSize(kVirtualWidth, kVirtualHeight, ResolutionPolicy::SHOW_ALL);
 
-  // set FPS. the default value is 1.0/60 if you don't call this
-  director->setAnimationInterval(1.0f / 60);
-
 #ifdef __linux__
   chdir("Resources");
 #endif
 
+  vigilante::Options::the().load(vigilante::Options::kOptionsFileName);
+  vigilante::Options::the().apply();
+  vigilante::FrameLimiter::the().activate();
+  vigilante::Localization::the().load(vigilante::Options::the().getLanguage());
+  vigilante::Localization::the().preloadGlyphs();
   vigilante::assets::loadSpritesheets(vigilante::assets::kSpritesheetsList);
+  vigilante::ActionMapper::the().load(vigilante::ActionMapper::kBindingsFileName);
   vigilante::SceneManager::the().runWithScene(vigilante::MainMenuScene::create());
 
   return true;
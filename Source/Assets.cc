@@ -13,6 +13,7 @@ extern "C" {
 #include <axmol.h>
 
 #include "util/Logger.h"
+#include "util/MemoryTracker.h"
 
 using namespace std;
 USING_NS_AX;
@@ -30,6 +31,7 @@ void loadSpritesheets(const fs::path& spritesheetsListFileName) {
   }
 
   VGLOG(LOG_INFO, "Loading textures...");
+  ScopedMemoryTag memoryTag{MemoryTag::TEXTURES};
   SpriteFrameCache* frameCache = SpriteFrameCache::getInstance();
   string line;
   while (std::getline(fin, line)) {
@@ -12,6 +12,7 @@ namespace vigilante::assets {
 // Dirs
 inline const fs::path kDataDir = "Data";
 inline const fs::path kGameplayDir = kDataDir / "gameplay";
+inline const fs::path kLocaleDir = kDataDir / "locale";
 inline const fs::path kFontDir = "Font";
 inline const fs::path kMapDir = "Map";
 inline const fs::path kMusicDir = "Music";
@@ -24,6 +25,8 @@ inline const fs::path kUIDir = kTextureDir / "ui";
 inline const fs::path kExpPointTable = kGameplayDir / "exp_point_table.txt";
 inline const fs::path kItemPriceTable = kGameplayDir / "item_price_table.txt";
 inline const fs::path kQuestsList = kGameplayDir / "quests_list.txt";
+inline const fs::path kWorldNpcsJson = kGameplayDir / "world_npcs.json";
+inline const fs::path kAchievementsJson = kGameplayDir / "achievements.json";
 inline const fs::path kSpritesheetsList = kTextureDir / "spritesheets.txt";
 inline const fs::path kPlayerJson = kDataDir / "character/joanna.json";
 
@@ -1,8 +1,9 @@
 // Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
 #include "CallbackManager.h"
 
+#include <algorithm>
+
 using namespace std;
-USING_NS_AX;
 
 namespace vigilante {
 
@@ -11,6 +12,19 @@ CallbackManager& CallbackManager::the() {
   return instance;
 }
 
+void CallbackManager::update(const float delta) {
+  _time += delta;
+
+  while (!_heap.empty() && _heap.front().time <= _time) {
+    std::pop_heap(_heap.begin(), _heap.end());
+    Entry entry = std::move(_heap.back());
+    _heap.pop_back();
+
+    // The callback may schedule or cancel other callbacks from here.
+    entry.callback(entry.id);
+  }
+}
+
 uint64_t CallbackManager::runAfter(function<void (const CallbackManager::CallbackId)>&& userCallback, float delay) {
   if (delay == 0) {
     userCallback(0);
@@ -18,25 +32,20 @@ uint64_t CallbackManager::runAfter(function<void (const CallbackManager::Callbac
   }
 
   const CallbackId id = _nextCallbackId++;
-  auto cancellableUserCallback = [this, id, callback = std::move(userCallback)]() {
-    const auto it = _cancelledCallbackIds.find(id);
-    if (it != _cancelledCallbackIds.end()) {
-      _cancelledCallbackIds.erase(it);
-      return;
-    }
-    callback(id);
-  };
-
-  _scene->runAction(Sequence::createWithTwoActions(
-    DelayTime::create(delay),
-    CallFunc::create(cancellableUserCallback)
-  ));
-
+  _heap.push_back({_time + delay, id, std::move(userCallback)});
+  std::push_heap(_heap.begin(), _heap.end());
   return id;
 }
 
 void CallbackManager::cancel(const CallbackManager::CallbackId callbackId) {
-  _cancelledCallbackIds.emplace(callbackId);
+  if (std::erase_if(_heap, [callbackId](const Entry& e) { return e.id == callbackId; })) {
+    std::make_heap(_heap.begin(), _heap.end());
+  }
+}
+
+void CallbackManager::reset() {
+  _heap.clear();
+  _time = 0;
 }
 
 }  // namespace vigilante
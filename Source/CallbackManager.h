@@ -4,29 +4,49 @@
 
 #include <cstdint>
 #include <functional>
-#include <unordered_set>
-
-#include <axmol.h>
+#include <vector>
 
 namespace vigilante {
 
+// CallbackManager runs the scheduled callbacks of the gameplay code from a
+// single min-heap, which is advanced once per frame with the game time (see
+// TimeScale), so that they are slowed down and paused along with the game.
 class CallbackManager {
  public:
   using CallbackId = uint64_t;
   static CallbackManager& the();
 
+  void update(const float delta);
+
   CallbackId runAfter(std::function<void (const CallbackId id)>&& userCallback, float delay);
   void cancel(const CallbackId id);
 
-  inline void setScene(ax::Scene* scene) { _scene = scene; }
+  // The callbacks of the previous scene (if any) will never be run.
+  void reset();
+  inline size_t getNumPendingCallbacks() const { return _heap.size(); }
+  inline CallbackId getNextCallbackId() const { return _nextCallbackId; }
 
  private:
-  CallbackManager() : _scene() {}
+  struct Entry final {
+    double time;
+    CallbackId id;
+    std::function<void (const CallbackId id)> callback;
+
+    // For a min-heap with std::push_heap() and std::pop_heap(). The callbacks
+    // due at the same time are run in the order they were scheduled.
+    bool operator<(const Entry& other) const {
+      return time != other.time ? time > other.time : id > other.id;
+    }
+  };
+
+  CallbackManager() = default;
 
   static inline CallbackId _nextCallbackId{1};
 
-  ax::Scene* _scene;
-  std::unordered_set<CallbackId> _cancelledCallbackIds;
+  // A double, since it accumulates for as long as the game is played, and a
+  // float would lose the precision of short delays after a few hours.
+  double _time{};
+  std::vector<CallbackManager::Entry> _heap;
 };
 
 }  // namespace vigilante
@@ -66,6 +66,7 @@ inline constexpr int kHud = 86;
 inline constexpr int kWindowBottom = 88;
 inline constexpr int kWindowTop = 92;
 inline constexpr int kDialogue = 94;
+inline constexpr int kWorldMap = 95;
 inline constexpr int kPauseMenu = 96;
 inline constexpr int kControlHints = 98;
 inline constexpr int kConsole = 99;
@@ -4,12 +4,19 @@
 #include <algorithm>
 
 #include "Constants.h"
+#include "combat/ImpulseQueue.h"
+#include "gameplay/TimeScale.h"
 #include "map/GameMapManager.h"
 
 using namespace std;
 
 namespace vigilante {
 
+DynamicActor::~DynamicActor() {
+  TimeScale::the().forget(this);
+  ImpulseQueue::the().forget(this);
+}
+
 bool DynamicActor::removeFromMap() {
   if (!StaticActor::removeFromMap()) {
     return false;
@@ -37,6 +44,9 @@ void DynamicActor::destroyBody() {
   _body->GetWorld()->DestroyBody(_body);
   _body = nullptr;
 
+  // Otherwise it would be applied to the next body, e.g., on another map.
+  ImpulseQueue::the().forget(this);
+
   std::fill(_fixtures.begin(), _fixtures.end(), nullptr);
 }
 
@@ -25,7 +25,7 @@ class DynamicActor : public StaticActor {
   DynamicActor(const std::size_t numAnimations = 1, const std::size_t numFixtures = 1)
       : StaticActor{numAnimations},
         _fixtures(numFixtures) {}
-  virtual ~DynamicActor() override = default;
+  virtual ~DynamicActor() override;
 
   virtual bool showOnMap(float x, float y) override = 0;  // StaticActor
   virtual bool removeFromMap() override;  // StaticActor:
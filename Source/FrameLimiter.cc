@@ -0,0 +1,86 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "FrameLimiter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+using namespace std;
+USING_NS_AX;
+
+namespace vigilante {
+
+FrameLimiter& FrameLimiter::the() {
+  static FrameLimiter instance;
+  return instance;
+}
+
+void FrameLimiter::activate() {
+  if (_listener) {
+    return;
+  }
+
+  _lastFrameTime = Clock::now();
+  _deadline = _lastFrameTime;
+  _listener = Director::getInstance()->getEventDispatcher()->addCustomEventListener(
+      Director::EVENT_AFTER_DRAW, [this](EventCustom*) { endFrame(); });
+}
+
+void FrameLimiter::setTargetFps(const int fps) {
+  _targetFps = std::max(fps, 0);
+  _period = (_targetFps > 0) ?
+      chrono::duration_cast<Clock::duration>(chrono::duration<double>{1.0 / _targetFps}) :
+      Clock::duration::zero();
+  _deadline = Clock::now();
+}
+
+float FrameLimiter::snapDelta(const float delta) const {
+  if (_targetFps <= 0) {
+    return delta;
+  }
+
+  const float period = 1.0f / _targetFps;
+  return (std::abs(delta - period) <= period * _kSnapTolerance) ? period : delta;
+}
+
+void FrameLimiter::endFrame() {
+  if (_targetFps > 0) {
+    _deadline += _period;
+    // If this frame took much longer (e.g., loading a GameMap), start over
+    // from now rather than rushing through the frames behind.
+    if (Clock::now() > _deadline + _period) {
+      _deadline = Clock::now();
+    } else {
+      wait(_deadline);
+    }
+  }
+
+  const Clock::time_point now = Clock::now();
+  _latestFrameTimeIndex = (_latestFrameTimeIndex + 1) % kFrameTimeHistorySize;
+  _frameTimes[_latestFrameTimeIndex] = chrono::duration<float>{now - _lastFrameTime}.count();
+  _lastFrameTime = now;
+}
+
+void FrameLimiter::wait(const Clock::time_point deadline) {
+  const Clock::time_point sleepStart = Clock::now();
+  const Clock::duration sleepTime = deadline - _spinMargin - sleepStart;
+
+  if (sleepTime > Clock::duration::zero()) {
+    this_thread::sleep_for(sleepTime);
+
+    // Widen the margin at once if the sleep has overshot it,
+    // otherwise narrow it slowly.
+    const Clock::duration overshoot = Clock::now() - (sleepStart + sleepTime);
+    if (overshoot > _spinMargin) {
+      _spinMargin = std::min<Clock::duration>(overshoot + overshoot / 4, _kMaxSpinMargin);
+    } else {
+      _spinMargin = std::max<Clock::duration>(_spinMargin - chrono::microseconds{10}, _kMinSpinMargin);
+    }
+  }
+
+  while (Clock::now() < deadline) {
+    this_thread::yield();
+  }
+}
+
+}  // namespace vigilante
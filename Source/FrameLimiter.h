@@ -0,0 +1,66 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_FRAME_LIMITER_H_
+#define VIGILANTE_FRAME_LIMITER_H_
+
+#include <array>
+#include <chrono>
+
+#include <axmol.h>
+
+namespace vigilante {
+
+// FrameLimiter paces the frames to a target rate at the end of each frame,
+// right before the buffers are swapped.
+//
+// The OS sleep alone may overshoot by a millisecond or more, which shows as
+// jitter at high frame rates, so it sleeps until shortly before the deadline
+// and spins for the rest. The spin margin adapts to the overshoot observed.
+//
+// It also records the time between frames for the FrameTimeGraph.
+class FrameLimiter final {
+ public:
+  static inline constexpr size_t kFrameTimeHistorySize = 240;
+
+  static FrameLimiter& the();
+
+  // Hooks the limiter into the Director, which must not pace the frames itself.
+  void activate();
+
+  // 0 is unlimited.
+  void setTargetFps(const int fps);
+  inline int getTargetFps() const { return _targetFps; }
+
+  // Returns the period of the target rate if `delta` is within the jitter
+  // tolerance of it, so that the gameplay doesn't see the jitter.
+  float snapDelta(const float delta) const;
+
+  // The time between frames in seconds, the latest at `getLatestFrameTimeIndex()`.
+  inline const std::array<float, kFrameTimeHistorySize>& getFrameTimes() const { return _frameTimes; }
+  inline size_t getLatestFrameTimeIndex() const { return _latestFrameTimeIndex; }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  static inline constexpr float _kSnapTolerance = .1f;  // of the period
+  static inline constexpr Clock::duration _kMinSpinMargin = std::chrono::microseconds{500};
+  static inline constexpr Clock::duration _kMaxSpinMargin = std::chrono::milliseconds{4};
+
+  FrameLimiter() = default;
+
+  void endFrame();
+  void wait(const Clock::time_point deadline);
+
+  int _targetFps{};
+  Clock::duration _period{};
+  Clock::time_point _deadline;
+  Clock::time_point _lastFrameTime;
+  Clock::duration _spinMargin{std::chrono::milliseconds{2}};
+  ax::EventListenerCustom* _listener{};
+
+  std::array<float, kFrameTimeHistorySize> _frameTimes{};
+  size_t _latestFrameTimeIndex{};
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_FRAME_LIMITER_H_
@@ -5,6 +5,7 @@
 #include "Constants.h"
 #include "StaticActor.h"
 #include "DynamicActor.h"
+#include "Options.h"
 #include "character/Character.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
@@ -16,7 +17,7 @@ USING_NS_AX;
 namespace vigilante {
 
 void FxManager::createDustFx(const Character* c) {
-  if (!c) {
+  if (!c || Options::the().getEffectQuality() < Options::EffectQuality::HIGH) {
     return;
   }
 
@@ -27,7 +28,7 @@ void FxManager::createDustFx(const Character* c) {
 }
 
 void FxManager::createHitFx(const Character* c) {
-  if (!c) {
+  if (!c || Options::the().getEffectQuality() == Options::EffectQuality::LOW) {
     return;
   }
 
@@ -2,6 +2,8 @@
 #ifndef VIGILANTE_INTERACTABLE_H_
 #define VIGILANTE_INTERACTABLE_H_
 
+class b2Body;
+
 namespace vigilante {
 
 class Character;
@@ -12,9 +14,20 @@ class Interactable {
 
   virtual void onInteract(Character* user) = 0;
   virtual bool willInteractOnContact() const = 0;
+  // Whether the player's InteractionResolver may focus on this interactable.
+  virtual bool isFocusable() const { return !willInteractOnContact(); }
+  // Called when a character's feet start or stop touching this interactable.
+  virtual void onContactBegin(Character*) {}
+  virtual void onContactEnd(Character*) {}
   virtual void showHintUI() = 0;
   virtual void hideHintUI() = 0;
 
+  // Used by InteractionResolver to pick a single target
+  // when several interactables are in range at once.
+  virtual const b2Body* getInteractionBody() const = 0;
+  // Interactables with a higher priority are preferred.
+  virtual int getInteractionPriority() const { return 0; }
+
  protected:
   virtual void createHintBubbleFx() = 0;
   virtual void removeHintBubbleFx() = 0;
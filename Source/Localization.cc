@@ -0,0 +1,714 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "Localization.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <system_error>
+#include <unordered_map>
+
+#include <axmol.h>
+
+#include "Assets.h"
+#include "util/JsonUtil.h"
+#include "util/Logger.h"
+
+using namespace std;
+using namespace vigilante::assets;
+USING_NS_AX;
+
+namespace vigilante {
+
+namespace {
+
+// The binary table of a language:
+//
+//   TableHeader
+//   TableEntry[stringCount], sorted by hash
+//   char[dataSize], the strings, each followed by '\0'
+//   char32_t[glyphCount], the glyph set, sorted
+constexpr array<char, 4> kTableMagic{{'V', 'G', 'S', 'T'}};
+constexpr uint32_t kTableVersion = 1;
+
+struct TableHeader final {
+  array<char, 4> magic;
+  uint32_t version;
+  uint32_t pluralRule;
+  uint32_t stringCount;
+  uint32_t dataSize;
+  uint32_t glyphCount;
+};
+
+struct TableEntry final {
+  uint32_t hash;
+  uint32_t offset;  // into the strings
+  uint32_t size;  // excluding '\0'
+};
+
+struct DefaultString final {
+  const char* key;
+  const char* text;
+};
+
+const DefaultString kDefaultStrings[] = {
+  {"party.following", "{0} is now following you."},
+  {"party.left", "{0} has left your party."},
+  {"party.waiting", "{0} will be waiting for you."},
+  {"player.acquiredExp", "Acquired {0} exp"},
+  {"player.acquiredItem", "Acquired item: {0}."},
+  {"player.acquiredItems", "Acquired item: {0} ({1})."},
+  {"player.removedItem", "Removed item: {0}."},
+  {"player.removedItems", "Removed item: {0} ({1})."},
+  {"player.levelUp", "Congrats! You are now level {0}."},
+  {"door.locked", "This door is locked."},
+  {"door.unlocked", "Door unlocked."},
+  {"portal.locked", "{0} (Locked)"},
+  {"interactable.nothingHappens", "Nothing happens."},
+  {"hint.open", "Open"},
+  {"hint.talk", "Talk"},
+  {"trade.receivingFrom", "Receiving from: {0}"},
+  {"trade.givingTo", "Giving to: {0}"},
+  {"trade.buyingFrom", "Buying from: {0}"},
+  {"trade.sellingTo", "Selling to: {0}"},
+  {"trade.cart", "Cart: {0|# item|# items}"},
+  {"trade.youPay", ", you pay {0} gold"},
+  {"trade.youReceive", ", you receive {0} gold"},
+  {"trade.traded", "Traded {0|# kind|# kinds} of items."},
+  {"trade.failed", "The trade could not be completed."},
+  {"trade.notEnoughItems", "{0} no longer has enough {1}."},
+  {"trade.notEnoughGold", "{0} doesn't have sufficient amount of gold."},
+  {"amount.prompt", "How many?"},
+  {"amount.invalid", "Invalid amount"},
+  {"amount.outOfRange", "Amount too large or too small"},
+  {"amount.unknownError", "Unknown error while parsing amount"},
+  {"save.saveGame", "Save Game"},
+  {"save.loadGame", "Load Game"},
+  {"save.quickSaveSlot", "Quick Save"},
+  {"save.slot", "Slot {0}"},
+  {"save.emptySlotEntry", "{0}: ---"},
+  {"save.slotEntry", "{0}: {1} (Lv. {2})"},
+  {"save.slotEmpty", "This slot is empty."},
+  {"save.succeeded", "Game saved."},
+  {"save.failed", "Failed to save the game."},
+  {"load.failed", "Failed to load the game."},
+  {"mainMenu.newGame", "New Game"},
+  {"mainMenu.loadGame", "Load Game"},
+  {"mainMenu.options", "Options"},
+  {"mainMenu.exit", "Exit"},
+  {"pane.inventory", "INVENTORY"},
+  {"pane.equipment", "EQUIPMENT"},
+  {"pane.skills", "SKILLS"},
+  {"pane.quests", "QUESTS"},
+  {"pane.options", "OPTIONS"},
+  {"option.options", "Options"},
+  {"option.keyBindings", "Key Bindings"},
+  {"option.quit", "Quit"},
+  {"options.frameRateCap", "Frame rate cap: {0}"},
+  {"options.unlimited", "unlimited"},
+  {"options.vsync", "VSync: {0}"},
+  {"options.resolutionScale", "Window scale: {0}x"},
+  {"options.fullscreen", "Fullscreen: {0}"},
+  {"options.effectQuality", "Effects: {0}"},
+  {"options.language", "Language: {0}"},
+  {"options.on", "on"},
+  {"options.off", "off"},
+  {"options.qualityLow", "low"},
+  {"options.qualityMedium", "medium"},
+  {"options.qualityHigh", "high"},
+  {"action.moveLeft", "Move left"},
+  {"action.moveRight", "Move right"},
+  {"action.aimUp", "Aim up"},
+  {"action.crouch", "Crouch"},
+  {"action.jump", "Jump"},
+  {"action.dodge", "Dodge"},
+  {"action.attack", "Attack"},
+  {"action.block", "Block"},
+  {"action.interact", "Interact"},
+  {"action.pickupItem", "Pick up item"},
+  {"action.usePortal", "Use portal"},
+  {"action.hotkey1", "Hotkey 1"},
+  {"action.hotkey2", "Hotkey 2"},
+  {"action.hotkey3", "Hotkey 3"},
+  {"action.hotkey4", "Hotkey 4"},
+  {"action.hotkey5", "Hotkey 5"},
+  {"action.worldMap", "World map"},
+  {"action.menuUp", "Menu: up"},
+  {"action.menuDown", "Menu: down"},
+  {"action.menuLeft", "Menu: left"},
+  {"action.menuRight", "Menu: right"},
+  {"action.menuConfirm", "Menu: confirm"},
+  {"action.menuPrevTab", "Menu: previous tab"},
+  {"action.menuNextTab", "Menu: next tab"},
+  {"action.menuCommit", "Menu: commit"},
+  {"action.pause", "Pause"},
+  {"action.debugDraw", "Toggle debug draw"},
+  {"action.console", "Open console"},
+  {"keyBindings.entry", "{0}: {1}"},
+  {"keyBindings.unbound", "---"},
+  {"keyBindings.conflict", "{0} (!)"},
+  {"keyBindings.reset", "Reset to defaults"},
+  {"keyBindings.pressAKey", "Press a key for {0}, or ESC to cancel."},
+  {"keyBindings.takeOver", "{0} is bound to {1}. Confirm to rebind it anyway."},
+  {"keyBindings.resetDone", "Key bindings have been reset."},
+  {"keyBindings.saveFailed", "Failed to save the key bindings."},
+  {"dialog.whatToDoWith", "What would you like to do with {0}?"},
+  {"dialog.pressAKey", "Press a key to assign to..."},
+  {"dialog.areYouSure", "Are you sure?"},
+  {"dialog.equip", "Equip"},
+  {"dialog.use", "Use"},
+  {"dialog.discard", "Discard"},
+  {"dialog.assign", "Assign"},
+  {"dialog.clear", "Clear"},
+  {"dialog.confirm", "Confirm"},
+  {"dialog.cancel", "Cancel"},
+  {"stats.level", "Level {0}"},
+  {"stats.health", "HEALTH"},
+  {"stats.magicka", "MAGICKA"},
+  {"stats.stamina", "STAMINA"},
+  {"stats.attackRange", "ATTACK RANGE"},
+  {"stats.attackSpeed", "ATTACK SPEED"},
+  {"stats.moveSpeed", "MOVE SPEED"},
+  {"stats.jumpHeight", "JUMP HEIGHT"},
+  {"stats.str", "STR"},
+  {"stats.dex", "DEX"},
+  {"stats.int", "INT"},
+  {"stats.luk", "LUK"},
+  {"quest.started", "Started: {0}"},
+  {"quest.completed", "Completed: {0}"},
+  {"quest.eliminate", "Eliminate: {0} ({1}/{2})"},
+  {"quest.collect", "Collect: {0} ({1}/{2})"},
+  {"quest.talkTo", "Talk to {0}"},
+  {"dialogue.trade", "Let's trade."},
+  {"dialogue.followMe", "Follow me."},
+  {"dialogue.partWays", "It's time for us to part ways"},
+  {"dialogue.waitHere", "Wait here."},
+  {"dialogue.continueToFollow", "Continue to follow me."},
+  {"worldClock", "Day {0}, {1}:{2}"},
+  {"achievement.unlocked", "Achievement unlocked: {0}"},
+};
+
+static_assert(std::size(kDefaultStrings) == static_cast<size_t>(StringId::SIZE),
+              "Every StringId needs a default string.");
+
+// 32-bit FNV-1a.
+uint32_t hashKey(const string_view key) {
+  uint32_t hash = 2166136261u;
+  for (const char c : key) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+size_t getPluralFormCount(const Localization::PluralRule rule) {
+  switch (rule) {
+    case Localization::PluralRule::NONE:
+      return 1;
+    case Localization::PluralRule::ENGLISH:
+    case Localization::PluralRule::FRENCH:
+      return 2;
+    default:
+      return 3;
+  }
+}
+
+size_t getPluralForm(const Localization::PluralRule rule, const int64_t n) {
+  const int64_t mod10 = n % 10;
+  const int64_t mod100 = n % 100;
+  const bool isFew = mod10 >= 2 && mod10 <= 4 && (mod100 < 12 || mod100 > 14);
+
+  switch (rule) {
+    case Localization::PluralRule::NONE:
+      return 0;
+    case Localization::PluralRule::ENGLISH:
+      return n == 1 ? 0 : 1;
+    case Localization::PluralRule::FRENCH:
+      return n <= 1 ? 0 : 1;
+    case Localization::PluralRule::SLAVIC:
+      return (mod10 == 1 && mod100 != 11) ? 0 : isFew ? 1 : 2;
+    case Localization::PluralRule::POLISH:
+    default:
+      return (n == 1) ? 0 : isFew ? 1 : 2;
+  }
+}
+
+// Returns the position of the '}' which closes the '{' at `begin`.
+size_t findClosingBrace(const string_view pattern, const size_t begin) {
+  int depth = 0;
+  for (size_t i = begin; i < pattern.size(); i++) {
+    if (pattern[i] == '{') {
+      depth++;
+    } else if (pattern[i] == '}' && --depth == 0) {
+      return i;
+    }
+  }
+  return string_view::npos;
+}
+
+// Splits the plural forms of a placeholder, i.e., by the '|' outside braces.
+vector<string_view> splitForms(const string_view forms) {
+  vector<string_view> result;
+  int depth = 0;
+  size_t begin = 0;
+  for (size_t i = 0; i < forms.size(); i++) {
+    if (forms[i] == '{') {
+      depth++;
+    } else if (forms[i] == '}') {
+      depth--;
+    } else if (forms[i] == '|' && depth == 0) {
+      result.push_back(forms.substr(begin, i - begin));
+      begin = i + 1;
+    }
+  }
+  result.push_back(forms.substr(begin));
+  return result;
+}
+
+// Parses the argument index at the beginning of a placeholder,
+// and returns the position past it, or 0 if there isn't one.
+size_t parseArgIndex(const string_view placeholder, size_t& argIdx) {
+  size_t pos = 0;
+  argIdx = 0;
+  while (pos < placeholder.size() && placeholder[pos] >= '0' && placeholder[pos] <= '9') {
+    argIdx = argIdx * 10 + (placeholder[pos] - '0');
+    pos++;
+  }
+  return pos;
+}
+
+// Checks the syntax of `pattern` upon compilation,
+// so that formatting never has to report an error.
+bool validate(const string_view pattern, const size_t pluralFormCount, string& error) {
+  for (size_t i = 0; i < pattern.size(); i++) {
+    if (pattern[i] != '{') {
+      continue;
+    }
+    if (i + 1 < pattern.size() && pattern[i + 1] == '{') {
+      i++;
+      continue;
+    }
+
+    const size_t end = findClosingBrace(pattern, i);
+    if (end == string_view::npos) {
+      error = "missing '}'";
+      return false;
+    }
+
+    const string_view placeholder = pattern.substr(i + 1, end - i - 1);
+    size_t argIdx;
+    const size_t pos = parseArgIndex(placeholder, argIdx);
+    if (pos == 0) {
+      error = "missing argument index";
+      return false;
+    }
+    if (pos < placeholder.size()) {
+      if (placeholder[pos] != '|') {
+        error = "unexpected character after argument index";
+        return false;
+      }
+      const vector<string_view> forms = splitForms(placeholder.substr(pos + 1));
+      if (forms.size() != pluralFormCount) {
+        error = "wrong number of plural forms";
+        return false;
+      }
+      for (const auto& form : forms) {
+        if (!validate(form, pluralFormCount, error)) {
+          return false;
+        }
+      }
+    }
+    i = end;
+  }
+  return true;
+}
+
+bool decodeUtf8(const string_view s, vector<char32_t>& codePoints) {
+  for (size_t i = 0; i < s.size();) {
+    const auto c = static_cast<uint8_t>(s[i]);
+    const size_t length = (c < 0x80) ? 1 : ((c >> 5) == 0x6) ? 2 : ((c >> 4) == 0xe) ? 3 : ((c >> 3) == 0x1e) ? 4 : 0;
+    if (length == 0 || i + length > s.size()) {
+      return false;
+    }
+
+    char32_t codePoint = (length == 1) ? c : (c & (0x7f >> length));
+    for (size_t j = 1; j < length; j++) {
+      const auto cc = static_cast<uint8_t>(s[i + j]);
+      if ((cc >> 6) != 0x2) {
+        return false;
+      }
+      codePoint = (codePoint << 6) | (cc & 0x3f);
+    }
+    codePoints.push_back(codePoint);
+    i += length;
+  }
+  return true;
+}
+
+string encodeUtf8(const u32string& codePoints) {
+  string s;
+  for (const char32_t c : codePoints) {
+    if (c < 0x80) {
+      s += static_cast<char>(c);
+    } else if (c < 0x800) {
+      s += static_cast<char>(0xc0 | (c >> 6));
+      s += static_cast<char>(0x80 | (c & 0x3f));
+    } else if (c < 0x10000) {
+      s += static_cast<char>(0xe0 | (c >> 12));
+      s += static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+      s += static_cast<char>(0x80 | (c & 0x3f));
+    } else {
+      s += static_cast<char>(0xf0 | (c >> 18));
+      s += static_cast<char>(0x80 | ((c >> 12) & 0x3f));
+      s += static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+      s += static_cast<char>(0x80 | (c & 0x3f));
+    }
+  }
+  return s;
+}
+
+// The glyphs of `strings`, plus printable ASCII for the numbers
+// and the names which are only known at runtime.
+u32string makeGlyphSet(const vector<string_view>& strings) {
+  vector<char32_t> codePoints;
+  for (char32_t c = 0x20; c < 0x7f; c++) {
+    codePoints.push_back(c);
+  }
+  for (const auto& s : strings) {
+    decodeUtf8(s, codePoints);
+  }
+  std::sort(codePoints.begin(), codePoints.end());
+  codePoints.erase(std::unique(codePoints.begin(), codePoints.end()), codePoints.end());
+  return {codePoints.begin(), codePoints.end()};
+}
+
+template <typename T>
+void writeBinary(ofstream& ofs, const T* data, const size_t count) {
+  ofs.write(reinterpret_cast<const char*>(data), static_cast<streamsize>(sizeof(T) * count));
+}
+
+}  // namespace
+
+Localization& Localization::the() {
+  static Localization instance;
+  return instance;
+}
+
+Localization::Localization() {
+  clear();
+}
+
+fs::path Localization::getSourceFilePath(const string& language) {
+  return kLocaleDir / (language + ".json");
+}
+
+fs::path Localization::getTableFilePath(const string& language) {
+  return kLocaleDir / (language + ".vst");
+}
+
+fs::path Localization::getGlyphSetFilePath(const string& language) {
+  return kLocaleDir / (language + ".glyphs.txt");
+}
+
+vector<string> Localization::getAvailableLanguages() {
+  set<string> languages{kDefaultLanguage};
+  error_code ec;
+  for (const auto& entry : fs::directory_iterator(kLocaleDir, ec)) {
+    const fs::path extension = entry.path().extension();
+    if (extension == ".json" || extension == ".vst") {
+      languages.insert(entry.path().stem().string());
+    }
+  }
+  return {languages.begin(), languages.end()};
+}
+
+bool Localization::load(const string& language) {
+  const fs::path sourceFilePath = getSourceFilePath(language);
+  const fs::path tableFilePath = getTableFilePath(language);
+  clear();
+  _language = language;
+
+  // Recompile the table if its source has been changed since.
+  error_code ec;
+  if (fs::exists(sourceFilePath, ec) &&
+      (!fs::exists(tableFilePath, ec) ||
+       fs::last_write_time(sourceFilePath, ec) > fs::last_write_time(tableFilePath, ec))) {
+    compile(language);
+  }
+
+  if (!fs::exists(tableFilePath, ec)) {
+    if (language != kDefaultLanguage) {
+      VGLOG(LOG_ERR, "Failed to find the strings of language [%s].", language.c_str());
+      return false;
+    }
+    return true;
+  }
+
+  ifstream ifs(tableFilePath, ios::binary);
+  const vector<char> buf{istreambuf_iterator<char>{ifs}, istreambuf_iterator<char>{}};
+
+  TableHeader header;
+  if (buf.size() < sizeof(header)) {
+    VGLOG(LOG_ERR, "Failed to load [%s]: truncated.", tableFilePath.c_str());
+    return false;
+  }
+  std::memcpy(&header, buf.data(), sizeof(header));
+
+  const size_t entriesOffset = sizeof(header);
+  const size_t dataOffset = entriesOffset + sizeof(TableEntry) * header.stringCount;
+  const size_t glyphsOffset = dataOffset + header.dataSize;
+  if (header.magic != kTableMagic || header.version != kTableVersion ||
+      header.pluralRule >= static_cast<uint32_t>(PluralRule::SIZE) ||
+      buf.size() != glyphsOffset + sizeof(char32_t) * header.glyphCount) {
+    VGLOG(LOG_ERR, "Failed to load [%s]: corrupted or outdated.", tableFilePath.c_str());
+    return false;
+  }
+
+  vector<TableEntry> entries(header.stringCount);
+  std::memcpy(entries.data(), buf.data() + entriesOffset, sizeof(TableEntry) * entries.size());
+  for (size_t i = 0; i < entries.size(); i++) {
+    if (static_cast<size_t>(entries[i].offset) + entries[i].size >= header.dataSize ||
+        (i > 0 && entries[i - 1].hash >= entries[i].hash)) {
+      VGLOG(LOG_ERR, "Failed to load [%s]: corrupted.", tableFilePath.c_str());
+      return false;
+    }
+  }
+
+  _pluralRule = static_cast<PluralRule>(header.pluralRule);
+  _data.assign(buf.begin() + dataOffset, buf.begin() + glyphsOffset);
+  _glyphSet.resize(header.glyphCount);
+  std::memcpy(_glyphSet.data(), buf.data() + glyphsOffset, sizeof(char32_t) * header.glyphCount);
+
+  _hashes.reserve(entries.size());
+  _strings.reserve(entries.size());
+  for (const auto& entry : entries) {
+    _hashes.push_back(entry.hash);
+    _strings.emplace_back(_data.data() + entry.offset, entry.size);
+  }
+
+  // Strings missing from the table keep their English texts.
+  size_t numMissingStrings = 0;
+  for (size_t i = 0; i < std::size(kDefaultStrings); i++) {
+    const string_view s = find(hashKey(kDefaultStrings[i].key));
+    if (s.data()) {
+      _stringsById[i] = s;
+      _isEnglishById[i] = false;
+    } else {
+      numMissingStrings++;
+    }
+  }
+
+  VGLOG(LOG_INFO, "Loaded %zu strings of language [%s], %zu missing.",
+        _strings.size(), language.c_str(), numMissingStrings);
+  return true;
+}
+
+bool Localization::compile(const string& language) {
+  const fs::path sourceFilePath = getSourceFilePath(language);
+  const fs::path tableFilePath = getTableFilePath(language);
+
+  rapidjson::Document json = json_util::parseJson(sourceFilePath);
+  if (!json.IsObject() || !json.HasMember("strings") || !json["strings"].IsObject()) {
+    VGLOG(LOG_ERR, "Failed to compile [%s]: no strings.", sourceFilePath.c_str());
+    return false;
+  }
+
+  PluralRule pluralRule = PluralRule::ENGLISH;
+  if (json.HasMember("plural")) {
+    auto it = std::find(kPluralRuleStr.begin(), kPluralRuleStr.end(),
+                        json["plural"].IsString() ? json["plural"].GetString() : "");
+    if (it == kPluralRuleStr.end()) {
+      VGLOG(LOG_ERR, "Failed to compile [%s]: unknown plural rule.", sourceFilePath.c_str());
+      return false;
+    }
+    pluralRule = static_cast<PluralRule>(it - kPluralRuleStr.begin());
+  }
+
+  vector<pair<uint32_t, string_view>> strings;
+  unordered_map<uint32_t, string_view> keys;
+  vector<char32_t> codePoints;
+  for (const auto& member : json["strings"].GetObject()) {
+    const string_view key{member.name.GetString(), member.name.GetStringLength()};
+    if (!member.value.IsString()) {
+      VGLOG(LOG_ERR, "Failed to compile [%s]: [%s] is not a string.", sourceFilePath.c_str(), key.data());
+      return false;
+    }
+
+    const string_view s{member.value.GetString(), member.value.GetStringLength()};
+    string error;
+    if (!validate(s, getPluralFormCount(pluralRule), error)) {
+      VGLOG(LOG_ERR, "Failed to compile [%s]: [%s]: %s.", sourceFilePath.c_str(), key.data(), error.c_str());
+      return false;
+    }
+    if (!decodeUtf8(s, codePoints)) {
+      VGLOG(LOG_ERR, "Failed to compile [%s]: [%s] is not UTF-8.", sourceFilePath.c_str(), key.data());
+      return false;
+    }
+
+    const uint32_t hash = hashKey(key);
+    auto [it, inserted] = keys.emplace(hash, key);
+    if (!inserted) {
+      VGLOG(LOG_ERR, "Failed to compile [%s]: [%s] and [%s] have the same hash, rename either.",
+            sourceFilePath.c_str(), it->second.data(), key.data());
+      return false;
+    }
+    strings.emplace_back(hash, s);
+  }
+  std::sort(strings.begin(), strings.end());
+
+  vector<TableEntry> entries;
+  string data;
+  vector<string_view> views;
+  for (const auto& [hash, s] : strings) {
+    entries.push_back({hash, static_cast<uint32_t>(data.size()), static_cast<uint32_t>(s.size())});
+    data.append(s);
+    data += '\0';
+    views.push_back(s);
+  }
+  const u32string glyphSet = makeGlyphSet(views);
+
+  const TableHeader header{kTableMagic, kTableVersion, static_cast<uint32_t>(pluralRule),
+                           static_cast<uint32_t>(entries.size()), static_cast<uint32_t>(data.size()),
+                           static_cast<uint32_t>(glyphSet.size())};
+  {
+    ofstream ofs(tableFilePath, ios::binary | ios::trunc);
+    writeBinary(ofs, &header, 1);
+    writeBinary(ofs, entries.data(), entries.size());
+    writeBinary(ofs, data.data(), data.size());
+    writeBinary(ofs, glyphSet.data(), glyphSet.size());
+    if (!ofs) {
+      VGLOG(LOG_ERR, "Failed to write [%s].", tableFilePath.c_str());
+      return false;
+    }
+  }
+  {
+    ofstream ofs(getGlyphSetFilePath(language), ios::trunc);
+    ofs << encodeUtf8(glyphSet);
+  }
+
+  VGLOG(LOG_INFO, "Compiled %zu strings and %zu glyphs of language [%s].",
+        entries.size(), glyphSet.size(), language.c_str());
+  return true;
+}
+
+bool Localization::exportDefaults() {
+  rapidjson::Document json;
+  json.SetObject();
+  rapidjson::Document::AllocatorType& allocator = json.GetAllocator();
+
+  rapidjson::Value strings(rapidjson::kObjectType);
+  for (const auto& [key, text] : kDefaultStrings) {
+    strings.AddMember(rapidjson::StringRef(key), rapidjson::StringRef(text), allocator);
+  }
+  json.AddMember("plural", rapidjson::StringRef(kPluralRuleStr[static_cast<size_t>(PluralRule::ENGLISH)].c_str()), allocator);
+  json.AddMember("strings", strings, allocator);
+
+  error_code ec;
+  fs::create_directories(kLocaleDir, ec);
+  json_util::saveToFile(getSourceFilePath(kDefaultLanguage), json);
+  return !ec;
+}
+
+string Localization::localize(const string& text) const {
+  if (text.empty() || text.front() != kDataKeyPrefix) {
+    return text;
+  }
+
+  const string_view key = string_view{text}.substr(1);
+  const string_view s = find(hashKey(key));
+  if (!s.data()) {
+    VGLOG(LOG_WARN, "Failed to find the string [%s] of language [%s].", text.c_str(), _language.c_str());
+    return string{key};
+  }
+  return string{s};
+}
+
+void Localization::preloadGlyphs() const {
+  const array<fs::path, 3> fonts{{kRegularFont, kBoldFont, kTitleFont}};
+  for (const auto& font : fonts) {
+    TTFConfig config{string{font}, kRegularFontSize};
+    if (FontAtlas* fontAtlas = FontAtlasCache::getFontAtlasTTF(&config)) {
+      fontAtlas->prepareLetterDefinitions(_glyphSet);
+    }
+  }
+}
+
+string Localization::format(const string_view pattern,
+                            span<const Localization::Arg> args,
+                            const Localization::PluralRule pluralRule,
+                            const string* hashText) const {
+  string result;
+  result.reserve(pattern.size());
+
+  for (size_t i = 0; i < pattern.size(); i++) {
+    if (pattern[i] == '#' && hashText) {
+      result += *hashText;
+      continue;
+    }
+    if (pattern[i] != '{') {
+      result += pattern[i];
+      continue;
+    }
+    if (i + 1 < pattern.size() && pattern[i + 1] == '{') {
+      result += '{';
+      i++;
+      continue;
+    }
+
+    // The pattern has been validated upon compilation, but the
+    // English texts in the code are kept as is if they are malformed.
+    const size_t end = findClosingBrace(pattern, i);
+    if (end == string_view::npos) {
+      result.append(pattern.substr(i));
+      break;
+    }
+    const string_view placeholder = pattern.substr(i + 1, end - i - 1);
+    size_t argIdx;
+    const size_t pos = parseArgIndex(placeholder, argIdx);
+    if (pos == 0 || argIdx >= args.size()) {
+      result.append(pattern.substr(i, end - i + 1));
+      i = end;
+      continue;
+    }
+    i = end;
+
+    const Localization::Arg& arg = args[argIdx];
+    if (pos == placeholder.size()) {
+      result += arg.getText();
+      continue;
+    }
+
+    // The arguments are substituted as they are, rather than being
+    // formatted along with the form, so any braces in them are kept.
+    const vector<string_view> forms = splitForms(placeholder.substr(pos + 1));
+    const string_view form = forms[std::min(getPluralForm(pluralRule, arg.getNumber()), forms.size() - 1)];
+    result += format(form, args, pluralRule, &arg.getText());
+  }
+  return result;
+}
+
+string_view Localization::find(const uint32_t hash) const {
+  auto it = std::lower_bound(_hashes.begin(), _hashes.end(), hash);
+  if (it == _hashes.end() || *it != hash) {
+    return {};
+  }
+  return _strings[it - _hashes.begin()];
+}
+
+void Localization::clear() {
+  _pluralRule = PluralRule::ENGLISH;
+  _data.clear();
+  _hashes.clear();
+  _strings.clear();
+
+  _isEnglishById.set();
+
+  vector<string_view> texts;
+  for (size_t i = 0; i < std::size(kDefaultStrings); i++) {
+    _stringsById[i] = kDefaultStrings[i].text;
+    texts.push_back(kDefaultStrings[i].text);
+  }
+  _glyphSet = makeGlyphSet(texts);
+}
+
+}  // namespace vigilante
@@ -0,0 +1,294 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_LOCALIZATION_H_
+#define VIGILANTE_LOCALIZATION_H_
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace vigilante {
+
+// The user-facing strings of the code. Their keys and English texts
+// are listed in Localization.cc, in the same order.
+enum class StringId : uint16_t {
+  PARTY_FOLLOWING,
+  PARTY_LEFT,
+  PARTY_WAITING,
+  PLAYER_ACQUIRED_EXP,
+  PLAYER_ACQUIRED_ITEM,
+  PLAYER_ACQUIRED_ITEMS,
+  PLAYER_REMOVED_ITEM,
+  PLAYER_REMOVED_ITEMS,
+  PLAYER_LEVEL_UP,
+  DOOR_LOCKED,
+  DOOR_UNLOCKED,
+  PORTAL_LOCKED,
+  NOTHING_HAPPENS,
+  HINT_OPEN,
+  HINT_TALK,
+  TRADE_RECEIVING_FROM,
+  TRADE_GIVING_TO,
+  TRADE_BUYING_FROM,
+  TRADE_SELLING_TO,
+  TRADE_CART,
+  TRADE_YOU_PAY,
+  TRADE_YOU_RECEIVE,
+  TRADE_TRADED,
+  TRADE_FAILED,
+  TRADE_NOT_ENOUGH_ITEMS,
+  TRADE_NOT_ENOUGH_GOLD,
+  AMOUNT_PROMPT,
+  AMOUNT_INVALID,
+  AMOUNT_OUT_OF_RANGE,
+  AMOUNT_UNKNOWN_ERROR,
+  SAVE_GAME,
+  LOAD_GAME,
+  SAVE_QUICK_SAVE_SLOT,
+  SAVE_SLOT,
+  SAVE_EMPTY_SLOT_ENTRY,
+  SAVE_SLOT_ENTRY,
+  SAVE_SLOT_EMPTY,
+  SAVE_SUCCEEDED,
+  SAVE_FAILED,
+  LOAD_FAILED,
+  MAIN_MENU_NEW_GAME,
+  MAIN_MENU_LOAD_GAME,
+  MAIN_MENU_OPTIONS,
+  MAIN_MENU_EXIT,
+  PANE_INVENTORY,
+  PANE_EQUIPMENT,
+  PANE_SKILLS,
+  PANE_QUESTS,
+  PANE_OPTIONS,
+  OPTION_OPTIONS,
+  OPTION_KEY_BINDINGS,
+  OPTION_QUIT,
+  OPTIONS_FRAME_RATE_CAP,
+  OPTIONS_UNLIMITED,
+  OPTIONS_VSYNC,
+  OPTIONS_RESOLUTION_SCALE,
+  OPTIONS_FULLSCREEN,
+  OPTIONS_EFFECT_QUALITY,
+  OPTIONS_LANGUAGE,
+  OPTIONS_ON,
+  OPTIONS_OFF,
+  OPTIONS_QUALITY_LOW,
+  OPTIONS_QUALITY_MEDIUM,
+  OPTIONS_QUALITY_HIGH,
+  ACTION_MOVE_LEFT,
+  ACTION_MOVE_RIGHT,
+  ACTION_AIM_UP,
+  ACTION_CROUCH,
+  ACTION_JUMP,
+  ACTION_DODGE,
+  ACTION_ATTACK,
+  ACTION_BLOCK,
+  ACTION_INTERACT,
+  ACTION_PICKUP_ITEM,
+  ACTION_USE_PORTAL,
+  ACTION_HOTKEY_1,
+  ACTION_HOTKEY_2,
+  ACTION_HOTKEY_3,
+  ACTION_HOTKEY_4,
+  ACTION_HOTKEY_5,
+  ACTION_WORLD_MAP,
+  ACTION_MENU_UP,
+  ACTION_MENU_DOWN,
+  ACTION_MENU_LEFT,
+  ACTION_MENU_RIGHT,
+  ACTION_MENU_CONFIRM,
+  ACTION_MENU_PREV_TAB,
+  ACTION_MENU_NEXT_TAB,
+  ACTION_MENU_COMMIT,
+  ACTION_PAUSE,
+  ACTION_DEBUG_DRAW,
+  ACTION_CONSOLE,
+  KEY_BINDINGS_ENTRY,
+  KEY_BINDINGS_UNBOUND,
+  KEY_BINDINGS_CONFLICT,
+  KEY_BINDINGS_RESET,
+  KEY_BINDINGS_PRESS_A_KEY,
+  KEY_BINDINGS_TAKE_OVER,
+  KEY_BINDINGS_RESET_DONE,
+  KEY_BINDINGS_SAVE_FAILED,
+  DIALOG_WHAT_TO_DO_WITH,
+  DIALOG_PRESS_A_KEY,
+  DIALOG_ARE_YOU_SURE,
+  DIALOG_EQUIP,
+  DIALOG_USE,
+  DIALOG_DISCARD,
+  DIALOG_ASSIGN,
+  DIALOG_CLEAR,
+  DIALOG_CONFIRM,
+  DIALOG_CANCEL,
+  STATS_LEVEL,
+  STATS_HEALTH,
+  STATS_MAGICKA,
+  STATS_STAMINA,
+  STATS_ATTACK_RANGE,
+  STATS_ATTACK_SPEED,
+  STATS_MOVE_SPEED,
+  STATS_JUMP_HEIGHT,
+  STATS_STR,
+  STATS_DEX,
+  STATS_INT,
+  STATS_LUK,
+  QUEST_STARTED,
+  QUEST_COMPLETED,
+  QUEST_ELIMINATE,
+  QUEST_COLLECT,
+  QUEST_TALK_TO,
+  DIALOGUE_TRADE,
+  DIALOGUE_FOLLOW_ME,
+  DIALOGUE_PART_WAYS,
+  DIALOGUE_WAIT_HERE,
+  DIALOGUE_CONTINUE_TO_FOLLOW,
+  WORLD_CLOCK,
+  ACHIEVEMENT_UNLOCKED,
+  SIZE
+};
+
+// Localization holds the string table of the active language.
+//
+// The strings of a language are written in Data/locale/<language>.json,
+//
+//   {
+//     "plural": "english",
+//     "strings": {
+//       "party.following": "{0} is now following you.",
+//       "trade.cart": "Cart: {0|# item|# items}",
+//       "item.rustySword.name": "Rusty Sword"
+//     }
+//   }
+//
+// and compiled into Data/locale/<language>.vst, a binary table of the
+// strings sorted by the hash of their keys, followed by the glyph set of
+// the language. Only the table of the active language is resident, and
+// the JSON is only read to recompile the table when it has been changed.
+//
+// In a string, `{n}` is replaced by the n-th argument, and `{n|a|b|...}`
+// is replaced by one of the forms, chosen by the plural rule of the
+// language for the n-th argument, with `#` replaced by the n-th argument.
+// `{{` is a literal `{`.
+//
+// Strings of the code are referenced by StringId, and those of the data
+// (items, quests and dialogues) by their keys, e.g., "@item.rustySword.name".
+// A string missing from the table falls back to its English text (whose
+// plural forms are chosen by the English plural rule), or to its key.
+class Localization final {
+ public:
+  static inline constexpr char kDefaultLanguage[] = "en";
+  static inline constexpr char kDataKeyPrefix = '@';
+
+  enum class PluralRule : uint32_t {
+    NONE,     // e.g., Japanese, Chinese, Korean
+    ENGLISH,  // one: n == 1
+    FRENCH,   // one: n <= 1
+    SLAVIC,   // one: n % 10 == 1 (but 11), few: n % 10 == 2..4 (but 12..14), many
+    POLISH,   // one: n == 1, few: n % 10 == 2..4 (but 12..14), many
+    SIZE
+  };
+
+  static inline const std::array<std::string, static_cast<size_t>(PluralRule::SIZE)> kPluralRuleStr{{
+    "none",
+    "english",
+    "french",
+    "slavic",
+    "polish",
+  }};
+
+  // An argument of a string, which may also choose a plural form.
+  class Arg final {
+   public:
+    Arg(const std::string& text) : _text{text} {}
+    Arg(const char* text) : _text{text} {}
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    Arg(const T n) : _text{std::to_string(n)}, _n{static_cast<int64_t>(n)}, _isNumber{true} {}
+
+    inline const std::string& getText() const { return _text; }
+    inline int64_t getNumber() const { return _n; }
+    inline bool isNumber() const { return _isNumber; }
+
+   private:
+    std::string _text;
+    int64_t _n{};
+    bool _isNumber{};
+  };
+
+  static Localization& the();
+  static fs::path getSourceFilePath(const std::string& language);
+  static fs::path getTableFilePath(const std::string& language);
+  static fs::path getGlyphSetFilePath(const std::string& language);
+  // The languages which have strings in Data/locale, and English.
+  static std::vector<std::string> getAvailableLanguages();
+
+  // Loads the table of `language`, compiling it first if needed.
+  // The English texts in the code are used if the language has no strings.
+  bool load(const std::string& language);
+  // Compiles Data/locale/<language>.json into a binary table,
+  // and writes its glyph set as UTF-8 for font atlas tools.
+  static bool compile(const std::string& language);
+  // Writes the English texts in the code as Data/locale/en.json,
+  // as the template for translations.
+  static bool exportDefaults();
+
+  template <typename... Args>
+  std::string get(const StringId id, const Args&... args) const;
+  // Resolves `text` if it is a key of the data (e.g., "@item.rustySword.name"),
+  // otherwise returns `text` as is.
+  std::string localize(const std::string& text) const;
+
+  // Builds the atlases of the UI fonts for the glyph set ahead of time,
+  // so that no glyph is rasterized while playing.
+  void preloadGlyphs() const;
+
+  inline const std::string& getLanguage() const { return _language; }
+  inline Localization::PluralRule getPluralRule() const { return _pluralRule; }
+  inline const std::u32string& getGlyphSet() const { return _glyphSet; }
+  inline size_t getStringCount() const { return _hashes.size(); }
+
+ private:
+  Localization();
+
+  // `#` is replaced by `*hashText`, if given (i.e., in a plural form).
+  std::string format(const std::string_view pattern,
+                     std::span<const Localization::Arg> args,
+                     const Localization::PluralRule pluralRule,
+                     const std::string* hashText=nullptr) const;
+  std::string_view find(const uint32_t hash) const;
+  void clear();
+
+  std::string _language;
+  Localization::PluralRule _pluralRule{PluralRule::ENGLISH};
+  std::vector<char> _data;  // the strings of the table
+  std::vector<uint32_t> _hashes;  // sorted
+  std::vector<std::string_view> _strings;  // parallel to `_hashes`, into `_data`
+  std::array<std::string_view, static_cast<size_t>(StringId::SIZE)> _stringsById;
+  std::bitset<static_cast<size_t>(StringId::SIZE)> _isEnglishById;  // i.e., missing from the table
+  std::u32string _glyphSet;
+};
+
+template <typename... Args>
+std::string Localization::get(const StringId id, const Args&... args) const {
+  const std::array<Localization::Arg, sizeof...(Args)> argArray{{Localization::Arg{args}...}};
+  const auto i = static_cast<size_t>(id);
+  return format(_stringsById[i], argArray, _isEnglishById[i] ? PluralRule::ENGLISH : _pluralRule);
+}
+
+// A shorthand for Localization::the().get().
+template <typename... Args>
+inline std::string tr(const StringId id, const Args&... args) {
+  return Localization::the().get(id, args...);
+}
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_LOCALIZATION_H_
@@ -0,0 +1,123 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "Options.h"
+
+#include <algorithm>
+
+#include <axmol.h>
+
+#include "Constants.h"
+#include "FrameLimiter.h"
+#include "Localization.h"
+#include "util/JsonUtil.h"
+#include "util/Logger.h"
+
+using namespace std;
+USING_NS_AX;
+
+namespace vigilante {
+
+Options& Options::the() {
+  static Options instance;
+  return instance;
+}
+
+Options::Options() : _language{Localization::kDefaultLanguage} {}
+
+bool Options::load(const fs::path& optionsFileName) {
+  if (!fs::exists(optionsFileName)) {
+    return false;
+  }
+
+  rapidjson::Document json = json_util::parseJson(optionsFileName);
+  if (!json.IsObject()) {
+    VGLOG(LOG_ERR, "Failed to load options from [%s].", optionsFileName.c_str());
+    return false;
+  }
+
+  if (json.HasMember("frameRateCap") && json["frameRateCap"].IsInt()) {
+    setFrameRateCap(json["frameRateCap"].GetInt());
+  }
+  if (json.HasMember("vsync") && json["vsync"].IsBool()) {
+    setVSyncEnabled(json["vsync"].GetBool());
+  }
+  if (json.HasMember("resolutionScale") && json["resolutionScale"].IsInt()) {
+    setResolutionScale(json["resolutionScale"].GetInt());
+  }
+  if (json.HasMember("fullscreen") && json["fullscreen"].IsBool()) {
+    setFullscreen(json["fullscreen"].GetBool());
+  }
+  if (json.HasMember("effectQuality") && json["effectQuality"].IsString()) {
+    auto it = std::find(kEffectQualityStr.begin(), kEffectQualityStr.end(), json["effectQuality"].GetString());
+    if (it != kEffectQualityStr.end()) {
+      setEffectQuality(static_cast<EffectQuality>(it - kEffectQualityStr.begin()));
+    } else {
+      VGLOG(LOG_WARN, "Unknown effect quality [%s], keeping [%s].",
+            json["effectQuality"].GetString(), kEffectQualityStr[static_cast<size_t>(_effectQuality)].c_str());
+    }
+  }
+  if (json.HasMember("language") && json["language"].IsString()) {
+    setLanguage(json["language"].GetString());
+  }
+
+  return true;
+}
+
+bool Options::save(const fs::path& optionsFileName) const {
+  rapidjson::Document json;
+  json.SetObject();
+  rapidjson::Document::AllocatorType& allocator = json.GetAllocator();
+
+  json.AddMember("frameRateCap", _frameRateCap, allocator);
+  json.AddMember("vsync", _isVSyncEnabled, allocator);
+  json.AddMember("resolutionScale", _resolutionScale, allocator);
+  json.AddMember("fullscreen", _isFullscreen, allocator);
+  json.AddMember("effectQuality",
+                 json_util::makeJsonObject(allocator, kEffectQualityStr[static_cast<size_t>(_effectQuality)]),
+                 allocator);
+  json.AddMember("language", json_util::makeJsonObject(allocator, _language), allocator);
+
+  json_util::saveToFile(optionsFileName, json);
+  VGLOG(LOG_INFO, "Saved options to [%s].", optionsFileName.c_str());
+  return true;
+}
+
+void Options::apply() const {
+  Director* director = Director::getInstance();
+
+  // The Director only sleeps with a millisecond granularity,
+  // so the frames are paced by the FrameLimiter instead.
+  director->setAnimationInterval(1.0f / 1000);
+  FrameLimiter::the().setTargetFps(_frameRateCap);
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32) || (CC_TARGET_PLATFORM == CC_PLATFORM_MAC) || (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+  auto glview = dynamic_cast<GLViewImpl*>(director->getOpenGLView());
+  if (!glview) {
+    return;
+  }
+
+  glfwSwapInterval(_isVSyncEnabled ? 1 : 0);
+
+  // The window is an integer multiple of the virtual resolution,
+  // so that the pixel art is scaled evenly. It is only resized if needed,
+  // since that also recenters it.
+  const Size windowSize{static_cast<float>(kVirtualWidth * _resolutionScale),
+                        static_cast<float>(kVirtualHeight * _resolutionScale)};
+  if (_isFullscreen) {
+    if (!glview->isFullscreen()) {
+      glview->setFullscreen();
+    }
+  } else if (glview->isFullscreen() || !glview->getFrameSize().equals(windowSize)) {
+    glview->setWindowed(static_cast<int>(windowSize.width), static_cast<int>(windowSize.height));
+  }
+#endif
+}
+
+void Options::setFrameRateCap(const int frameRateCap) {
+  _frameRateCap = std::max(frameRateCap, 0);
+}
+
+void Options::setResolutionScale(const int resolutionScale) {
+  _resolutionScale = std::clamp(resolutionScale, 1, kMaxResolutionScale);
+}
+
+}  // namespace vigilante
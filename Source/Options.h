@@ -0,0 +1,71 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_OPTIONS_H_
+#define VIGILANTE_OPTIONS_H_
+
+#include <array>
+#include <filesystem>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace vigilante {
+
+// The user's options, persisted to `kOptionsFileName` next to the input bindings.
+// Options missing from the file (e.g., added by a newer version) keep their defaults.
+class Options final {
+ public:
+  enum class EffectQuality {
+    LOW,     // no hit fx, after images or parallax scrolling
+    MEDIUM,  // sparser after images, at most `kMediumParallaxLayerCount` parallax layers
+    HIGH,
+    SIZE
+  };
+
+  static inline const std::array<std::string, static_cast<size_t>(EffectQuality::SIZE)> kEffectQualityStr{{
+    "low",
+    "medium",
+    "high",
+  }};
+
+  static inline constexpr char kOptionsFileName[] = "options.json";
+  // 0 is unlimited.
+  static inline constexpr std::array<int, 6> kFrameRateCaps{{0, 30, 60, 120, 144, 240}};
+  static inline constexpr int kMaxResolutionScale = 4;
+  static inline constexpr int kMediumParallaxLayerCount = 3;
+
+  static Options& the();
+
+  bool load(const fs::path& optionsFileName);
+  bool save(const fs::path& optionsFileName) const;
+  // Applies the display options to the Director, the GLView and the FrameLimiter.
+  // EffectQuality is read by the fx managers whenever they create an effect.
+  void apply() const;
+
+  inline int getFrameRateCap() const { return _frameRateCap; }
+  inline bool isVSyncEnabled() const { return _isVSyncEnabled; }
+  inline int getResolutionScale() const { return _resolutionScale; }
+  inline bool isFullscreen() const { return _isFullscreen; }
+  inline Options::EffectQuality getEffectQuality() const { return _effectQuality; }
+  inline const std::string& getLanguage() const { return _language; }
+
+  void setFrameRateCap(const int frameRateCap);
+  inline void setVSyncEnabled(const bool vsync) { _isVSyncEnabled = vsync; }
+  void setResolutionScale(const int resolutionScale);
+  inline void setFullscreen(const bool fullscreen) { _isFullscreen = fullscreen; }
+  inline void setEffectQuality(const Options::EffectQuality effectQuality) { _effectQuality = effectQuality; }
+  inline void setLanguage(const std::string& language) { _language = language; }
+
+ private:
+  Options();
+
+  int _frameRateCap{60};
+  bool _isVSyncEnabled{true};
+  int _resolutionScale{2};
+  bool _isFullscreen{};
+  Options::EffectQuality _effectQuality{EffectQuality::HIGH};
+  std::string _language;
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_OPTIONS_H_
@@ -8,6 +8,7 @@
 #include "map/GameMapManager.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
+#include "util/MemoryTracker.h"
 
 namespace fs = std::filesystem;
 using namespace std;
@@ -54,6 +55,7 @@ Animation* StaticActor::createAnimation(const string& textureResDir,
                                         const string& framesName,
                                         const float interval,
                                         Animation* fallback) {
+  ScopedMemoryTag memoryTag{MemoryTag::ANIMATIONS};
   FileUtils* fileUtils = FileUtils::getInstance();
   SpriteFrameCache* frameCache = SpriteFrameCache::getInstance();
 
@@ -26,6 +26,7 @@ class StaticActor {
   virtual bool removeFromMap();
   virtual void setPosition(float x, float y);
 
+  inline bool isShownOnMap() const { return _isShownOnMap; }
   inline ax::Node* getNode() const { return _node; }
   inline ax::Sprite* getBodySprite() const { return _bodySprite; }
   inline ax::SpriteBatchNode* getBodySpritesheet() const { return _bodySpritesheet; }
@@ -0,0 +1,256 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "BehaviorTree.h"
+
+#include <limits>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+#include "character/NpcController.h"
+#include "util/JsonUtil.h"
+#include "util/Logger.h"
+
+using namespace std;
+
+namespace vigilante {
+
+namespace {
+
+// The tree of the Npcs which don't specify one. It behaves exactly
+// like the decision chain NpcController used to have.
+constexpr char kDefaultBehaviorTree[] = R"({
+  "type": "sequence", "children": [
+    {"type": "action", "name": "updatePerception"},
+    {"type": "selector", "children": [
+      {"type": "sequence", "children": [
+        {"type": "condition", "name": "hasTarget"},
+        {"type": "selector", "children": [
+          {"type": "action", "name": "castSkill"},
+          {"type": "sequence", "children": [
+            {"type": "condition", "name": "isTargetInRange"},
+            {"type": "action", "name": "attack"}
+          ]},
+          {"type": "action", "name": "moveToTarget"}
+        ]}
+      ]},
+      {"type": "sequence", "children": [
+        {"type": "condition", "name": "isTargetKilled"},
+        {"type": "action", "name": "retarget"}
+      ]},
+      {"type": "sequence", "children": [
+        {"type": "condition", "name": "isFollowingParty"},
+        {"type": "action", "name": "followFormation"}
+      ]},
+      {"type": "sequence", "children": [
+        {"type": "condition", "name": "hasMoveDest"},
+        {"type": "action", "name": "moveToMoveDest"}
+      ]},
+      {"type": "sequence", "children": [
+        {"type": "condition", "name": "hasTravelDest"},
+        {"type": "action", "name": "moveToTravelDest"}
+      ]},
+      {"type": "sequence", "children": [
+        {"type": "condition", "name": "isSandboxing"},
+        {"type": "action", "name": "moveRandomly", "args": [0, 5, 0, 5]}
+      ]}
+    ]}
+  ]
+})";
+
+constexpr char kDefaultBehaviorTreeName[] = "default";
+
+const array<string, 3> kCompositeNodeTypeStr{{
+  "selector",
+  "sequence",
+  "inverter",
+}};
+
+template <typename Enum, size_t N>
+optional<Enum> findByName(const array<string, N>& names, const string& name) {
+  for (size_t i = 0; i < N; i++) {
+    if (names[i] == name) {
+      return static_cast<Enum>(i);
+    }
+  }
+  return nullopt;
+}
+
+}  // namespace
+
+const BehaviorTree* BehaviorTree::get(const string& jsonFileName) {
+  // Trees which fail to compile are cached as nullptr, and the default tree
+  // is used instead. If even the default tree fails, there's no tree at all.
+  static unordered_map<string, unique_ptr<BehaviorTree>> trees;
+
+  auto it = trees.find(jsonFileName);
+  if (it != trees.end()) {
+    if (it->second) {
+      return it->second.get();
+    }
+    return jsonFileName.empty() ? nullptr : get("");
+  }
+
+  rapidjson::Document json;
+  if (jsonFileName.empty()) {
+    json.Parse(kDefaultBehaviorTree);
+  } else {
+    json = json_util::parseJson(jsonFileName);
+  }
+
+  unique_ptr<BehaviorTree> tree{new BehaviorTree(jsonFileName.empty() ? kDefaultBehaviorTreeName : jsonFileName)};
+  if (json.HasParseError() || !tree->compile(json)) {
+    VGLOG(LOG_ERR, "Failed to compile behavior tree [%s].", jsonFileName.c_str());
+    tree.reset();
+  }
+
+  const BehaviorTree* ret = tree.get();
+  trees.emplace(jsonFileName, std::move(tree));
+  if (!ret && !jsonFileName.empty()) {
+    return get("");
+  }
+  return ret;
+}
+
+BehaviorTree::Status BehaviorTree::tick(NpcController& controller, Blackboard& blackboard, const float delta) const {
+  // Always from the root, so that a running action is preempted
+  // as soon as a branch before it becomes viable.
+  return tick(0, controller, blackboard, delta);
+}
+
+BehaviorTree::Status BehaviorTree::tick(const size_t nodeIdx, NpcController& controller,
+                                        Blackboard& blackboard, const float delta) const {
+  const Node& node = _nodes[nodeIdx];
+
+  switch (node.type) {
+    case NodeType::SELECTOR:
+      for (size_t child = nodeIdx + 1; child < node.end; child = _nodes[child].end) {
+        if (const Status status = tick(child, controller, blackboard, delta); status != Status::FAILURE) {
+          return status;
+        }
+      }
+      return Status::FAILURE;
+
+    case NodeType::SEQUENCE:
+      for (size_t child = nodeIdx + 1; child < node.end; child = _nodes[child].end) {
+        if (const Status status = tick(child, controller, blackboard, delta); status != Status::SUCCESS) {
+          return status;
+        }
+      }
+      return Status::SUCCESS;
+
+    case NodeType::INVERTER:
+      switch (tick(nodeIdx + 1, controller, blackboard, delta)) {
+        case Status::SUCCESS:
+          return Status::FAILURE;
+        case Status::FAILURE:
+          return Status::SUCCESS;
+        default:
+          return Status::RUNNING;
+      }
+
+    case NodeType::CONDITION:
+      return controller.evaluate(static_cast<NpcController::Condition>(node.leafId)) ? Status::SUCCESS :
+                                                                                       Status::FAILURE;
+
+    case NodeType::ACTION:
+    default: {
+      const Status status = controller.perform(static_cast<NpcController::Action>(node.leafId), node.args, delta);
+      blackboard.activeNode = static_cast<int>(nodeIdx);
+      blackboard.isRunning = status == Status::RUNNING;
+      return status;
+    }
+  }
+}
+
+string BehaviorTree::describe(const int nodeIdx) const {
+  if (nodeIdx < 0 || nodeIdx >= static_cast<int>(_nodes.size())) {
+    return "none";
+  }
+
+  // Walk down from the root to the node.
+  string path = getNodeName(0);
+  size_t current = 0;
+  while (current != static_cast<size_t>(nodeIdx)) {
+    size_t child = current + 1;
+    while (_nodes[child].end <= static_cast<size_t>(nodeIdx)) {
+      child = _nodes[child].end;
+    }
+    current = child;
+    path += " > " + getNodeName(current);
+  }
+  return path;
+}
+
+bool BehaviorTree::compile(const rapidjson::Value& json) {
+  if (!json.IsObject() || !json.HasMember("type")) {
+    VGLOG(LOG_ERR, "Invalid node in behavior tree [%s].", _name.c_str());
+    return false;
+  }
+  if (_nodes.size() >= numeric_limits<uint16_t>::max()) {
+    VGLOG(LOG_ERR, "Too many nodes in behavior tree [%s].", _name.c_str());
+    return false;
+  }
+
+  const string type = json["type"].GetString();
+  const size_t nodeIdx = _nodes.size();
+  _nodes.push_back({});
+
+  Node node{};
+  if (const auto compositeType = findByName<NodeType>(kCompositeNodeTypeStr, type)) {
+    if (!json.HasMember("children") || !json["children"].IsArray() || json["children"].Empty()) {
+      VGLOG(LOG_ERR, "Node [%s] has no children in behavior tree [%s].", type.c_str(), _name.c_str());
+      return false;
+    }
+    if (*compositeType == NodeType::INVERTER && json["children"].Size() != 1) {
+      VGLOG(LOG_ERR, "Inverter must have exactly one child in behavior tree [%s].", _name.c_str());
+      return false;
+    }
+    for (const auto& childJson : json["children"].GetArray()) {
+      if (!compile(childJson)) {
+        return false;
+      }
+    }
+    node.type = *compositeType;
+
+  } else if (type == "condition" || type == "action") {
+    const string name = json.HasMember("name") ? json["name"].GetString() : "";
+    const optional<uint8_t> leafId = (type == "condition") ?
+      findByName<uint8_t>(NpcController::kConditionStr, name) :
+      findByName<uint8_t>(NpcController::kActionStr, name);
+    if (!leafId) {
+      VGLOG(LOG_ERR, "Unknown %s [%s] in behavior tree [%s].", type.c_str(), name.c_str(), _name.c_str());
+      return false;
+    }
+
+    node.type = (type == "condition") ? NodeType::CONDITION : NodeType::ACTION;
+    node.leafId = *leafId;
+    if (json.HasMember("args")) {
+      const auto& argsJson = json["args"].GetArray();
+      for (rapidjson::SizeType i = 0; i < argsJson.Size() && i < node.args.size(); i++) {
+        node.args[i] = argsJson[i].GetFloat();
+      }
+    }
+
+  } else {
+    VGLOG(LOG_ERR, "Unknown node type [%s] in behavior tree [%s].", type.c_str(), _name.c_str());
+    return false;
+  }
+
+  node.end = static_cast<uint16_t>(_nodes.size());
+  _nodes[nodeIdx] = node;
+  return true;
+}
+
+const string& BehaviorTree::getNodeName(const size_t nodeIdx) const {
+  const Node& node = _nodes[nodeIdx];
+  switch (node.type) {
+    case NodeType::CONDITION:
+      return NpcController::kConditionStr[node.leafId];
+    case NodeType::ACTION:
+      return NpcController::kActionStr[node.leafId];
+    default:
+      return kCompositeNodeTypeStr[static_cast<size_t>(node.type)];
+  }
+}
+
+}  // namespace vigilante
@@ -0,0 +1,99 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_BEHAVIOR_TREE_H_
+#define VIGILANTE_BEHAVIOR_TREE_H_
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+namespace vigilante {
+
+class NpcController;
+
+// A BehaviorTree decides what an Npc does. Trees are defined in json, e.g.,
+//
+//   {"type": "selector", "children": [
+//     {"type": "sequence", "children": [
+//       {"type": "condition", "name": "hasTarget"},
+//       {"type": "action", "name": "moveToTarget"}
+//     ]},
+//     {"type": "action", "name": "moveRandomly", "args": [0, 5, 0, 5]}
+//   ]}
+//
+// and compiled once into an immutable array of nodes in pre-order, which is
+// shared by all the Npcs using the same tree. The conditions and actions
+// (the leaves) are implemented by NpcController, and the per-Npc state of
+// the tree lives in its Blackboard.
+//
+// The tree is reactive: every tick starts over from the root rather than
+// resuming the node which returned RUNNING. A running action is continued
+// simply by being reached again, with its progress kept by NpcController
+// (e.g., its move destination), while a branch before it (e.g., a target
+// showing up) takes over right away once its conditions hold.
+class BehaviorTree final {
+ public:
+  enum class Status : uint8_t {
+    SUCCESS,
+    FAILURE,
+    RUNNING,
+  };
+
+  enum class NodeType : uint8_t {
+    SELECTOR,  // succeeds as soon as one of its children doesn't fail
+    SEQUENCE,  // fails as soon as one of its children doesn't succeed
+    INVERTER,
+    CONDITION,
+    ACTION,
+  };
+
+  using Args = std::array<float, 4>;
+
+  struct Node final {
+    BehaviorTree::NodeType type;
+    uint8_t leafId;  // NpcController::Condition or NpcController::Action
+    uint16_t end;  // one past the last node of this subtree
+    BehaviorTree::Args args;
+  };
+
+  struct Blackboard final {
+    // For debugging only (see the inspectNpc command), since
+    // the tree isn't resumed from here.
+    int activeNode{-1};  // the action ticked most recently
+    bool isRunning{};  // whether the active node is still running
+    // An Npc which has nothing to do (the tree has failed) isn't ticked
+    // again until something happens to it, or until this timer runs out.
+    bool isAwake{true};
+    float sleepTimer{};
+  };
+
+  // Returns the compiled tree of `jsonFileName`, which is compiled upon the
+  // first request. An empty `jsonFileName` gives the default tree, which is
+  // also returned if the requested tree fails to compile. Returns nullptr
+  // if the default tree fails to compile as well.
+  static const BehaviorTree* get(const std::string& jsonFileName);
+
+  Status tick(NpcController& controller, BehaviorTree::Blackboard& blackboard, const float delta) const;
+
+  // e.g., "sequence > selector > sequence > moveToTarget"
+  std::string describe(const int nodeIdx) const;
+  inline const std::string& getName() const { return _name; }
+  inline size_t getNodeCount() const { return _nodes.size(); }
+
+ private:
+  explicit BehaviorTree(const std::string& name) : _name{name} {}
+
+  bool compile(const rapidjson::Value& json);
+  Status tick(const size_t nodeIdx, NpcController& controller,
+              BehaviorTree::Blackboard& blackboard, const float delta) const;
+  const std::string& getNodeName(const size_t nodeIdx) const;
+
+  const std::string _name;
+  std::vector<BehaviorTree::Node> _nodes;
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_BEHAVIOR_TREE_H_
@@ -4,6 +4,8 @@
 #include <algorithm>
 #include <cassert>
 #include <filesystem>
+#include <map>
+#include <tuple>
 
 #include "Assets.h"
 #include "Audio.h"
@@ -11,14 +13,19 @@
 #include "Constants.h"
 #include "character/Player.h"
 #include "combat/ComboSystem.h"
+#include "combat/ImpulseQueue.h"
+#include "combat/MeleeHitResolver.h"
 #include "gameplay/ExpPointTable.h"
+#include "gameplay/Statistics.h"
+#include "gameplay/StatusEffectSystem.h"
+#include "gameplay/TimeScale.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
-#include "util/B2BodyBuilder.h"
 #include "util/JsonUtil.h"
 #include "util/MathUtil.h"
 #include "util/RandUtil.h"
 #include "util/Logger.h"
+#include "util/MemoryTracker.h"
 
 namespace fs = std::filesystem;
 using namespace std;
@@ -27,13 +34,70 @@ USING_NS_AX;
 
 namespace vigilante {
 
+namespace {
+
+// A heavy hit, i.e., a killing blow or one which deals at least this
+// portion of the target's full health, freezes the game for a moment.
+constexpr float kHeavyHitDamageRatio = .25f;
+constexpr float kHeavyHitStopDuration = .08f;
+
+// The portion of a hit's horizontal knockback which still pushes back a blocker.
+constexpr float kBlockedKnockBackRatio = .3f;
+
+// Bumping into an enemy's body.
+const HitImpact kBodyContactHitImpact{HitImpact::kDefaultStagger, {2.5f, 3.0f}, false};
+
+b2Filter makeFilter(const short categoryBits, const short maskBits) {
+  b2Filter filter;
+  filter.categoryBits = categoryBits;
+  filter.maskBits = maskBits;
+  return filter;
+}
+
+// Equipment and Consumable profiles share the same set of bonus fields.
+template <typename ItemProfile>
+void addBonusModifiers(StatModifierStack& statModifiers,
+                       const ItemProfile& itemProfile,
+                       const string& source,
+                       const float duration,
+                       const StatModifierStack::Stacking stacking) {
+  using Stat = StatModifierStack::Stat;
+
+  const array<pair<Stat, int>, 8> bonuses{{
+    {Stat::PHYSICAL_DAMAGE, itemProfile.bonusPhysicalDamage},
+    {Stat::MAGICAL_DAMAGE, itemProfile.bonusMagicalDamage},
+    {Stat::STRENGTH, itemProfile.bonusStr},
+    {Stat::DEXTERITY, itemProfile.bonusDex},
+    {Stat::INTELLIGENCE, itemProfile.bonusInt},
+    {Stat::LUCK, itemProfile.bonusLuk},
+    {Stat::MOVE_SPEED, itemProfile.bonusMoveSpeed},
+    {Stat::JUMP_HEIGHT, itemProfile.bonusJumpHeight},
+  }};
+
+  for (const auto& [stat, value] : bonuses) {
+    if (value) {
+      statModifiers.add({source, stat, StatModifierStack::Op::ADD,
+                         static_cast<float>(value), duration, stacking});
+    }
+  }
+}
+
+}  // namespace
+
+Character::~Character() {
+  StatusEffectSystem::the().forget(this);
+}
+
 Character::Character(const string& jsonFileName)
     : DynamicActor{State::STATE_SIZE, FixtureType::FIXTURE_SIZE},
       _characterProfile{jsonFileName},
       _comboSystem{std::make_shared<ComboSystem>(*this)},
+      _meleeHitResolver{std::make_unique<MeleeHitResolver>(*this)},
       // There will be at least `1` attack animation.
       _kAttackAnimationIdxMax{1 + getExtraAttackAnimationsCount()},
       _bodyExtraAttackAnimations(_kAttackAnimationIdxMax - 1) {
+  _hitReaction.reset();
+
   for (const auto& skillJsonFileName : _characterProfile.defaultSkills) {
     addSkill(Skill::create(skillJsonFileName, this));
   }
@@ -64,11 +128,76 @@ bool Character::removeFromMap() {
   return true;
 }
 
+void Character::revive() {
+  if (_isShownOnMap) {
+    VGLOG(LOG_ERR, "Failed to revive [%s], it is still shown on the map.",
+          _characterProfile.jsonFileName.c_str());
+    return;
+  }
+
+  StatusEffectSystem::the().forget(this);
+  _statModifiers.clear();
+  for (const auto equipment : _equipmentSlots) {
+    if (equipment) {
+      addEquipmentModifiers(*equipment);
+    }
+  }
+
+  _characterProfile.health = _characterProfile.fullHealth;
+  _characterProfile.stamina = _characterProfile.fullStamina;
+  _characterProfile.magicka = _characterProfile.fullMagicka;
+  _healthRegenRemainder = 0;
+  _magickaRegenRemainder = 0;
+  _staminaRegenRemainder = 0;
+
+  _hitReaction.reset();
+
+  _currentState = State::IDLE;
+  _previousState = State::IDLE;
+  _overridingAttackState = std::nullopt;
+  _previousBodyVelocity = {0.0f, 0.0f};
+
+  _isStartRunning = false;
+  _isStopRunning = false;
+  _isOnGround = true;
+  _isJumpingDisallowed = false;
+  _isJumping = false;
+  _isDoubleJumping = false;
+  _isOnPlatform = false;
+  _isGettingUpFromFalling = false;
+  _isDodgingBackward = false;
+  _isDodgingForward = false;
+  _isAttacking = false;
+  _isUsingSkill = false;
+  _isBlocking = false;
+  _isHitWhileBlocking = false;
+  _isCrouching = false;
+  _isInvincible = false;
+  _isRunningIntroAnimation = false;
+  _isStunned = false;
+  _isTakingDamage = false;
+  _isTakingDamageFromTraps = false;
+  _isKilled = false;
+  _isSetToKill = false;
+  _currentlyUsedSkill = nullptr;
+
+  _inRangeTargets.clear();
+  _lockedOnTarget = nullptr;
+  _isAlerted = false;
+  _inRangeItems.clear();
+  _inRangeInteractables.clear();
+  _portal = nullptr;
+
+  _skillCooldowns.resetAll();
+}
+
 void Character::update(const float delta) {
   if (!_isShownOnMap || _isKilled) {
     return;
   }
 
+  _moveImpulseScale = delta * kFps;
+
   constexpr float kSlopeStopMinVelocity = 0.05f;
   if (_isOnGround &&
       std::abs(_body->GetLinearVelocity().x) < kSlopeStopMinVelocity &&
@@ -90,28 +219,40 @@ void Character::update(const float delta) {
   _bodySprite->setPosition(b2bodyPos.x * kPpm + _characterProfile.spriteOffsetX,
                            b2bodyPos.y * kPpm + _characterProfile.spriteOffsetY);
 
-  // Handle stats regeneration.
-  _statsRegenTimer += delta;
-  if (_statsRegenTimer >= 5.0f) {
-    _statsRegenTimer = 0;
-    regenHealth(_baseRegenDeltaHealth);
-    regenMagicka(_baseRegenDeltaMagicka);
-    regenStamina(_baseRegenDeltaStamina);
+  // Keep the body animation in step with this character's time.
+  if (auto speed = dynamic_cast<Speed*>(_bodySprite->getActionByTag(kBodyAnimationActionTag))) {
+    speed->setSpeed(TimeScale::the().getScale(this));
+  }
 
+  // Handle stats regeneration.
+  if (regenStats(delta)) {
     auto hud = SceneManager::the().getCurrentScene<GameScene>()->getHud();
     hud->updateStatusBars();
   }
 
+  // A launched character which never lands recovers once the launch times out.
+  const bool wasLaunched = _hitReaction.isLaunched();
+  _hitReaction.update(delta);
+  if (wasLaunched && !_hitReaction.isLaunched()) {
+    _isTakingDamage = false;
+  }
+
   for (const auto interactable : _inRangeInteractables) {
     if (const auto trigger = dynamic_cast<GameMap::Trigger*>(interactable)) {
       if (const auto damage = trigger->getDamage()) {
         receiveDamage(damage);
       }
+      if (!trigger->getStatusEffect().empty()) {
+        StatusEffectSystem::the().apply(this, trigger->getStatusEffect(), trigger);
+      }
     }
   }
 
   _comboSystem->update(delta);
 
+  _animationTime += delta;
+  _meleeHitResolver->update(getAnimationFrameIdx());
+
   if (_isUsingSkill) {
     return;
   }
@@ -163,7 +304,9 @@ void Character::update(const float delta) {
 }
 
 void Character::import(const string& jsonFileName) {
+  _meleeHitResolver->endSwing();
   _characterProfile = Character::Profile{jsonFileName};
+  _statModifiers.markDirty();
 }
 
 void Character::replaceSpritesheet(const string& jsonFileName) {
@@ -174,6 +317,8 @@ void Character::replaceSpritesheet(const string& jsonFileName) {
   _bodySpritesheet->removeFromParent();
   std::fill(_bodyAnimations.begin(), _bodyAnimations.end(), nullptr);
   std::fill(_bodyExtraAttackAnimations.begin(), _bodyExtraAttackAnimations.end(), nullptr);
+  _runningAnimation = nullptr;
+  _meleeHitResolver->endSwing();
 
   _characterProfile.loadSpritesheetInfo(jsonFileName);
   loadBodyAnimations(_characterProfile.textureResDir);
@@ -181,18 +326,14 @@ void Character::replaceSpritesheet(const string& jsonFileName) {
   _node->addChild(_bodySpritesheet, spritesheetZOrder);
 }
 
-void Character::defineBody(b2BodyType bodyType,
-                           float x,
+void Character::defineBody(float x,
                            float y,
                            short bodyCategoryBits,
                            short bodyMaskBits,
                            short feetMaskBits,
                            short weaponMaskBits) {
   auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
-  B2BodyBuilder bodyBuilder{gmMgr->getWorld()};
-  _body = bodyBuilder.type(bodyType)
-    .position(x, y, kPpm)
-    .buildBody();
+  _body = getBodyTemplate(_characterProfile).instantiate(gmMgr->getWorld(), x, y, kPpm);
 
   redefineBodyFixture(bodyCategoryBits, bodyMaskBits);
   redefineFeetFixture(feetMaskBits);
@@ -208,56 +349,21 @@ void Character::redefineBodyFixture(short bodyCategoryBits, short bodyMaskBits)
     _fixtures[FixtureType::BODY] = nullptr;
   }
 
-  const float scaleFactor = Director::getInstance()->getContentScaleFactor();
-  const float bw = _characterProfile.bodyWidth;
-  const float bh = _characterProfile.bodyHeight;
-
-  const float x0 = -bw / 2 / scaleFactor;
-  const float x1 = bw / 2 / scaleFactor;
-  const float x2 = -bw / 2 / scaleFactor;
-  const float x3 = bw / 2 / scaleFactor;
-
-  const float y0 = _isCrouching ? 0 : (bh / 2 / scaleFactor);
-  const float y1 = _isCrouching ? 0 : (bh / 2 / scaleFactor);
-  const float y2 = -bh / 2 / scaleFactor;
-  const float y3 = -bh / 2 / scaleFactor;
-
-  const b2Vec2 bodyVertices[] = {
-    {x0, y0},
-    {x1, y1},
-    {x2, y2},
-    {x3, y3}
-  };
-
-  B2BodyBuilder bodyBuilder{_body};
-  _fixtures[FixtureType::BODY] = bodyBuilder.newPolygonFixture(bodyVertices, 4, kPpm)
-    .categoryBits(bodyCategoryBits)
-    .maskBits(bodyMaskBits)
-    .setSensor(true)
-    .setUserData(this)
-    .buildFixture();
+  const size_t fixtureIdx = _isCrouching ? kCrouchingBodyFixture : kStandingBodyFixture;
+  _fixtures[FixtureType::BODY] = getBodyTemplate(_characterProfile).instantiateFixture(
+      _body, fixtureIdx, this, makeFilter(bodyCategoryBits, bodyMaskBits));
 }
 
 void Character::redefineFeetFixture(short feetMaskBits) {
   if (_fixtures[FixtureType::FEET]) {
     feetMaskBits = _fixtures[FixtureType::FEET]->GetFilterData().maskBits;
 
-    _body->DestroyFixture(_fixtures[FixtureType::BODY]);
-    _fixtures[FixtureType::BODY] = nullptr;
+    _body->DestroyFixture(_fixtures[FixtureType::FEET]);
+    _fixtures[FixtureType::FEET] = nullptr;
   }
 
-  const float bw = _characterProfile.bodyWidth;
-  const float bh = _characterProfile.bodyHeight;
-  const float feetFixtureRadius = bw / 2;
-  const b2Vec2 feetFixtureCenter{0, -bh / 2 + bw / 2};
-
-  B2BodyBuilder bodyBuilder{_body};
-  _fixtures[FixtureType::FEET] = bodyBuilder.newCircleFixture(feetFixtureCenter, feetFixtureRadius, kPpm)
-    .categoryBits(category_bits::kFeet)
-    .maskBits(feetMaskBits)
-    .density(kDensity)
-    .setUserData(this)
-    .buildFixture();
+  _fixtures[FixtureType::FEET] = getBodyTemplate(_characterProfile).instantiateFixture(
+      _body, kFeetFixture, this, makeFilter(category_bits::kFeet, feetMaskBits));
 }
 
 void Character::redefineWeaponFixture(short weaponMaskBits) {
@@ -268,35 +374,83 @@ void Character::redefineWeaponFixture(short weaponMaskBits) {
     _fixtures[FixtureType::WEAPON] = nullptr;
   }
 
+  const size_t fixtureIdx = kWeaponFixtures[_isCrouching][_isFacingRight];
+  _fixtures[FixtureType::WEAPON] = getBodyTemplate(_characterProfile).instantiateFixture(
+      _body, fixtureIdx, this, makeFilter(category_bits::kMeleeWeapon, weaponMaskBits));
+}
+
+const B2BodyTemplate& Character::getBodyTemplate(const Character::Profile& profile) {
+  static map<tuple<int, int, float>, unique_ptr<B2BodyTemplate>> bodyTemplates;
+
+  const auto key = make_tuple(profile.bodyWidth, profile.bodyHeight, profile.attackRange);
+  auto it = bodyTemplates.find(key);
+  if (it != bodyTemplates.end()) {
+    return *it->second;
+  }
+
+  auto bodyTemplate = std::make_unique<B2BodyTemplate>(b2BodyType::b2_dynamicBody);
+
   const float scaleFactor = Director::getInstance()->getContentScaleFactor();
-  const float bw = _characterProfile.bodyWidth;
-  const float bh = _characterProfile.bodyHeight;
-  const float attackRange = _characterProfile.attackRange;
-
-  const float x0 = _isFacingRight ? (bw / 2 / scaleFactor) : (-bw / 2 / scaleFactor);
-  const float x1 = _isFacingRight ? (bw / 2 + attackRange) : (-bw / 2 - attackRange);
-  const float x2 = _isFacingRight ? (bw / 2 / scaleFactor) : (-bw / 2 / scaleFactor);
-  const float x3 = _isFacingRight ? (bw / 2 + attackRange) : (-bw / 2 - attackRange);
-
-  const float y0 = _isCrouching ? (bh / 4 / scaleFactor) : (bh / 2 / scaleFactor);
-  const float y1 = _isCrouching ? (bh / 4 / scaleFactor) : (bh / 2 / scaleFactor);
-  const float y2 = _isCrouching ? (-bh / 2 / scaleFactor) : (-bh / 2 / scaleFactor);
-  const float y3 = _isCrouching ? (-bh / 2 / scaleFactor) : (-bh / 2 / scaleFactor);
-
-  const b2Vec2 weaponVertices[] = {
-    {x0, y0},
-    {x1, y1},
-    {x2, y2},
-    {x3, y3}
-  };
+  const float bw = profile.bodyWidth;
+  const float bh = profile.bodyHeight;
+  const float attackRange = profile.attackRange;
+
+  // The body fixture, standing and crouching.
+  for (const bool isCrouching : {false, true}) {
+    const float top = isCrouching ? 0 : (bh / 2 / scaleFactor);
+    const b2Vec2 bodyVertices[] = {
+      {-bw / 2 / scaleFactor, top},
+      {bw / 2 / scaleFactor, top},
+      {-bw / 2 / scaleFactor, -bh / 2 / scaleFactor},
+      {bw / 2 / scaleFactor, -bh / 2 / scaleFactor}
+    };
+    bodyTemplate->newPolygonFixture(bodyVertices, 4, kPpm)
+      .setSensor(true)
+      .addFixture();
+  }
+
+  // The feet fixture.
+  const float feetFixtureRadius = bw / 2;
+  const b2Vec2 feetFixtureCenter{0, -bh / 2 + bw / 2};
+  bodyTemplate->newCircleFixture(feetFixtureCenter, feetFixtureRadius, kPpm)
+    .categoryBits(category_bits::kFeet)
+    .density(kDensity)
+    .addFixture();
+
+  // The weapon fixture, standing and crouching, facing left and right.
+  for (const bool isCrouching : {false, true}) {
+    for (const bool isFacingRight : {false, true}) {
+      const float x0 = isFacingRight ? (bw / 2 / scaleFactor) : (-bw / 2 / scaleFactor);
+      const float x1 = isFacingRight ? (bw / 2 + attackRange) : (-bw / 2 - attackRange);
+      const float top = isCrouching ? (bh / 4 / scaleFactor) : (bh / 2 / scaleFactor);
+      const b2Vec2 weaponVertices[] = {
+        {x0, top},
+        {x1, top},
+        {x0, -bh / 2 / scaleFactor},
+        {x1, -bh / 2 / scaleFactor}
+      };
+      bodyTemplate->newPolygonFixture(weaponVertices, 4, kPpm)
+        .categoryBits(category_bits::kMeleeWeapon)
+        .setSensor(true)
+        .addFixture();
+    }
+  }
 
-  B2BodyBuilder bodyBuilder{_body};
-  _fixtures[FixtureType::WEAPON] = bodyBuilder.newPolygonFixture(weaponVertices, 4, kPpm)
-    .categoryBits(category_bits::kMeleeWeapon)
-    .maskBits(weaponMaskBits)
+  // The interactable area of an Npc, which can collide with the player's feet.
+  const float sideLength = std::max(bw, bh) * 1.2f;
+  const b2Vec2 interactableAreaVertices[] = {
+    {-sideLength / scaleFactor,  sideLength / scaleFactor},
+    { sideLength / scaleFactor,  sideLength / scaleFactor},
+    {-sideLength / scaleFactor, -sideLength / scaleFactor},
+    { sideLength / scaleFactor, -sideLength / scaleFactor}
+  };
+  bodyTemplate->newPolygonFixture(interactableAreaVertices, 4, kPpm)
+    .categoryBits(category_bits::kInteractable)
+    .maskBits(category_bits::kFeet)
     .setSensor(true)
-    .setUserData(this)
-    .buildFixture();
+    .addFixture();
+
+  return *bodyTemplates.emplace(key, std::move(bodyTemplate)).first->second;
 }
 
 void Character::defineTexture(const string& bodyTextureResDir, float x, float y) {
@@ -307,6 +461,7 @@ void Character::defineTexture(const string& bodyTextureResDir, float x, float y)
 }
 
 void Character::loadBodyAnimations(const string& bodyTextureResDir) {
+  ScopedMemoryTag memoryTag{MemoryTag::ANIMATIONS};
   createBodyAnimation(State::IDLE, nullptr);
   Animation* fallback = _bodyAnimations[State::IDLE];
 
@@ -400,23 +555,33 @@ Animation* Character::getBodyAttackAnimation() const {
                                       _bodyExtraAttackAnimations[_attackAnimationIdx - 1];
 }
 
-void Character::runAnimation(State state, bool loop) {
-  Animate* animate = Animate::create((state != State::ATTACKING) ? _bodyAnimations[state] :
-                                                                   getBodyAttackAnimation());
+void Character::runBodyAnimation(ActionInterval* action) {
+  Speed* speed = Speed::create(action, TimeScale::the().getScale(this));
+  speed->setTag(kBodyAnimationActionTag);
   _bodySprite->stopAllActions();
-  _bodySprite->runAction(loop ? dynamic_cast<Action*>(RepeatForever::create(animate)) :
-                                dynamic_cast<Action*>(Repeat::create(animate, 1)));
+  _bodySprite->runAction(speed);
+}
+
+void Character::runAnimation(State state, bool loop) {
+  Animation* animation = (state != State::ATTACKING) ? _bodyAnimations[state] : getBodyAttackAnimation();
+  Animate* animate = Animate::create(animation);
+  runBodyAnimation(loop ? dynamic_cast<ActionInterval*>(RepeatForever::create(animate)) :
+                          dynamic_cast<ActionInterval*>(Repeat::create(animate, 1)));
 
   if (state == State::ATTACKING) {
+    onAnimationStarted(getAttackFramesName(state), animation, loop);
     _attackAnimationIdx = (_attackAnimationIdx + 1) % _kAttackAnimationIdxMax;
+  } else {
+    onAnimationStarted(_kCharacterStateStr[state], animation, loop);
   }
 }
 
-void Character::runAnimation(State state, const function<void ()>& func) const {
+void Character::runAnimation(State state, const function<void ()>& func) {
   auto animate = Animate::create(_bodyAnimations[state]);
   auto callback = CallFunc::create(func);
-  _bodySprite->stopAllActions();
-  _bodySprite->runAction(Sequence::createWithTwoActions(animate, callback));
+  runBodyAnimation(Sequence::createWithTwoActions(animate, callback));
+
+  onAnimationStarted(_kCharacterStateStr[state], _bodyAnimations[state], /*loop=*/false);
 }
 
 void Character::runAnimation(const string& framesName, float interval) {
@@ -431,8 +596,9 @@ void Character::runAnimation(const string& framesName, float interval) {
     _skillBodyAnimations.insert({framesName, bodyAnimation});
   }
 
-  _bodySprite->stopAllActions();
-  _bodySprite->runAction(Repeat::create(Animate::create(bodyAnimation), 1));
+  runBodyAnimation(Repeat::create(Animate::create(bodyAnimation), 1));
+
+  onAnimationStarted(framesName, bodyAnimation, /*loop=*/false);
 }
 
 float Character::getAttackAnimationDuration(const Character::State state) const {
@@ -442,6 +608,79 @@ float Character::getAttackAnimationDuration(const Character::State state) const
   return _bodyAnimations[state]->getDuration();
 }
 
+string Character::getAttackFramesName(const Character::State attackState) const {
+  if (attackState == State::ATTACKING) {
+    return "attacking" + std::to_string(_attackAnimationIdx);
+  }
+  return _kCharacterStateStr[attackState];
+}
+
+void Character::onAnimationStarted(const string& framesName, Animation* animation, const bool loop) {
+  _runningAnimationName = framesName;
+  _runningAnimation = animation;
+  _isRunningAnimationLooped = loop;
+  _animationTime = 0;
+  _meleeHitResolver->beginSwing(getHitboxes(framesName));
+}
+
+int Character::getAnimationFrameIdx() const {
+  if (!_runningAnimation || _runningAnimation->getFrames().empty()) {
+    return 0;
+  }
+
+  const int numFrames = static_cast<int>(_runningAnimation->getFrames().size());
+  const int frameIdx = static_cast<int>(_animationTime / _runningAnimation->getDelayPerUnit());
+  return _isRunningAnimationLooped ? frameIdx % numFrames : std::min(frameIdx, numFrames - 1);
+}
+
+const vector<Hitbox>* Character::getHurtboxes() const {
+  return _characterProfile.hitboxProfile.getHurtboxes(_runningAnimationName);
+}
+
+const vector<Hitbox>* Character::getHitboxes(const string& framesName) const {
+  if (const Equipment* weapon = _equipmentSlots[Equipment::Type::WEAPON]) {
+    if (const auto hitboxes = weapon->getEquipmentProfile().hitboxProfile.getHitboxes(framesName)) {
+      return hitboxes;
+    }
+  }
+  return _characterProfile.hitboxProfile.getHitboxes(framesName);
+}
+
+HitImpact Character::getHitImpact() const {
+  if (_isUsingSkill && _currentlyUsedSkill && _currentlyUsedSkill->getSkillProfile().hitImpact) {
+    return *_currentlyUsedSkill->getSkillProfile().hitImpact;
+  }
+  if (const Equipment* weapon = _equipmentSlots[Equipment::Type::WEAPON]) {
+    if (const auto hitImpact = weapon->getEquipmentProfile().hitImpactProfile.getHitImpact(_runningAnimationName)) {
+      return *hitImpact;
+    }
+  }
+  if (const auto hitImpact = _characterProfile.hitImpactProfile.getHitImpact(_runningAnimationName)) {
+    return *hitImpact;
+  }
+
+  // Without any hit impacts defined, a hit knocks back by the attack force,
+  // and an upward attack launches the target.
+  HitImpact hitImpact;
+  if (_currentState == State::ATTACKING_UPWARD) {
+    hitImpact.knockBack = {.3f, 3.0f};
+    hitImpact.launches = true;
+  } else {
+    hitImpact.knockBack = {_characterProfile.attackForce, _characterProfile.attackForce};
+  }
+  return hitImpact;
+}
+
+bool Character::hasHyperArmor() const {
+  const int frameIdx = getAnimationFrameIdx();
+  if (const Equipment* weapon = _equipmentSlots[Equipment::Type::WEAPON]) {
+    if (weapon->getEquipmentProfile().hitboxProfile.hasHyperArmor(_runningAnimationName, frameIdx)) {
+      return true;
+    }
+  }
+  return _characterProfile.hitboxProfile.hasHyperArmor(_runningAnimationName, frameIdx);
+}
+
 Character::State Character::determineState() const {
   if (_isSetToKill) {
     return State::KILLED;
@@ -504,7 +743,7 @@ void Character::maybeOverrideCurrentStateWithAttackingMidairState() {
 void Character::maybeOverrideCurrentStateWithStopRunningState() {
   bool needToStopRunning = true;
   const b2Vec2 currentBodyVelocity = _body->GetLinearVelocity();
-  if (std::abs(currentBodyVelocity.x) >= _characterProfile.moveSpeed * 4) {
+  if (std::abs(currentBodyVelocity.x) >= _statModifiers.get(StatModifierStack::Stat::MOVE_SPEED) * 4) {
     needToStopRunning = true;
   }
 
@@ -541,6 +780,8 @@ void Character::onFallToGroundOrPlatform() {
     _isTakingDamage = false;
     getUpFromFalling();
   }
+
+  _hitReaction.onLanded();
 }
 
 void Character::onBodyContactWithEnemyBody(Character* enemy) {
@@ -553,9 +794,7 @@ void Character::onBodyContactWithEnemyBody(Character* enemy) {
     return;
   }
 
-  const float knockBackForceX = _isFacingRight ? -2.5f : 2.5f;
-  const float knockBackForceY = 3.0f;
-  enemy->knockBack(this, knockBackForceX, knockBackForceY);
+  receiveHitImpact(enemy, kBodyContactHitImpact, _isFacingRight ? -1.0f : 1.0f);
   enemy->inflictDamage(this, 25);
 }
 
@@ -567,6 +806,10 @@ void Character::onMeleeWeaponContactWithEnemyBody(Character *enemy) {
                   getDamageOutput() + _currentlyUsedSkill->getSkillProfile().physicalDamage,
                   _currentlyUsedSkill->getSkillProfile().numTimesInflictDamage,
                   _currentlyUsedSkill->getSkillProfile().damageInflictionInterval);
+
+    if (!_currentlyUsedSkill->getSkillProfile().statusEffect.empty()) {
+      StatusEffectSystem::the().apply(enemy, _currentlyUsedSkill->getSkillProfile().statusEffect);
+    }
   }
 }
 
@@ -590,7 +833,7 @@ bool Character::isSkillActivationDisallowed() const {
 void Character::startRunning() {
   /*
   _isStartRunning = true;
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  runAfter([this](const CallbackManager::CallbackId) {
     _isStartRunning = false;
   }, _bodyAnimations[State::RUNNING_START]->getDuration());
   */
@@ -598,7 +841,7 @@ void Character::startRunning() {
 
 void Character::stopRunning() {
   _isStopRunning = true;
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  runAfter([this](const CallbackManager::CallbackId) {
     _isStopRunning = false;
   }, _bodyAnimations[State::RUNNING_STOP]->getDuration());
 }
@@ -625,8 +868,9 @@ void Character::moveImpl(const bool moveTowardsRight) {
     startRunning();
   }
 
-  if (std::hypotf(velocity.x, velocity.y) <= _characterProfile.moveSpeed) {
-    float force = _characterProfile.bodyWidth * _characterProfile.bodyHeight * kBodyVolumeToMoveForceFactor;
+  if (std::hypotf(velocity.x, velocity.y) <= _statModifiers.get(StatModifierStack::Stat::MOVE_SPEED)) {
+    float force = _characterProfile.bodyWidth * _characterProfile.bodyHeight * kBodyVolumeToMoveForceFactor *
+                  _moveImpulseScale;
     if (!moveTowardsRight) {
       force = -force;
     }
@@ -643,11 +887,12 @@ void Character::moveImpl(const bool moveTowardsRight) {
 void Character::jump() {
   // Block current jump request if:
   // 1. This character's is not allowed to move (and jump).
-  // 2. This character's cannot jump (_characterProfile.jumpHeight == 0)
+  // 2. This character's cannot jump (its effective jump height is 0)
   // 3. This character cannot double jump, and it has already jumped.
   // 4. This character can double jump, and it has already double jumped.
+  const float jumpHeight = _statModifiers.get(StatModifierStack::Stat::JUMP_HEIGHT);
   if (isMovementDisallowed() ||
-      _characterProfile.jumpHeight == 0.0f ||
+      jumpHeight == 0.0f ||
       (!_characterProfile.canDoubleJump && _isJumping) ||
       (_characterProfile.canDoubleJump && _isDoubleJumping)) {
     return;
@@ -661,18 +906,18 @@ void Character::jump() {
   }
 
   _isJumpingDisallowed = true;
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  runAfter([this](const CallbackManager::CallbackId) {
     _isJumpingDisallowed = false;
   }, .2f);
 
   _isJumping = true;
-  _body->ApplyLinearImpulse({0, _characterProfile.jumpHeight}, _body->GetWorldCenter(), true);
+  _body->ApplyLinearImpulse({0, jumpHeight}, _body->GetWorldCenter(), true);
 }
 
 void Character::doubleJump() {
   jump();
 
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  runAfter([this](const CallbackManager::CallbackId) {
     jump();
   }, .25f);
 }
@@ -683,7 +928,7 @@ void Character::jumpDown() {
   }
 
   _fixtures[FixtureType::FEET]->SetSensor(true);
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  runAfter([this](const CallbackManager::CallbackId) {
     _fixtures[FixtureType::FEET]->SetSensor(false);
   }, .25f);
 }
@@ -721,7 +966,7 @@ void Character::getUpFromFalling() {
   }
 
   _isGettingUpFromFalling = true;
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  runAfter([this](const CallbackManager::CallbackId) {
     _isGettingUpFromFalling = false;
   }, _bodyAnimations[State::FALLING_GETUP]->getDuration());
 }
@@ -736,6 +981,13 @@ void Character::dodgeForward() {
   dodge(State::DODGING_FORWARD, rushPowerX, _isDodgingForward);
 }
 
+CallbackManager::CallbackId Character::runAfter(function<void (const CallbackManager::CallbackId)>&& callback,
+                                                const float delay) const {
+  // The delay is converted with the current scale of this character,
+  // so a slowed character also takes longer to finish its actions.
+  return CallbackManager::the().runAfter(std::move(callback), delay / TimeScale::the().getActorScale(this));
+}
+
 void Character::dodge(const Character::State dodgeState, const float rushPowerX, bool &isDodgingFlag) {
   if (isDodging() || isDoubleJumping() || isMovementDisallowed()) {
     return;
@@ -750,12 +1002,12 @@ void Character::dodge(const Character::State dodgeState, const float rushPowerX,
   enableAfterImageFx(AfterImageFxManager::kPlayerAfterImageColor);
 
   _isInvincible = true;
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  runAfter([this](const CallbackManager::CallbackId) {
     _isInvincible = false;
   }, 0.2f);
 
   isDodgingFlag = true;
-  CallbackManager::the().runAfter([this, originalBodyDamping, &isDodgingFlag](const CallbackManager::CallbackId) {
+  runAfter([this, originalBodyDamping, &isDodgingFlag](const CallbackManager::CallbackId) {
     isDodgingFlag = false;
     _body->SetLinearDamping(originalBodyDamping);
     disableAfterImageFx();
@@ -788,7 +1040,7 @@ void Character::disableAfterImageFx() {
 
 void Character::runIntroAnimation() {
   _isRunningIntroAnimation = true;
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  runAfter([this](const CallbackManager::CallbackId) {
     _isRunningIntroAnimation = false;
   }, _bodyAnimations[State::INTRO]->getDuration());
 
@@ -820,7 +1072,7 @@ bool Character::attack(const Character::State attackState,
 
   {
     lock_guard<mutex> lock{_cancelAttackCallbacksMutex};
-    const CallbackManager::CallbackId cancelAttackCallbackId = CallbackManager::the().runAfter([this](const CallbackManager::CallbackId id) {
+    const CallbackManager::CallbackId cancelAttackCallbackId = runAfter([this](const CallbackManager::CallbackId id) {
       _isAttacking = false;
       _overridingAttackState = std::nullopt;
       _cancelAttackCallbacks.erase(id);
@@ -839,6 +1091,15 @@ bool Character::attack(const Character::State attackState,
     }
   }
 
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  gmMgr->getPerceptionSystem()->publishNoise(this, PerceptionSystem::kAttackNoiseRadius);
+
+  // If this attack's animation has authored hitboxes, the hits are resolved
+  // by MeleeHitResolver on the exact frames of the animation instead.
+  if (getHitboxes(getAttackFramesName(attackState))) {
+    return true;
+  }
+
   if (_inRangeTargets.empty()) {
     return false;
   }
@@ -858,6 +1119,7 @@ bool Character::attack(const Character::State attackState,
 void Character::cancelAttack() {
   _isAttacking = false;
   _overridingAttackState = std::nullopt;
+  _meleeHitResolver->endSwing();
 
   {
     lock_guard<mutex> lock{_cancelAttackCallbacksMutex};
@@ -900,14 +1162,16 @@ bool Character::activateSkill(Skill* rawSkill) {
     return true;
   }
 
-  if (!skill->canActivate()) {
+  // Forked instances share the cooldown of the skill in the skill book.
+  if (!_skillCooldowns.isReady(rawSkill) || !skill->canActivate()) {
     return false;
   }
+  _skillCooldowns.trigger(rawSkill);
 
   _isUsingSkill = true;
   _currentlyUsedSkill = rawSkill;
 
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  runAfter([this](const CallbackManager::CallbackId) {
     _isUsingSkill = false;
     _currentState = State::FORCE_UPDATE;
   }, skill->getSkillProfile().framesDuration);
@@ -937,8 +1201,7 @@ void Character::knockBack(Character* target, float forceX, float forceY) const {
     return;
   }
 
-  b2Body* b2body = target->getBody();
-  b2body->ApplyLinearImpulse({forceX, forceY}, b2body->GetWorldCenter(), true);
+  ImpulseQueue::the().push(target, {forceX, forceY});
 }
 
 bool Character::inflictDamage(Character* target, int damage) {
@@ -973,21 +1236,12 @@ bool Character::inflictDamage(Character *target, int damage,
   }
 
   for (int i = 0; i < numTimesInflictDamage; i++) {
-    const CallbackManager::CallbackId id = CallbackManager::the().runAfter([this, target, damage](const CallbackManager::CallbackId id) {
+    const CallbackManager::CallbackId id = runAfter([this, target, damage](const CallbackManager::CallbackId id) {
       if (_isTakingDamage || !_inRangeTargets.contains(target)) {
         return;
       }
 
-      inflictDamage(target, damage);
-
-      const float attackForce = _characterProfile.attackForce;
-      const float knockBackForceX = _isFacingRight ? attackForce : -attackForce;
-      const float knockBackForceY = attackForce;
-      knockBack(target, knockBackForceX, knockBackForceY);
-
-      if (const auto weapon = _equipmentSlots[Equipment::Type::WEAPON]) {
-        Audio::the().playSfx(weapon->getSfxFileName(Equipment::Sfx::SFX_HIT));
-      }
+      landMeleeHit(target, damage);
 
       lock_guard<mutex> lock{_inflictDamageCallbacksMutex};
       _inflictDamageCallbacks.erase(id);
@@ -1000,7 +1254,60 @@ bool Character::inflictDamage(Character *target, int damage,
   return true;
 }
 
-bool Character::receiveDamage(Character *source, int damage, float takeDamageDuration) {
+void Character::landMeleeHit(Character* target, int damage) {
+  target->receiveHitImpact(this, getHitImpact(), _isFacingRight ? 1.0f : -1.0f);
+  inflictDamage(target, damage);
+
+  if (target->isSetToKill() ||
+      damage >= target->getCharacterProfile().fullHealth * kHeavyHitDamageRatio) {
+    TimeScale::the().pushHitStop(kHeavyHitStopDuration);
+  }
+
+  if (const auto weapon = _equipmentSlots[Equipment::Type::WEAPON]) {
+    Audio::the().playSfx(weapon->getSfxFileName(Equipment::Sfx::SFX_HIT));
+    if (!weapon->getEquipmentProfile().statusEffect.empty()) {
+      StatusEffectSystem::the().apply(target, weapon->getEquipmentProfile().statusEffect);
+    }
+  }
+}
+
+HitReaction::Result Character::receiveHitImpact(Character* source, const HitImpact& hitImpact, const float direction) {
+  if (_isSetToKill || _isInvincible || (source && (source->isSetToKill() || source->isKilled()))) {
+    return HitReaction::Result::ABSORBED;
+  }
+
+  // A blocked hit doesn't touch the poise, but still pushes the blocker back a little.
+  if (_isBlocking) {
+    ImpulseQueue::the().push(this, {direction * hitImpact.knockBack.x * kBlockedKnockBackRatio, 0.0f});
+    return HitReaction::Result::ABSORBED;
+  }
+
+  const HitReaction::Result result = _hitReaction.resolve(hitImpact, hasHyperArmor());
+  if (result == HitReaction::Result::ABSORBED) {
+    return result;
+  }
+
+  b2Vec2 knockBack{direction * hitImpact.knockBack.x, hitImpact.knockBack.y};
+  if (result == HitReaction::Result::JUGGLED) {
+    knockBack *= _hitReaction.getJuggleKnockBackScale();
+  }
+  ImpulseQueue::the().push(this, knockBack);
+
+  // Only a hit which breaks the poise flinches the character and interrupts its attack.
+  _isTakingDamage = true;
+  runAfter([this](const CallbackManager::CallbackId) {
+    // A launched character keeps reeling until it lands.
+    if (!_hitReaction.isLaunched()) {
+      _isTakingDamage = false;
+    }
+    _isTakingDamageFromTraps = false;
+  }, getStaggerDuration());
+  cancelAttack();
+
+  return result;
+}
+
+bool Character::receiveDamage(Character* source, int damage) {
   if (_isSetToKill || _isInvincible) {
     return false;
   }
@@ -1011,7 +1318,7 @@ bool Character::receiveDamage(Character *source, int damage, float takeDamageDur
 
   if (_isBlocking) {
     _isHitWhileBlocking = true;
-    CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+    runAfter([this](const CallbackManager::CallbackId) {
       _isHitWhileBlocking = false;
     }, _bodyAnimations[State::BLOCKING_HIT]->getDuration());
     return true;
@@ -1019,17 +1326,12 @@ bool Character::receiveDamage(Character *source, int damage, float takeDamageDur
 
   _characterProfile.health -= damage;
 
+  // The hits from other characters flinch only if they stagger (see receiveHitImpact()).
   _isTakingDamageFromTraps = !source;
-  if (source) {
-    _isTakingDamage = true;
-    CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
-      _isTakingDamage = false;
-      _isTakingDamageFromTraps = false;
-    }, takeDamageDuration);
+  if (!source) {
+    cancelAttack();
   }
 
-  cancelAttack();
-
   if (_characterProfile.health <= 0) {
     _characterProfile.health = 0;
 
@@ -1051,12 +1353,30 @@ bool Character::receiveDamage(Character *source, int damage, float takeDamageDur
     // TODO: play hurt sound.
   }
 
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  if (const Player* player = gmMgr->getPlayer()) {
+    // The kills by the player's allies are credited to the player, as with quests.
+    Statistics& statistics = Statistics::the();
+    if (this == player) {
+      statistics.record(Statistics::Event::DAMAGE_TAKEN, damage);
+    } else if (source == player) {
+      statistics.record(Statistics::Event::DAMAGE_DEALT, damage);
+    }
+    if (_isSetToKill && source && source->getParty() == player->getParty()) {
+      statistics.record(Statistics::Event::KILL, 1, _characterProfile.killCounterId);
+    }
+  }
+
   auto fxMgr = SceneManager::the().getCurrentScene<GameScene>()->getFxManager();
   fxMgr->createHitFx(this);
 
   auto floatingDamages = SceneManager::the().getCurrentScene<GameScene>()->getFloatingDamages();
   floatingDamages->show(this, damage);
 
+  if (source) {
+    gmMgr->getPerceptionSystem()->publishDamage(this, source);
+  }
+
   if (const auto& sfxFileName = getSfxFileName(Character::Sfx::SFX_HURT); sfxFileName.size()) {
     Audio::the().playSfx(sfxFileName);
   }
@@ -1064,9 +1384,8 @@ bool Character::receiveDamage(Character *source, int damage, float takeDamageDur
   return true;
 }
 
-bool Character::receiveDamage(Character* source, int damage) {
-  constexpr float kNumSecCantMove = 0.2f;
-  return receiveDamage(source, damage, kNumSecCantMove);
+float Character::getStaggerDuration() const {
+  return .2f;
 }
 
 bool Character::receiveDamage(int damage) {
@@ -1163,15 +1482,23 @@ void Character::useItem(Consumable* consumable) {
   profile.stamina += consumableProfile.restoreStamina;
   if (profile.stamina > profile.fullStamina) profile.stamina = profile.fullStamina;
 
-  profile.baseMeleeDamage += consumableProfile.bonusPhysicalDamage;
-  //profile.baseMagicalDamage += consumableProfile.bonusMagicalDamage;
-  profile.strength += consumableProfile.bonusStr;
-  profile.dexterity += consumableProfile.bonusDex;
-  profile.intelligence += consumableProfile.bonusInt;
-  profile.luck += consumableProfile.bonusLuk;
+  if (consumableProfile.duration > 0) {
+    // Using the same consumable again while its effects are
+    // still active only resets their duration.
+    addBonusModifiers(_statModifiers, consumableProfile, consumable->getItemProfile().jsonFileName,
+                      consumableProfile.duration, StatModifierStack::Stacking::REFRESH);
+  } else {
+    profile.baseMeleeDamage += consumableProfile.bonusPhysicalDamage;
+    //profile.baseMagicalDamage += consumableProfile.bonusMagicalDamage;
+    profile.strength += consumableProfile.bonusStr;
+    profile.dexterity += consumableProfile.bonusDex;
+    profile.intelligence += consumableProfile.bonusInt;
+    profile.luck += consumableProfile.bonusLuk;
 
-  profile.moveSpeed += consumableProfile.bonusMoveSpeed;
-  profile.jumpHeight += consumableProfile.bonusJumpHeight;
+    profile.moveSpeed += consumableProfile.bonusMoveSpeed;
+    profile.jumpHeight += consumableProfile.bonusJumpHeight;
+    _statModifiers.markDirty();
+  }
 
   removeItem(consumable, 1);
 
@@ -1188,6 +1515,8 @@ void Character::equip(Equipment* equipment, bool audio) {
   _equipmentSlots[type] = equipment;
   removeItem(equipment, 1);
 
+  addEquipmentModifiers(*equipment);
+
   if (audio) {
     Audio::the().playSfx(kSfxEquipUnequipItem);
   }
@@ -1202,8 +1531,13 @@ void Character::unequip(Equipment::Type equipmentType, bool audio) {
 
   Equipment* e = _equipmentSlots[equipmentType];
   _equipmentSlots[equipmentType] = nullptr;
+  if (equipmentType == Equipment::Type::WEAPON) {
+    _meleeHitResolver->endSwing();
+  }
 
   const auto& jsonFileName = e->getItemProfile().jsonFileName;
+  _statModifiers.removeBySource(jsonFileName);
+
   auto it = _items.find(e->getItemProfile().jsonFileName);
   if (it == _items.end()) {
     VGLOG(LOG_ERR, "The unequipped item [%s] is not in player's itemMapper.", jsonFileName.c_str());
@@ -1262,6 +1596,7 @@ bool Character::addSkill(shared_ptr<Skill> skill) {
   }
 
   _skillBook[skill->getSkillProfile().skillType].insert(skill.get());
+  _skillCooldowns.addSkill(skill.get());
   _skills.emplace(skill->getName(), std::move(skill));
   return true;
 }
@@ -1280,6 +1615,7 @@ bool Character::removeSkill(Skill* skill) {
   }
 
   _skillBook[skill->getSkillProfile().skillType].erase(skill);
+  _skillCooldowns.removeSkill(it->second.get());
   _skills.erase(it);
   return true;
 }
@@ -1301,6 +1637,11 @@ int Character::getItemAmount(const string& itemJsonFileName) const {
   return it == _items.end() ? 0 : it->second->getAmount();
 }
 
+Item* Character::getItem(const string& itemJsonFileName) const {
+  auto it = _items.find(itemJsonFileName);
+  return it == _items.end() ? nullptr : it->second.get();
+}
+
 shared_ptr<Skill> Character::getActiveSkillInstance(Skill* skill) const {
   shared_ptr<Skill> key{shared_ptr<Skill>{}, skill};
   const auto it = _activeSkillInstances.find(key);
@@ -1332,11 +1673,8 @@ unordered_set<Character*> Character::getAllies() const {
 }
 
 int Character::getDamageOutput() const {
-  int output = _characterProfile.baseMeleeDamage;
-
-  if (Equipment* weapon = _equipmentSlots[Equipment::Type::WEAPON]) {
-    output += weapon->getEquipmentProfile().bonusPhysicalDamage;
-  }
+  // The weapon's bonus is already included as a modifier.
+  const int output = _statModifiers.getInt(StatModifierStack::Stat::PHYSICAL_DAMAGE);
   return output + rand_util::randInt(-5, 5); // temporary
 }
 
@@ -1364,6 +1702,42 @@ void Character::regenStamina(int deltaStamina) {
   stamina = (stamina > fullStamina) ? fullStamina : stamina;
 }
 
+void Character::addEquipmentModifiers(const Equipment& equipment) {
+  // Equipment bonuses last until it is unequipped.
+  addBonusModifiers(_statModifiers, equipment.getEquipmentProfile(),
+                    equipment.getItemProfile().jsonFileName,
+                    /*duration=*/0, StatModifierStack::Stacking::STACK);
+}
+
+bool Character::regenStats(const float delta) {
+  using Stat = StatModifierStack::Stat;
+
+  const auto takeWholePoints = [this, delta](float& remainder, const Stat stat) {
+    remainder += _statModifiers.get(stat) * delta;
+    const int points = static_cast<int>(remainder);
+    remainder -= points;
+    return points;
+  };
+
+  const int prevHealth = _characterProfile.health;
+  const int prevMagicka = _characterProfile.magicka;
+  const int prevStamina = _characterProfile.stamina;
+
+  if (const int points = takeWholePoints(_healthRegenRemainder, Stat::HEALTH_REGEN)) {
+    regenHealth(points);
+  }
+  if (const int points = takeWholePoints(_magickaRegenRemainder, Stat::MAGICKA_REGEN)) {
+    regenMagicka(points);
+  }
+  if (const int points = takeWholePoints(_staminaRegenRemainder, Stat::STAMINA_REGEN)) {
+    regenStamina(points);
+  }
+
+  return _characterProfile.health != prevHealth ||
+         _characterProfile.magicka != prevMagicka ||
+         _characterProfile.stamina != prevStamina;
+}
+
 Character::Profile::Profile(const string& jsonFileName) : jsonFileName(jsonFileName) {
   loadSpritesheetInfo(jsonFileName);
 
@@ -1388,6 +1762,15 @@ Character::Profile::Profile(const string& jsonFileName) : jsonFileName(jsonFileN
 
   baseMeleeDamage = json["baseMeleeDamage"].GetInt();
 
+  poise = json.HasMember("poise") ? json["poise"].GetFloat() : HitReaction::kDefaultPoise;
+  poiseRegen = json.HasMember("poiseRegen") ? json["poiseRegen"].GetFloat() : HitReaction::kDefaultPoiseRegen;
+
+  if (json.HasMember("statusEffectImmunities")) {
+    for (const auto& effectJson : json["statusEffectImmunities"].GetArray()) {
+      statusEffectImmunities.push_back(effectJson.GetString());
+    }
+  }
+
   for (const auto& skillJson : json["defaultSkills"].GetArray()) {
     string skillJsonFileName = skillJson.GetString();
     defaultSkills.push_back(std::move(skillJsonFileName));
@@ -1398,6 +1781,9 @@ Character::Profile::Profile(const string& jsonFileName) : jsonFileName(jsonFileN
     int amount = itemJson.value.GetInt();
     defaultInventory.push_back({std::move(itemJsonFileName), amount});
   }
+
+  killCounterId = Statistics::the().internSubject(Statistics::Event::KILL, jsonFileName);
+  recruitCounterId = Statistics::the().internSubject(Statistics::Event::MEMBER_RECRUITED, jsonFileName);
 }
 
 void Character::Profile::loadSpritesheetInfo(const string& jsonFileName) {
@@ -1440,6 +1826,9 @@ void Character::Profile::loadSpritesheetInfo(const string& jsonFileName) {
     extraAttackFrameIntervals.emplace_back(json["frameInterval"][key.c_str()].GetFloat());
   }
 
+  hitboxProfile.load(json);
+  hitImpactProfile.load(json);
+
   for (int i = 0; i < Character::Sfx::SFX_SIZE; i++) {
     const string &sfxKey = Character::_kCharacterSfxStr[i];
     if (!json["sfx"].HasMember(sfxKey.c_str())) {
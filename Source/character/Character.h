@@ -20,16 +20,24 @@
 #include "Importable.h"
 #include "Interactable.h"
 #include "character/Party.h"
+#include "character/StatModifierStack.h"
+#include "combat/Hitbox.h"
+#include "combat/HitImpact.h"
+#include "combat/HitReaction.h"
+#include "gameplay/Statistics.h"
 #include "item/Item.h"
 #include "item/Equipment.h"
 #include "item/Consumable.h"
 #include "map/GameMap.h"
+#include "skill/CooldownTracker.h"
 #include "skill/Skill.h"
+#include "util/B2BodyTemplate.h"
 #include "util/ds/SetVector.h"
 
 namespace vigilante {
 
 class ComboSystem;
+class MeleeHitResolver;
 
 class Character : public DynamicActor, public Importable {
  public:
@@ -92,6 +100,7 @@ class Character : public DynamicActor, public Importable {
     float spriteScaleY;
     std::array<float, Character::State::STATE_SIZE> frameIntervals;
     std::vector<float> extraAttackFrameIntervals;
+    HitboxProfile hitboxProfile;
     std::array<std::string, Character::Sfx::SFX_SIZE> sfxFileNames;
 
     std::string name;
@@ -122,9 +131,19 @@ class Character : public DynamicActor, public Importable {
     float attackDelay;
     int baseMeleeDamage;
     int forwardAttackNumTimesInflictDamage{1};
+    HitImpactProfile hitImpactProfile;
+
+    float poise;
+    float poiseRegen;  // per second
 
     std::vector<std::string> defaultSkills;
     std::vector<std::pair<std::string, int>> defaultInventory;
+    // The json file names of the status effects which can't be applied.
+    std::vector<std::string> statusEffectImmunities;
+
+    // The Statistics counters of this character as a subject, interned once.
+    Statistics::CounterId killCounterId{Statistics::kInvalidCounterId};
+    Statistics::CounterId recruitCounterId{Statistics::kInvalidCounterId};
   };
 
   // We have a vector of b2Fixtures (declared in DynamicActor abstract class).
@@ -136,13 +155,29 @@ class Character : public DynamicActor, public Importable {
     FIXTURE_SIZE
   };
 
-  virtual ~Character() override = default;
+  // The fixtures of the B2BodyTemplate which the body of a character is
+  // instantiated from. A body only uses one of the variants of the BODY
+  // and the WEAPON fixtures at a time, based on its posture and facing.
+  static inline constexpr size_t kStandingBodyFixture = 0;
+  static inline constexpr size_t kCrouchingBodyFixture = 1;
+  static inline constexpr size_t kFeetFixture = 2;
+  static inline constexpr size_t kWeaponFixtures[2][2] = {{3, 4}, {5, 6}};  // [isCrouching][isFacingRight]
+  static inline constexpr size_t kInteractableAreaFixture = 7;  // used by Npcs
+
+  // Returns the body template shared by all the characters with the same
+  // body size and attack range as `profile`, which is defined upon the first request.
+  static const B2BodyTemplate& getBodyTemplate(const Character::Profile& profile);
+
+  virtual ~Character() override;
 
   virtual bool showOnMap(float x, float y) override;  // DynamicActor
   virtual bool removeFromMap() override;  // DynamicActor
   virtual void update(const float delta) override;  // DynamicActor
   virtual void import(const std::string& jsonFileName) override;  // Importable
   virtual void replaceSpritesheet(const std::string& jsonFileName);
+  // Restores a character which has been killed and removed from the map,
+  // so that the same instance can be shown again (e.g., respawned).
+  virtual void revive();
 
   virtual void onKilled();
   virtual void onFallToGroundOrPlatform();
@@ -180,6 +215,12 @@ class Character : public DynamicActor, public Importable {
   virtual void knockBack(Character* target, float forceX, float forceY) const;
   virtual bool inflictDamage(Character* target, int damage);
   virtual bool inflictDamage(Character* target, int damage, const int numTimesINflictDamage, const float damageInflictionInterval);
+  // Damages, knocks back and applies the weapon's status effect to a target hit by a melee attack.
+  virtual void landMeleeHit(Character* target, int damage);
+  // Resolves the stagger of a hit against the poise of this character. If it
+  // staggers, this character flinches, its attack is interrupted and the
+  // knockback is queued towards `direction` (1 is right, -1 is left).
+  HitReaction::Result receiveHitImpact(Character* source, const HitImpact& hitImpact, const float direction);
   virtual bool receiveDamage(Character* source, int damage);
   virtual bool receiveDamage(int damage);
   virtual void lockOn(Character* target);
@@ -236,12 +277,16 @@ class Character : public DynamicActor, public Importable {
   inline void setStunned(bool stunned) { _isStunned = stunned; }
   inline void setAfterImageFxEnabled(bool afterImageFxEnabled) { _isAfterImageFxEnabled = afterImageFxEnabled; }
 
+  inline Character::State getCurrentState() const { return _currentState; }
   inline float getGroundAngle() const { return _groundAngle; }
   inline void setGroundAngle(float groundAngle) { _groundAngle = groundAngle; }
 
   inline void resetAttackAnimationIdx() { _attackAnimationIdx = 0; }
 
   inline Character::Profile& getCharacterProfile() { return _characterProfile; }
+  inline StatModifierStack& getStatModifiers() { return _statModifiers; }
+  inline HitReaction& getHitReaction() { return _hitReaction; }
+  inline const StatModifierStack& getStatModifiers() const { return _statModifiers; }
 
   inline ComboSystem &getCombatSystem() { return *_comboSystem; }
 
@@ -259,11 +304,14 @@ class Character : public DynamicActor, public Importable {
   inline const Inventory& getInventory() const { return _inventory; }
   inline const EquipmentSlots& getEquipmentSlots() const { return _equipmentSlots; }
   int getItemAmount(const std::string& itemJsonFileName) const;
+  Item* getItem(const std::string& itemJsonFileName) const;
 
   inline GameMap::Portal* getPortal() const { return _portal; }
   inline void setPortal(GameMap::Portal* portal) { _portal = portal; }
 
   inline SkillBook& getSkillBook() { return _skillBook; }
+  inline CooldownTracker& getSkillCooldowns() { return _skillCooldowns; }
+  inline const CooldownTracker& getSkillCooldowns() const { return _skillCooldowns; }
   std::shared_ptr<Skill> getActiveSkillInstance(Skill* skill) const;
   inline Skill* getCurrentlyUsedSkill() const { return _currentlyUsedSkill; }
   void removeActiveSkillInstance(Skill* skill);
@@ -274,9 +322,16 @@ class Character : public DynamicActor, public Importable {
   inline void setParty(std::shared_ptr<Party> party) { _party = party; }
 
   int getDamageOutput() const;
+  // The hit impact of the running attack animation or melee skill.
+  HitImpact getHitImpact() const;
+  bool hasHyperArmor() const;
   inline float getAnimationDuration(const Character::State state) const {
     return _bodyAnimations[state]->getDuration();
   }
+  // The index of the currently shown frame of the running animation.
+  int getAnimationFrameIdx() const;
+  // The hurtboxes of the running animation, or nullptr if it has none.
+  const std::vector<Hitbox>* getHurtboxes() const;
 
  protected:
   static inline const std::array<std::string, Character::State::STATE_SIZE> _kCharacterStateStr{{
@@ -318,6 +373,8 @@ class Character : public DynamicActor, public Importable {
     "killed",
   }};
 
+  static inline constexpr int kBodyAnimationActionTag = 1;
+
   static std::optional<Character::State> getCharacterState(const std::string& frameName);
 
   static constexpr bool isAttackState(const Character::State state) {
@@ -337,9 +394,11 @@ class Character : public DynamicActor, public Importable {
   virtual void regenHealth(int deltaHealth);
   virtual void regenMagicka(int deltaMagicka);
   virtual void regenStamina(int deltaStamina);
+  // Returns true if any of health, magicka and stamina has changed.
+  bool regenStats(const float delta);
+  void addEquipmentModifiers(const Equipment& equipment);
 
-  virtual void defineBody(b2BodyType bodyType,
-                          float x,
+  virtual void defineBody(float x,
                           float y,
                           short bodyCategoryBits=0,
                           short bodyMaskBits=0,
@@ -352,7 +411,8 @@ class Character : public DynamicActor, public Importable {
   virtual void loadBodyAnimations(const std::string& bodyTextureResDir);
 
   void moveImpl(const bool moveTowardsRight);
-  bool receiveDamage(Character* source, int damage, float numSecCantMove);
+  // How long a staggering hit keeps this character from moving.
+  virtual float getStaggerDuration() const;
 
   void createBodyAnimation(const Character::State state,
                            ax::Animation* fallbackAnimation);
@@ -363,11 +423,19 @@ class Character : public DynamicActor, public Importable {
     return _bodyAnimations[State::ATTACKING_UNARMED] != _bodyAnimations[State::ATTACKING];
   }
 
+  // Runs `action` on the body sprite at the speed of this character's time.
+  void runBodyAnimation(ax::ActionInterval* action);
   void runAnimation(Character::State state, bool loop=true);
-  void runAnimation(Character::State state, const std::function<void ()>& func) const;
+  void runAnimation(Character::State state, const std::function<void ()>& func);
   void runAnimation(const std::string& framesName, float interval);
 
   float getAttackAnimationDuration(const Character::State state) const;
+  // The frames name of the animation which the next `attackState` will run.
+  std::string getAttackFramesName(const Character::State attackState) const;
+  void onAnimationStarted(const std::string& framesName, ax::Animation* animation, const bool loop);
+
+  // The weapon's hitboxes take precedence over the character's own.
+  const std::vector<Hitbox>* getHitboxes(const std::string& framesName) const;
 
   Character::State determineState() const;
   Character::State determineAttackState() const;
@@ -379,17 +447,26 @@ class Character : public DynamicActor, public Importable {
 
   Item* getExistingItemObj(Item* item) const;
 
+  // Schedules `callback` to be run after `delay` seconds of this character's time.
+  CallbackManager::CallbackId runAfter(std::function<void (const CallbackManager::CallbackId)>&& callback,
+                                       const float delay) const;
+
   void dodge(const Character::State dodgeState, const float rushPowerX, bool &isDodgingFlag);
   void cancelAttack();
 
   // Characater data.
   Character::Profile _characterProfile;
 
-  // Stats regen timer
-  float _statsRegenTimer{};
-  const int _baseRegenDeltaHealth{5};
-  const int _baseRegenDeltaMagicka{5};
-  const int _baseRegenDeltaStamina{5};
+  // The derived attributes, i.e., _characterProfile with all modifiers applied.
+  StatModifierStack _statModifiers{*this};
+
+  // Stats regen is applied every frame, and the fractional
+  // points are carried over until they add up to a whole one.
+  float _healthRegenRemainder{};
+  float _magickaRegenRemainder{};
+  float _staminaRegenRemainder{};
+
+  HitReaction _hitReaction{*this};
 
   // The following variables are used to determine the character's state
   // and run the corresponding animations. Please see Character::update()
@@ -399,6 +476,15 @@ class Character : public DynamicActor, public Importable {
   std::optional<Character::State> _overridingAttackState{std::nullopt};
   b2Vec2 _previousBodyVelocity{0.0f, 0.0f};
   b2Vec2 _killedPos{0.0f, 0.0f};
+  // The move impulse is applied once per frame, so it is scaled by the
+  // game time of the last frame relative to 1 / kFps (see moveImpl()).
+  float _moveImpulseScale{1.0f};
+
+  // The running animation, used to look up the active hitboxes and hurtboxes.
+  std::string _runningAnimationName;
+  ax::Animation* _runningAnimation{};
+  bool _isRunningAnimationLooped{};
+  float _animationTime{};
 
   bool _isFacingRight{true};
   bool _isStartRunning{};
@@ -434,6 +520,7 @@ class Character : public DynamicActor, public Importable {
 
   // Combat related systems
   std::shared_ptr<ComboSystem> _comboSystem;
+  std::unique_ptr<MeleeHitResolver> _meleeHitResolver;
 
   // The following variables are used to determine combat targets.
   // A character can only inflict damage to another iff the target is
@@ -462,6 +549,7 @@ class Character : public DynamicActor, public Importable {
   // Currently used skill.
   Character::SkillBook _skillBook{};
   std::unordered_map<std::string, std::shared_ptr<Skill>> _skills;
+  CooldownTracker _skillCooldowns{*this};
   std::unordered_set<std::shared_ptr<Skill>> _activeSkillInstances;
   Skill* _currentlyUsedSkill{};
 
@@ -0,0 +1,105 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "InteractionResolver.h"
+
+#include "Constants.h"
+#include "Interactable.h"
+#include "character/Player.h"
+#include "scene/GameScene.h"
+#include "scene/SceneManager.h"
+
+using namespace std;
+using namespace vigilante::category_bits;
+
+namespace vigilante {
+
+namespace {
+
+constexpr float kPriorityWeight = 10.0f;
+constexpr float kDistanceWeight = 1.0f;
+constexpr float kFacingBonus = .5f;
+// The focused target keeps its focus unless another candidate
+// is clearly better, so that the hint doesn't flicker between
+// two interactables which are about equally close.
+constexpr float kFocusStickiness = .25f;
+constexpr short kLineOfSightBlockingCategoryBits = kGround | kWall;
+
+}  // namespace
+
+void InteractionResolver::update() {
+  Interactable* bestTarget = nullptr;
+  float bestScore = 0.0f;
+
+  for (const auto interactable : _player.getInRangeInteractables()) {
+    optional<float> s = score(interactable);
+    if (!s.has_value()) {
+      continue;
+    }
+    if (interactable == _focusedTarget) {
+      *s += kFocusStickiness;
+    }
+    if (!bestTarget || *s > bestScore) {
+      bestTarget = interactable;
+      bestScore = *s;
+    }
+  }
+
+  // If the focused target's priority has changed (e.g., a chest has been
+  // opened), its hint has to be refreshed as well.
+  if (bestTarget && bestTarget == _focusedTarget &&
+      bestTarget->getInteractionPriority() != _focusedTargetPriority) {
+    setFocusedTarget(nullptr);
+  }
+  setFocusedTarget(bestTarget);
+}
+
+void InteractionResolver::onOutOfRange(Interactable* interactable) {
+  if (interactable == _focusedTarget) {
+    setFocusedTarget(nullptr);
+  }
+}
+
+optional<float> InteractionResolver::score(const Interactable* interactable) const {
+  // e.g., those interacted with automatically, so there's nothing to focus on.
+  if (!interactable->isFocusable()) {
+    return nullopt;
+  }
+
+  const b2Body* body = interactable->getInteractionBody();
+  if (!body || !_player.getBody()) {
+    return nullopt;
+  }
+
+  const b2Vec2& playerPos = _player.getBody()->GetPosition();
+  const b2Vec2& targetPos = body->GetPosition();
+
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  if (gmMgr->rayCast(playerPos, targetPos, kLineOfSightBlockingCategoryBits)) {
+    return nullopt;
+  }
+
+  const float dx = targetPos.x - playerPos.x;
+  const bool isInFront = _player.isFacingRight() ? dx >= 0 : dx <= 0;
+
+  return interactable->getInteractionPriority() * kPriorityWeight -
+         (targetPos - playerPos).Length() * kDistanceWeight +
+         (isInFront ? kFacingBonus : 0.0f);
+}
+
+void InteractionResolver::setFocusedTarget(Interactable* interactable) {
+  if (interactable == _focusedTarget) {
+    return;
+  }
+
+  if (_focusedTarget) {
+    _focusedTarget->hideHintUI();
+  }
+
+  _focusedTarget = interactable;
+  _focusedTargetPriority = (interactable) ? interactable->getInteractionPriority() : 0;
+
+  if (_focusedTarget) {
+    _focusedTarget->showHintUI();
+  }
+}
+
+}  // namespace vigilante
@@ -0,0 +1,38 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_INTERACTION_RESOLVER_H_
+#define VIGILANTE_INTERACTION_RESOLVER_H_
+
+#include <optional>
+
+namespace vigilante {
+
+class Interactable;
+class Player;
+
+// When several interactables are in range of the player, InteractionResolver
+// picks a single one to focus on. The candidates are scored once per frame by
+// type priority, distance, facing and line of sight, and only the focused one
+// shows its hint, so ControlHints is only touched when the focus changes.
+class InteractionResolver final {
+ public:
+  explicit InteractionResolver(Player& player) : _player{player} {}
+
+  void update();
+  // Must be called as soon as `interactable` leaves the player's range,
+  // since it may be destroyed before the next update().
+  void onOutOfRange(Interactable* interactable);
+
+  inline Interactable* getFocusedTarget() const { return _focusedTarget; }
+
+ private:
+  std::optional<float> score(const Interactable* interactable) const;
+  void setFocusedTarget(Interactable* interactable);
+
+  Player& _player;
+  Interactable* _focusedTarget{};
+  int _focusedTargetPriority{};
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_INTERACTION_RESOLVER_H_
@@ -8,6 +8,7 @@
 #include "Assets.h"
 #include "CallbackManager.h"
 #include "Constants.h"
+#include "Localization.h"
 #include "character/Player.h"
 #include "item/Item.h"
 #include "quest/KillTargetObjective.h"
@@ -15,7 +16,6 @@
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
 #include "ui/trade/TradeWindow.h"
-#include "util/B2BodyBuilder.h"
 #include "util/JsonUtil.h"
 #include "util/RandUtil.h"
 #include "util/StringUtil.h"
@@ -90,7 +90,7 @@ bool Npc::showOnMap(float x, float y) {
   // Construct b2Body and b2Fixtures.
   // The category/mask bits of each fixture are set in Npc::setDisposition()
   // based on the disposition of this npc.
-  defineBody(b2BodyType::b2_dynamicBody, x, y);
+  defineBody(x, y);
   setDisposition(_disposition);
 
   // Load sprites, spritesheets, and animations, and then add them to GameMapManager layer.
@@ -115,41 +115,38 @@ bool Npc::removeFromMap() {
   }
 
   _floatingHealthBar->getLayout()->removeFromParentAndCleanup(true);
+  return true;
 }
 
-void Npc::defineBody(b2BodyType bodyType, float x, float y,
+void Npc::defineBody(float x, float y,
                      short bodyCategoryBits, short bodyMaskBits,
                      short feetMaskBits, short weaponMaskBits) {
-  Character::defineBody(bodyType, x, y,
+  Character::defineBody(x, y,
                         bodyCategoryBits,
                         bodyMaskBits,
                         feetMaskBits,
                         weaponMaskBits);
 
-  float scaleFactor = Director::getInstance()->getContentScaleFactor();
-  float sideLength = std::max(_characterProfile.bodyWidth, _characterProfile.bodyHeight) * 1.2;
-  b2Vec2 vertices[] = {
-    {-sideLength / scaleFactor,  sideLength / scaleFactor},
-    { sideLength / scaleFactor,  sideLength / scaleFactor},
-    {-sideLength / scaleFactor, -sideLength / scaleFactor},
-    { sideLength / scaleFactor, -sideLength / scaleFactor}
-  };
-
   // Besides the original fixtures created in Character::defineBody(),
   // create one extra fixture which can collide with player's feetFixture,
   // but make it a sensor. This is the interactable area of this Npc.
-  B2BodyBuilder bodyBuilder{_body};
-  bodyBuilder.newPolygonFixture(vertices, 4, kPpm)
-    .categoryBits(kInteractable)
-    .maskBits(kFeet)
-    .setSensor(true)
-    .setUserData(static_cast<Interactable*>(this))
-    .buildFixture();
+  getBodyTemplate(_characterProfile).instantiateFixture(
+      _body, kInteractableAreaFixture, static_cast<Interactable*>(this));
 }
 
 void Npc::import(const string& jsonFileName) {
   Character::import(jsonFileName);
   _npcProfile = Npc::Profile{jsonFileName};
+  _npcController.setBehaviorTree(nullptr);
+}
+
+void Npc::revive() {
+  Character::revive();
+
+  _disposition = _npcProfile.disposition;
+  _npcController.clearMoveDest();
+  _npcController.wake();
+  _perception.forgetAll();
 }
 
 void Npc::onKilled() {
@@ -166,6 +163,8 @@ void Npc::onKilled() {
 
 void Npc::onMapChanged() {
   _npcController.clearMoveDest();
+  _npcController.wake();
+  _perception.forgetAll();
 
   if (_isKilled && _party) {
     _party->dismiss(this, /*addToMap=*/false);
@@ -191,20 +190,17 @@ bool Npc::inflictDamage(Character* target, int damage) {
 }
 
 bool Npc::receiveDamage(Character* source, int damage) {
-  constexpr float kAllyNumSecCantMove = 5.0f;
-  if (_disposition == Npc::Disposition::ALLY && !Character::receiveDamage(source, damage, kAllyNumSecCantMove)) {
-    VGLOG(LOG_ERR, "Failed to receive damage from source: [%p].", source);
-    return false;
-  } else if (!Character::receiveDamage(source, damage)) {
+  if (!Character::receiveDamage(source, damage)) {
     VGLOG(LOG_ERR, "Failed to receive damage from source: [%p].", source);
     return false;
   }
 
   _isAlerted = true;
+  _npcController.wake();
 
   if (!source) {
     _isInvincible = true;
-    CallbackManager::the().runAfter([this](const CallbackManager::CallbackId){
+    runAfter([this](const CallbackManager::CallbackId){
       _isInvincible = false;
     }, 1.0f);
   }
@@ -219,6 +215,11 @@ bool Npc::receiveDamage(Character* source, int damage) {
   return true;
 }
 
+float Npc::getStaggerDuration() const {
+  // Allies reel as long as the player does.
+  return (_disposition == Npc::Disposition::ALLY) ? 5.0f : Character::getStaggerDuration();
+}
+
 void Npc::interact(Interactable* target) {
   if (!dynamic_cast<GameMap::Portal*>(target)) {
     Character::interact(target);
@@ -242,7 +243,7 @@ void Npc::showHintUI() {
   createHintBubbleFx();
 
   auto controlHints = SceneManager::the().getCurrentScene<GameScene>()->getControlHints();
-  controlHints->insert({EventKeyboard::KeyCode::KEY_CAPITAL_E}, "Talk");
+  controlHints->insert({EventKeyboard::KeyCode::KEY_CAPITAL_E}, tr(StringId::HINT_TALK));
 }
 
 void Npc::hideHintUI() {
@@ -252,6 +253,11 @@ void Npc::hideHintUI() {
   controlHints->remove({EventKeyboard::KeyCode::KEY_CAPITAL_E});
 }
 
+int Npc::getInteractionPriority() const {
+  // Talking to someone is usually what the player wants.
+  return _npcProfile.dialogueTreeJsonFile.empty() ? 0 : 2;
+}
+
 void Npc::createHintBubbleFx() {
   if (_hintBubbleFxSprite) {
     return;
@@ -274,7 +280,7 @@ void Npc::removeHintBubbleFx() {
 void Npc::dropItems() {
   // We'll use a callback to drop items since creating fixtures during collision callback
   // will cause the game to crash. Ref: https://github.com/libgdx/libgdx/issues/2730
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+  runAfter([this](const CallbackManager::CallbackId) {
     auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
 
     for (const auto& i : _npcProfile.droppedItems) {
@@ -400,6 +406,9 @@ Npc::Profile::Profile(const string& jsonFileName) {
   isRecruitable = json["isRecruitable"].GetBool();
   isTradable = json["isTradable"].GetBool();
   shouldSandbox = json["shouldSandbox"].GetBool();
+  if (json.HasMember("behaviorTree")) {
+    behaviorTreeJsonFile = json["behaviorTree"].GetString();
+  }
 }
 
 }  // namespace vigilante
@@ -10,6 +10,7 @@
 #include "Interactable.h"
 #include "character/Character.h"
 #include "character/NpcController.h"
+#include "character/Perception.h"
 #include "gameplay/DialogueTree.h"
 #include "ui/hud/StatusBar.h"
 
@@ -53,6 +54,7 @@ class Npc : public Character, public Interactable {
     bool isRecruitable;
     bool isTradable;
     bool shouldSandbox;
+    std::string behaviorTreeJsonFile;  // optional, see BehaviorTree
   };
 
   explicit Npc(const std::string& jsonFileName);
@@ -62,6 +64,7 @@ class Npc : public Character, public Interactable {
   virtual bool removeFromMap() override;  // Character
   virtual void update(const float delta) override;  // Character
   virtual void import(const std::string& jsonFileName) override;  // Character
+  virtual void revive() override;  // Character
 
   virtual void onKilled() override;  // Character
   virtual void onMapChanged() override;  // Character
@@ -74,9 +77,13 @@ class Npc : public Character, public Interactable {
   virtual bool willInteractOnContact() const override;  // Interactable
   virtual void showHintUI() override;  // Interactable
   virtual void hideHintUI() override;  // Interactable
+  virtual const b2Body* getInteractionBody() const override { return _body; }  // Interactable
+  virtual int getInteractionPriority() const override;  // Interactable
 
   void act(const float delta) { _npcController.update(delta); }
   void reverseDirection() { _npcController.reverseDirection(); }
+  void setTravelDest(const b2Vec2& travelDest) { _npcController.setTravelDest(travelDest); }
+  void wake() { _npcController.wake(); }
   void dropItems();
 
   void updateDialogueTreeIfNeeded();
@@ -93,13 +100,15 @@ class Npc : public Character, public Interactable {
   inline DialogueTree& getDialogueTree() { return _dialogueTree; }
   inline Npc::Disposition getDisposition() const { return _disposition; }
   void setDisposition(Npc::Disposition disposition);
+  inline Perception& getPerception() { return _perception; }
+  inline const NpcController& getNpcController() const { return _npcController; }
 
   inline bool isSandboxing() const { return _npcController.isSandboxing(); }
   inline void setSandboxing(const bool sandboxing) { _npcController.setSandboxing(sandboxing); }
 
  private:
-  virtual void defineBody(b2BodyType bodyType,
-                          float x,
+  virtual float getStaggerDuration() const override;  // Character
+  virtual void defineBody(float x,
                           float y,
                           short bodyCategoryBits=0,
                           short bodyMaskBits=0,
@@ -113,6 +122,7 @@ class Npc : public Character, public Interactable {
   DialogueTree _dialogueTree;
   Npc::Disposition _disposition;
   NpcController _npcController;
+  Perception _perception;
 
   ax::Sprite* _hintBubbleFxSprite{};
   std::unique_ptr<StatusBar> _floatingHealthBar;
@@ -1,10 +1,13 @@
 // Copyright (c) 2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
 #include "NpcController.h"
 
+#include <optional>
+
 #include "Constants.h"
 #include "character/Npc.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
+#include "util/Logger.h"
 #include "util/RandUtil.h"
 
 using namespace std;
@@ -16,57 +19,173 @@ namespace {
 
 constexpr float kAllyTeleportDist = 2.5f;
 constexpr float kAllyFollowDist = .75f;
+constexpr float kFormationSlotTolerance = .15f;
+constexpr float kFormationJumpHeight = .3f;
 constexpr float kMoveDestFollowDist = .2f;
+constexpr float kSearchDist = .5f;
 constexpr float kJumpCheckInterval = .5f;
 constexpr float kActivateRandomSkillInterval = 3.0f;
 
 }  // namespace
 
-// This Npc may perform one of the following actions:
-// (1) Has `_lockedOnTarget` and `_lockedOnTarget` is not dead yet:
-//     a. target is within attack range -> attack()
-//     b. target not within attack range -> moveToTarget()
-// (2) Has `_lockedOnTarget` but `_lockedOnTarget` is dead:
-//     a. target belongs to a party -> try to select other member as new _lockedOnTarget
-//     b. target doesnt belong to any party -> clear _lockedOnTarget
-// (3) If too far away from the party leader, teleport to the leader.
-// (4) Has a target destination (_moveDest) to travel to
-// (5) Is following another Character -> moveToTarget()
-// (6) Sandboxing (just moving around wasting its time) -> moveRandomly()
+// Each update ticks the behavior tree of this Npc (see BehaviorTree::get()),
+// unless it has nothing to do and nothing has happened to it since.
 void NpcController::update(const float delta) {
   if (_npc.isKilled() || _npc.isSetToKill() || _npc.isAttacking()) {
     return;
   }
 
+  if (_npc.getLockedOnTarget()) {
+    _activateSkillTimer += delta;
+  }
+
+  if (!_blackboard.isAwake) {
+    _blackboard.sleepTimer -= delta;
+    if (_blackboard.sleepTimer > 0) {
+      return;
+    }
+  }
+
+  if (!_behaviorTree) {
+    _behaviorTree = BehaviorTree::get(_npc.getNpcProfile().behaviorTreeJsonFile);
+  }
+  if (!_behaviorTree) {
+    return;
+  }
+
+  // A failed tree means that there's nothing to do for now, so go to sleep.
+  const BehaviorTree::Status status = _behaviorTree->tick(*this, _blackboard, delta);
+  _blackboard.isAwake = status != BehaviorTree::Status::FAILURE;
+  _blackboard.sleepTimer = kSleepDuration;
+}
+
+bool NpcController::evaluate(const Condition condition) const {
   Character* lockedOnTarget = _npc.getLockedOnTarget();
-  if (lockedOnTarget && !lockedOnTarget->isSetToKill()) {
-    auto &skillbook = _npc.getSkillBook()[Skill::Type::MAGIC];
-    if (skillbook.size() && _activateSkillTimer >= kActivateRandomSkillInterval) {
-      Skill* skill = skillbook.front();
-      _npc.activateSkill(skill);
+
+  switch (condition) {
+    case Condition::HAS_TARGET:
+      return lockedOnTarget && !lockedOnTarget->isSetToKill();
+    case Condition::IS_TARGET_KILLED:
+      return lockedOnTarget && lockedOnTarget->isSetToKill();
+    case Condition::IS_TARGET_IN_RANGE:
+      return lockedOnTarget && _npc.getInRangeTargets().contains(lockedOnTarget);
+    case Condition::IS_FOLLOWING_PARTY:
+      return _npc.getParty() && !_npc.isWaitingForPartyLeader();
+    case Condition::HAS_MOVE_DEST:
+      return _moveDest.x || _moveDest.y;
+    case Condition::HAS_TRAVEL_DEST:
+      return _travelDest.has_value();
+    case Condition::IS_SANDBOXING:
+      return _isSandboxing;
+    default:
+      VGLOG(LOG_ERR, "Unknown condition: [%d].", static_cast<int>(condition));
+      return false;
+  }
+}
+
+BehaviorTree::Status NpcController::perform(const Action action,
+                                            const BehaviorTree::Args& args, const float delta) {
+  using Status = BehaviorTree::Status;
+
+  switch (action) {
+    case Action::UPDATE_PERCEPTION:
+      updatePerception();
+      return Status::SUCCESS;
+
+    case Action::CAST_SKILL: {
+      auto& skillbook = _npc.getSkillBook()[Skill::Type::MAGIC];
+      if (skillbook.empty() || _activateSkillTimer < kActivateRandomSkillInterval) {
+        return Status::FAILURE;
+      }
+      _npc.activateSkill(skillbook.front());
       _activateSkillTimer = 0;
-    } else if (_npc.getInRangeTargets().contains(lockedOnTarget)) {
+      return Status::SUCCESS;
+    }
+
+    case Action::ATTACK:
       _npc.attack();
-    } else if (!_npc.isUsingSkill()) {
-      moveToTarget(delta, lockedOnTarget, _npc.getCharacterProfile().attackRange / kPpm);
+      return Status::SUCCESS;
+
+    case Action::MOVE_TO_TARGET:
+      if (!_npc.isUsingSkill()) {
+        moveToLockedOnTarget(delta, _npc.getLockedOnTarget());
+      }
+      return Status::RUNNING;
+
+    case Action::RETARGET: {
+      Character* killedTarget = _npc.getLockedOnTarget();
+      _npc.setLockedOnTarget(nullptr);
+      findNewLockedOnTargetFromParty(killedTarget);
+      return Status::SUCCESS;
     }
-    _activateSkillTimer += delta;
-  } else if (lockedOnTarget && lockedOnTarget->isSetToKill()) {
-    Character* killedTarget = lockedOnTarget;
+
+    case Action::FOLLOW_FORMATION:
+      followFormation(delta);
+      return Status::RUNNING;
+
+    case Action::MOVE_TO_MOVE_DEST:
+      moveToTarget(delta, _moveDest, kMoveDestFollowDist);
+      return Status::RUNNING;
+
+    case Action::MOVE_TO_TRAVEL_DEST: {
+      const b2Vec2& thisPos = _npc.getBody()->GetPosition();
+      if (std::hypotf(_travelDest->x - thisPos.x, _travelDest->y - thisPos.y) <= kMoveDestFollowDist) {
+        _travelDest.reset();
+        return Status::SUCCESS;
+      }
+      moveToTarget(delta, *_travelDest, kMoveDestFollowDist);
+      return Status::RUNNING;
+    }
+
+    case Action::MOVE_RANDOMLY:
+      moveRandomly(delta, static_cast<int>(args[0]), static_cast<int>(args[1]),
+                   static_cast<int>(args[2]), static_cast<int>(args[3]));
+      return Status::RUNNING;
+
+    default:
+      VGLOG(LOG_ERR, "Unknown action: [%d].", static_cast<int>(action));
+      return Status::FAILURE;
+  }
+}
+
+void NpcController::updatePerception() {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  PerceptionSystem* perceptionSystem = gmMgr->getPerceptionSystem();
+  if (!perceptionSystem->isPerceiver(&_npc)) {
+    return;
+  }
+
+  Perception& perception = _npc.getPerception();
+  const float now = perceptionSystem->getTime();
+  Character* lockedOnTarget = _npc.getLockedOnTarget();
+
+  if (!lockedOnTarget) {
+    const Perception::Memory* memory = perception.getMostRelevantMemory(now);
+    if (!memory) {
+      return;
+    }
+    // The target may have been killed or left the map since it was sensed.
+    if (!perceptionSystem->isPerceivable(memory->target)) {
+      perception.forget(memory->target);
+      return;
+    }
+    _npc.lockOn(memory->target);
+    return;
+  }
+
+  if (!perceptionSystem->isPerceivable(lockedOnTarget)) {
+    return;
+  }
+
+  if (!perception.remembers(lockedOnTarget)) {
+    // We've been locked on by other means, e.g., one of our allies was attacked.
+    perception.sense(lockedOnTarget, lockedOnTarget->getBody()->GetPosition(),
+                     Perception::Sense::DAMAGE, now);
+  } else if (!perception.getMemory(lockedOnTarget, now)) {
+    // We haven't sensed the target for a while, so give up.
+    perception.forget(lockedOnTarget);
     _npc.setLockedOnTarget(nullptr);
-    findNewLockedOnTargetFromParty(killedTarget);
-  } else if (_npc.getParty() &&
-             !_npc.isWaitingForPartyLeader() &&
-             isTooFarAwayFromTarget(_npc.getParty()->getLeader())) {
-    clearMoveDest();
-    _npc.teleportToTarget(_npc.getParty()->getLeader());
-    _npc.getBody()->SetAwake(true);
-  } else if (_moveDest.x || _moveDest.y) {
-    moveToTarget(delta, _moveDest, kMoveDestFollowDist);
-  } else if (_npc.getParty() && !_npc.isWaitingForPartyLeader()) {
-    moveToTarget(delta, _npc.getParty()->getLeader(), kAllyFollowDist);
-  } else if (_isSandboxing) {
-    moveRandomly(delta, 0, 5, 0, 5);
+    _npc.setAlerted(false);
   }
 }
 
@@ -83,10 +202,67 @@ void NpcController::findNewLockedOnTargetFromParty(const Character* killedTarget
   }
 }
 
-bool NpcController::isTooFarAwayFromTarget(const Character* target) const {
+void NpcController::moveToLockedOnTarget(const float delta, Character* target) {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  const Perception& perception = _npc.getPerception();
+  const float now = gmMgr->getPerceptionSystem()->getTime();
+  const Perception::Memory* memory = perception.getMemory(target, now);
+
+  if (!memory || perception.canSee(*memory, now)) {
+    moveToTarget(delta, target, _npc.getCharacterProfile().attackRange / kPpm);
+    return;
+  }
+
+  // We've lost sight of the target, so go to where it was last sensed,
+  // and then look around for a while.
   const b2Vec2& thisPos = _npc.getBody()->GetPosition();
-  const b2Vec2& targetPos = target->getBody()->GetPosition();
+  const b2Vec2& lastKnownPos = memory->lastKnownPosition;
+  if (std::hypotf(lastKnownPos.x - thisPos.x, lastKnownPos.y - thisPos.y) > kSearchDist) {
+    moveToTarget(delta, lastKnownPos, kMoveDestFollowDist);
+  } else {
+    moveRandomly(delta, 0, 1, 0, 1);
+  }
+}
+
+void NpcController::followFormation(const float delta) {
+  PartyFormation& formation = _npc.getParty()->getFormation();
+  const optional<b2Vec2> slotPos = formation.getSlotPosition(&_npc);
+  if (!slotPos) {
+    // Not assigned a slot yet (e.g., just recruited), so follow the leader directly.
+    moveToTarget(delta, _npc.getParty()->getLeader(), kAllyFollowDist);
+    return;
+  }
+
+  clearMoveDest();
+
+  if (isTooFarAwayFromTarget(*slotPos)) {
+    _npc.teleportToTarget(*slotPos);
+    _npc.getBody()->SetAwake(true);
+    return;
+  }
 
+  // The slot lies on the route the leader has already walked,
+  // so there is no need for path finding here. A small dead zone
+  // keeps the member from jittering around its slot.
+  const b2Vec2& thisPos = _npc.getBody()->GetPosition();
+  const float dx = slotPos->x - thisPos.x;
+  if (std::abs(dx) > kFormationSlotTolerance) {
+    (dx > 0) ? _npc.moveRight() : _npc.moveLeft();
+    _npc.setFacingRight(dx > 0);
+  } else {
+    _npc.setFacingRight(formation.isLeaderFacingRight());
+  }
+
+  const float dy = slotPos->y - thisPos.y;
+  if (dy > kFormationJumpHeight && !_npc.isJumping()) {
+    _npc.jump();
+  } else if (dy < -kFormationJumpHeight && std::abs(dx) <= kFormationSlotTolerance) {
+    _npc.jumpDown();
+  }
+}
+
+bool NpcController::isTooFarAwayFromTarget(const b2Vec2& targetPos) const {
+  const b2Vec2& thisPos = _npc.getBody()->GetPosition();
   return std::hypotf(targetPos.x - thisPos.x, targetPos.y - thisPos.y) > kAllyTeleportDist;
 }
 
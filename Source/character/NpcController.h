@@ -2,27 +2,100 @@
 #ifndef VIGILANTE_NPC_CONTROLLER_H_
 #define VIGILANTE_NPC_CONTROLLER_H_
 
+#include <array>
+#include <optional>
+#include <string>
+
 #include <box2d/box2d.h>
 
+#include "character/BehaviorTree.h"
+
 namespace vigilante {
 
 class Character;
 class Npc;
 
+// NpcController runs the BehaviorTree of an Npc, and implements
+// the conditions and actions which the trees are made of.
 class NpcController final {
  public:
+  enum class Condition : uint8_t {
+    HAS_TARGET,
+    IS_TARGET_KILLED,
+    IS_TARGET_IN_RANGE,
+    IS_FOLLOWING_PARTY,
+    HAS_MOVE_DEST,
+    HAS_TRAVEL_DEST,
+    IS_SANDBOXING,
+    SIZE
+  };
+
+  enum class Action : uint8_t {
+    UPDATE_PERCEPTION,
+    CAST_SKILL,
+    ATTACK,
+    MOVE_TO_TARGET,
+    RETARGET,
+    FOLLOW_FORMATION,
+    MOVE_TO_MOVE_DEST,
+    MOVE_TO_TRAVEL_DEST,
+    MOVE_RANDOMLY,  // args: minMoveDuration, maxMoveDuration, minWaitDuration, maxWaitDuration
+    SIZE
+  };
+
+  static inline const std::array<std::string, static_cast<size_t>(Condition::SIZE)> kConditionStr{{
+    "hasTarget",
+    "isTargetKilled",
+    "isTargetInRange",
+    "isFollowingParty",
+    "hasMoveDest",
+    "hasTravelDest",
+    "isSandboxing",
+  }};
+
+  static inline const std::array<std::string, static_cast<size_t>(Action::SIZE)> kActionStr{{
+    "updatePerception",
+    "castSkill",
+    "attack",
+    "moveToTarget",
+    "retarget",
+    "followFormation",
+    "moveToMoveDest",
+    "moveToTravelDest",
+    "moveRandomly",
+  }};
+
   explicit NpcController(Npc& npc) : _npc{npc} {}
 
   void update(const float delta);
+  // Makes the behavior tree re-evaluated on the next update,
+  // e.g., the Npc has sensed something or has been given an order.
+  inline void wake() { _blackboard.isAwake = true; }
+
+  bool evaluate(const NpcController::Condition condition) const;
+  BehaviorTree::Status perform(const NpcController::Action action,
+                               const BehaviorTree::Args& args, const float delta);
 
   inline void reverseDirection() { _isMovingRight = !_isMovingRight; }
   inline bool isSandboxing() const { return _isSandboxing; }
-  inline void setSandboxing(const bool sandboxing) { _isSandboxing = sandboxing; }
-  inline void clearMoveDest() { _moveDest.SetZero(); }
+  inline void setSandboxing(const bool sandboxing) { _isSandboxing = sandboxing; wake(); }
+  inline void clearMoveDest() { _moveDest.SetZero(); _travelDest.reset(); }
+  inline void setTravelDest(const b2Vec2& travelDest) { _travelDest = travelDest; wake(); }
+
+  inline void setBehaviorTree(const BehaviorTree* behaviorTree) { _behaviorTree = behaviorTree; _blackboard = {}; }
+  inline const BehaviorTree* getBehaviorTree() const { return _behaviorTree; }
+  inline const BehaviorTree::Blackboard& getBlackboard() const { return _blackboard; }
 
  private:
+  // How long an Npc with nothing to do sleeps before re-evaluating its
+  // tree anyway, in case something has changed without waking it up.
+  static inline constexpr float kSleepDuration = .5f;
+
+  void updatePerception();
   void findNewLockedOnTargetFromParty(const Character* killedTarget);
-  bool isTooFarAwayFromTarget(const Character* target) const;
+  void moveToLockedOnTarget(const float delta, Character* target);
+  void followFormation(const float delta);
+  bool isTooFarAwayFromTarget(const b2Vec2& targetPos) const;
   void moveToTarget(const float delta, Character* target, const float followDist);
   void moveToTarget(const float delta, const b2Vec2& targetPos, const float followDist);
   void moveRandomly(const float delta,
@@ -31,6 +104,8 @@ class NpcController final {
   void jumpIfStucked(const float delta, const float checkInterval);
 
   Npc& _npc;
+  const BehaviorTree* _behaviorTree{};
+  BehaviorTree::Blackboard _blackboard;
 
   bool _isSandboxing{};
   bool _isMovingRight{};
@@ -41,6 +116,7 @@ class NpcController final {
   float _calculateDistanceTimer{};
   float _activateSkillTimer{};
   b2Vec2 _moveDest{0.f, 0.f};
+  std::optional<b2Vec2> _travelDest;  // where its schedule wants it to be
   b2Vec2 _lastStoppedPosition{0.f, 0.f};
 };
 
@@ -4,11 +4,12 @@
 #include <box2d/box2d.h>
 
 #include "Constants.h"
+#include "Localization.h"
 #include "character/Character.h"
 #include "character/Npc.h"
+#include "gameplay/Statistics.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
-#include "util/StringUtil.h"
 
 using namespace std;
 
@@ -51,9 +52,11 @@ void Party::recruit(Character* targetCharacter) {
   target->showOnMap(targetPos.x * kPpm, targetPos.y * kPpm);
   addMember(std::move(target));
 
+  Statistics::the().record(Statistics::Event::MEMBER_RECRUITED, 1,
+                           targetCharacter->getCharacterProfile().recruitCounterId);
+
   auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
-  notifications->show(string_util::format("%s is now following you.",
-                                          targetCharacter->getCharacterProfile().name.c_str()));
+  notifications->show(tr(StringId::PARTY_FOLLOWING, targetCharacter->getCharacterProfile().name));
 }
 
 void Party::dismiss(Character* targetCharacter, bool addToMap) {
@@ -86,8 +89,7 @@ void Party::dismiss(Character* targetCharacter, bool addToMap) {
   }
 
   auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
-  notifications->show(string_util::format("%s has left your party.",
-                                          targetCharacter->getCharacterProfile().name.c_str()));
+  notifications->show(tr(StringId::PARTY_LEFT, targetCharacter->getCharacterProfile().name));
 }
 
 void Party::dismissAll(bool addToMap) {
@@ -108,16 +110,22 @@ void Party::askMemberToWait(Character* targetCharacter) {
                    targetPos.y);
 
   auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
-  notifications->show(string_util::format("%s will be waiting for you.",
-                                          targetCharacter->getCharacterProfile().name.c_str()));
+  notifications->show(tr(StringId::PARTY_WAITING, targetCharacter->getCharacterProfile().name));
 }
 
 void Party::askMemberToFollow(Character* targetCharacter) {
   removeWaitingMember(targetCharacter->getCharacterProfile().jsonFileName);
 
   auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
-  notifications->show(string_util::format("%s is now following you.",
-                                          targetCharacter->getCharacterProfile().name.c_str()));
+  notifications->show(tr(StringId::PARTY_FOLLOWING, targetCharacter->getCharacterProfile().name));
+}
+
+bool Party::isFollowingLeader(const Character* character) const {
+  shared_ptr<Character> key(shared_ptr<Character>(), const_cast<Character*>(character));
+  if (!_members.contains(key) || !character->getBody()) {
+    return false;
+  }
+  return !getWaitingMemberLocationInfo(character->getCharacterProfile().jsonFileName);
 }
 
 void Party::addWaitingMember(const string& characterJsonFileName,
@@ -8,6 +8,8 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "character/PartyFormation.h"
+
 namespace vigilante {
 
 // Forward declaration
@@ -31,6 +33,8 @@ class Party final {
 
   void askMemberToWait(Character* targetCharacter);  // wait in a specific map
   void askMemberToFollow(Character* targetCharacter);  // resume following
+  bool isFollowingLeader(const Character* character) const;
+  inline void updateFormation() { _formation.update(*this); }
 
   void addWaitingMember(const std::string& characterJsonFileName,
                         const std::string& currentTmxMapFileName,
@@ -44,6 +48,7 @@ class Party final {
   inline const std::unordered_set<std::shared_ptr<Character>>& getMembers() const { return _members; }
   inline Character* getLeader() const { return _leader; }
   std::unordered_set<Character*> getLeaderAndMembers() const;
+  inline PartyFormation& getFormation() { return _formation; }
 
   inline const std::unordered_map<std::string, Party::WaitingLocationInfo>&
   getWaitingMembersLocationInfos() const {
@@ -60,6 +65,7 @@ class Party final {
   Character* _leader{};
   std::unordered_set<std::shared_ptr<Character>> _members;
   std::unordered_map<std::string, Party::WaitingLocationInfo> _waitingMembersLocationInfos;
+  PartyFormation _formation;
 
   friend class GameState;
 };
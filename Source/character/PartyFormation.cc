@@ -0,0 +1,122 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "PartyFormation.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "character/Character.h"
+#include "character/Party.h"
+
+using namespace std;
+
+namespace vigilante {
+
+namespace {
+
+constexpr float kWaypointSpacing = .1f;
+constexpr float kMaxLeaderStepDist = 1.5f;
+
+float getDistance(const b2Vec2& a, const b2Vec2& b) {
+  return std::hypotf(b.x - a.x, b.y - a.y);
+}
+
+}  // namespace
+
+void PartyFormation::update(const Party& party) {
+  const Character* leader = party.getLeader();
+  if (!leader->getBody()) {
+    return;
+  }
+
+  const b2Vec2& leaderPos = leader->getBody()->GetPosition();
+  _isLeaderFacingRight = leader->isFacingRight();
+
+  updateSlots(party);
+  updateTrail(leaderPos);
+  updateSlotPositions(leaderPos);
+}
+
+void PartyFormation::reset(const b2Vec2& leaderPos) {
+  _trail.clear();
+  _trail.push_back({leaderPos, 0.0f});
+  updateSlotPositions(leaderPos);
+}
+
+optional<b2Vec2> PartyFormation::getSlotPosition(const Character* member) const {
+  auto it = std::find(_slots.begin(), _slots.end(), member);
+  if (it == _slots.end()) {
+    return std::nullopt;
+  }
+  return _slotPositions[it - _slots.begin()];
+}
+
+void PartyFormation::updateSlots(const Party& party) {
+  // Keep the existing order so that the members don't swap places
+  // whenever someone joins, leaves or is asked to wait.
+  std::erase_if(_slots, [&party](const Character* member) {
+    return !party.isFollowingLeader(member);
+  });
+
+  for (const auto& member : party.getMembers()) {
+    if (party.isFollowingLeader(member.get()) &&
+        std::find(_slots.begin(), _slots.end(), member.get()) == _slots.end()) {
+      _slots.push_back(member.get());
+    }
+  }
+}
+
+void PartyFormation::updateTrail(const b2Vec2& leaderPos) {
+  // If the leader has moved too far within a single frame, it must have
+  // been teleported, so the old trail is no longer walkable.
+  if (_trail.empty() || getDistance(_trail.back().position, leaderPos) > kMaxLeaderStepDist) {
+    reset(leaderPos);
+    return;
+  }
+
+  const float dist = getDistance(_trail.back().position, leaderPos);
+  if (dist >= kWaypointSpacing) {
+    _trail.push_back({leaderPos, _trail.back().distance + dist});
+  }
+
+  // Only keep as much trail as the last slot needs.
+  const float maxTrailLength = kLeaderSpacing + _slots.size() * kSlotSpacing + kWaypointSpacing;
+  while (_trail.size() > 2 && _trail.back().distance - _trail[1].distance > maxTrailLength) {
+    _trail.pop_front();
+  }
+}
+
+void PartyFormation::updateSlotPositions(const b2Vec2& leaderPos) {
+  _slotPositions.clear();
+  if (_trail.empty()) {
+    return;
+  }
+
+  // The slots are sorted by their distance to the leader, so all of them
+  // can be resolved with a single backward walk along the trail.
+  const float leaderDist = _trail.back().distance + getDistance(_trail.back().position, leaderPos);
+  b2Vec2 nextPos = leaderPos;
+  float nextDist = leaderDist;
+  auto it = _trail.rbegin();
+
+  for (size_t i = 0; i < _slots.size(); i++) {
+    const float slotDist = leaderDist - (kLeaderSpacing + i * kSlotSpacing);
+    while (it != _trail.rend() && it->distance > slotDist) {
+      nextPos = it->position;
+      nextDist = it->distance;
+      ++it;
+    }
+
+    // The trail is shorter than this slot's distance (e.g., right after
+    // a map transition), so just wait at the end of the trail.
+    if (it == _trail.rend()) {
+      _slotPositions.push_back(nextPos);
+      continue;
+    }
+
+    const float segmentLength = nextDist - it->distance;
+    const float t = (segmentLength > 0.0f) ? (slotDist - it->distance) / segmentLength : 0.0f;
+    _slotPositions.push_back(it->position + t * (nextPos - it->position));
+  }
+}
+
+}  // namespace vigilante
@@ -0,0 +1,54 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_PARTY_FORMATION_H_
+#define VIGILANTE_PARTY_FORMATION_H_
+
+#include <deque>
+#include <optional>
+#include <vector>
+
+#include <box2d/box2d.h>
+
+namespace vigilante {
+
+class Character;
+class Party;
+
+// PartyFormation records the route walked by the party leader (its trail)
+// once per frame, and assigns each following member a slot at a fixed
+// distance behind the leader along that trail. Since the leader has already
+// walked the route, the members simply replay it instead of each running
+// their own path finding.
+class PartyFormation final {
+ public:
+  static inline constexpr float kLeaderSpacing = .6f;
+  static inline constexpr float kSlotSpacing = .45f;
+
+  void update(const Party& party);
+
+  // Discards the trail, e.g., after the leader has gone through a portal.
+  // Every slot collapses onto `leaderPos` until the leader moves again.
+  void reset(const b2Vec2& leaderPos);
+
+  // Returns std::nullopt if `member` doesn't have a slot.
+  std::optional<b2Vec2> getSlotPosition(const Character* member) const;
+  inline bool isLeaderFacingRight() const { return _isLeaderFacingRight; }
+
+ private:
+  struct Waypoint final {
+    b2Vec2 position;
+    float distance;  // accumulated distance along the trail
+  };
+
+  void updateSlots(const Party& party);
+  void updateTrail(const b2Vec2& leaderPos);
+  void updateSlotPositions(const b2Vec2& leaderPos);
+
+  std::deque<PartyFormation::Waypoint> _trail;
+  std::vector<const Character*> _slots;
+  std::vector<b2Vec2> _slotPositions;
+  bool _isLeaderFacingRight{true};
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_PARTY_FORMATION_H_
@@ -0,0 +1,83 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "Perception.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace vigilante {
+
+void Perception::sense(Character* target, const b2Vec2& position,
+                       const Perception::Sense sense, const float now) {
+  auto it = std::find_if(_memories.begin(), _memories.end(), [target](const Memory& m) {
+    return m.target == target;
+  });
+
+  if (it == _memories.end()) {
+    // Replace the oldest memory if we're running out of slots.
+    if (static_cast<int>(_memories.size()) >= kMaxMemories) {
+      it = std::min_element(_memories.begin(), _memories.end(), [](const Memory& a, const Memory& b) {
+        return a.lastSensedTime < b.lastSensedTime;
+      });
+      *it = Memory{target, position, now, -kMemoryDuration, sense};
+    } else {
+      _memories.push_back(Memory{target, position, now, -kMemoryDuration, sense});
+      it = std::prev(_memories.end());
+    }
+  }
+
+  it->lastKnownPosition = position;
+  it->lastSensedTime = now;
+  it->lastSense = sense;
+  if (sense == Perception::Sense::SIGHT) {
+    it->lastSeenTime = now;
+  }
+}
+
+void Perception::forget(const Character* target) {
+  std::erase_if(_memories, [target](const Memory& m) { return m.target == target; });
+}
+
+void Perception::forgetAll() {
+  _memories.clear();
+}
+
+bool Perception::remembers(const Character* target) const {
+  return std::any_of(_memories.begin(), _memories.end(), [target](const Memory& m) {
+    return m.target == target;
+  });
+}
+
+const Perception::Memory* Perception::getMemory(const Character* target, const float now) const {
+  for (const auto& memory : _memories) {
+    if (memory.target == target && getConfidence(memory, now) > 0.0f) {
+      return &memory;
+    }
+  }
+  return nullptr;
+}
+
+const Perception::Memory* Perception::getMostRelevantMemory(const float now) const {
+  const Memory* ret = nullptr;
+  float maxConfidence = 0.0f;
+
+  for (const auto& memory : _memories) {
+    // Targets which are currently visible always win.
+    const float confidence = getConfidence(memory, now) + (canSee(memory, now) ? 1.0f : 0.0f);
+    if (confidence > maxConfidence) {
+      maxConfidence = confidence;
+      ret = &memory;
+    }
+  }
+  return ret;
+}
+
+float Perception::getConfidence(const Perception::Memory& memory, const float now) const {
+  return std::max(0.0f, 1.0f - (now - memory.lastSensedTime) / kMemoryDuration);
+}
+
+bool Perception::canSee(const Perception::Memory& memory, const float now) const {
+  return now - memory.lastSeenTime <= kSightGraceDuration;
+}
+
+}  // namespace vigilante
@@ -0,0 +1,60 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_PERCEPTION_H_
+#define VIGILANTE_PERCEPTION_H_
+
+#include <vector>
+
+#include <box2d/box2d.h>
+
+namespace vigilante {
+
+class Character;
+
+// The per-Npc memory of perceived targets. Entries are written by
+// PerceptionSystem and read by NpcController. A memory fades out
+// gradually once its target is no longer sensed, so an Npc can
+// still walk to where it last saw or heard its target.
+class Perception final {
+ public:
+  enum class Sense {
+    SIGHT,
+    HEARING,
+    DAMAGE
+  };
+
+  struct Memory final {
+    Character* target;
+    b2Vec2 lastKnownPosition;
+    float lastSensedTime;
+    float lastSeenTime;
+    Perception::Sense lastSense;
+  };
+
+  static inline constexpr int kMaxMemories = 4;
+  static inline constexpr float kMemoryDuration = 8.0f;
+  static inline constexpr float kSightGraceDuration = .5f;
+
+  void sense(Character* target, const b2Vec2& position, const Perception::Sense sense, const float now);
+  void forget(const Character* target);
+  void forgetAll();
+
+  // Whether `target` has an entry, even if its confidence has dropped to zero.
+  bool remembers(const Character* target) const;
+  // Returns nullptr if `target` is not remembered (or has been forgotten).
+  const Perception::Memory* getMemory(const Character* target, const float now) const;
+  const Perception::Memory* getMostRelevantMemory(const float now) const;
+
+  float getConfidence(const Perception::Memory& memory, const float now) const;
+  bool canSee(const Perception::Memory& memory, const float now) const;
+
+  inline bool isEvaluationDue(const float now) const { return now >= _nextEvaluationTime; }
+  inline void setNextEvaluationTime(const float time) { _nextEvaluationTime = time; }
+
+ private:
+  std::vector<Perception::Memory> _memories;
+  float _nextEvaluationTime{};
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_PERCEPTION_H_
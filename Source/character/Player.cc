@@ -8,7 +8,9 @@
 #include "Audio.h"
 #include "CallbackManager.h"
 #include "Constants.h"
+#include "Localization.h"
 #include "character/Party.h"
+#include "gameplay/Statistics.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
 #include "skill/Skill.h"
@@ -17,7 +19,6 @@
 #include "quest/KillTargetObjective.h"
 #include "quest/InteractWithTargetObjective.h"
 #include "util/CameraUtil.h"
-#include "util/StringUtil.h"
 
 using namespace std;
 using namespace vigilante::category_bits;
@@ -46,7 +47,7 @@ bool Player::showOnMap(float x, float y) {
     return false;
   }
 
-  defineBody(b2BodyType::b2_dynamicBody, x, y,
+  defineBody(x, y,
              kPlayerBodyCategoryBits,
              kPlayerBodyMaskBits,
              kPlayerFeetMaskBits,
@@ -63,6 +64,16 @@ bool Player::showOnMap(float x, float y) {
   return true;
 }
 
+void Player::update(const float delta) {
+  Character::update(delta);
+  _interactionResolver.update();
+
+  if (_body) {
+    Statistics::the().recordFraction(Statistics::Event::DISTANCE_TRAVELLED,
+                                     _body->GetLinearVelocity().Length() * delta);
+  }
+}
+
 void Player::onKilled() {
   Character::onKilled();
 
@@ -77,7 +88,7 @@ bool Player::inflictDamage(Character* target, int damage) {
 
   if (target->isSetToKill()) {
     auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
-    notifications->show(string_util::format("Acquired %d exp", target->getCharacterProfile().exp));
+    notifications->show(tr(StringId::PLAYER_ACQUIRED_EXP, target->getCharacterProfile().exp));
 
     updateKillTargetObjectives(target);
   }
@@ -87,14 +98,13 @@ bool Player::inflictDamage(Character* target, int damage) {
 }
 
 bool Player::receiveDamage(Character* source, int damage) {
-  constexpr float kNumSecCantMove = 5.0f;
-  if (!Character::receiveDamage(source, damage, kNumSecCantMove)) {
+  if (!Character::receiveDamage(source, damage)) {
     VGLOG(LOG_ERR, "Failed to receive damage from source: [%p].", source);
     return false;
   }
 
   _isInvincible = true;
-  CallbackManager::the().runAfter([this](const CallbackManager::CallbackId){
+  runAfter([this](const CallbackManager::CallbackId){
     _isInvincible = false;
   }, 1.0f);
 
@@ -105,31 +115,44 @@ bool Player::receiveDamage(Character* source, int damage) {
   return true;
 }
 
+float Player::getStaggerDuration() const {
+  return 5.0f;
+}
+
 bool Player::addItem(shared_ptr<Item> item, int amount) {
   if (!Character::addItem(item, amount)) {
     VGLOG(LOG_ERR, "Failed to add item to player.");
     return false;
   }
 
+  if (_isBatchingItems) {
+    _batchedLoot.push_back({item->getItemProfile().lootCounterId, amount});
+    return true;
+  }
+
   auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
-  notifications->show((amount > 1) ?
-      string_util::format("Acquired item: %s (%d).", item->getName().c_str(), amount) :
-      string_util::format("Acquired item: %s.", item->getName().c_str()));
+  notifications->show(tr(amount > 1 ? StringId::PLAYER_ACQUIRED_ITEMS : StringId::PLAYER_ACQUIRED_ITEM, item->getName(), amount));
 
+  _questBook.update(Quest::Objective::Type::COLLECT);
   return true;
 }
 
 bool Player::removeItem(Item* item, int amount) {
+  // The item may be freed once removed.
+  const string itemName = item->getName();
   if (!Character::removeItem(item, amount)) {
     VGLOG(LOG_ERR, "Failed to remove item from player.");
     return false;
   }
 
+  if (_isBatchingItems) {
+    return true;
+  }
+
   auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
-  notifications->show((amount > 1) ?
-      string_util::format("Removed item: %s (%d).", item->getName().c_str(), amount) :
-      string_util::format("Removed item: %s.", item->getName().c_str()));
+  notifications->show(tr(amount > 1 ? StringId::PLAYER_REMOVED_ITEMS : StringId::PLAYER_REMOVED_ITEM, itemName, amount));
 
+  _questBook.update(Quest::Objective::Type::COLLECT);
   return true;
 }
 
@@ -148,8 +171,12 @@ void Player::unequip(Equipment::Type equipmentType, bool audio) {
 }
 
 void Player::pickupItem(Item* item) {
+  // The item may be merged into an existing copy and freed.
+  const Statistics::CounterId subjectId = item->getItemProfile().lootCounterId;
+  const int amount = item->getAmount();
+
   Character::pickupItem(item);
-  _questBook.update(Quest::Objective::Type::COLLECT);
+  Statistics::the().record(Statistics::Event::ITEM_LOOTED, amount, subjectId);
 }
 
 void Player::interact(Interactable* target) {
@@ -172,7 +199,7 @@ void Player::addExp(const int exp) {
 
   if (_characterProfile.level > originalLevel) {
     auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
-    notifications->show(string_util::format("Congrats! You are now level %d.", _characterProfile.level));
+    notifications->show(tr(StringId::PLAYER_LEVEL_UP, _characterProfile.level));
   }
 }
 
@@ -180,6 +207,26 @@ void Player::handleInput() {
   _playerController.handleInput();
 }
 
+void Player::beginItemBatch() {
+  _isBatchingItems = true;
+  _batchedLoot.clear();
+}
+
+void Player::endItemBatch(const bool commit) {
+  _isBatchingItems = false;
+  if (!commit) {
+    _batchedLoot.clear();
+    return;
+  }
+
+  Statistics& statistics = Statistics::the();
+  for (const auto& [subjectId, amount] : _batchedLoot) {
+    statistics.record(Statistics::Event::ITEM_LOOTED, amount, subjectId);
+  }
+  _batchedLoot.clear();
+  _questBook.update(Quest::Objective::Type::COLLECT);
+}
+
 void Player::updateKillTargetObjectives(Character* killedCharacter) {
   if (!killedCharacter->isSetToKill()) {
     return;
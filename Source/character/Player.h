@@ -4,13 +4,17 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <box2d/box2d.h>
 
 #include "Assets.h"
 #include "Controllable.h"
 #include "character/Character.h"
+#include "character/InteractionResolver.h"
 #include "character/PlayerController.h"
+#include "gameplay/Statistics.h"
 #include "item/Equipment.h"
 #include "quest/QuestBook.h"
 
@@ -22,6 +26,7 @@ class Player : public Character, public Controllable {
   virtual ~Player() override = default;
 
   virtual bool showOnMap(float x, float y) override;  // Character
+  virtual void update(const float delta) override;  // Character
   virtual void onKilled() override;  // Character
 
   virtual bool inflictDamage(Character* target, int damage) override;  // Character
@@ -39,11 +44,24 @@ class Player : public Character, public Controllable {
 
   void updateKillTargetObjectives(Character* killedCharacter);
 
+  // Between beginItemBatch() and endItemBatch(), addItem() and removeItem()
+  // neither show notifications nor update the quests. If the batch is committed,
+  // the items added are recorded as looted and the quests are updated once.
+  void beginItemBatch();
+  void endItemBatch(const bool commit);
+
   inline QuestBook& getQuestBook() { return _questBook; }
+  inline InteractionResolver& getInteractionResolver() { return _interactionResolver; }
 
  private:
+  virtual float getStaggerDuration() const override;  // Character
+
   PlayerController _playerController;
+  InteractionResolver _interactionResolver{*this};
   QuestBook _questBook{assets::kQuestsList};
+
+  bool _isBatchingItems{};
+  std::vector<std::pair<Statistics::CounterId, int>> _batchedLoot;
 };
 
 }  // namespace vigilante
@@ -1,10 +1,12 @@
 // Copyright (c) 2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
 #include "PlayerController.h"
 
+#include <utility>
+
 #include "character/Player.h"
 #include "combat/CombatMotion.h"
 #include "combat/ComboSystem.h"
-#include "input/InputManager.h"
+#include "input/ActionMapper.h"
 #include "scene/SceneManager.h"
 #include "util/Logger.h"
 
@@ -13,78 +15,69 @@ USING_NS_AX;
 
 namespace vigilante {
 
-namespace {
-
-constexpr auto kMoveLeftKey = EventKeyboard::KeyCode::KEY_LEFT_ARROW;
-constexpr auto kMoveRightKey = EventKeyboard::KeyCode::KEY_RIGHT_ARROW;
-constexpr auto kCrouchKey = EventKeyboard::KeyCode::KEY_DOWN_ARROW;
-constexpr auto kJumpKey = EventKeyboard::KeyCode::KEY_LEFT_ALT;
-constexpr auto kSheatheUnsheatheWeaponKey = EventKeyboard::KeyCode::KEY_R;
-constexpr auto kDodgeKey = EventKeyboard::KeyCode::KEY_X;
-constexpr auto kAttackKey = EventKeyboard::KeyCode::KEY_LEFT_CTRL;
-constexpr auto kBlockKey = EventKeyboard::KeyCode::KEY_Q;
-constexpr auto kInteractKey = EventKeyboard::KeyCode::KEY_E;
-constexpr auto kPickupItemKey = EventKeyboard::KeyCode::KEY_Z;
-constexpr auto kUsePortalKey = EventKeyboard::KeyCode::KEY_F;
-
-}  // namespace
-
 void PlayerController::handleInput() {
   if (shouldIgnoreInput()) {
+    // An attack pressed meanwhile stays unconsumed in ActionMapper until the current
+    // one is over, and an attack held until then chains the next one in the combo.
+    _isAttackHeld = _player.isAttacking() && IS_ACTION_PRESSED(ActionMapper::Action::ATTACK);
     return;
   }
+  const bool wasAttackHeld = std::exchange(_isAttackHeld, false);
 
-  if (_player.getInRangeInteractables().size() && IS_KEY_JUST_PRESSED(kInteractKey)) {
-    _player.interact(*(_player.getInRangeInteractables().begin()));
+  Interactable* focusedTarget = _player.getInteractionResolver().getFocusedTarget();
+  if (focusedTarget && IS_ACTION_JUST_PRESSED(ActionMapper::Action::INTERACT)) {
+    _player.interact(focusedTarget);
     return;
   }
 
-  if (_player.getPortal() && IS_KEY_JUST_PRESSED(kUsePortalKey)) {
+  if (_player.getPortal() && IS_ACTION_JUST_PRESSED(ActionMapper::Action::USE_PORTAL)) {
     _player.interact(_player.getPortal());
     return;
   }
 
-  if (_player.getInRangeItems().size() && IS_KEY_JUST_PRESSED(kPickupItemKey)) {
+  if (_player.getInRangeItems().size() && IS_ACTION_JUST_PRESSED(ActionMapper::Action::PICKUP_ITEM)) {
     _player.pickupItem(*(_player.getInRangeItems().begin()));
   }
 
-  if (IS_KEY_PRESSED(kCrouchKey)) {
+  if (IS_ACTION_PRESSED(ActionMapper::Action::CROUCH)) {
     _player.crouch();
   } else if (_player.isCrouching()) {
     _player.getUpFromCrouching();
   }
 
-  if (IS_KEY_PRESSED(kMoveLeftKey)) {
+  if (IS_ACTION_PRESSED(ActionMapper::Action::MOVE_LEFT)) {
     _player.moveLeft();
-  } else if (IS_KEY_PRESSED(kMoveRightKey)) {
+  } else if (IS_ACTION_PRESSED(ActionMapper::Action::MOVE_RIGHT)) {
     _player.moveRight();
   }
 
-  if (IS_KEY_JUST_PRESSED(kDodgeKey)) {
-    if (IS_KEY_PRESSED(kMoveLeftKey) || IS_KEY_PRESSED(kMoveRightKey)) {
+  if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::DODGE)) {
+    if (IS_ACTION_PRESSED(ActionMapper::Action::MOVE_LEFT) ||
+        IS_ACTION_PRESSED(ActionMapper::Action::MOVE_RIGHT)) {
       _player.dodgeForward();
     } else {
       _player.dodgeBackward();
     }
   }
 
-  if (IS_KEY_JUST_PRESSED(kJumpKey)) {
+  if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::JUMP)) {
     _player.isCrouching() ? _player.jumpDown() : _player.jump();
   }
 
-  if (IS_KEY_PRESSED(kBlockKey)) {
+  if (IS_ACTION_PRESSED(ActionMapper::Action::BLOCK)) {
     _player.setBlocking(true);
   } else if (_player.isBlocking()) {
     _player.setBlocking(false);
   }
 
-  if (IS_KEY_JUST_PRESSED(kAttackKey)) {
+  if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::ATTACK) ||
+      (wasAttackHeld && IS_ACTION_PRESSED(ActionMapper::Action::ATTACK))) {
     handleAttackInput();
     return;
   }
 
   /*
-  if (IS_KEY_JUST_PRESSED(kSheatheUnsheatheWeaponKey)) {
+  if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_R)) {
     handleSheatheUnsheatheWeaponInput();
   }
   */
@@ -118,14 +111,16 @@ void PlayerController::handleAttackInput() {
 
 void PlayerController::handleHotkeyInput() {
   auto hotkeyMgr = SceneManager::the().getCurrentScene<GameScene>()->getHotkeyManager();
-  for (auto keyCode : HotkeyManager::kBindableKeys) {
-    Keybindable* action = hotkeyMgr->getHotkeyAction(keyCode);
-    if (IS_KEY_JUST_PRESSED(keyCode) && action) {
-      if (dynamic_cast<Skill*>(action)) {
-        _player.activateSkill(dynamic_cast<Skill*>(action));
-      } else if (dynamic_cast<Consumable*>(action)) {
-        _player.useItem(dynamic_cast<Consumable*>(action));
-      }
+  for (size_t i = 0; i < ActionMapper::kHotkeyActions.size(); i++) {
+    if (!IS_ACTION_JUST_PRESSED(ActionMapper::kHotkeyActions[i])) {
+      continue;
+    }
+
+    Keybindable* keybindable = hotkeyMgr->getHotkeyAction(HotkeyManager::kBindableKeys[i]);
+    if (dynamic_cast<Skill*>(keybindable)) {
+      _player.activateSkill(dynamic_cast<Skill*>(keybindable));
+    } else if (dynamic_cast<Consumable*>(keybindable)) {
+      _player.useItem(dynamic_cast<Consumable*>(keybindable));
     }
   }
 }
@@ -22,6 +22,7 @@ class PlayerController final : public Controllable {
   void handleHotkeyInput();
 
   Player& _player;
+  bool _isAttackHeld{};
 };
 
 }  // namespace vigilante
@@ -0,0 +1,150 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "StatModifierStack.h"
+
+#include <algorithm>
+
+#include "character/Character.h"
+
+using namespace std;
+
+namespace vigilante {
+
+namespace {
+
+constexpr float kBaseHealthRegen = 1.0f;
+constexpr float kBaseMagickaRegen = 1.0f;
+constexpr float kBaseStaminaRegen = 1.0f;
+
+}  // namespace
+
+StatModifierStack::~StatModifierStack() {
+  EffectScheduler::the().cancelAll(this);
+}
+
+void StatModifierStack::onEffectExpired(const EffectScheduler::EffectId id) {
+  auto it = std::find_if(_entries.begin(), _entries.end(), [id](const Entry& e) {
+    return e.effectId == id;
+  });
+  if (it != _entries.end()) {
+    _entries.erase(it);
+    _isDirty = true;
+  }
+}
+
+void StatModifierStack::add(const StatModifierStack::Modifier& modifier) {
+  auto it = std::find_if(_entries.begin(), _entries.end(), [&modifier](const Entry& e) {
+    return e.modifier.source == modifier.source && e.modifier.stat == modifier.stat;
+  });
+
+  if (it != _entries.end()) {
+    switch (modifier.stacking) {
+      case Stacking::REFRESH:
+        if (it->effectId) {
+          EffectScheduler::the().reschedule(it->effectId, modifier.duration);
+        }
+        return;
+      case Stacking::REPLACE:
+        erase(it);
+        break;
+      case Stacking::STACK:
+      default:
+        break;
+    }
+  }
+
+  const EffectScheduler::EffectId effectId =
+      (modifier.duration > 0) ? EffectScheduler::the().schedule(this, modifier.duration) : 0;
+  _entries.push_back({modifier, effectId});
+  _isDirty = true;
+}
+
+void StatModifierStack::removeBySource(const string& source) {
+  for (auto it = _entries.begin(); it != _entries.end();) {
+    if (it->modifier.source == source) {
+      if (it->effectId) {
+        EffectScheduler::the().cancel(it->effectId);
+      }
+      it = _entries.erase(it);
+      _isDirty = true;
+    } else {
+      ++it;
+    }
+  }
+}
+
+void StatModifierStack::clear() {
+  EffectScheduler::the().cancelAll(this);
+  _entries.clear();
+  _isDirty = true;
+}
+
+float StatModifierStack::get(const StatModifierStack::Stat stat) const {
+  if (_isDirty) {
+    recompute();
+  }
+  return _cachedValues[static_cast<size_t>(stat)];
+}
+
+float StatModifierStack::getBaseValue(const StatModifierStack::Stat stat) const {
+  const Character::Profile& profile = _owner.getCharacterProfile();
+
+  switch (stat) {
+    case Stat::STRENGTH:
+      return profile.strength;
+    case Stat::DEXTERITY:
+      return profile.dexterity;
+    case Stat::INTELLIGENCE:
+      return profile.intelligence;
+    case Stat::LUCK:
+      return profile.luck;
+    case Stat::MOVE_SPEED:
+      return profile.moveSpeed;
+    case Stat::JUMP_HEIGHT:
+      return profile.jumpHeight;
+    case Stat::PHYSICAL_DAMAGE:
+      return profile.baseMeleeDamage;
+    case Stat::HEALTH_REGEN:
+      return kBaseHealthRegen;
+    case Stat::MAGICKA_REGEN:
+      return kBaseMagickaRegen;
+    case Stat::STAMINA_REGEN:
+      return kBaseStaminaRegen;
+    case Stat::MAGICAL_DAMAGE:
+    case Stat::COOLDOWN_REDUCTION:
+    default:
+      return 0.0f;
+  }
+}
+
+void StatModifierStack::recompute() const {
+  // All additive modifiers are applied before the multiplicative ones,
+  // so the result doesn't depend on the order they were added in.
+  array<float, kNumStats> additions{};
+  array<float, kNumStats> multipliers;
+  multipliers.fill(1.0f);
+
+  for (const auto& entry : _entries) {
+    const size_t i = static_cast<size_t>(entry.modifier.stat);
+    if (entry.modifier.op == Op::ADD) {
+      additions[i] += entry.modifier.value;
+    } else {
+      multipliers[i] *= entry.modifier.value;
+    }
+  }
+
+  for (size_t i = 0; i < kNumStats; i++) {
+    const float value = (getBaseValue(static_cast<Stat>(i)) + additions[i]) * multipliers[i];
+    _cachedValues[i] = std::max(0.0f, value);
+  }
+  _isDirty = false;
+}
+
+void StatModifierStack::erase(vector<StatModifierStack::Entry>::iterator it) {
+  if (it->effectId) {
+    EffectScheduler::the().cancel(it->effectId);
+  }
+  _entries.erase(it);
+  _isDirty = true;
+}
+
+}  // namespace vigilante
@@ -0,0 +1,94 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_STAT_MODIFIER_STACK_H_
+#define VIGILANTE_STAT_MODIFIER_STACK_H_
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "gameplay/EffectScheduler.h"
+
+namespace vigilante {
+
+class Character;
+
+// The derived attributes of a Character, i.e., the base values from its
+// Character::Profile with all active modifiers (equipment bonuses, buffs,
+// debuffs, ...) applied. The derived values are cached and only recomputed
+// after the modifiers or the base values have changed.
+class StatModifierStack final : public EffectScheduler::Listener {
+ public:
+  enum class Stat {
+    STRENGTH,
+    DEXTERITY,
+    INTELLIGENCE,
+    LUCK,
+    MOVE_SPEED,
+    JUMP_HEIGHT,
+    PHYSICAL_DAMAGE,
+    MAGICAL_DAMAGE,
+    HEALTH_REGEN,  // per second
+    MAGICKA_REGEN,  // per second
+    STAMINA_REGEN,  // per second
+    COOLDOWN_REDUCTION,  // fraction of a skill's cooldown
+    SIZE
+  };
+
+  enum class Op {
+    ADD,
+    MULTIPLY
+  };
+
+  // What happens if a modifier with the same source and stat is already active.
+  enum class Stacking {
+    STACK,  // both are kept
+    REFRESH,  // the existing one gets its duration reset
+    REPLACE  // the existing one is removed
+  };
+
+  struct Modifier final {
+    std::string source;
+    StatModifierStack::Stat stat;
+    StatModifierStack::Op op;
+    float value;
+    float duration;  // 0 means it never expires
+    StatModifierStack::Stacking stacking;
+  };
+
+  explicit StatModifierStack(Character& owner) : _owner{owner} {}
+  virtual ~StatModifierStack() override;
+
+  virtual void onEffectExpired(const EffectScheduler::EffectId id) override;  // EffectScheduler::Listener
+
+  void add(const StatModifierStack::Modifier& modifier);
+  void removeBySource(const std::string& source);
+  void clear();
+
+  float get(const StatModifierStack::Stat stat) const;
+  inline int getInt(const StatModifierStack::Stat stat) const { return static_cast<int>(get(stat)); }
+
+  // Must be called whenever the base values in Character::Profile have changed.
+  inline void markDirty() { _isDirty = true; }
+
+ private:
+  struct Entry final {
+    StatModifierStack::Modifier modifier;
+    EffectScheduler::EffectId effectId;  // 0 if it never expires
+  };
+
+  static inline constexpr size_t kNumStats = static_cast<size_t>(Stat::SIZE);
+
+  float getBaseValue(const StatModifierStack::Stat stat) const;
+  void recompute() const;
+  void erase(std::vector<StatModifierStack::Entry>::iterator it);
+
+  Character& _owner;
+  std::vector<StatModifierStack::Entry> _entries;
+
+  mutable std::array<float, kNumStats> _cachedValues{};
+  mutable bool _isDirty{true};
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_STAT_MODIFIER_STACK_H_
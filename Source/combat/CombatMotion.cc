@@ -2,6 +2,7 @@
 #include "CombatMotion.h"
 
 #include "character/Character.h"
+#include "combat/ImpulseQueue.h"
 #include "util/Logger.h"
 
 using namespace std;
@@ -14,14 +15,10 @@ namespace {
 bool handleAttackingUpward(Character& c) {
   c.attack(Character::State::ATTACKING_UPWARD, /*numTimesInflictDamage=*/2);
 
+  // The targets are launched by the hit impact of the attack (see Character::getHitImpact()).
   const float forceX = c.isFacingRight() ? .3f : -.3f;
   const float forceY = 3.0f;
-  c.getBody()->ApplyLinearImpulse({forceX, forceY}, c.getBody()->GetWorldCenter(), true);
-
-  if (c.getInRangeTargets().size()) {
-    Character* target = *(c.getInRangeTargets().begin());
-    target->getBody()->ApplyLinearImpulse({forceX, forceY}, target->getBody()->GetWorldCenter(), true);
-  }
+  ImpulseQueue::the().push(&c, {forceX, forceY});
 
   return true;
 }
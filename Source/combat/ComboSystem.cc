@@ -1,10 +1,8 @@
 // Copyright (c) 2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
 #include "ComboSystem.h"
 
-#include <algorithm>
-
 #include "character/Character.h"
-#include "input/InputManager.h"
+#include "input/ActionMapper.h"
 #include "scene/SceneManager.h"
 #include "util/Logger.h"
 
@@ -29,11 +27,11 @@ ComboSystem::ComboSystem(Character& c) : _character{c} {
 
   _fsm.defineStateTransition(v0, v1, {});
   _fsm.defineStateTransition(v1, v2, {});
-  _fsm.defineStateTransition(v2, v4, {EventKeyboard::KeyCode::KEY_UP_ARROW});
-  _fsm.defineStateTransition(v2, v3, {EventKeyboard::KeyCode::KEY_LEFT_ARROW});
-  _fsm.defineStateTransition(v2, v3, {EventKeyboard::KeyCode::KEY_RIGHT_ARROW});
-  _fsm.defineStateTransition(v4, v5, {EventKeyboard::KeyCode::KEY_LEFT_ARROW});
-  _fsm.defineStateTransition(v4, v5, {EventKeyboard::KeyCode::KEY_RIGHT_ARROW});
+  _fsm.defineStateTransition(v2, v4, ActionMapper::toMask(ActionMapper::Action::AIM_UP));
+  _fsm.defineStateTransition(v2, v3, ActionMapper::toMask(ActionMapper::Action::MOVE_LEFT));
+  _fsm.defineStateTransition(v2, v3, ActionMapper::toMask(ActionMapper::Action::MOVE_RIGHT));
+  _fsm.defineStateTransition(v4, v5, ActionMapper::toMask(ActionMapper::Action::MOVE_LEFT));
+  _fsm.defineStateTransition(v4, v5, ActionMapper::toMask(ActionMapper::Action::MOVE_RIGHT));
 }
 
 optional<Character::State> ComboSystem::determineNextAttackState() {
@@ -48,11 +46,9 @@ optional<Character::State> ComboSystem::determineNextAttackState() {
     return std::nullopt;
   }
 
-  auto isKeyPressed = [](const EventKeyboard::KeyCode keyCode) -> bool {
-    return IS_KEY_PRESSED(keyCode);
-  };
-  for (const auto &[nextStateId, keyCodes] : reqs) {
-    if (std::all_of(keyCodes.begin(), keyCodes.end(), isKeyPressed)) {
+  const ActionMask pressedActions = ActionMapper::the().getPressedActions();
+  for (const auto &[nextStateId, requiredActions] : reqs) {
+    if ((pressedActions & requiredActions) == requiredActions) {
       _fsm.setCurrentStateId(nextStateId);
       _fsm.setTimer(kComboResetTimer);
       return _fsm.getState(nextStateId);
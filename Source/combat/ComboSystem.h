@@ -3,6 +3,7 @@
 #define VIGILANTE_COMBO_SYSTEM_H_
 
 #include "character/Character.h"
+#include "input/ActionMapper.h"
 #include "util/ds/Digraph.h"
 
 namespace vigilante {
@@ -65,7 +66,8 @@ class TimedFiniteStateMachine final {
 };
 
 class ComboSystem final {
-  using StateTransitionRequirement = std::list<ax::EventKeyboard::KeyCode>;
+  // All of the actions in this mask must be pressed to take the transition.
+  using StateTransitionRequirement = ActionMask;
 
  public:
   explicit ComboSystem(Character& c);
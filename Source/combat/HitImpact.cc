@@ -0,0 +1,55 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "HitImpact.h"
+
+#include "util/Logger.h"
+
+using namespace std;
+
+namespace vigilante {
+
+HitImpact HitImpact::load(const rapidjson::Value& json) {
+  HitImpact hitImpact;
+  if (json.HasMember("stagger")) {
+    hitImpact.stagger = json["stagger"].GetFloat();
+  }
+  if (json.HasMember("knockBack")) {
+    const auto& knockBackJson = json["knockBack"];
+    if (knockBackJson.IsArray() && knockBackJson.Size() == 2) {
+      hitImpact.knockBack = {knockBackJson[0].GetFloat(), knockBackJson[1].GetFloat()};
+    } else {
+      VGLOG(LOG_ERR, "Invalid knockBack of a hit impact, expected [x, y].");
+    }
+  }
+  if (json.HasMember("launch")) {
+    hitImpact.launches = json["launch"].GetBool();
+  }
+  return hitImpact;
+}
+
+void HitImpactProfile::load(const rapidjson::Value& json) {
+  _defaultHitImpact.reset();
+  _hitImpacts.clear();
+
+  if (!json.HasMember("hitImpacts")) {
+    return;
+  }
+
+  for (const auto& hitImpactJson : json["hitImpacts"].GetObject()) {
+    const string framesName = hitImpactJson.name.GetString();
+    if (framesName == "default") {
+      _defaultHitImpact = HitImpact::load(hitImpactJson.value);
+    } else {
+      _hitImpacts[framesName] = HitImpact::load(hitImpactJson.value);
+    }
+  }
+}
+
+const HitImpact* HitImpactProfile::getHitImpact(const string& framesName) const {
+  auto it = _hitImpacts.find(framesName);
+  if (it != _hitImpacts.end()) {
+    return &it->second;
+  }
+  return _defaultHitImpact ? &*_defaultHitImpact : nullptr;
+}
+
+}  // namespace vigilante
@@ -0,0 +1,54 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_HIT_IMPACT_H_
+#define VIGILANTE_HIT_IMPACT_H_
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <box2d/box2d.h>
+#include <rapidjson/document.h>
+
+namespace vigilante {
+
+// How hard a hit is, apart from its damage.
+//
+//   {"stagger": 25, "knockBack": [0.3, 3.0], "launch": true}
+//
+// The stagger is dealt to the target's poise (see HitReaction), and the
+// knockback is an impulse whose x points away from the attacker, which is
+// only applied if the hit staggers the target. A launching hit sends a
+// staggered target into the air, where it can be juggled until it lands.
+struct HitImpact final {
+  static inline constexpr float kDefaultStagger = 10.0f;
+
+  static HitImpact load(const rapidjson::Value& json);
+
+  float stagger{kDefaultStagger};
+  b2Vec2 knockBack{0.0f, 0.0f};
+  bool launches{};
+};
+
+// The hit impacts of each attack animation of a character or a weapon,
+// keyed by its frames name, with "default" for the rest of them.
+//
+//   "hitImpacts": {
+//     "default": {"stagger": 10, "knockBack": [1.5, 1.5]},
+//     "attacking_upward": {"stagger": 25, "knockBack": [0.3, 3.0], "launch": true}
+//   }
+class HitImpactProfile final {
+ public:
+  void load(const rapidjson::Value& json);
+
+  // Returns nullptr if neither `framesName` nor "default" is defined.
+  const HitImpact* getHitImpact(const std::string& framesName) const;
+  inline bool hasHitImpacts() const { return _defaultHitImpact.has_value() || !_hitImpacts.empty(); }
+
+ private:
+  std::optional<HitImpact> _defaultHitImpact;
+  std::unordered_map<std::string, HitImpact> _hitImpacts;
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_HIT_IMPACT_H_
@@ -0,0 +1,80 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "HitReaction.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "character/Character.h"
+
+using namespace std;
+
+namespace vigilante {
+
+void HitReaction::update(const float delta) {
+  if (_isLaunched) {
+    _launchTimer -= delta;
+    if (_launchTimer <= 0) {
+      onLanded();
+    }
+  }
+
+  if (_poiseRegenDelayTimer > 0) {
+    _poiseRegenDelayTimer -= delta;
+    return;
+  }
+
+  _poise = std::min(_poise + _owner.getCharacterProfile().poiseRegen * delta, getFullPoise());
+}
+
+HitReaction::Result HitReaction::resolve(const HitImpact& hitImpact, const bool hasHyperArmor) {
+  _poiseRegenDelayTimer = _kPoiseRegenDelay;
+
+  if (_isLaunched) {
+    if (_juggleCount >= kMaxJuggleHits) {
+      return Result::ABSORBED;
+    }
+    _juggleCount++;
+    _launchTimer = kLaunchTimeout;
+    return Result::JUGGLED;
+  }
+
+  if (hasHyperArmor) {
+    return Result::ABSORBED;
+  }
+
+  _poise -= hitImpact.stagger;
+  if (_poise > 0) {
+    return Result::ABSORBED;
+  }
+
+  _poise = getFullPoise();
+  if (hitImpact.launches) {
+    _isLaunched = true;
+    _launchTimer = kLaunchTimeout;
+    _juggleCount = 0;
+    return Result::LAUNCHED;
+  }
+  return Result::STAGGERED;
+}
+
+void HitReaction::onLanded() {
+  _isLaunched = false;
+  _launchTimer = 0;
+  _juggleCount = 0;
+}
+
+void HitReaction::reset() {
+  _poise = getFullPoise();
+  _poiseRegenDelayTimer = 0;
+  onLanded();
+}
+
+float HitReaction::getJuggleKnockBackScale() const {
+  return std::pow(_kJuggleKnockBackDecay, static_cast<float>(_juggleCount));
+}
+
+float HitReaction::getFullPoise() const {
+  return _owner.getCharacterProfile().poise;
+}
+
+}  // namespace vigilante
@@ -0,0 +1,68 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_HIT_REACTION_H_
+#define VIGILANTE_HIT_REACTION_H_
+
+#include "combat/HitImpact.h"
+
+namespace vigilante {
+
+class Character;
+
+// The hit reactions of a Character, driven by its poise.
+//
+// Every hit deals its stagger to the poise, and only a hit which breaks
+// the poise staggers the character and knocks it back, after which the
+// poise is restored in full. Hence a crowd of weak hits can't stun-lock
+// anyone, while a heavy weapon staggers in one or two hits. The poise
+// regenerates after a while without being hit, and the hits landed during
+// the hyper armor frames of an attack (see HitboxProfile) are absorbed.
+//
+// A launching hit which breaks the poise sends the character airborne,
+// where every hit juggles it with a decaying knockback, until it lands
+// or has been juggled kMaxJuggleHits times, after which it drops. If it
+// hasn't landed kLaunchTimeout seconds after the last of these hits
+// (e.g., it was too heavy to be lifted at all), it recovers anyway.
+class HitReaction final {
+ public:
+  static inline constexpr float kDefaultPoise = 25.0f;
+  static inline constexpr float kDefaultPoiseRegen = 15.0f;  // per second
+  static inline constexpr int kMaxJuggleHits = 4;
+  static inline constexpr float kLaunchTimeout = 2.0f;
+
+  enum class Result {
+    ABSORBED,  // no stagger, no knockback
+    STAGGERED,
+    LAUNCHED,
+    JUGGLED,
+  };
+
+  explicit HitReaction(Character& owner) : _owner{owner} {}
+
+  void update(const float delta);
+  HitReaction::Result resolve(const HitImpact& hitImpact, const bool hasHyperArmor);
+  void onLanded();
+  void reset();
+
+  // The knockback of the next juggling hit is scaled by this.
+  float getJuggleKnockBackScale() const;
+
+  inline float getPoise() const { return _poise; }
+  inline bool isLaunched() const { return _isLaunched; }
+
+ private:
+  static inline constexpr float _kPoiseRegenDelay = 1.5f;
+  static inline constexpr float _kJuggleKnockBackDecay = .75f;
+
+  float getFullPoise() const;
+
+  Character& _owner;
+  float _poise{kDefaultPoise};
+  float _poiseRegenDelayTimer{};
+  bool _isLaunched{};
+  float _launchTimer{};
+  int _juggleCount{};
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_HIT_REACTION_H_
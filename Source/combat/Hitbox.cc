@@ -0,0 +1,101 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "Hitbox.h"
+
+#include <algorithm>
+
+#include "Constants.h"
+#include "util/Logger.h"
+
+using namespace std;
+
+namespace vigilante {
+
+b2AABB Hitbox::toAABB(const b2Vec2& bodyPos, const bool isFacingRight) const {
+  const b2Vec2 center{bodyPos.x + (isFacingRight ? x : -x) / kPpm, bodyPos.y + y / kPpm};
+  const b2Vec2 halfExtents{width / 2 / kPpm, height / 2 / kPpm};
+
+  b2AABB aabb;
+  aabb.lowerBound = center - halfExtents;
+  aabb.upperBound = center + halfExtents;
+  return aabb;
+}
+
+void HitboxProfile::load(const rapidjson::Value& json) {
+  _hitboxes.clear();
+  _hurtboxes.clear();
+  _hyperArmorFrames.clear();
+
+  if (json.HasMember("hitboxes")) {
+    loadBoxes(json["hitboxes"], _hitboxes);
+  }
+  if (json.HasMember("hurtboxes")) {
+    loadBoxes(json["hurtboxes"], _hurtboxes);
+  }
+  if (json.HasMember("hyperArmor")) {
+    for (const auto& animationJson : json["hyperArmor"].GetObject()) {
+      auto& windows = _hyperArmorFrames[animationJson.name.GetString()];
+      for (const auto& framesJson : animationJson.value.GetArray()) {
+        if (!framesJson.IsArray() || framesJson.Size() != 2) {
+          VGLOG(LOG_ERR, "Invalid hyper armor frames in [%s], expected [first, last].",
+                animationJson.name.GetString());
+          continue;
+        }
+        windows.emplace_back(framesJson[0].GetInt(), framesJson[1].GetInt());
+      }
+    }
+  }
+}
+
+const vector<Hitbox>* HitboxProfile::getHitboxes(const string& framesName) const {
+  auto it = _hitboxes.find(framesName);
+  return it != _hitboxes.end() ? &it->second : nullptr;
+}
+
+const vector<Hitbox>* HitboxProfile::getHurtboxes(const string& framesName) const {
+  auto it = _hurtboxes.find(framesName);
+  return it != _hurtboxes.end() ? &it->second : nullptr;
+}
+
+bool HitboxProfile::hasHyperArmor(const string& framesName, const int frameIdx) const {
+  auto it = _hyperArmorFrames.find(framesName);
+  if (it == _hyperArmorFrames.end()) {
+    return false;
+  }
+  return std::any_of(it->second.begin(), it->second.end(), [frameIdx](const pair<int, int>& window) {
+    return frameIdx >= window.first && frameIdx <= window.second;
+  });
+}
+
+void HitboxProfile::loadBoxes(const rapidjson::Value& json, HitboxMap& boxes) {
+  for (const auto& animationJson : json.GetObject()) {
+    const string framesName = animationJson.name.GetString();
+    vector<Hitbox>& animationBoxes = boxes[framesName];
+
+    for (const auto& boxJson : animationJson.value.GetArray()) {
+      const auto& framesJson = boxJson["frames"];
+      if (!framesJson.IsArray() || framesJson.Size() != 2) {
+        VGLOG(LOG_ERR, "Invalid frames of a box in [%s], expected [first, last].", framesName.c_str());
+        continue;
+      }
+
+      const float width = boxJson["width"].GetFloat();
+      const float height = boxJson["height"].GetFloat();
+      if (width <= 0 || height <= 0) {
+        VGLOG(LOG_ERR, "Invalid size of a box in [%s].", framesName.c_str());
+        continue;
+      }
+
+      animationBoxes.push_back({
+        framesJson[0].GetInt(),
+        framesJson[1].GetInt(),
+        boxJson["x"].GetFloat(),
+        boxJson["y"].GetFloat(),
+        width,
+        height,
+        boxJson.HasMember("hitGroup") ? boxJson["hitGroup"].GetInt() : 0
+      });
+    }
+  }
+}
+
+}  // namespace vigilante
@@ -0,0 +1,73 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_HITBOX_H_
+#define VIGILANTE_HITBOX_H_
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <box2d/box2d.h>
+#include <rapidjson/document.h>
+
+namespace vigilante {
+
+// A box relative to the center of a character's body, which is only
+// active on the frames [firstFrame, lastFrame] of an animation.
+// x is mirrored when the character is facing left.
+struct Hitbox final {
+  int firstFrame;
+  int lastFrame;
+  float x;  // pixels
+  float y;  // pixels
+  float width;  // pixels
+  float height;  // pixels
+  // The boxes of the same hit group (e.g., a blade sweeping across several
+  // frames) can only hit the same target once per swing.
+  int hitGroup;
+
+  inline bool isActiveOn(const int frameIdx) const {
+    return frameIdx >= firstFrame && frameIdx <= lastFrame;
+  }
+
+  b2AABB toAABB(const b2Vec2& bodyPos, const bool isFacingRight) const;
+};
+
+// The hitboxes and hurtboxes of each animation, keyed by its frames name
+// (e.g., "attacking0", "attacking_forward", "dodging_backward").
+//
+//   "hitboxes": {
+//     "attacking0": [{"frames": [2, 3], "x": 14, "y": 2, "width": 22, "height": 12}]
+//   },
+//   "hurtboxes": {
+//     "dodging_backward": []
+//   },
+//   "hyperArmor": {
+//     "attacking_forward": [[1, 4]]
+//   }
+//
+// An animation with hurtboxes can only be hit through them, so an empty
+// list (or frames without any active box) grants invulnerability frames.
+// Without hurtboxes, the body fixture is used. During the hyper armor
+// frames, hits still deal damage but never stagger (see HitReaction).
+class HitboxProfile final {
+ public:
+  void load(const rapidjson::Value& json);
+
+  const std::vector<Hitbox>* getHitboxes(const std::string& framesName) const;
+  const std::vector<Hitbox>* getHurtboxes(const std::string& framesName) const;
+  bool hasHyperArmor(const std::string& framesName, const int frameIdx) const;
+
+ private:
+  using HitboxMap = std::unordered_map<std::string, std::vector<Hitbox>>;
+
+  static void loadBoxes(const rapidjson::Value& json, HitboxMap& boxes);
+
+  HitboxMap _hitboxes;
+  HitboxMap _hurtboxes;
+  std::unordered_map<std::string, std::vector<std::pair<int, int>>> _hyperArmorFrames;  // [first, last]
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_HITBOX_H_
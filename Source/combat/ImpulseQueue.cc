@@ -0,0 +1,47 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "ImpulseQueue.h"
+
+#include <algorithm>
+
+#include "DynamicActor.h"
+
+using namespace std;
+
+namespace vigilante {
+
+ImpulseQueue& ImpulseQueue::the() {
+  static ImpulseQueue instance;
+  return instance;
+}
+
+void ImpulseQueue::push(DynamicActor* actor, const b2Vec2& impulse) {
+  // Only a handful of actors are hit in the same step,
+  // so a linear search beats hashing here.
+  auto it = std::find_if(_entries.begin(), _entries.end(), [actor](const Entry& entry) {
+    return entry.actor == actor;
+  });
+  if (it != _entries.end()) {
+    it->impulse += impulse;
+    return;
+  }
+
+  _entries.push_back({actor, impulse});
+}
+
+void ImpulseQueue::flush() {
+  for (const auto& [actor, impulse] : _entries) {
+    // The body may have been destroyed since, e.g., upon removing the actor from the map.
+    if (b2Body* body = actor->getBody()) {
+      body->ApplyLinearImpulse(impulse, body->GetWorldCenter(), true);
+    }
+  }
+  _entries.clear();
+}
+
+void ImpulseQueue::forget(const DynamicActor* actor) {
+  std::erase_if(_entries, [actor](const Entry& entry) {
+    return entry.actor == actor;
+  });
+}
+
+}  // namespace vigilante
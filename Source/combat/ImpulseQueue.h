@@ -0,0 +1,44 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_IMPULSE_QUEUE_H_
+#define VIGILANTE_IMPULSE_QUEUE_H_
+
+#include <vector>
+
+#include <box2d/box2d.h>
+
+namespace vigilante {
+
+class DynamicActor;
+
+// ImpulseQueue defers the knockback impulses, which are mostly raised from
+// within the contact callbacks and the hit resolution, to a single batch
+// applied between the world steps. The impulses pushed to the same actor
+// in between are summed, so simultaneous hits add up predictably.
+class ImpulseQueue final {
+ public:
+  static ImpulseQueue& the();
+
+  void push(DynamicActor* actor, const b2Vec2& impulse);
+  // Applies and clears all the queued impulses. Must not be
+  // called while the world is stepping.
+  void flush();
+  // Drops the queued impulse of `actor`.
+  // Must be called before `actor` is destroyed.
+  void forget(const DynamicActor* actor);
+
+  inline bool isEmpty() const { return _entries.empty(); }
+
+ private:
+  struct Entry final {
+    DynamicActor* actor;
+    b2Vec2 impulse;
+  };
+
+  ImpulseQueue() = default;
+
+  std::vector<ImpulseQueue::Entry> _entries;
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_IMPULSE_QUEUE_H_
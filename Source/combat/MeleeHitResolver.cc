@@ -0,0 +1,160 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "MeleeHitResolver.h"
+
+#include <algorithm>
+
+#include "character/Character.h"
+
+using namespace std;
+
+namespace vigilante {
+
+namespace {
+
+// Collects the characters whose body fixtures are in the queried AABB.
+class TargetQueryCallback final : public b2QueryCallback {
+ public:
+  explicit TargetQueryCallback(const uint16 maskBits) : _maskBits{maskBits} {}
+
+  virtual bool ReportFixture(b2Fixture* fixture) override {  // b2QueryCallback
+    if (fixture->GetFilterData().categoryBits & _maskBits) {
+      Character* target = reinterpret_cast<Character*>(fixture->GetUserData().pointer);
+      if (target && std::find(_targets.begin(), _targets.end(), target) == _targets.end()) {
+        _targets.push_back(target);
+      }
+    }
+    return true;
+  }
+
+  inline const vector<Character*>& getTargets() const { return _targets; }
+
+ private:
+  const uint16 _maskBits;
+  vector<Character*> _targets;
+};
+
+b2PolygonShape makeBoxShape(const b2AABB& box) {
+  b2PolygonShape shape;
+  shape.SetAsBox(box.GetExtents().x, box.GetExtents().y, box.GetCenter(), 0.0f);
+  return shape;
+}
+
+// The convex hull of a box at its previous and current positions.
+b2PolygonShape makeSweptShape(const b2AABB& previousBox, const b2AABB& box) {
+  const b2Vec2 vertices[] = {
+    previousBox.lowerBound,
+    {previousBox.upperBound.x, previousBox.lowerBound.y},
+    previousBox.upperBound,
+    {previousBox.lowerBound.x, previousBox.upperBound.y},
+    box.lowerBound,
+    {box.upperBound.x, box.lowerBound.y},
+    box.upperBound,
+    {box.lowerBound.x, box.upperBound.y},
+  };
+
+  b2PolygonShape shape;
+  shape.Set(vertices, 8);
+  return shape;
+}
+
+}  // namespace
+
+MeleeHitResolver::MeleeHitResolver(Character& c) : _character{c} {}
+
+void MeleeHitResolver::beginSwing(const vector<Hitbox>* hitboxes) {
+  endSwing();
+
+  if (!hitboxes || hitboxes->empty()) {
+    return;
+  }
+
+  _hitboxes = hitboxes;
+  _previousBoxes.resize(hitboxes->size());
+}
+
+void MeleeHitResolver::endSwing() {
+  _hitboxes = nullptr;
+  _previousBoxes.clear();
+  _hitTargets.clear();
+  _lastFrameIdx = -1;
+}
+
+void MeleeHitResolver::update(const int frameIdx) {
+  if (!_hitboxes) {
+    return;
+  }
+
+  // If several frames have passed since the last update (e.g., a hitch),
+  // the hitboxes of the skipped frames are still swept once.
+  const int fromFrameIdx = (frameIdx > _lastFrameIdx) ? _lastFrameIdx + 1 : frameIdx;
+  const b2Vec2& bodyPos = _character.getBody()->GetPosition();
+
+  for (size_t i = 0; i < _hitboxes->size(); i++) {
+    const Hitbox& hitbox = (*_hitboxes)[i];
+    if (hitbox.lastFrame < fromFrameIdx || hitbox.firstFrame > frameIdx) {
+      _previousBoxes[i].reset();
+      continue;
+    }
+
+    const b2AABB box = hitbox.toAABB(bodyPos, _character.isFacingRight());
+    sweep(hitbox, _previousBoxes[i], box);
+    _previousBoxes[i] = box;
+  }
+
+  _lastFrameIdx = frameIdx;
+}
+
+void MeleeHitResolver::sweep(const Hitbox& hitbox, const optional<b2AABB>& previousBox, const b2AABB& box) {
+  b2AABB queryBox = box;
+  if (previousBox) {
+    queryBox.Combine(*previousBox);
+  }
+
+  const b2Fixture* weaponFixture = _character.getFixtures()[Character::FixtureType::WEAPON];
+  TargetQueryCallback callback{weaponFixture->GetFilterData().maskBits};
+  _character.getBody()->GetWorld()->QueryAABB(&callback, queryBox);
+  if (callback.getTargets().empty()) {
+    return;
+  }
+
+  const b2PolygonShape sweptShape = previousBox ? makeSweptShape(*previousBox, box) : makeBoxShape(box);
+
+  for (auto target : callback.getTargets()) {
+    if (target == &_character || target->isInvincible() || target->isSetToKill()) {
+      continue;
+    }
+    if (_hitTargets.contains({hitbox.hitGroup, target}) || !overlapsHurtboxes(sweptShape, *target)) {
+      continue;
+    }
+
+    _hitTargets.insert({hitbox.hitGroup, target});
+    _character.landMeleeHit(target, _character.getDamageOutput());
+  }
+}
+
+bool MeleeHitResolver::overlapsHurtboxes(const b2PolygonShape& sweptShape, Character& target) const {
+  b2Transform identity;
+  identity.SetIdentity();
+
+  const vector<Hitbox>* hurtboxes = target.getHurtboxes();
+  if (!hurtboxes) {
+    const b2Fixture* bodyFixture = target.getFixtures()[Character::FixtureType::BODY];
+    return b2TestOverlap(&sweptShape, 0, bodyFixture->GetShape(), 0,
+                         identity, target.getBody()->GetTransform());
+  }
+
+  const int frameIdx = target.getAnimationFrameIdx();
+  const b2Vec2& bodyPos = target.getBody()->GetPosition();
+  for (const auto& hurtbox : *hurtboxes) {
+    if (!hurtbox.isActiveOn(frameIdx)) {
+      continue;
+    }
+    const b2PolygonShape hurtboxShape = makeBoxShape(hurtbox.toAABB(bodyPos, target.isFacingRight()));
+    if (b2TestOverlap(&sweptShape, 0, &hurtboxShape, 0, identity, identity)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace vigilante
@@ -0,0 +1,50 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_MELEE_HIT_RESOLVER_H_
+#define VIGILANTE_MELEE_HIT_RESOLVER_H_
+
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <box2d/box2d.h>
+
+#include "combat/Hitbox.h"
+
+namespace vigilante {
+
+class Character;
+
+// MeleeHitResolver resolves the hits of an attack animation with authored
+// hitboxes (see HitboxProfile), in place of the per-hit timers and the
+// weapon fixture's in-range targets.
+//
+// Each frame, every active hitbox is swept from where it was in the last
+// frame to where it is now, so fast swings and fast movement can't skip
+// over a thin target. A target can be hit at most once per hit group per swing.
+class MeleeHitResolver final {
+ public:
+  explicit MeleeHitResolver(Character& c);
+
+  // Starts a new swing with the hitboxes of the attack animation which
+  // has just started, or ends the current one if `hitboxes` is nullptr.
+  void beginSwing(const std::vector<Hitbox>* hitboxes);
+  void endSwing();
+  void update(const int frameIdx);
+
+  inline bool isSwinging() const { return _hitboxes != nullptr; }
+
+ private:
+  void sweep(const Hitbox& hitbox, const std::optional<b2AABB>& previousBox, const b2AABB& box);
+  bool overlapsHurtboxes(const b2PolygonShape& sweptShape, Character& target) const;
+
+  Character& _character;
+  const std::vector<Hitbox>* _hitboxes{};
+  std::vector<std::optional<b2AABB>> _previousBoxes;
+  std::set<std::pair<int, Character*>> _hitTargets;  // (hitGroup, target)
+  int _lastFrameIdx{-1};
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_MELEE_HIT_RESOLVER_H_
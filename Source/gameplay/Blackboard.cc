@@ -0,0 +1,96 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "Blackboard.h"
+
+#include <cassert>
+#include <limits>
+
+#include "util/Logger.h"
+
+using namespace std;
+
+namespace vigilante {
+
+Blackboard& Blackboard::the() {
+  static Blackboard instance;
+  return instance;
+}
+
+Blackboard::Blackboard() {
+  // The empty string is always interned as 0,
+  // which is what an unset string variable reads as.
+  internString("");
+}
+
+Blackboard::VarId Blackboard::intern(const string& name) {
+  auto it = _varIds.find(name);
+  if (it != _varIds.end()) {
+    return it->second;
+  }
+
+  assert(_names.size() < numeric_limits<VarId>::max());
+  const auto id = static_cast<VarId>(_names.size());
+  _names.push_back(name);
+  _vars.push_back({Type::NONE, 0});
+  _varIds.emplace(name, id);
+  return id;
+}
+
+Blackboard::StringId Blackboard::internString(const string& s) {
+  auto it = _stringIds.find(s);
+  if (it != _stringIds.end()) {
+    return it->second;
+  }
+
+  const auto id = static_cast<StringId>(_strings.size());
+  _strings.push_back(s);
+  _stringIds.emplace(s, id);
+  return id;
+}
+
+bool Blackboard::setInt(const VarId id, const int value) {
+  return set(id, Type::INT, value);
+}
+
+bool Blackboard::setBool(const VarId id, const bool value) {
+  return set(id, Type::BOOL, value ? 1 : 0);
+}
+
+bool Blackboard::setString(const VarId id, const string& value) {
+  return set(id, Type::STRING, internString(value));
+}
+
+string Blackboard::toString(const VarId id) const {
+  const Variable& var = _vars[id];
+  switch (var.type) {
+    case Type::INT:
+      return _names[id] + " = " + std::to_string(var.value);
+    case Type::BOOL:
+      return _names[id] + " = " + (var.value ? "true" : "false");
+    case Type::STRING:
+      return _names[id] + " = \"" + _strings[var.value] + "\"";
+    default:
+      return _names[id] + " is not set";
+  }
+}
+
+void Blackboard::reset() {
+  for (auto& var : _vars) {
+    var = {Type::NONE, 0};
+  }
+  _hasChanged = true;
+}
+
+bool Blackboard::set(const VarId id, const Type type, const int32_t value) {
+  Variable& var = _vars[id];
+  if (var.type != Type::NONE && var.type != type) {
+    VGLOG(LOG_ERR, "Failed to set [%s] to a %s, it is a %s.", _names[id].c_str(),
+          kTypeStr[static_cast<size_t>(type)].c_str(), kTypeStr[static_cast<size_t>(var.type)].c_str());
+    return false;
+  }
+
+  var = {type, value};
+  _hasChanged = true;
+  return true;
+}
+
+}  // namespace vigilante
@@ -0,0 +1,97 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_BLACKBOARD_H_
+#define VIGILANTE_BLACKBOARD_H_
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace vigilante {
+
+// Blackboard holds the game-wide story variables, e.g., flags such as
+// "metTheKing", counters such as "wolvesKilled", or strings such as
+// "guildRank". It is saved along with the game.
+//
+// Variables are addressed by the ids interned from their names, so that
+// the compiled conditions (see gameplay/Expression.h) never look up a name
+// at runtime. The string values are interned as well, hence every value
+// fits in an int32_t, and an unset variable reads as 0, false or "".
+class Blackboard final {
+ public:
+  using VarId = uint16_t;
+  using StringId = int32_t;
+
+  enum class Type : uint8_t {
+    NONE,  // not set yet
+    INT,
+    BOOL,
+    STRING,
+    SIZE
+  };
+
+  static inline const std::array<std::string, static_cast<size_t>(Type::SIZE)> kTypeStr{{
+    "none",
+    "int",
+    "bool",
+    "string",
+  }};
+
+  static Blackboard& the();
+
+  // Returns the id of the variable `name`. The same name always
+  // gives the same id until the game exits, even across saves.
+  VarId intern(const std::string& name);
+  StringId internString(const std::string& s);
+  inline const std::string& getName(const VarId id) const { return _names[id]; }
+  inline const std::string& getInternedString(const StringId id) const { return _strings[id]; }
+
+  // A variable keeps the type it is first set with, and setting it
+  // with a value of another type fails.
+  bool setInt(const VarId id, const int value);
+  bool setBool(const VarId id, const bool value);
+  bool setString(const VarId id, const std::string& value);
+
+  inline Blackboard::Type getType(const VarId id) const { return _vars[id].type; }
+  inline int getInt(const VarId id) const { return _vars[id].value; }
+  inline bool getBool(const VarId id) const { return _vars[id].value != 0; }
+  inline const std::string& getString(const VarId id) const { return _strings[_vars[id].value]; }
+  // The raw value of any type, as used by the compiled conditions.
+  inline int32_t getValue(const VarId id) const { return _vars[id].value; }
+
+  // Returns whether any variable has been set or unset since the last call,
+  // so that the conditions depending on them can be re-evaluated.
+  inline bool consumeChanges() { return std::exchange(_hasChanged, false); }
+
+  // e.g., "wolvesKilled = 3"
+  std::string toString(const VarId id) const;
+  inline size_t getVarCount() const { return _vars.size(); }
+
+  // Unsets all the variables. The interned ids stay valid.
+  void reset();
+
+ private:
+  struct Variable final {
+    Blackboard::Type type;
+    int32_t value;
+  };
+
+  Blackboard();
+
+  bool set(const VarId id, const Blackboard::Type type, const int32_t value);
+
+  std::vector<std::string> _names;
+  std::unordered_map<std::string, VarId> _varIds;
+  std::vector<Blackboard::Variable> _vars;
+
+  std::vector<std::string> _strings;
+  std::unordered_map<std::string, StringId> _stringIds;
+
+  bool _hasChanged{};
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_BLACKBOARD_H_
@@ -0,0 +1,476 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "DeterminismChecker.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <tuple>
+
+#include <box2d/box2d.h>
+
+#include "CallbackManager.h"
+#include "character/Npc.h"
+#include "character/Player.h"
+#include "gameplay/GameState.h"
+#include "item/Item.h"
+#include "scene/GameScene.h"
+#include "scene/SceneManager.h"
+#include "util/Logger.h"
+#include "util/RandUtil.h"
+#include "util/StringUtil.h"
+
+using namespace std;
+
+namespace vigilante {
+
+namespace {
+
+constexpr char kTraceMagic[] = "vgtrace";
+constexpr int kTraceVersion = 2;
+constexpr char kStartingSaveFileExtension[] = ".vgs";
+
+constexpr array<const char*, DeterminismChecker::Subsystem::SIZE> kSubsystemNames{{
+  "bodies",
+  "characters",
+  "inventories",
+  "quests",
+  "timers",
+  "rng",
+}};
+
+// 64-bit FNV-1a.
+class StateHasher final {
+ public:
+  void add(const void* data, const size_t size) {
+    const auto bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+      _hash ^= bytes[i];
+      _hash *= 0x100000001b3ULL;
+    }
+  }
+
+  void add(const uint64_t value) { add(&value, sizeof(value)); }
+  void add(const int value) { add(static_cast<uint64_t>(value)); }
+  void add(const bool value) { add(static_cast<uint64_t>(value)); }
+
+  void add(float value) {
+    // +0.0f and -0.0f compare equal, so they should hash the same.
+    if (value == 0.0f) {
+      value = 0.0f;
+    }
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    add(static_cast<uint64_t>(bits));
+  }
+
+  void add(const b2Vec2& value) {
+    add(value.x);
+    add(value.y);
+  }
+
+  void add(const string& value) {
+    add(static_cast<uint64_t>(value.size()));
+    add(value.data(), value.size());
+  }
+
+  // Combines the hashes of unordered elements in a canonical order.
+  void addUnordered(vector<uint64_t>& hashes) {
+    std::sort(hashes.begin(), hashes.end());
+    add(static_cast<uint64_t>(hashes.size()));
+    for (const auto hash : hashes) {
+      add(hash);
+    }
+  }
+
+  inline uint64_t get() const { return _hash; }
+
+ private:
+  uint64_t _hash{0xcbf29ce484222325ULL};
+};
+
+vector<Character*> getCharacters(GameMapManager* gmMgr) {
+  vector<Character*> characters;
+
+  if (Player* player = gmMgr->getPlayer()) {
+    characters.push_back(player);
+    for (auto ally : player->getAllies()) {
+      characters.push_back(ally);
+    }
+  }
+
+  for (const auto& actor : gmMgr->getGameMap()->getDynamicActors()) {
+    if (Character* c = dynamic_cast<Character*>(actor.get())) {
+      characters.push_back(c);
+    }
+  }
+
+  std::sort(characters.begin(), characters.end());
+  characters.erase(std::unique(characters.begin(), characters.end()), characters.end());
+  return characters;
+}
+
+uint64_t hashBodies(b2World* world) {
+  vector<uint64_t> hashes;
+  for (const b2Body* body = world->GetBodyList(); body; body = body->GetNext()) {
+    StateHasher hasher;
+    hasher.add(static_cast<int>(body->GetType()));
+    hasher.add(body->GetPosition());
+    hasher.add(body->GetAngle());
+    hasher.add(body->GetLinearVelocity());
+    hasher.add(body->GetAngularVelocity());
+    hasher.add(body->IsAwake());
+    hasher.add(body->IsEnabled());
+    hashes.push_back(hasher.get());
+  }
+
+  StateHasher hasher;
+  hasher.addUnordered(hashes);
+  return hasher.get();
+}
+
+uint64_t hashCharacters(const vector<Character*>& characters) {
+  vector<uint64_t> hashes;
+  for (const auto c : characters) {
+    const Character::Profile& profile = c->getCharacterProfile();
+
+    StateHasher hasher;
+    hasher.add(profile.jsonFileName);
+    hasher.add(profile.level);
+    hasher.add(profile.exp);
+    hasher.add(profile.health);
+    hasher.add(profile.stamina);
+    hasher.add(profile.magicka);
+    hasher.add(profile.fullHealth);
+    hasher.add(profile.fullStamina);
+    hasher.add(profile.fullMagicka);
+    hasher.add(profile.strength);
+    hasher.add(profile.dexterity);
+    hasher.add(profile.intelligence);
+    hasher.add(profile.luck);
+    hasher.add(static_cast<int>(c->getCurrentState()));
+    hasher.add(c->isFacingRight());
+    hasher.add(c->isOnGround());
+    hasher.add(c->isJumping());
+    hasher.add(c->isAttacking());
+    hasher.add(c->isBlocking());
+    hasher.add(c->isDodging());
+    hasher.add(c->isInvincible());
+    hasher.add(c->isStunned());
+    hasher.add(c->isSetToKill());
+    hasher.add(c->isKilled());
+    hasher.add(c->isAlerted());
+    if (const Character* target = c->getLockedOnTarget()) {
+      hasher.add(const_cast<Character*>(target)->getCharacterProfile().jsonFileName);
+    }
+    hashes.push_back(hasher.get());
+  }
+
+  StateHasher hasher;
+  hasher.addUnordered(hashes);
+  return hasher.get();
+}
+
+uint64_t hashInventories(GameMapManager* gmMgr, const vector<Character*>& characters) {
+  vector<uint64_t> hashes;
+
+  for (const auto c : characters) {
+    StateHasher hasher;
+    hasher.add(c->getCharacterProfile().jsonFileName);
+    hasher.add(c->getGoldBalance());
+
+    // Items are kept in insertion order, which is part of the state.
+    for (const auto& items : c->getInventory()) {
+      for (const auto item : items) {
+        hasher.add(item->getItemProfile().jsonFileName);
+        hasher.add(item->getAmount());
+      }
+    }
+    for (const auto equipment : c->getEquipmentSlots()) {
+      hasher.add(equipment ? equipment->getItemProfile().jsonFileName : "");
+    }
+    hashes.push_back(hasher.get());
+  }
+
+  // The items lying on the ground.
+  for (const auto& actor : gmMgr->getGameMap()->getDynamicActors()) {
+    if (const Item* item = dynamic_cast<const Item*>(actor.get())) {
+      StateHasher hasher;
+      hasher.add(item->getItemProfile().jsonFileName);
+      hasher.add(item->getAmount());
+      hashes.push_back(hasher.get());
+    }
+  }
+
+  StateHasher hasher;
+  hasher.addUnordered(hashes);
+  return hasher.get();
+}
+
+uint64_t hashQuests(Player* player) {
+  StateHasher hasher;
+  if (!player) {
+    return hasher.get();
+  }
+
+  const QuestBook& questBook = player->getQuestBook();
+  for (const auto quests : {&questBook.getInProgressQuests(), &questBook.getCompletedQuests()}) {
+    hasher.add(static_cast<uint64_t>(quests->size()));
+    for (const auto quest : *quests) {
+      hasher.add(quest->getQuestProfile().jsonFileName);
+      hasher.add(quest->getCurrentStageIdx());
+    }
+  }
+  return hasher.get();
+}
+
+uint64_t hashTimers(const CallbackManager::CallbackId firstCallbackId) {
+  // The callback ids keep counting up across sessions,
+  // so only the ones issued since the start are hashed.
+  StateHasher hasher;
+  hasher.add(static_cast<uint64_t>(CallbackManager::the().getNumPendingCallbacks()));
+  hasher.add(CallbackManager::the().getNextCallbackId() - firstCallbackId);
+  return hasher.get();
+}
+
+uint64_t hashRng() {
+  StateHasher hasher;
+  hasher.add(rand_util::getNumDraws());
+  return hasher.get();
+}
+
+}  // namespace
+
+DeterminismChecker& DeterminismChecker::the() {
+  static DeterminismChecker instance;
+  return instance;
+}
+
+bool DeterminismChecker::startRecording(const fs::path& traceFileName, const unsigned int seed) {
+  if (isActive()) {
+    VGLOG(LOG_ERR, "A determinism check is already in progress.");
+    return false;
+  }
+
+  const fs::path startingSaveFilePath{traceFileName.native() + kStartingSaveFileExtension};
+  if (!GameState{startingSaveFilePath}.save()) {
+    VGLOG(LOG_ERR, "Failed to save the starting state to [%s].", startingSaveFilePath.c_str());
+    return false;
+  }
+
+  _mode = Mode::RECORDING;
+  _traceFileName = traceFileName;
+  _startingSaveFilePath = startingSaveFilePath;
+  _seed = seed;
+  _inputs.clear();
+  _trace.clear();
+
+  // The recording starts from the reloaded save rather than from the live state,
+  // since the latter holds things which aren't saved (e.g., the AI timers).
+  restoreStartingState();
+  VGLOG(LOG_INFO, "Recording world state trace to [%s], seed: [%u].", _traceFileName.c_str(), _seed);
+  return true;
+}
+
+bool DeterminismChecker::startVerifying(const fs::path& traceFileName) {
+  if (isActive()) {
+    VGLOG(LOG_ERR, "A determinism check is already in progress.");
+    return false;
+  }
+
+  ifstream fin{traceFileName};
+  if (!fin.is_open()) {
+    VGLOG(LOG_ERR, "Failed to open world state trace [%s].", traceFileName.c_str());
+    return false;
+  }
+
+  string magic;
+  int version = 0;
+  unsigned int seed = kDefaultSeed;
+  string startingSaveFilePath;
+  fin >> magic >> version >> seed >> std::quoted(startingSaveFilePath);
+  if (magic != kTraceMagic || version != kTraceVersion) {
+    VGLOG(LOG_ERR, "Unsupported world state trace [%s].", traceFileName.c_str());
+    return false;
+  }
+  if (!fs::exists(startingSaveFilePath)) {
+    VGLOG(LOG_ERR, "The starting state [%s] of world state trace [%s] is missing.",
+          startingSaveFilePath.c_str(), traceFileName.c_str());
+    return false;
+  }
+
+  // i <actions>
+  // s <tick> <hashes...>
+  vector<ActionMask> inputs;
+  vector<Snapshot> trace;
+  string tag;
+  while (fin >> tag) {
+    if (tag == "i") {
+      ActionMask actions{};
+      fin >> std::hex >> actions >> std::dec;
+      inputs.push_back(actions);
+    } else if (tag == "s") {
+      int tick;
+      Snapshot snapshot{};
+      fin >> tick;
+      for (auto& hash : snapshot) {
+        fin >> std::hex >> hash >> std::dec;
+      }
+      trace.push_back(snapshot);
+    }
+    if (!fin || (tag != "i" && tag != "s")) {
+      VGLOG(LOG_ERR, "Malformed world state trace [%s] at tick [%d].",
+            traceFileName.c_str(), static_cast<int>(trace.size()));
+      return false;
+    }
+  }
+
+  _mode = Mode::VERIFYING;
+  _traceFileName = traceFileName;
+  _startingSaveFilePath = startingSaveFilePath;
+  _seed = seed;
+  _inputs = std::move(inputs);
+  _trace = std::move(trace);
+
+  restoreStartingState();
+  VGLOG(LOG_INFO, "Verifying against world state trace [%s] (%d ticks), seed: [%u].",
+        _traceFileName.c_str(), static_cast<int>(_trace.size()), _seed);
+  return true;
+}
+
+void DeterminismChecker::stop() {
+  if (_mode == Mode::RECORDING) {
+    saveTrace();
+  } else if (_mode == Mode::VERIFYING && !_isRestoring) {
+    VGLOG(LOG_INFO, "World state matched the golden trace for [%d] ticks.", _tick);
+  }
+
+  _mode = Mode::NONE;
+  _isRestoring = false;
+  _inputs.clear();
+  _trace.clear();
+}
+
+void DeterminismChecker::update() {
+  if (!isActive()) {
+    return;
+  }
+
+  if (_isRestoring) {
+    // The save is loaded behind the shade, so it has been
+    // restored once the shade has finished fading out.
+    auto gameScene = SceneManager::the().getCurrentScene<GameScene>();
+    if (gameScene->getShade()->getImageView()->getNumberOfRunningActions() > 0) {
+      return;
+    }
+    _isRestoring = false;
+    _firstCallbackId = CallbackManager::the().getNextCallbackId();
+    rand_util::init(_seed);
+  }
+
+  if (_mode == Mode::RECORDING) {
+    _inputs.push_back(ActionMapper::the().getPressedActions());
+  } else {
+    ActionMapper::the().overridePressedActions((_frame < static_cast<int>(_inputs.size())) ? _inputs[_frame] : 0);
+  }
+  _frame++;
+}
+
+void DeterminismChecker::tick() {
+  if (!isActive() || _isRestoring) {
+    return;
+  }
+
+  const Snapshot snapshot = takeSnapshot();
+
+  if (_mode == Mode::RECORDING) {
+    _trace.push_back(snapshot);
+    _tick++;
+    return;
+  }
+
+  if (_tick >= static_cast<int>(_trace.size())) {
+    stop();
+    return;
+  }
+
+  const Snapshot& expected = _trace[_tick];
+  for (int i = 0; i < Subsystem::SIZE; i++) {
+    if (snapshot[i] != expected[i]) {
+      reportDivergence(static_cast<Subsystem>(i));
+      _mode = Mode::NONE;
+      _inputs.clear();
+      _trace.clear();
+      return;
+    }
+  }
+  _tick++;
+}
+
+DeterminismChecker::Snapshot DeterminismChecker::takeSnapshot() const {
+  Snapshot snapshot{};
+
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  if (!gmMgr->getGameMap()) {
+    return snapshot;
+  }
+
+  const vector<Character*> characters = getCharacters(gmMgr);
+  snapshot[Subsystem::BODIES] = hashBodies(gmMgr->getWorld());
+  snapshot[Subsystem::CHARACTERS] = hashCharacters(characters);
+  snapshot[Subsystem::INVENTORIES] = hashInventories(gmMgr, characters);
+  snapshot[Subsystem::QUESTS] = hashQuests(gmMgr->getPlayer());
+  snapshot[Subsystem::TIMERS] = hashTimers(_firstCallbackId);
+  snapshot[Subsystem::RNG] = hashRng();
+  return snapshot;
+}
+
+const char* DeterminismChecker::getSubsystemName(const Subsystem subsystem) {
+  return kSubsystemNames[subsystem];
+}
+
+void DeterminismChecker::restoreStartingState() {
+  _isRestoring = true;
+  _frame = 0;
+  _tick = 0;
+
+  // The callbacks of the discarded session must not run in the restored one.
+  CallbackManager::the().reset();
+  SceneManager::the().getCurrentScene<GameScene>()->loadGame(_startingSaveFilePath.string());
+}
+
+bool DeterminismChecker::saveTrace() const {
+  ofstream fout{_traceFileName};
+  if (!fout.is_open()) {
+    VGLOG(LOG_ERR, "Failed to save world state trace to [%s].", _traceFileName.c_str());
+    return false;
+  }
+
+  fout << kTraceMagic << ' ' << kTraceVersion << ' ' << _seed << ' '
+       << std::quoted(_startingSaveFilePath.string()) << '\n';
+  for (const auto actions : _inputs) {
+    fout << "i " << std::hex << actions << std::dec << '\n';
+  }
+  for (size_t tick = 0; tick < _trace.size(); tick++) {
+    fout << "s " << std::dec << tick;
+    for (const auto hash : _trace[tick]) {
+      fout << ' ' << std::hex << hash;
+    }
+    fout << '\n';
+  }
+
+  VGLOG(LOG_INFO, "Saved world state trace (%d ticks) to [%s].",
+        static_cast<int>(_trace.size()), _traceFileName.c_str());
+  return true;
+}
+
+void DeterminismChecker::reportDivergence(const Subsystem subsystem) const {
+  const string msg = string_util::format("World state diverged at tick %d (%s).",
+                                         _tick, getSubsystemName(subsystem));
+  VGLOG(LOG_ERR, "%s", msg.c_str());
+
+  auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
+  notifications->show(msg);
+}
+
+}  // namespace vigilante
@@ -0,0 +1,97 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_DETERMINISM_CHECKER_H_
+#define VIGILANTE_DETERMINISM_CHECKER_H_
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "CallbackManager.h"
+#include "input/ActionMapper.h"
+
+namespace fs = std::filesystem;
+
+namespace vigilante {
+
+// DeterminismChecker hashes a canonical view of the simulation state once per
+// tick. While recording, the hashes are written to a trace file. While verifying,
+// they are compared against a previously recorded (golden) trace, and the first
+// divergent tick and subsystem are reported.
+//
+// A trace also holds everything the simulation is fed with: the seed, a save
+// of the starting state, and the actions pressed in every frame. Both recording
+// and verifying first restore the starting state from that save, and verifying
+// replays the recorded actions in place of the live input, so that two runs
+// only diverge if the simulation itself isn't deterministic.
+//
+// Containers with an unspecified iteration order (e.g., the dynamic actors of
+// a GameMap) are hashed per element, and the element hashes are sorted before
+// being combined, so only the state itself affects the result.
+class DeterminismChecker final {
+ public:
+  enum Subsystem {
+    BODIES,
+    CHARACTERS,
+    INVENTORIES,
+    QUESTS,
+    TIMERS,
+    RNG,
+    SIZE
+  };
+
+  using Snapshot = std::array<uint64_t, Subsystem::SIZE>;
+
+  static inline constexpr unsigned int kDefaultSeed = 1;
+
+  static DeterminismChecker& the();
+
+  // Saves the current game next to the trace as its starting state.
+  bool startRecording(const fs::path& traceFileName, const unsigned int seed);
+  bool startVerifying(const fs::path& traceFileName);
+  void stop();
+
+  // Called once per frame right after ActionMapper::update(). Records this
+  // frame's actions, or replaces them with the recorded ones.
+  void update();
+  // Called once per tick after the simulation has been updated.
+  void tick();
+
+  Snapshot takeSnapshot() const;
+
+  inline bool isActive() const { return _mode != Mode::NONE; }
+  // Nothing may advance the simulation while the starting state is being restored.
+  inline bool isRestoring() const { return _isRestoring; }
+  inline int getTick() const { return _tick; }
+
+  static const char* getSubsystemName(const Subsystem subsystem);
+
+ private:
+  enum class Mode {
+    NONE,
+    RECORDING,
+    VERIFYING
+  };
+
+  DeterminismChecker() = default;
+
+  void restoreStartingState();
+  bool saveTrace() const;
+  void reportDivergence(const Subsystem subsystem) const;
+
+  Mode _mode{Mode::NONE};
+  fs::path _traceFileName;
+  fs::path _startingSaveFilePath;
+  unsigned int _seed{kDefaultSeed};
+  bool _isRestoring{};
+  int _frame{};
+  int _tick{};
+  CallbackManager::CallbackId _firstCallbackId{};
+  std::vector<ActionMask> _inputs;  // per frame
+  std::vector<Snapshot> _trace;  // per tick
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_DETERMINISM_CHECKER_H_
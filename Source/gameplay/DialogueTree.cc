@@ -6,8 +6,8 @@
 
 #include <axmol.h>
 
+#include "Localization.h"
 #include "character/Npc.h"
-#include "util/ds/Algorithm.h"
 #include "util/JsonUtil.h"
 #include "util/Logger.h"
 
@@ -63,12 +63,16 @@ void DialogueTree::import(const string& jsonFileName) {
     }
 
     for (const auto& line : jsonNode["lines"].GetArray()) {
-      node->_lines.push_back(line.GetString());
+      node->_lines.push_back(Localization::the().localize(line.GetString()));
     }
     for (const auto& cmd : jsonNode["exec"].GetArray()) {
       node->_cmds.push_back(cmd.GetString());
     }
 
+    if (jsonNode.HasMember("condition")) {
+      node->_condition.compile(jsonNode["condition"].GetString());
+    }
+
     if (jsonNode.HasMember("childrenRef")) {
       node->_childrenRef = jsonNode["childrenRef"].GetString();
     } else {
@@ -120,7 +124,7 @@ void DialogueTree::import(const string& jsonFileName) {
   // then add trade dialogue as a root node's child.
   if (_owner->getNpcProfile().isTradable) {
     auto tradeNode = std::make_unique<DialogueTree::Node>(this);
-    tradeNode->_lines.push_back("Let's trade.");
+    tradeNode->_lines.push_back(tr(StringId::DIALOGUE_TRADE));
     tradeNode->_cmds.push_back("tradeWithPlayer");
     _tradeNode = tradeNode.get();
     _rootNode->_children.push_back(std::move(tradeNode));
@@ -132,20 +136,20 @@ void DialogueTree::import(const string& jsonFileName) {
 void DialogueTree::update() {
   if (_toggleJoinPartyNode) {
     if (!_owner->isPlayerLeaderOfParty()) {
-      _toggleJoinPartyNode->_lines.front() = "Follow me.";
+      _toggleJoinPartyNode->_lines.front() = tr(StringId::DIALOGUE_FOLLOW_ME);
       _toggleJoinPartyNode->_cmds.front() = "joinPlayerParty";
     } else {
-      _toggleJoinPartyNode->_lines.front() = "It's time for us to part ways";
+      _toggleJoinPartyNode->_lines.front() = tr(StringId::DIALOGUE_PART_WAYS);
       _toggleJoinPartyNode->_cmds.front() = "leavePlayerParty";
     }
   }
 
   if (_toggleWaitNode) {
     if (!_owner->isWaitingForPlayer()) {
-      _toggleWaitNode->_lines.front() = "Wait here.";
+      _toggleWaitNode->_lines.front() = tr(StringId::DIALOGUE_WAIT_HERE);
       _toggleWaitNode->_cmds.front() = "playerPartyMemberWait";
     } else {
-      _toggleWaitNode->_lines.front() = "Continue to follow me.";
+      _toggleWaitNode->_lines.front() = tr(StringId::DIALOGUE_CONTINUE_TO_FOLLOW);
       _toggleWaitNode->_cmds.front() = "playerPartyMemberFollow";
     }
   }
@@ -160,12 +164,16 @@ DialogueTree::Node::Node(DialogueTree* tree)
     : _tree(tree), _nodeName(), _lines(), _cmds(), _children() {}
 
 vector<DialogueTree::Node*> DialogueTree::Node::getChildren() const {
-  if (_childrenRef.empty()) {
-    return uniqueVec2RawVec<Dialogue>(_children);
-  }
+  const auto& children = _childrenRef.empty() ? _children : _tree->getNode(_childrenRef)->_children;
 
-  DialogueTree::Node* refNode = _tree->getNode(_childrenRef);
-  return uniqueVec2RawVec<Dialogue>(refNode->_children);
+  vector<DialogueTree::Node*> ret;
+  ret.reserve(children.size());
+  for (const auto& child : children) {
+    if (child->_condition.evaluate()) {
+      ret.push_back(child.get());
+    }
+  }
+  return ret;
 }
 
 }  // namespace vigilante
@@ -8,6 +8,7 @@
 #include <unordered_map>
 
 #include "Importable.h"
+#include "gameplay/Expression.h"
 
 namespace vigilante {
 
@@ -35,6 +36,8 @@ class DialogueTree : public Importable {
     inline const std::vector<std::string>& getLines() const { return _lines; }
     inline const std::vector<std::string>& getCmds() const { return _cmds; }
     inline const std::string& getChildrenRef() const { return _childrenRef; }
+    inline const Expression& getCondition() const { return _condition; }
+    // The children whose conditions currently hold.
     std::vector<Node*> getChildren() const;
 
    private:
@@ -43,6 +46,7 @@ class DialogueTree : public Importable {
     std::string _nodeName;  // only required when `childrenRef` exists. See comment below.
     std::vector<std::string> _lines;
     std::vector<std::string> _cmds;  // the command to execute after all lines are shown.
+    Expression _condition;  // this node is only offered while it holds.
 
     // We have two (mutually exclusive) methods for keeping children:
     //
@@ -0,0 +1,61 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "EffectScheduler.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace vigilante {
+
+EffectScheduler& EffectScheduler::the() {
+  static EffectScheduler instance;
+  return instance;
+}
+
+void EffectScheduler::update(const float delta) {
+  _time += delta;
+
+  while (!_heap.empty() && _heap.front().expiryTime <= _time) {
+    std::pop_heap(_heap.begin(), _heap.end());
+    const Entry entry = _heap.back();
+    _heap.pop_back();
+
+    // The listener may schedule or cancel other effects from here.
+    entry.listener->onEffectExpired(entry.id);
+  }
+}
+
+EffectScheduler::EffectId EffectScheduler::schedule(Listener* listener, const float duration) {
+  const EffectId id = _nextEffectId++;
+  _heap.push_back({_time + duration, id, listener});
+  std::push_heap(_heap.begin(), _heap.end());
+  return id;
+}
+
+void EffectScheduler::reschedule(const EffectId id, const float duration) {
+  auto it = std::find_if(_heap.begin(), _heap.end(), [id](const Entry& e) { return e.id == id; });
+  if (it == _heap.end()) {
+    return;
+  }
+  it->expiryTime = _time + duration;
+  std::make_heap(_heap.begin(), _heap.end());
+}
+
+void EffectScheduler::cancel(const EffectId id) {
+  if (std::erase_if(_heap, [id](const Entry& e) { return e.id == id; })) {
+    std::make_heap(_heap.begin(), _heap.end());
+  }
+}
+
+void EffectScheduler::cancelAll(const Listener* listener) {
+  if (std::erase_if(_heap, [listener](const Entry& e) { return e.listener == listener; })) {
+    std::make_heap(_heap.begin(), _heap.end());
+  }
+}
+
+float EffectScheduler::getRemainingTime(const EffectId id) const {
+  auto it = std::find_if(_heap.begin(), _heap.end(), [id](const Entry& e) { return e.id == id; });
+  return (it != _heap.end()) ? std::max(0.0f, it->expiryTime - _time) : 0.0f;
+}
+
+}  // namespace vigilante
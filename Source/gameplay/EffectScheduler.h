@@ -0,0 +1,56 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_EFFECT_SCHEDULER_H_
+#define VIGILANTE_EFFECT_SCHEDULER_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace vigilante {
+
+// EffectScheduler expires all timed effects (buffs, debuffs, ...) from a
+// single min-heap which is advanced once per frame with the game time,
+// instead of each effect running its own timer action.
+class EffectScheduler final {
+ public:
+  using EffectId = uint64_t;
+
+  class Listener {
+   public:
+    virtual ~Listener() = default;
+    virtual void onEffectExpired(const EffectId id) = 0;
+  };
+
+  static EffectScheduler& the();
+
+  void update(const float delta);
+
+  EffectId schedule(Listener* listener, const float duration);
+  void reschedule(const EffectId id, const float duration);
+  void cancel(const EffectId id);
+  // Must be called before `listener` is destroyed.
+  void cancelAll(const Listener* listener);
+
+  float getRemainingTime(const EffectId id) const;
+  inline float getTime() const { return _time; }
+
+ private:
+  struct Entry final {
+    float expiryTime;
+    EffectId id;
+    Listener* listener;
+
+    // For a min-heap with std::push_heap() and std::pop_heap().
+    bool operator<(const Entry& other) const { return expiryTime > other.expiryTime; }
+  };
+
+  EffectScheduler() = default;
+
+  static inline EffectId _nextEffectId{1};
+
+  float _time{};
+  std::vector<EffectScheduler::Entry> _heap;
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_EFFECT_SCHEDULER_H_
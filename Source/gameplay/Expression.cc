@@ -0,0 +1,356 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "Expression.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <string_view>
+
+#include "util/Logger.h"
+
+using namespace std;
+
+namespace vigilante {
+
+namespace {
+
+// A recursive descent parser which emits the postfix code as it goes.
+// From the lowest to the highest precedence:
+//
+//   or      := and ('||' and)*
+//   and     := compare ('&&' compare)*
+//   compare := unary (('==' | '!=' | '<' | '<=' | '>' | '>=') unary)?
+//   unary   := ('!' | '-') unary | primary
+//   primary := integer | 'true' | 'false' | string | variable | '(' or ')'
+class Parser final {
+ public:
+  Parser(const string& source, vector<Expression::Instruction>& code)
+      : _source{source},
+        _code{code} {}
+
+  bool parse() {
+    if (!parseOr()) {
+      return false;
+    }
+    skipSpaces();
+    if (_pos != _source.size()) {
+      return fail("unexpected character");
+    }
+    return true;
+  }
+
+  inline const string& getError() const { return _error; }
+  inline size_t getPos() const { return _pos; }
+
+ private:
+  bool parseOr() {
+    if (!parseAnd()) {
+      return false;
+    }
+    while (consume("||")) {
+      if (!parseAnd()) {
+        return false;
+      }
+      emit(Expression::Op::OR);
+    }
+    return true;
+  }
+
+  bool parseAnd() {
+    if (!parseCompare()) {
+      return false;
+    }
+    while (consume("&&")) {
+      if (!parseCompare()) {
+        return false;
+      }
+      emit(Expression::Op::AND);
+    }
+    return true;
+  }
+
+  bool parseCompare() {
+    if (!parseUnary()) {
+      return false;
+    }
+
+    // The two-character operators must be tried first.
+    static const array<pair<const char*, Expression::Op>, 6> kCompareOps{{
+      {"==", Expression::Op::EQ},
+      {"!=", Expression::Op::NE},
+      {"<=", Expression::Op::LE},
+      {">=", Expression::Op::GE},
+      {"<", Expression::Op::LT},
+      {">", Expression::Op::GT},
+    }};
+    for (const auto& [token, op] : kCompareOps) {
+      if (consume(token)) {
+        if (!parseUnary()) {
+          return false;
+        }
+        emit(op);
+        return true;
+      }
+    }
+    return true;
+  }
+
+  bool parseUnary() {
+    skipSpaces();
+    if (peek() == '!' && peek(1) != '=') {
+      _pos++;
+      if (!parseUnary()) {
+        return false;
+      }
+      emit(Expression::Op::NOT);
+      return true;
+    }
+    if (peek() == '-' && !std::isdigit(static_cast<unsigned char>(peek(1)))) {
+      _pos++;
+      if (!parseUnary()) {
+        return false;
+      }
+      emit(Expression::Op::NEG);
+      return true;
+    }
+    return parsePrimary();
+  }
+
+  bool parsePrimary() {
+    skipSpaces();
+    const char c = peek();
+
+    if (c == '(') {
+      _pos++;
+      if (!parseOr()) {
+        return false;
+      }
+      return consume(")") || fail("missing ')'");
+    }
+
+    if (c == '\'' || c == '"') {
+      const size_t end = _source.find(c, _pos + 1);
+      if (end == string::npos) {
+        return fail("unterminated string");
+      }
+      const string s = _source.substr(_pos + 1, end - _pos - 1);
+      _pos = end + 1;
+      emit(Expression::Op::PUSH, Blackboard::Type::STRING, Blackboard::the().internString(s));
+      return true;
+    }
+
+    if (std::isdigit(static_cast<unsigned char>(c)) || c == '-') {
+      const size_t begin = _pos++;
+      while (std::isdigit(static_cast<unsigned char>(peek()))) {
+        _pos++;
+      }
+      int32_t value = 0;
+      const auto [end, ec] = std::from_chars(_source.data() + begin, _source.data() + _pos, value);
+      if (ec == std::errc::result_out_of_range) {
+        return fail("integer is too large");
+      }
+      if (ec != std::errc{} || end != _source.data() + _pos) {
+        return fail("invalid integer");
+      }
+      emit(Expression::Op::PUSH, Blackboard::Type::INT, value);
+      return true;
+    }
+
+    if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+      const size_t begin = _pos++;
+      while (std::isalnum(static_cast<unsigned char>(peek())) || peek() == '_' || peek() == '.') {
+        _pos++;
+      }
+      const string name = _source.substr(begin, _pos - begin);
+      if (name == "true" || name == "false") {
+        emit(Expression::Op::PUSH, Blackboard::Type::BOOL, name == "true" ? 1 : 0);
+      } else {
+        emit(Expression::Op::LOAD, Blackboard::Type::NONE, Blackboard::the().intern(name));
+      }
+      return true;
+    }
+
+    return fail(c ? "unexpected character" : "unexpected end of expression");
+  }
+
+  void emit(const Expression::Op op, const Blackboard::Type type=Blackboard::Type::NONE, const int32_t operand=0) {
+    _code.push_back({op, type, operand});
+  }
+
+  bool consume(const char* token) {
+    skipSpaces();
+    const string_view t{token};
+    if (_source.compare(_pos, t.size(), t) != 0) {
+      return false;
+    }
+    _pos += t.size();
+    return true;
+  }
+
+  void skipSpaces() {
+    while (std::isspace(static_cast<unsigned char>(peek()))) {
+      _pos++;
+    }
+  }
+
+  char peek(const size_t offset=0) const {
+    return _pos + offset < _source.size() ? _source[_pos + offset] : '\0';
+  }
+
+  bool fail(const char* error) {
+    _error = error;
+    return false;
+  }
+
+  const string& _source;
+  vector<Expression::Instruction>& _code;
+  size_t _pos{};
+  string _error;
+};
+
+// Returns the maximum depth of the evaluation stack needed by `code`.
+size_t getStackDepth(const vector<Expression::Instruction>& code) {
+  size_t depth = 0;
+  size_t maxDepth = 0;
+  for (const auto& instruction : code) {
+    switch (instruction.op) {
+      case Expression::Op::PUSH:
+      case Expression::Op::LOAD:
+        maxDepth = std::max(maxDepth, ++depth);
+        break;
+      case Expression::Op::NOT:
+      case Expression::Op::NEG:
+        break;
+      default:
+        depth--;
+        break;
+    }
+  }
+  return maxDepth;
+}
+
+}  // namespace
+
+bool Expression::compile(const string& source) {
+  _source = source;
+  _code.clear();
+  _isValid = true;
+
+  if (source.find_first_not_of(" \t") == string::npos) {
+    _source.clear();
+    return true;
+  }
+
+  Parser parser{source, _code};
+  if (!parser.parse()) {
+    VGLOG(LOG_ERR, "Failed to compile expression [%s]: %s at %zu.",
+          source.c_str(), parser.getError().c_str(), parser.getPos());
+    _code.clear();
+    _isValid = false;
+    return false;
+  }
+
+  if (getStackDepth(_code) > kMaxStackDepth) {
+    VGLOG(LOG_ERR, "Failed to compile expression [%s]: too deeply nested.", source.c_str());
+    _code.clear();
+    _isValid = false;
+    return false;
+  }
+  return true;
+}
+
+bool Expression::evaluate() const {
+  if (!_isValid) {
+    return false;
+  }
+  if (_code.empty()) {
+    return true;
+  }
+
+  struct Value final {
+    Blackboard::Type type;
+    int32_t value;
+  };
+
+  const Blackboard& blackboard = Blackboard::the();
+  array<Value, kMaxStackDepth> stack;
+  size_t top = 0;
+
+  for (const auto& instruction : _code) {
+    switch (instruction.op) {
+      case Op::PUSH:
+        stack[top++] = {instruction.type, instruction.operand};
+        continue;
+      case Op::LOAD: {
+        const auto id = static_cast<Blackboard::VarId>(instruction.operand);
+        stack[top++] = {blackboard.getType(id), blackboard.getValue(id)};
+        continue;
+      }
+      case Op::NOT:
+        stack[top - 1] = {Blackboard::Type::BOOL, !stack[top - 1].value};
+        continue;
+      case Op::NEG:
+        if (!isOfType(stack[top - 1].type, Blackboard::Type::INT)) {
+          return fail("`-` of a non-integer");
+        }
+        stack[top - 1] = {Blackboard::Type::INT, -stack[top - 1].value};
+        continue;
+      default:
+        break;
+    }
+
+    const Value rhs = stack[--top];
+    Value& lhs = stack[top - 1];
+    switch (instruction.op) {
+      case Op::AND:
+        lhs = {Blackboard::Type::BOOL, lhs.value && rhs.value};
+        continue;
+      case Op::OR:
+        lhs = {Blackboard::Type::BOOL, lhs.value || rhs.value};
+        continue;
+      case Op::EQ:
+      case Op::NE:
+        if (!isOfType(lhs.type, rhs.type)) {
+          return fail("comparing values of different types");
+        }
+        lhs = {Blackboard::Type::BOOL, (lhs.value == rhs.value) == (instruction.op == Op::EQ)};
+        continue;
+      default:
+        break;
+    }
+
+    // The interned strings aren't in any order, so only integers can be ordered.
+    if (!isOfType(lhs.type, Blackboard::Type::INT) || !isOfType(rhs.type, Blackboard::Type::INT)) {
+      return fail("ordering non-integers");
+    }
+    switch (instruction.op) {
+      case Op::LT:
+        lhs = {Blackboard::Type::BOOL, lhs.value < rhs.value};
+        break;
+      case Op::LE:
+        lhs = {Blackboard::Type::BOOL, lhs.value <= rhs.value};
+        break;
+      case Op::GT:
+        lhs = {Blackboard::Type::BOOL, lhs.value > rhs.value};
+        break;
+      case Op::GE:
+      default:
+        lhs = {Blackboard::Type::BOOL, lhs.value >= rhs.value};
+        break;
+    }
+  }
+  return stack[0].value != 0;
+}
+
+bool Expression::isOfType(const Blackboard::Type type, const Blackboard::Type expectedType) {
+  // An unset variable reads as 0, false or "", whichever is expected.
+  return type == expectedType || type == Blackboard::Type::NONE || expectedType == Blackboard::Type::NONE;
+}
+
+bool Expression::fail(const char* error) const {
+  VGLOG(LOG_ERR, "Failed to evaluate expression [%s]: %s.", _source.c_str(), error);
+  return false;
+}
+
+}  // namespace vigilante
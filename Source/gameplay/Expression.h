@@ -0,0 +1,75 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_EXPRESSION_H_
+#define VIGILANTE_EXPRESSION_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gameplay/Blackboard.h"
+
+namespace vigilante {
+
+// An Expression is a condition on the variables of the Blackboard, e.g.,
+//
+//   metTheKing && !questFailed && (wolvesKilled >= 3 || guildRank == 'gold')
+//
+// which supports integers, true/false, 'strings', variables, parentheses,
+// `!`, unary `-`, `==`, `!=`, `<`, `<=`, `>`, `>=`, `&&` and `||`.
+// A bare variable is true if it is non-zero, true or non-empty.
+//
+// Values are compared only with values of the same type (an unset variable
+// matches any type), and only integers are ordered, e.g., `guildRank == 3`
+// with a string `guildRank` is an error, which makes the expression false.
+//
+// Expressions are compiled once upon loading into postfix code over the
+// interned variable ids, so evaluating one never touches a string.
+// An empty expression is always true, and one which fails to compile
+// is always false.
+class Expression final {
+ public:
+  // The evaluation stack is fixed-size, and the
+  // expressions which would need more don't compile.
+  static inline constexpr size_t kMaxStackDepth = 16;
+
+  enum class Op : uint8_t {
+    PUSH,  // operand: an integer, a bool, or an interned string (see `type`)
+    LOAD,  // operand: Blackboard::VarId
+    NOT,
+    NEG,
+    AND,
+    OR,
+    EQ,
+    NE,
+    LT,
+    LE,
+    GT,
+    GE,
+  };
+
+  struct Instruction final {
+    Expression::Op op;
+    Blackboard::Type type;  // of the operand of PUSH
+    int32_t operand;
+  };
+
+  Expression() = default;
+
+  bool compile(const std::string& source);
+  bool evaluate() const;
+
+  inline bool isEmpty() const { return _source.empty(); }
+  inline const std::string& getSource() const { return _source; }
+
+ private:
+  static bool isOfType(const Blackboard::Type type, const Blackboard::Type expectedType);
+  bool fail(const char* error) const;
+
+  std::string _source;
+  std::vector<Expression::Instruction> _code;
+  bool _isValid{true};
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_EXPRESSION_H_
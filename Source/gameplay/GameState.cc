@@ -1,40 +1,393 @@
 // Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
 #include "GameState.h"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <string_view>
+#include <system_error>
 #include <vector>
 
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
 #include "character/Npc.h"
+#include "gameplay/Blackboard.h"
+#include "gameplay/Statistics.h"
+#include "gameplay/WorldClock.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
 #include "util/JsonUtil.h"
+#include "util/Logger.h"
+#include "util/StringUtil.h"
 
 using namespace std;
 
 namespace vigilante {
 
-void GameState::save() {
-  _json.SetObject();
+namespace {
+
+constexpr char kQuickSaveFileName[] = "quicksave.vgs";
+constexpr char kTmpFileExtension[] = ".tmp";
+constexpr char kBackupFileExtension[] = ".bak";
+
+// Each migration upgrades the body of a save by exactly one version,
+// i.e., kMigrations[i] upgrades a save from version i + 1 to i + 2.
+using Migration = void (*)(rapidjson::Document& json);
+
+void migrateFromV1(rapidjson::Document& json) {
+  auto& allocator = json.GetAllocator();
+
+  // Version 1 saves didn't keep track of the play time.
+  json.AddMember("playTime", 0.0f, allocator);
+
+  // "allPortalStates" has been renamed after GameMapManager::_allOpenableObjectStates.
+  rapidjson::Value& gameMap = json["gameMap"];
+  if (gameMap.HasMember("allPortalStates")) {
+    rapidjson::Value states(gameMap["allPortalStates"], allocator);
+    gameMap.RemoveMember("allPortalStates");
+    gameMap.AddMember("allOpenableObjectStates", states, allocator);
+  }
+}
+
+void migrateFromV2(rapidjson::Document& json) {
+  auto& allocator = json.GetAllocator();
+
+  // Version 2 saves had no world time. Their world Npcs are
+  // placed according to their schedules upon loading.
+  json.AddMember("worldTime", WorldClock::kNewGameTime, allocator);
+  json.AddMember("worldNpcs", rapidjson::Value(rapidjson::kArrayType), allocator);
+}
+
+void migrateFromV3(rapidjson::Document& json) {
+  // Version 3 saves had no blackboard, so no story variables are set.
+  json.AddMember("blackboard", rapidjson::Value(rapidjson::kObjectType), json.GetAllocator());
+}
+
+void migrateFromV4(rapidjson::Document& json) {
+  // Version 4 saves had no map exploration, so all maps are unexplored.
+  json.AddMember("mapExploration", rapidjson::Value(rapidjson::kObjectType), json.GetAllocator());
+}
+
+void migrateFromV5(rapidjson::Document& json) {
+  auto& allocator = json.GetAllocator();
+
+  // Version 5 saves had no statistics, so counting starts over from this save.
+  rapidjson::Value statistics(rapidjson::kObjectType);
+  statistics.AddMember("counters", rapidjson::Value(rapidjson::kObjectType), allocator);
+  statistics.AddMember("achievements", rapidjson::Value(rapidjson::kArrayType), allocator);
+  json.AddMember("statistics", statistics, allocator);
+}
+
+const array<Migration, GameState::kVersion - 1> kMigrations{{
+  &migrateFromV1,
+  &migrateFromV2,
+  &migrateFromV3,
+  &migrateFromV4,
+  &migrateFromV5,
+}};
+
+// The explored cells of each map are saved as a hex string, 16 digits per word.
+string toHexString(const vector<uint64_t>& words) {
+  string s;
+  s.reserve(words.size() * 16);
+  for (const uint64_t word : words) {
+    s += string_util::format("%016llx", static_cast<unsigned long long>(word));
+  }
+  return s;
+}
+
+bool fromHexString(const string& s, vector<uint64_t>& words) {
+  if (s.size() != words.size() * 16 ||
+      s.find_first_not_of("0123456789abcdef") != string::npos) {
+    return false;
+  }
+  for (size_t i = 0; i < words.size(); i++) {
+    words[i] = std::stoull(s.substr(i * 16, 16), nullptr, 16);
+  }
+  return true;
+}
+
+// 32-bit FNV-1a.
+uint32_t checksum(const string_view data) {
+  uint32_t hash = 0x811c9dc5U;
+  for (const char c : data) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x01000193U;
+  }
+  return hash;
+}
+
+fs::path withExtension(const fs::path& path, const char* extension) {
+  return fs::path{path.native() + extension};
+}
+
+bool isValidHeader(const rapidjson::Document& header) {
+  return !header.HasParseError() &&
+         header.IsObject() &&
+         header.HasMember("version") && header["version"].IsInt() &&
+         header.HasMember("checksum") && header["checksum"].IsUint() &&
+         header.HasMember("timestamp") && header["timestamp"].IsInt64() &&
+         header.HasMember("location") && header["location"].IsString() &&
+         header.HasMember("playTime") && header["playTime"].IsNumber() &&
+         header.HasMember("playerName") && header["playerName"].IsString() &&
+         header.HasMember("playerLevel") && header["playerLevel"].IsInt();
+}
+
+// Version 1 saves have no header, so the header is taken from their body.
+bool isValidV1Body(const rapidjson::Document& body) {
+  if (!body.HasMember("gameMap") || !body["gameMap"].IsObject() ||
+      !body.HasMember("player") || !body["player"].IsObject()) {
+    return false;
+  }
 
+  const rapidjson::Value& gameMap = body["gameMap"];
+  const rapidjson::Value& player = body["player"];
+  return gameMap.HasMember("tmxTiledMapFileName") && gameMap["tmxTiledMapFileName"].IsString() &&
+         player.HasMember("name") && player["name"].IsString() &&
+         player.HasMember("level") && player["level"].IsInt();
+}
+
+}  // namespace
+
+bool GameState::save() {
+  auto gameScene = SceneManager::the().getCurrentScene<GameScene>();
+  auto gmMgr = gameScene->getGameMapManager();
+  const auto& profile = gmMgr->getPlayer()->getCharacterProfile();
+
+  _json.SetObject();
   _json.AddMember("gameMap", serializeGameMapState(), _allocator);
   _json.AddMember("player", serializePlayerState(), _allocator);
+  _json.AddMember("playTime", gameScene->getPlayTime(), _allocator);
+  _json.AddMember("worldTime", WorldClock::the().getTime(), _allocator);
+  _json.AddMember("worldNpcs", serializeWorldNpcs(), _allocator);
+  _json.AddMember("blackboard", serializeBlackboard(), _allocator);
+  _json.AddMember("mapExploration", serializeMapExploration(), _allocator);
+  _json.AddMember("statistics", serializeStatistics(), _allocator);
+
+  rapidjson::StringBuffer body;
+  rapidjson::Writer<rapidjson::StringBuffer> bodyWriter(body);
+  _json.Accept(bodyWriter);
+
+  const int64_t timestamp = chrono::duration_cast<chrono::seconds>(
+      chrono::system_clock::now().time_since_epoch()).count();
+
+  rapidjson::Value headerJsonObject = json_util::serialize(_allocator,
+      make_pair("version", kVersion),
+      make_pair("checksum", checksum({body.GetString(), body.GetSize()})),
+      make_pair("timestamp", timestamp),
+      make_pair("location", gmMgr->getGameMap()->getTmxTiledMapFileName()),
+      make_pair("playTime", gameScene->getPlayTime()),
+      make_pair("playerName", profile.name),
+      make_pair("playerLevel", profile.level));
+
+  rapidjson::StringBuffer header;
+  rapidjson::Writer<rapidjson::StringBuffer> headerWriter(header);
+  headerJsonObject.Accept(headerWriter);
 
   VGLOG(LOG_INFO, "Saving to save file [%s].", _saveFilePath.c_str());
-  json_util::saveToFile(_saveFilePath, _json);
+
+  // Write everything to a temporary file first, so that a failed
+  // or interrupted write never clobbers the existing save.
+  const fs::path tmpFilePath = withExtension(_saveFilePath, kTmpFileExtension);
+  error_code ec;
+  {
+    ofstream ofs(tmpFilePath, ios::binary | ios::trunc);
+    if (!ofs.is_open()) {
+      VGLOG(LOG_ERR, "Failed to open [%s].", tmpFilePath.c_str());
+      return false;
+    }
+
+    ofs.write(header.GetString(), header.GetSize());
+    ofs.put('\n');
+    ofs.write(body.GetString(), body.GetSize());
+    ofs.flush();
+
+    if (!ofs) {
+      VGLOG(LOG_ERR, "Failed to write [%s].", tmpFilePath.c_str());
+      ofs.close();
+      fs::remove(tmpFilePath, ec);
+      return false;
+    }
+  }
+
+  // Keep the current save as the backup, but only if it is intact.
+  // Otherwise the backup still holds the last good save.
+  if (fs::exists(_saveFilePath, ec) && GameState{_saveFilePath}.readBody(_saveFilePath)) {
+    const fs::path backupFilePath = withExtension(_saveFilePath, kBackupFileExtension);
+    fs::copy_file(_saveFilePath, backupFilePath, fs::copy_options::overwrite_existing, ec);
+    if (ec) {
+      VGLOG(LOG_WARN, "Failed to back up [%s]: %s.", _saveFilePath.c_str(), ec.message().c_str());
+    }
+  }
+
+  fs::rename(tmpFilePath, _saveFilePath, ec);
+  if (ec) {
+    VGLOG(LOG_ERR, "Failed to replace [%s]: %s.", _saveFilePath.c_str(), ec.message().c_str());
+    return false;
+  }
+  return true;
 }
 
-void GameState::load() {
+bool GameState::load() {
   VGLOG(LOG_INFO, "Loading from save file [%s].", _saveFilePath.c_str());
-  _json = json_util::parseJson(_saveFilePath);
+  if (!readBody(_saveFilePath)) {
+    const fs::path backupFilePath = withExtension(_saveFilePath, kBackupFileExtension);
+    VGLOG(LOG_WARN, "Falling back to backup save file [%s].", backupFilePath.c_str());
+    if (!readBody(backupFilePath)) {
+      VGLOG(LOG_ERR, "Failed to load from save file [%s].", _saveFilePath.c_str());
+      return false;
+    }
+  }
 
-  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  auto gameScene = SceneManager::the().getCurrentScene<GameScene>();
+  auto gmMgr = gameScene->getGameMapManager();
   gmMgr->setNpcsAllowedToAct(false);
 
+  // The parked Npcs belong to the session being discarded, including the
+  // ones on the current map which would otherwise be parked upon unloading.
+  gmMgr->getNpcResidencyCache()->clear();
+  if (auto gameMap = gmMgr->getGameMap()) {
+    gameMap->_placedNpcs.clear();
+  }
+
+  WorldClock::the().setTime(_json["worldTime"].GetDouble());
+  deserializeWorldNpcs(_json["worldNpcs"]);
+  deserializeBlackboard(_json["blackboard"]);
+  deserializeMapExploration(_json["mapExploration"]);
+  deserializeStatistics(_json["statistics"]);
   deserializePlayerState(_json["player"].GetObject());
   deserializeGameMapState(_json["gameMap"].GetObject());
+  gameScene->setPlayTime(_json["playTime"].GetFloat());
 
-  auto hud = SceneManager::the().getCurrentScene<GameScene>()->getHud();
+  auto hud = gameScene->getHud();
   hud->updateEquippedWeapon();
   hud->updateStatusBars();
+  return true;
+}
+
+fs::path GameState::getSlotSaveFilePath(const int slot) {
+  // Slot 0 is the quick save slot, which is also
+  // where version 1 saves used to be written to.
+  if (slot == 0) {
+    return kQuickSaveFileName;
+  }
+  return string_util::format("save%d.vgs", slot);
+}
+
+vector<GameState::SlotInfo> GameState::getSlotInfos() {
+  vector<SlotInfo> slotInfos;
+  slotInfos.reserve(kSlotCount);
+
+  for (int slot = 0; slot < kSlotCount; slot++) {
+    SlotInfo info{slot, getSlotSaveFilePath(slot), /*isEmpty=*/true, {}};
+    info.isEmpty = !readHeader(info.saveFilePath, info.header) &&
+                   !readHeader(withExtension(info.saveFilePath, kBackupFileExtension), info.header);
+    slotInfos.push_back(std::move(info));
+  }
+  return slotInfos;
+}
+
+fs::path GameState::getMostRecentSaveFilePath() {
+  const vector<SlotInfo> slotInfos = getSlotInfos();
+
+  const SlotInfo* mostRecent = nullptr;
+  for (const auto& info : slotInfos) {
+    if (!info.isEmpty && (!mostRecent || info.header.timestamp > mostRecent->header.timestamp)) {
+      mostRecent = &info;
+    }
+  }
+  return mostRecent ? mostRecent->saveFilePath : fs::path{};
+}
+
+bool GameState::readHeader(const fs::path& saveFilePath, GameState::Header& header) {
+  ifstream ifs(saveFilePath, ios::binary);
+  if (!ifs.is_open()) {
+    return false;
+  }
+
+  string line;
+  if (!std::getline(ifs, line)) {
+    return false;
+  }
+
+  rapidjson::Document json;
+  json.Parse(line.c_str(), line.size());
+
+  // Version 1 saves have no header at all, and the entire file is the body.
+  if (!json.HasParseError() && json.IsObject() && !json.HasMember("version")) {
+    if (!isValidV1Body(json)) {
+      VGLOG(LOG_WARN, "Unreadable version 1 save [%s].", saveFilePath.c_str());
+      return false;
+    }
+    header = Header{};
+    header.version = 1;
+    header.location = json["gameMap"]["tmxTiledMapFileName"].GetString();
+    header.playerName = json["player"]["name"].GetString();
+    header.playerLevel = json["player"]["level"].GetInt();
+    return true;
+  }
+
+  if (!isValidHeader(json)) {
+    return false;
+  }
+  header.version = json["version"].GetInt();
+  header.timestamp = json["timestamp"].GetInt64();
+  header.location = json["location"].GetString();
+  header.playTime = json["playTime"].GetFloat();
+  header.playerName = json["playerName"].GetString();
+  header.playerLevel = json["playerLevel"].GetInt();
+  return true;
+}
+
+bool GameState::readBody(const fs::path& saveFilePath) {
+  ifstream ifs(saveFilePath, ios::binary);
+  if (!ifs.is_open()) {
+    VGLOG(LOG_ERR, "Failed to open [%s].", saveFilePath.c_str());
+    return false;
+  }
+  const string content{istreambuf_iterator<char>{ifs}, istreambuf_iterator<char>{}};
+
+  int version = 1;
+  string_view body{content};
+  if (const size_t pos = content.find('\n'); pos != string::npos) {
+    rapidjson::Document header;
+    header.Parse(content.c_str(), pos);
+    if (!isValidHeader(header)) {
+      VGLOG(LOG_ERR, "Invalid header in [%s].", saveFilePath.c_str());
+      return false;
+    }
+
+    body = body.substr(pos + 1);
+    if (checksum(body) != header["checksum"].GetUint()) {
+      VGLOG(LOG_ERR, "Checksum mismatch in [%s].", saveFilePath.c_str());
+      return false;
+    }
+    version = header["version"].GetInt();
+  }
+
+  _json.Parse(body.data(), body.size());
+  if (_json.HasParseError() || !_json.IsObject() ||
+      !_json.HasMember("gameMap") || !_json.HasMember("player")) {
+    VGLOG(LOG_ERR, "Failed to parse [%s].", saveFilePath.c_str());
+    return false;
+  }
+  return migrate(version);
+}
+
+bool GameState::migrate(const int version) {
+  if (version < 1 || version > kVersion) {
+    VGLOG(LOG_ERR, "Unsupported save version: %d (latest: %d).", version, kVersion);
+    return false;
+  }
+
+  for (int v = version; v < kVersion; v++) {
+    VGLOG(LOG_INFO, "Migrating save from version %d to %d.", v, v + 1);
+    kMigrations[v - 1](_json);
+  }
+  return true;
 }
 
 rapidjson::Value GameState::serializeGameMapState() const {
@@ -48,7 +401,7 @@ rapidjson::Value GameState::serializeGameMapState() const {
   return json_util::serialize(_allocator,
                               make_pair("tmxTiledMapFileName", gameMap->getTmxTiledMapFileName()),
                               make_pair("npcSpawningBlacklist", gmMgr->_npcSpawningBlacklist),
-                              make_pair("allPortalStates", gmMgr->_allOpenableObjectStates),
+                              make_pair("allOpenableObjectStates", gmMgr->_allOpenableObjectStates),
                               make_pair("playerPos", playerPosPair));
 }
 
@@ -62,7 +415,7 @@ void GameState::deserializeGameMapState(const rapidjson::Value& obj) const {
   json_util::deserialize(obj,
                          make_pair("tmxTiledMapFileName", &tmxTiledMapFileName),
                          make_pair("npcSpawningBlacklist", &gmMgr->_npcSpawningBlacklist),
-                         make_pair("allPortalStates", &gmMgr->_allOpenableObjectStates),
+                         make_pair("allOpenableObjectStates", &gmMgr->_allOpenableObjectStates),
                          make_pair("playerPos", &playerPos));
 
   gmMgr->loadGameMap(tmxTiledMapFileName, [=]() {
@@ -113,7 +466,8 @@ rapidjson::Value GameState::serializePlayerState() const {
 
 void GameState::deserializePlayerState(const rapidjson::Value& obj) const {
   auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
-  auto &profile = gmMgr->getPlayer()->getCharacterProfile();
+  auto player = gmMgr->getPlayer();
+  auto &profile = player->getCharacterProfile();
 
   rapidjson::Value inventoryJsonObject;
   rapidjson::Value partyJsonObject;
@@ -142,6 +496,8 @@ void GameState::deserializePlayerState(const rapidjson::Value& obj) const {
                          make_pair("inventory", &inventoryJsonObject),
                          make_pair("party", &partyJsonObject));
 
+  player->_statModifiers.markDirty();
+
   deserializePlayerInventory(inventoryJsonObject);
   deserializePlayerParty(partyJsonObject);
 }
@@ -196,6 +552,8 @@ void GameState::deserializePlayerInventory(const rapidjson::Value& obj) const {
   for (int type = 0; type < Equipment::Type::SIZE; type++) {
     player->unequip(static_cast<Equipment::Type>(type), /*audio=*/false);
   }
+  // Timed effects (e.g., from consumables) are not part of a save.
+  player->_statModifiers.clear();
 
   player->_items.clear();
   for (const auto& [itemJsonFileName, amount] : itemMapper) {
@@ -234,6 +592,7 @@ void GameState::deserializePlayerInventory(const rapidjson::Value& obj) const {
       continue;
     }
     player->_equipmentSlots[type] = equipment;
+    player->addEquipmentModifiers(*equipment);
   }
 }
 
@@ -292,4 +651,260 @@ void GameState::deserializePlayerParty(const rapidjson::Value& obj) const {
   }
 }
 
+rapidjson::Value GameState::serializeWorldNpcs() const {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  const WorldSimulation* worldSimulation = gmMgr->getWorldSimulation();
+
+  // The spawned Npcs are written back to their records first,
+  // so that the save reflects where they currently are.
+  vector<rapidjson::Value> records;
+  for (const auto& record : worldSimulation->_records) {
+    float x = record.x;
+    float y = record.y;
+    if (record.npc && record.npc->getBody()) {
+      const b2Vec2& pos = record.npc->getBody()->GetPosition();
+      x = pos.x * kPpm;
+      y = pos.y * kPpm;
+    }
+
+    const bool isKilled = record.isKilled || (record.npc && record.npc->isKilled());
+    const double respawnTime = (isKilled && !record.isKilled) ?
+      WorldClock::the().getTime() + worldSimulation->_definitions[record.definitionId].respawnTime :
+      record.respawnTime;
+    // A spawned Npc which is traveling hasn't left the map yet.
+    const double arrivalTime = (record.npc && record.activity == WorldSimulation::Activity::TRAVEL) ?
+      WorldClock::the().getTime() + WorldSimulation::kTravelTime :
+      record.arrivalTime;
+
+    auto obj = json_util::serialize(_allocator,
+                                    make_pair("json", worldSimulation->_definitions[record.definitionId].jsonFileName),
+                                    make_pair("tmxMapFileName", worldSimulation->_mapNames[record.mapId]),
+                                    make_pair("activity", static_cast<int>(record.activity)),
+                                    make_pair("isKilled", isKilled),
+                                    make_pair("hasLeft", record.hasLeft),
+                                    make_pair("x", x),
+                                    make_pair("y", y),
+                                    make_pair("arrivalTime", arrivalTime),
+                                    make_pair("respawnTime", respawnTime),
+                                    make_pair("restockTime", record.restockTime));
+    records.push_back(std::move(obj));
+  }
+
+  return json_util::makeJsonObject(_allocator, std::move(records));
+}
+
+void GameState::deserializeWorldNpcs(const rapidjson::Value& obj) const {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  WorldSimulation* worldSimulation = gmMgr->getWorldSimulation();
+  const double time = WorldClock::the().getTime();
+
+  // The actors of the current records are left on the current map,
+  // which is about to be unloaded along with them.
+  worldSimulation->_records.clear();
+  worldSimulation->_cursor = 0;
+  worldSimulation->_loadedMapId = WorldSimulation::kNoMapId;
+
+  vector<bool> hasRecord(worldSimulation->_definitions.size());
+  for (const auto& recordJson : obj.GetArray()) {
+    string jsonFileName;
+    string tmxMapFileName;
+    int activity = 0;
+    WorldSimulation::Record record{};
+    json_util::deserialize(recordJson,
+                           make_pair("json", &jsonFileName),
+                           make_pair("tmxMapFileName", &tmxMapFileName),
+                           make_pair("activity", &activity),
+                           make_pair("isKilled", &record.isKilled),
+                           make_pair("hasLeft", &record.hasLeft),
+                           make_pair("x", &record.x),
+                           make_pair("y", &record.y),
+                           make_pair("arrivalTime", &record.arrivalTime),
+                           make_pair("respawnTime", &record.respawnTime),
+                           make_pair("restockTime", &record.restockTime));
+
+    const int definitionId = worldSimulation->findDefinition(jsonFileName);
+    if (activity < 0 || activity >= static_cast<int>(WorldSimulation::Activity::SIZE)) {
+      VGLOG(LOG_WARN, "Discarding the record of world Npc [%s], invalid activity [%d].",
+            jsonFileName.c_str(), activity);
+      continue;
+    }
+    if (definitionId < 0 || hasRecord[definitionId]) {
+      VGLOG(LOG_WARN, "Discarding the record of world Npc [%s].", jsonFileName.c_str());
+      continue;
+    }
+
+    record.definitionId = static_cast<uint16_t>(definitionId);
+    record.mapId = worldSimulation->internMapName(tmxMapFileName);
+    record.activity = static_cast<WorldSimulation::Activity>(activity);
+    worldSimulation->_records.push_back(record);
+    hasRecord[definitionId] = true;
+  }
+
+  // World Npcs added to the game after this save was made.
+  for (size_t i = 0; i < hasRecord.size(); i++) {
+    if (!hasRecord[i]) {
+      worldSimulation->_records.push_back(worldSimulation->makeRecord(static_cast<uint16_t>(i), time));
+    }
+  }
+}
+
+rapidjson::Value GameState::serializeBlackboard() const {
+  const Blackboard& blackboard = Blackboard::the();
+
+  // Variables are saved by name, since the interned ids
+  // depend on the order in which the names are seen.
+  rapidjson::Value obj(rapidjson::kObjectType);
+  for (size_t i = 0; i < blackboard.getVarCount(); i++) {
+    const auto id = static_cast<Blackboard::VarId>(i);
+    rapidjson::Value value;
+    switch (blackboard.getType(id)) {
+      case Blackboard::Type::INT:
+        value.SetInt(blackboard.getInt(id));
+        break;
+      case Blackboard::Type::BOOL:
+        value.SetBool(blackboard.getBool(id));
+        break;
+      case Blackboard::Type::STRING:
+        value.SetString(blackboard.getString(id).c_str(), _allocator);
+        break;
+      default:
+        continue;
+    }
+    obj.AddMember(rapidjson::Value(blackboard.getName(id).c_str(), _allocator), value, _allocator);
+  }
+  return obj;
+}
+
+void GameState::deserializeBlackboard(const rapidjson::Value& obj) const {
+  Blackboard& blackboard = Blackboard::the();
+  blackboard.reset();
+
+  for (const auto& member : obj.GetObject()) {
+    const Blackboard::VarId id = blackboard.intern(member.name.GetString());
+    if (member.value.IsBool()) {
+      blackboard.setBool(id, member.value.GetBool());
+    } else if (member.value.IsInt()) {
+      blackboard.setInt(id, member.value.GetInt());
+    } else if (member.value.IsString()) {
+      blackboard.setString(id, member.value.GetString());
+    } else {
+      VGLOG(LOG_WARN, "Discarding blackboard variable [%s].", member.name.GetString());
+    }
+  }
+}
+
+rapidjson::Value GameState::serializeMapExploration() const {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  const MapExploration* mapExploration = gmMgr->getMapExploration();
+
+  rapidjson::Value obj(rapidjson::kObjectType);
+  for (const auto& [tmxMapFileName, record] : mapExploration->_records) {
+    vector<rapidjson::Value> connections;
+    for (const auto& connection : record.connections) {
+      connections.push_back(json_util::serialize(_allocator,
+                                                 make_pair("destMap", connection.destTmxMapFileName),
+                                                 make_pair("x", connection.x),
+                                                 make_pair("y", connection.y)));
+    }
+
+    auto recordJson = json_util::serialize(_allocator,
+                                           make_pair("cols", record.cols),
+                                           make_pair("rows", record.rows),
+                                           make_pair("width", record.width),
+                                           make_pair("height", record.height),
+                                           make_pair("exploredCells", toHexString(record.exploredCells)),
+                                           make_pair("connections", json_util::makeJsonObject(_allocator, std::move(connections))));
+    obj.AddMember(rapidjson::Value(tmxMapFileName.c_str(), _allocator), recordJson, _allocator);
+  }
+  return obj;
+}
+
+void GameState::deserializeMapExploration(const rapidjson::Value& obj) const {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  MapExploration* mapExploration = gmMgr->getMapExploration();
+
+  // The current map is about to be unloaded, and the record
+  // of the saved one is picked up once it is loaded.
+  mapExploration->reset();
+
+  for (const auto& member : obj.GetObject()) {
+    MapExploration::Record record;
+    string exploredCells;
+    list<rapidjson::Value> connections;
+    json_util::deserialize(member.value,
+                           make_pair("cols", &record.cols),
+                           make_pair("rows", &record.rows),
+                           make_pair("width", &record.width),
+                           make_pair("height", &record.height),
+                           make_pair("exploredCells", &exploredCells),
+                           make_pair("connections", &connections));
+
+    record.exploredCells.resize((static_cast<size_t>(std::max(record.cols, 0)) * std::max(record.rows, 0) + 63) / 64);
+    if (!fromHexString(exploredCells, record.exploredCells)) {
+      VGLOG(LOG_WARN, "Discarding the explored cells of [%s].", member.name.GetString());
+      std::fill(record.exploredCells.begin(), record.exploredCells.end(), 0);
+    }
+
+    for (const auto& connectionJson : connections) {
+      MapExploration::Connection connection;
+      json_util::deserialize(connectionJson,
+                             make_pair("destMap", &connection.destTmxMapFileName),
+                             make_pair("x", &connection.x),
+                             make_pair("y", &connection.y));
+      record.connections.push_back(std::move(connection));
+    }
+
+    mapExploration->_records.emplace(member.name.GetString(), std::move(record));
+  }
+}
+
+rapidjson::Value GameState::serializeStatistics() const {
+  const Statistics& statistics = Statistics::the();
+
+  // Like the blackboard, the counters are saved by name,
+  // and the ones which are still zero are left out.
+  rapidjson::Value counters(rapidjson::kObjectType);
+  for (size_t i = 0; i < statistics.getCounterCount(); i++) {
+    const auto id = static_cast<Statistics::CounterId>(i);
+    if (statistics.getCount(id) == 0) {
+      continue;
+    }
+    counters.AddMember(rapidjson::Value(statistics.getName(id).c_str(), _allocator),
+                       rapidjson::Value(statistics.getCount(id)), _allocator);
+  }
+
+  rapidjson::Value achievements(rapidjson::kArrayType);
+  for (const auto& achievement : statistics.getAchievements()) {
+    if (achievement.isUnlocked) {
+      achievements.PushBack(rapidjson::Value(achievement.name.c_str(), _allocator), _allocator);
+    }
+  }
+
+  rapidjson::Value obj(rapidjson::kObjectType);
+  obj.AddMember("counters", counters, _allocator);
+  obj.AddMember("achievements", achievements, _allocator);
+  return obj;
+}
+
+void GameState::deserializeStatistics(const rapidjson::Value& obj) const {
+  Statistics& statistics = Statistics::the();
+  statistics.reset();
+
+  for (const auto& member : obj["counters"].GetObject()) {
+    const Statistics::CounterId id = statistics.intern(member.name.GetString());
+    if (id == Statistics::kInvalidCounterId || !member.value.IsInt64()) {
+      VGLOG(LOG_WARN, "Discarding statistics counter [%s].", member.name.GetString());
+      continue;
+    }
+    statistics.setCount(id, member.value.GetInt64());
+  }
+
+  // The achievements which have been removed from the game are dropped.
+  for (const auto& achievementName : obj["achievements"].GetArray()) {
+    if (!statistics.setUnlocked(achievementName.GetString())) {
+      VGLOG(LOG_WARN, "Discarding unknown achievement [%s].", achievementName.GetString());
+    }
+  }
+}
+
 }  // namespace vigilante
@@ -2,7 +2,10 @@
 #ifndef VIGILANTE_GAME_STATE_H_
 #define VIGILANTE_GAME_STATE_H_
 
+#include <cstdint>
 #include <filesystem>
+#include <string>
+#include <vector>
 
 #include <rapidjson/document.h>
 
@@ -10,18 +13,55 @@ namespace fs = std::filesystem;
 
 namespace vigilante {
 
+// A save file consists of two lines: a small header and the body.
+// The header can be read without parsing the body, so that the
+// save slots can be listed quickly. The body is verified against
+// the checksum in the header, and it is migrated to the latest schema
+// version if it was written by an older version of the game.
+//
+// Saves are written to a temporary file first, which then atomically
+// replaces the old save. The last good save is kept as a backup and
+// is used if the save itself turns out to be corrupted.
 class GameState final {
  public:
+  static inline constexpr int kVersion = 6;
+  static inline constexpr int kSlotCount = 8;
+
+  struct Header final {
+    int version{};
+    int64_t timestamp{};  // seconds since epoch
+    std::string location;
+    float playTime{};  // seconds
+    std::string playerName;
+    int playerLevel{};
+  };
+
+  struct SlotInfo final {
+    int slot;
+    fs::path saveFilePath;
+    bool isEmpty;
+    Header header;
+  };
+
   explicit GameState(const fs::path& saveFilePath)
     : _saveFilePath{saveFilePath},
       _allocator{_json.GetAllocator()} {}
 
-  void save();
-  void load();
+  bool save();
+  bool load();
 
   inline const fs::path& getSaveFilePath() const { return _saveFilePath; }
 
+  static fs::path getSlotSaveFilePath(const int slot);
+  static std::vector<GameState::SlotInfo> getSlotInfos();
+  // Returns an empty path if there are no saves at all.
+  static fs::path getMostRecentSaveFilePath();
+  static bool readHeader(const fs::path& saveFilePath, GameState::Header& header);
+
  private:
+  bool readBody(const fs::path& saveFilePath);
+  bool migrate(const int version);
+
   rapidjson::Value serializeGameMapState() const;
   void deserializeGameMapState(const rapidjson::Value& obj) const;
 
@@ -34,6 +74,18 @@ class GameState final {
   rapidjson::Value serializePlayerParty() const;
   void deserializePlayerParty(const rapidjson::Value& obj) const;
 
+  rapidjson::Value serializeWorldNpcs() const;
+  void deserializeWorldNpcs(const rapidjson::Value& obj) const;
+
+  rapidjson::Value serializeBlackboard() const;
+  void deserializeBlackboard(const rapidjson::Value& obj) const;
+
+  rapidjson::Value serializeMapExploration() const;
+  void deserializeMapExploration(const rapidjson::Value& obj) const;
+
+  rapidjson::Value serializeStatistics() const;
+  void deserializeStatistics(const rapidjson::Value& obj) const;
+
   const fs::path _saveFilePath;
   rapidjson::Document _json;
   rapidjson::Document::AllocatorType& _allocator;
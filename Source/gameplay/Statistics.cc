@@ -0,0 +1,199 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "Statistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Localization.h"
+#include "scene/GameScene.h"
+#include "scene/SceneManager.h"
+#include "util/JsonUtil.h"
+#include "util/Logger.h"
+
+using namespace std;
+
+namespace vigilante {
+
+Statistics& Statistics::the() {
+  static Statistics instance;
+  return instance;
+}
+
+Statistics::Statistics() {
+  for (const auto& eventStr : kEventStr) {
+    intern(eventStr);
+  }
+}
+
+bool Statistics::loadAchievements(const fs::path& jsonFileName) {
+  _achievements.clear();
+  _watchers.clear();
+  _isWatched.fill(false);
+
+  if (!fs::exists(jsonFileName)) {
+    VGLOG(LOG_WARN, "No achievements defined in [%s].", jsonFileName.c_str());
+    return false;
+  }
+
+  rapidjson::Document json = json_util::parseJson(jsonFileName);
+  if (json.HasParseError() || !json.IsObject()) {
+    VGLOG(LOG_ERR, "Failed to load achievements from [%s].", jsonFileName.c_str());
+    return false;
+  }
+
+  //   "wolfHunter": {
+  //     "title": "@achievement.wolfHunter",
+  //     "desc": "@achievement.wolfHunter.desc",
+  //     "requirements": {"kills:Data/character/wolf.json": 10}
+  //   }
+  for (const auto& member : json.GetObject()) {
+    const rapidjson::Value& obj = member.value;
+    if (!obj.IsObject() ||
+        !obj.HasMember("title") || !obj["title"].IsString() ||
+        !obj.HasMember("desc") || !obj["desc"].IsString() ||
+        !obj.HasMember("requirements") || !obj["requirements"].IsObject()) {
+      VGLOG(LOG_ERR, "Discarding achievement [%s], it is malformed.", member.name.GetString());
+      continue;
+    }
+
+    Achievement achievement{member.name.GetString(), {}, {}, {}, false};
+    json_util::deserialize(obj,
+                           make_pair("title", &achievement.title),
+                           make_pair("desc", &achievement.desc));
+
+    bool isValid = true;
+    for (const auto& requirement : obj["requirements"].GetObject()) {
+      const CounterId id = intern(requirement.name.GetString());
+      if (id == kInvalidCounterId || !requirement.value.IsInt64()) {
+        isValid = false;
+        break;
+      }
+      achievement.requirements.emplace_back(id, requirement.value.GetInt64());
+    }
+    if (!isValid || achievement.requirements.empty()) {
+      VGLOG(LOG_ERR, "Discarding achievement [%s], it has invalid requirements.", member.name.GetString());
+      continue;
+    }
+
+    for (const auto& [id, _] : achievement.requirements) {
+      _watchers[id].push_back(_achievements.size());
+      _isWatched[id] = true;
+    }
+    _achievements.push_back(std::move(achievement));
+  }
+
+  _dirtyCounterIds.reserve(_watchers.size());
+  return true;
+}
+
+Statistics::CounterId Statistics::intern(const string& name) {
+  auto it = _counterIds.find(name);
+  if (it != _counterIds.end()) {
+    return it->second;
+  }
+
+  if (_names.size() >= kMaxCounterCount) {
+    VGLOG(LOG_ERR, "Failed to intern counter [%s], there are already %zu counters.",
+          name.c_str(), kMaxCounterCount);
+    return kInvalidCounterId;
+  }
+
+  const auto id = static_cast<CounterId>(_names.size());
+  _names.push_back(name);
+  _counterIds.emplace(name, id);
+  return id;
+}
+
+Statistics::CounterId Statistics::find(const string& name) const {
+  auto it = _counterIds.find(name);
+  return it != _counterIds.end() ? it->second : kInvalidCounterId;
+}
+
+Statistics::CounterId Statistics::internSubject(const Event event, const string& subject) {
+  return intern(kEventStr[static_cast<size_t>(event)] + ":" + subject);
+}
+
+void Statistics::recordFraction(const Event event, const float amount) {
+  float& fraction = _fractions[static_cast<size_t>(event)];
+  fraction += amount;
+  if (fraction < 1.0f) {
+    return;
+  }
+
+  const float whole = std::floor(fraction);
+  fraction -= whole;
+  record(event, static_cast<int64_t>(whole));
+}
+
+void Statistics::update(const float delta) {
+  recordFraction(Event::PLAY_TIME, delta);
+
+  if (_dirtyCounterIds.empty()) {
+    return;
+  }
+
+  for (const CounterId id : _dirtyCounterIds) {
+    _isDirty[id] = false;
+
+    for (const size_t i : _watchers[id]) {
+      Achievement& achievement = _achievements[i];
+      if (achievement.isUnlocked || !isFulfilled(achievement)) {
+        continue;
+      }
+
+      achievement.isUnlocked = true;
+      VGLOG(LOG_INFO, "Unlocked achievement [%s].", achievement.name.c_str());
+
+      auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
+      notifications->show(tr(StringId::ACHIEVEMENT_UNLOCKED, Localization::the().localize(achievement.title)));
+    }
+  }
+  _dirtyCounterIds.clear();
+}
+
+void Statistics::setCount(const CounterId id, const int64_t count) {
+  _counts[id] = count;
+
+  // An achievement added after the save was made
+  // is unlocked right away if it is already fulfilled.
+  if (_isWatched[id]) {
+    for (const size_t i : _watchers[id]) {
+      if (isFulfilled(_achievements[i])) {
+        _achievements[i].isUnlocked = true;
+      }
+    }
+  }
+}
+
+bool Statistics::setUnlocked(const string& achievementName) {
+  auto it = std::find_if(_achievements.begin(), _achievements.end(),
+                         [&achievementName](const Achievement& achievement) {
+                           return achievement.name == achievementName;
+                         });
+  if (it == _achievements.end()) {
+    return false;
+  }
+
+  it->isUnlocked = true;
+  return true;
+}
+
+void Statistics::reset() {
+  _counts.fill(0);
+  _isDirty.fill(false);
+  _dirtyCounterIds.clear();
+  _fractions.fill(0);
+
+  for (auto& achievement : _achievements) {
+    achievement.isUnlocked = false;
+  }
+}
+
+bool Statistics::isFulfilled(const Achievement& achievement) const {
+  return std::all_of(achievement.requirements.begin(), achievement.requirements.end(),
+                     [this](const pair<CounterId, int64_t>& requirement) {
+                       return _counts[requirement.first] >= requirement.second;
+                     });
+}
+
+}  // namespace vigilante
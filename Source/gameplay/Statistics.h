@@ -0,0 +1,142 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_STATISTICS_H_
+#define VIGILANTE_STATISTICS_H_
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace vigilante {
+
+// Statistics aggregates the gameplay events, e.g., kills, damage dealt,
+// items looted, distance travelled and play time, into counters which are
+// saved along with the game, and unlocks the achievements defined in
+// Data/gameplay/achievements.json once their counters reach the targets.
+//
+// Each event adds to the counter of its type, e.g., "kills", and optionally
+// to the counter of its subject, e.g., "kills:Data/character/wolf.json".
+// The counters live in a fixed-size array indexed by the ids interned from
+// their names, so recording an event is two additions and a flag test.
+// The achievements are evaluated once per frame, and only the ones which
+// depend on a counter that has changed since.
+class Statistics final {
+ public:
+  using CounterId = uint16_t;
+
+  static inline constexpr size_t kMaxCounterCount = 1024;
+  static inline constexpr CounterId kInvalidCounterId = std::numeric_limits<CounterId>::max();
+
+  // The counter of each event type is interned first,
+  // so its id is the value of the event type.
+  enum class Event : uint8_t {
+    KILL,
+    DAMAGE_DEALT,
+    DAMAGE_TAKEN,
+    ITEM_LOOTED,
+    MEMBER_RECRUITED,
+    DISTANCE_TRAVELLED,  // meters
+    PLAY_TIME,  // seconds
+    SIZE
+  };
+
+  static inline const std::array<std::string, static_cast<size_t>(Event::SIZE)> kEventStr{{
+    "kills",
+    "damageDealt",
+    "damageTaken",
+    "itemsLooted",
+    "membersRecruited",
+    "distanceTravelled",
+    "playTime",
+  }};
+
+  struct Achievement final {
+    std::string name;
+    std::string title;  // may be a localization key, e.g., "@achievement.wolfHunter"
+    std::string desc;
+    // All of the counters have to reach their targets.
+    std::vector<std::pair<Statistics::CounterId, int64_t>> requirements;
+    bool isUnlocked;
+  };
+
+  static Statistics& the();
+
+  bool loadAchievements(const fs::path& jsonFileName);
+
+  // Returns the id of the counter `name`, or kInvalidCounterId if there
+  // are already kMaxCounterCount counters. The same name always gives
+  // the same id until the game exits, even across saves.
+  CounterId intern(const std::string& name);
+  // e.g., internSubject(Event::KILL, "Data/character/wolf.json"). The ids of
+  // the subjects are interned once, when their profiles are loaded.
+  CounterId internSubject(const Event event, const std::string& subject);
+  // Returns the id of the counter `name` without interning it,
+  // or kInvalidCounterId if it hasn't been interned.
+  CounterId find(const std::string& name) const;
+
+  inline void record(const Event event, const int64_t amount,
+                     const CounterId subjectId = kInvalidCounterId) {
+    add(static_cast<CounterId>(event), amount);
+    if (subjectId != kInvalidCounterId) {
+      add(subjectId, amount);
+    }
+  }
+
+  // For the events measured in fractions, e.g., the distance travelled
+  // in a frame, which are only counted in whole units.
+  void recordFraction(const Event event, const float amount);
+
+  // Advances the play time, and unlocks the achievements
+  // whose counters have changed and reached their targets.
+  void update(const float delta);
+
+  inline int64_t getCount(const CounterId id) const { return _counts[id]; }
+  inline const std::string& getName(const CounterId id) const { return _names[id]; }
+  inline size_t getCounterCount() const { return _names.size(); }
+  inline const std::vector<Statistics::Achievement>& getAchievements() const { return _achievements; }
+
+  // Restores a counter or an achievement from a save. Neither of them
+  // shows a notification, even if it unlocks an achievement.
+  void setCount(const CounterId id, const int64_t count);
+  bool setUnlocked(const std::string& achievementName);
+
+  // Zeroes all the counters and locks all the achievements.
+  // The interned ids stay valid.
+  void reset();
+
+ private:
+  Statistics();
+
+  inline void add(const CounterId id, const int64_t amount) {
+    _counts[id] += amount;
+    if (_isWatched[id] && !_isDirty[id]) {
+      _isDirty[id] = true;
+      _dirtyCounterIds.push_back(id);
+    }
+  }
+
+  bool isFulfilled(const Statistics::Achievement& achievement) const;
+
+  std::array<int64_t, kMaxCounterCount> _counts{};
+  std::array<bool, kMaxCounterCount> _isWatched{};
+  std::array<bool, kMaxCounterCount> _isDirty{};
+  std::vector<CounterId> _dirtyCounterIds;
+  std::array<float, static_cast<size_t>(Event::SIZE)> _fractions{};
+
+  std::vector<std::string> _names;
+  std::unordered_map<std::string, CounterId> _counterIds;
+
+  std::vector<Statistics::Achievement> _achievements;
+  // The indices of the achievements which depend on each counter.
+  std::unordered_map<CounterId, std::vector<size_t>> _watchers;
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_STATISTICS_H_
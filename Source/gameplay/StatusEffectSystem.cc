@@ -0,0 +1,309 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "StatusEffectSystem.h"
+
+#include <algorithm>
+
+#include "character/Character.h"
+#include "gameplay/TimeScale.h"
+#include "util/JsonUtil.h"
+#include "util/Logger.h"
+
+using namespace std;
+USING_NS_AX;
+
+namespace vigilante {
+
+namespace {
+
+// Multiplier stat modifiers applied by slows are keyed by this prefix
+// plus the effect's json file name, see StatModifierStack::removeBySource().
+constexpr char kModifierSourcePrefix[] = "status_effect:";
+
+}  // namespace
+
+StatusEffectSystem& StatusEffectSystem::the() {
+  static StatusEffectSystem instance;
+  return instance;
+}
+
+void StatusEffectSystem::update(const float delta) {
+  std::erase_if(_cooldowns, [delta](Cooldown& cooldown) {
+    cooldown.remainingTime -= delta;
+    return cooldown.remainingTime <= 0.0f;
+  });
+
+  size_t i = 0;
+  while (i < _effects.size()) {
+    ActiveEffect& effect = _effects[i];
+    Character* target = effect.target;
+
+    if (target->isSetToKill() || target->isKilled()) {
+      // Swap-and-pop, the order of the table doesn't matter.
+      const ActiveEffect endedEffect = effect;
+      effect = _effects.back();
+      _effects.pop_back();
+      onEffectEnded(endedEffect);
+      continue;
+    }
+
+    // The target isn't on the map right now (e.g., while
+    // an ally is moving between maps), so hold the effect.
+    if (!target->getBody()) {
+      i++;
+      continue;
+    }
+
+    effect.remainingTime -= delta;
+
+    if (effect.profile->type == Type::DAMAGE_OVER_TIME) {
+      // A long frame may cover several ticks, so they're batched into one hit.
+      int numTicks = 0;
+      effect.tickTimer -= delta;
+      while (effect.tickTimer <= 0.0f) {
+        effect.tickTimer += effect.profile->tickInterval;
+        numTicks++;
+      }
+      if (numTicks) {
+        const float damage = effect.profile->magnitude * effect.stacks * numTicks;
+        target->receiveDamage(static_cast<int>(damage));
+      }
+    }
+
+    if (effect.remainingTime <= 0.0f) {
+      const ActiveEffect endedEffect = _effects[i];
+      _effects[i] = _effects.back();
+      _effects.pop_back();
+      onEffectEnded(endedEffect);
+      continue;
+    }
+
+    i++;
+  }
+}
+
+bool StatusEffectSystem::apply(Character* target, const string& effectJsonFileName, const void* source) {
+  if (!target) {
+    VGLOG(LOG_ERR, "Failed to apply status effect [%s], target: [nullptr].", effectJsonFileName.c_str());
+    return false;
+  }
+
+  if (target->isSetToKill() || target->isKilled() || target->isInvincible()) {
+    return false;
+  }
+
+  const auto& immunities = target->getCharacterProfile().statusEffectImmunities;
+  if (std::find(immunities.begin(), immunities.end(), effectJsonFileName) != immunities.end()) {
+    return false;
+  }
+
+  const Profile* profile = getProfile(effectJsonFileName);
+  if (!profile) {
+    return false;
+  }
+
+  if (source) {
+    const bool isCoolingDown = std::any_of(_cooldowns.begin(), _cooldowns.end(), [&](const Cooldown& c) {
+      return c.target == target && c.profile == profile && c.source == source;
+    });
+    if (isCoolingDown) {
+      return false;
+    }
+    _cooldowns.push_back({target, profile, source, profile->reapplyInterval});
+  }
+
+  auto it = std::find_if(_effects.begin(), _effects.end(), [target, profile](const ActiveEffect& e) {
+    return e.target == target && e.profile == profile;
+  });
+
+  if (it != _effects.end()) {
+    it->remainingTime = profile->duration;
+    if (it->stacks < profile->maxStacks) {
+      it->stacks++;
+      onStacksChanged(*it);
+    }
+    return true;
+  }
+
+  _effects.push_back({target, profile, profile->duration, profile->tickInterval, 1});
+  onEffectStarted(_effects.back());
+  return true;
+}
+
+void StatusEffectSystem::remove(Character* target, const string& effectJsonFileName) {
+  auto it = std::find_if(_effects.begin(), _effects.end(), [&](const ActiveEffect& e) {
+    return e.target == target && e.profile->jsonFileName == effectJsonFileName;
+  });
+  if (it == _effects.end()) {
+    return;
+  }
+
+  const ActiveEffect endedEffect = *it;
+  *it = _effects.back();
+  _effects.pop_back();
+  onEffectEnded(endedEffect);
+}
+
+void StatusEffectSystem::removeAll(Character* target) {
+  vector<ActiveEffect> endedEffects;
+  std::erase_if(_effects, [target, &endedEffects](const ActiveEffect& e) {
+    if (e.target != target) {
+      return false;
+    }
+    endedEffects.push_back(e);
+    return true;
+  });
+
+  for (const auto& effect : endedEffects) {
+    onEffectEnded(effect);
+  }
+}
+
+void StatusEffectSystem::forget(const Character* target) {
+  if (hasEffectOfType(target, Type::TIME_DILATION)) {
+    TimeScale::the().forget(target);
+  }
+  std::erase_if(_effects, [target](const ActiveEffect& e) { return e.target == target; });
+  std::erase_if(_cooldowns, [target](const Cooldown& c) { return c.target == target; });
+}
+
+bool StatusEffectSystem::hasEffect(const Character* target, const string& effectJsonFileName) const {
+  return std::any_of(_effects.begin(), _effects.end(), [&](const ActiveEffect& e) {
+    return e.target == target && e.profile->jsonFileName == effectJsonFileName;
+  });
+}
+
+const StatusEffectSystem::Profile* StatusEffectSystem::getProfile(const string& effectJsonFileName) {
+  auto it = _profiles.find(effectJsonFileName);
+  if (it != _profiles.end()) {
+    return it->second.get();
+  }
+
+  auto profile = std::make_unique<Profile>(effectJsonFileName);
+  if (profile->type >= Type::SIZE ||
+      (profile->type == Type::DAMAGE_OVER_TIME && profile->tickInterval <= 0.0f)) {
+    VGLOG(LOG_ERR, "Invalid status effect: [%s].", effectJsonFileName.c_str());
+    _profiles.emplace(effectJsonFileName, nullptr);
+    return nullptr;
+  }
+
+  return _profiles.emplace(effectJsonFileName, std::move(profile)).first->second.get();
+}
+
+void StatusEffectSystem::onEffectStarted(const ActiveEffect& effect) {
+  Character* target = effect.target;
+
+  switch (effect.profile->type) {
+    case Type::SLOW:
+      onStacksChanged(effect);
+      break;
+    case Type::STUN:
+      target->setStunned(true);
+      break;
+    case Type::TIME_DILATION:
+      updateTimeDilation(target);
+      break;
+    case Type::DAMAGE_OVER_TIME:
+    default:
+      break;
+  }
+
+  if (effect.profile->tint.has_value() && target->getBodySprite()) {
+    target->getBodySprite()->setColor(*effect.profile->tint);
+  }
+}
+
+void StatusEffectSystem::onStacksChanged(const ActiveEffect& effect) {
+  if (effect.profile->type == Type::TIME_DILATION) {
+    updateTimeDilation(effect.target);
+    return;
+  }
+
+  if (effect.profile->type != Type::SLOW) {
+    return;
+  }
+
+  const float multiplier = std::max(0.0f, 1.0f - effect.profile->magnitude * effect.stacks);
+  effect.target->getStatModifiers().add({
+    kModifierSourcePrefix + effect.profile->jsonFileName,
+    StatModifierStack::Stat::MOVE_SPEED,
+    StatModifierStack::Op::MULTIPLY,
+    multiplier,
+    /*duration=*/0,
+    StatModifierStack::Stacking::REPLACE
+  });
+}
+
+void StatusEffectSystem::onEffectEnded(const ActiveEffect& effect) {
+  Character* target = effect.target;
+
+  switch (effect.profile->type) {
+    case Type::SLOW:
+      target->getStatModifiers().removeBySource(kModifierSourcePrefix + effect.profile->jsonFileName);
+      break;
+    case Type::STUN:
+      if (!hasEffectOfType(target, Type::STUN)) {
+        target->setStunned(false);
+      }
+      break;
+    case Type::TIME_DILATION:
+      updateTimeDilation(target);
+      break;
+    case Type::DAMAGE_OVER_TIME:
+    default:
+      break;
+  }
+
+  if (effect.profile->tint.has_value() && target->getBodySprite()) {
+    target->getBodySprite()->setColor(getTint(target).value_or(Color3B::WHITE));
+  }
+}
+
+bool StatusEffectSystem::hasEffectOfType(const Character* target, const Type type) const {
+  return std::any_of(_effects.begin(), _effects.end(), [target, type](const ActiveEffect& e) {
+    return e.target == target && e.profile->type == type;
+  });
+}
+
+void StatusEffectSystem::updateTimeDilation(const Character* target) const {
+  // The time dilations of a target multiply, e.g., a haste cancels out a slow.
+  float scale = 1.0f;
+  for (const auto& effect : _effects) {
+    if (effect.target == target && effect.profile->type == Type::TIME_DILATION) {
+      scale *= std::max(0.0f, 1.0f + effect.profile->magnitude * effect.stacks);
+    }
+  }
+  TimeScale::the().setActorScale(target, scale);
+}
+
+optional<Color3B> StatusEffectSystem::getTint(const Character* target) const {
+  for (const auto& effect : _effects) {
+    if (effect.target == target && effect.profile->tint.has_value()) {
+      return effect.profile->tint;
+    }
+  }
+  return nullopt;
+}
+
+StatusEffectSystem::Profile::Profile(const string& jsonFileName) : jsonFileName{jsonFileName} {
+  rapidjson::Document json = json_util::parseJson(jsonFileName);
+  if (!json.IsObject()) {
+    type = Type::SIZE;
+    return;
+  }
+
+  name = json["name"].GetString();
+  type = static_cast<StatusEffectSystem::Type>(json["type"].GetInt());
+  duration = json["duration"].GetFloat();
+  tickInterval = json["tickInterval"].GetFloat();
+  magnitude = json["magnitude"].GetFloat();
+  maxStacks = std::max(1, json["maxStacks"].GetInt());
+  reapplyInterval = json.HasMember("reapplyInterval") ?
+      json["reapplyInterval"].GetFloat() : kDefaultReapplyInterval;
+
+  if (json.HasMember("tint")) {
+    const auto& tintJson = json["tint"].GetArray();
+    tint = Color3B(tintJson[0].GetInt(), tintJson[1].GetInt(), tintJson[2].GetInt());
+  }
+}
+
+}  // namespace vigilante
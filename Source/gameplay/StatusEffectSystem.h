@@ -0,0 +1,123 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_STATUS_EFFECT_SYSTEM_H_
+#define VIGILANTE_STATUS_EFFECT_SYSTEM_H_
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <axmol.h>
+
+namespace vigilante {
+
+class Character;
+
+// StatusEffectSystem manages the status effects (poison, burn, bleed, slow,
+// stun, ...) of all characters. The active effects are stored in a single
+// contiguous table which is ticked in one pass per frame, and damage over
+// time is fed into Character::receiveDamage().
+//
+// Status effects are defined in json, e.g., Data/status_effect/poison.json:
+// {
+//   "name": "Poison",
+//   "type": 0,  // see StatusEffectSystem::Type
+//   "duration": 6.0,
+//   "tickInterval": 1.0,
+//   "magnitude": 3,  // damage per tick, the move speed reduction of a slow,
+//                    // or the time scale change of a time dilation
+//   "maxStacks": 3,
+//   "reapplyInterval": 1.0,  // optional
+//   "tint": [170, 255, 170]  // optional
+// }
+//
+// A source which keeps applying an effect (e.g., a trigger area, which applies
+// it every frame while a character stands in it) only gets through once per
+// reapplyInterval per target, so it doesn't reach maxStacks at once.
+//
+// A time dilation scales the whole time of its target with TimeScale (its
+// animations, timers and AI), slowing it down with a negative magnitude
+// (e.g., -0.2 per stack) or hasting it with a positive one.
+class StatusEffectSystem final {
+ public:
+  enum Type {
+    DAMAGE_OVER_TIME,
+    SLOW,
+    STUN,
+    TIME_DILATION,
+    SIZE
+  };
+
+  struct Profile final {
+    static inline constexpr float kDefaultReapplyInterval = 1.0f;
+
+    explicit Profile(const std::string& jsonFileName);
+
+    std::string jsonFileName;
+    std::string name;
+    StatusEffectSystem::Type type;
+    float duration;
+    float tickInterval;
+    float magnitude;
+    int maxStacks;
+    float reapplyInterval;
+    std::optional<ax::Color3B> tint;
+  };
+
+  static StatusEffectSystem& the();
+
+  void update(const float delta);
+
+  // Applies the status effect defined in `effectJsonFileName` to `target`.
+  // If it is already active, its duration is refreshed, and another stack
+  // is added unless it's already at maxStacks. A continuous `source` (e.g.,
+  // a trigger) fails if it has already applied the same effect to `target`
+  // within its reapplyInterval. Discrete hits pass no source.
+  bool apply(Character* target, const std::string& effectJsonFileName, const void* source = nullptr);
+  void remove(Character* target, const std::string& effectJsonFileName);
+  // Ends all the status effects of `target`.
+  void removeAll(Character* target);
+  // Drops all the status effects of `target` without touching it.
+  // Must be called before `target` is destroyed.
+  void forget(const Character* target);
+
+  bool hasEffect(const Character* target, const std::string& effectJsonFileName) const;
+  inline size_t getNumActiveEffects() const { return _effects.size(); }
+
+ private:
+  struct ActiveEffect final {
+    Character* target;
+    const StatusEffectSystem::Profile* profile;
+    float remainingTime;
+    float tickTimer;
+    int stacks;
+  };
+
+  struct Cooldown final {
+    const Character* target;
+    const StatusEffectSystem::Profile* profile;
+    const void* source;  // only compared, never dereferenced
+    float remainingTime;
+  };
+
+  StatusEffectSystem() = default;
+
+  const StatusEffectSystem::Profile* getProfile(const std::string& effectJsonFileName);
+  void onEffectStarted(const StatusEffectSystem::ActiveEffect& effect);
+  void onStacksChanged(const StatusEffectSystem::ActiveEffect& effect);
+  // `effect` must have already been removed from `_effects`.
+  void onEffectEnded(const StatusEffectSystem::ActiveEffect& effect);
+  bool hasEffectOfType(const Character* target, const StatusEffectSystem::Type type) const;
+  void updateTimeDilation(const Character* target) const;
+  std::optional<ax::Color3B> getTint(const Character* target) const;
+
+  std::vector<StatusEffectSystem::ActiveEffect> _effects;
+  std::vector<StatusEffectSystem::Cooldown> _cooldowns;
+  // The profiles which failed to load are kept as nullptr, so they're only loaded once.
+  std::unordered_map<std::string, std::unique_ptr<StatusEffectSystem::Profile>> _profiles;
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_STATUS_EFFECT_SYSTEM_H_
@@ -0,0 +1,69 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "TimeScale.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace vigilante {
+
+TimeScale& TimeScale::the() {
+  static TimeScale instance;
+  return instance;
+}
+
+float TimeScale::update(const float delta) {
+  if (!_hitStops.empty()) {
+    for (auto& hitStop : _hitStops) {
+      hitStop.remainingTime -= delta;
+    }
+    std::erase_if(_hitStops, [](const HitStop& hitStop) { return hitStop.remainingTime <= 0; });
+    updateScale();
+  }
+
+  return delta * _scale;
+}
+
+void TimeScale::reset() {
+  _globalScale = 1.0f;
+  _hitStops.clear();
+  _actorScales.clear();
+  updateScale();
+}
+
+void TimeScale::pushHitStop(const float duration, const float scale) {
+  if (duration <= 0) {
+    return;
+  }
+
+  _hitStops.push_back({duration, std::max(0.0f, scale)});
+  updateScale();
+}
+
+void TimeScale::setActorScale(const DynamicActor* actor, const float scale) {
+  if (scale == 1.0f) {
+    _actorScales.erase(actor);
+    return;
+  }
+  _actorScales[actor] = std::max(kMinActorScale, scale);
+}
+
+float TimeScale::getActorScale(const DynamicActor* actor) const {
+  auto it = _actorScales.find(actor);
+  return (it != _actorScales.end()) ? it->second : 1.0f;
+}
+
+void TimeScale::forget(const DynamicActor* actor) {
+  _actorScales.erase(actor);
+}
+
+void TimeScale::updateScale() {
+  // Overlapping hit-stops don't multiply, the strongest one wins.
+  float hitStopScale = 1.0f;
+  for (const auto& hitStop : _hitStops) {
+    hitStopScale = std::min(hitStopScale, hitStop.scale);
+  }
+  _scale = std::max(0.0f, _globalScale) * hitStopScale;
+}
+
+}  // namespace vigilante
@@ -0,0 +1,66 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_TIME_SCALE_H_
+#define VIGILANTE_TIME_SCALE_H_
+
+#include <unordered_map>
+#include <vector>
+
+namespace vigilante {
+
+class DynamicActor;
+
+// TimeScale turns the real frame time into the game time consumed by the
+// simulation (physics, actors, animations, fx and scheduled callbacks),
+// while the UI and the console keep running on real time.
+//
+// The game time is scaled by a global scale and by the strongest of the
+// active hit-stops, which expire in real time. Each actor can be further
+// dilated with its own scale (e.g., a slowed enemy).
+class TimeScale final {
+ public:
+  // An actor can be slowed down, but never frozen by its own scale,
+  // otherwise its timers would never expire.
+  static inline constexpr float kMinActorScale = .05f;
+
+  static TimeScale& the();
+
+  // Advances the hit-stops by the real `delta`,
+  // and returns the game time of this frame.
+  float update(const float delta);
+  void reset();
+
+  // Freezes the game for `duration` seconds of real time,
+  // or slows it down if `scale` is greater than 0.
+  void pushHitStop(const float duration, const float scale=0.0f);
+
+  void setActorScale(const DynamicActor* actor, const float scale);
+  float getActorScale(const DynamicActor* actor) const;
+  // Must be called before `actor` is destroyed.
+  void forget(const DynamicActor* actor);
+
+  // The scale of the game time, and of the time of `actor`.
+  inline float getScale() const { return _scale; }
+  inline float getScale(const DynamicActor* actor) const { return _scale * getActorScale(actor); }
+
+  inline float getGlobalScale() const { return _globalScale; }
+  inline void setGlobalScale(const float scale) { _globalScale = scale; updateScale(); }
+
+ private:
+  struct HitStop final {
+    float remainingTime;
+    float scale;
+  };
+
+  TimeScale() = default;
+
+  void updateScale();
+
+  float _globalScale{1.0f};
+  float _scale{1.0f};
+  std::vector<TimeScale::HitStop> _hitStops;
+  std::unordered_map<const DynamicActor*, float> _actorScales;
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_TIME_SCALE_H_
@@ -0,0 +1,164 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "TradeSession.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "Assets.h"
+#include "Localization.h"
+#include "character/Character.h"
+#include "character/Player.h"
+#include "gameplay/ItemPriceTable.h"
+#include "item/Item.h"
+#include "util/Logger.h"
+
+using namespace std;
+
+namespace vigilante {
+
+TradeSession::TradeSession(Character* a, Character* b, const bool isFree)
+    : _a{a},
+      _b{b},
+      _isFree{isFree} {}
+
+int TradeSession::addToCart(Character* owner, Item* item, const int amount) {
+  if (!owner || !item || amount <= 0) {
+    return 0;
+  }
+
+  const string& itemJsonFileName = item->getItemProfile().jsonFileName;
+  const int available = owner->getItemAmount(itemJsonFileName) - getAmountInCart(owner, itemJsonFileName);
+  const int amountToAdd = std::min(amount, available);
+  if (amountToAdd <= 0) {
+    return 0;
+  }
+
+  auto it = std::find_if(_cart.begin(), _cart.end(), [owner, &itemJsonFileName](const CartEntry& e) {
+    return e.owner == owner && e.itemJsonFileName == itemJsonFileName;
+  });
+
+  if (it != _cart.end()) {
+    it->amount += amountToAdd;
+  } else {
+    const int unitPrice = (_isFree || item->isGold()) ? 0 : item_price_table::getPrice(item);
+    _cart.push_back({owner, itemJsonFileName, item->getName(), unitPrice, amountToAdd});
+  }
+  return amountToAdd;
+}
+
+void TradeSession::clearCart() {
+  _cart.clear();
+}
+
+bool TradeSession::commit(string& errMsg) {
+  if (_cart.empty()) {
+    return true;
+  }
+
+  // Check everything up front, so that in most cases nothing has to be rolled back.
+  for (const auto& entry : _cart) {
+    if (entry.owner->getItemAmount(entry.itemJsonFileName) < entry.amount) {
+      errMsg = tr(StringId::TRADE_NOT_ENOUGH_ITEMS, entry.owner->getCharacterProfile().name, entry.itemName);
+      return false;
+    }
+  }
+
+  const int netPrice = getNetPrice();
+  Character* payer = (netPrice > 0) ? _a : _b;
+  Character* payee = getCounterparty(payer);
+  const int gold = std::abs(netPrice);
+  const int goldInCart = getAmountInCart(payer, assets::kGoldCoin.string());
+  if (gold && payer->getGoldBalance() < gold + goldInCart) {
+    errMsg = tr(StringId::TRADE_NOT_ENOUGH_GOLD, payer->getCharacterProfile().name);
+    return false;
+  }
+
+  vector<Operation> ops;
+  ops.reserve(_cart.size() * 2 + 2);
+  for (const auto& entry : _cart) {
+    ops.push_back({entry.owner, entry.itemJsonFileName, -entry.amount});
+    ops.push_back({getCounterparty(entry.owner), entry.itemJsonFileName, entry.amount});
+  }
+  if (gold) {
+    const string goldJsonFileName = assets::kGoldCoin.string();
+    ops.push_back({payer, goldJsonFileName, -gold});
+    ops.push_back({payee, goldJsonFileName, gold});
+  }
+
+  // The player is notified once for the whole cart rather than for every stack.
+  vector<Player*> players;
+  for (Character* c : {_a, _b}) {
+    if (auto player = dynamic_cast<Player*>(c)) {
+      player->beginItemBatch();
+      players.push_back(player);
+    }
+  }
+
+  vector<Operation> journal;
+  journal.reserve(ops.size());
+  for (const auto& op : ops) {
+    if (!apply(op)) {
+      rollback(journal);
+      for (auto player : players) {
+        player->endItemBatch(/*commit=*/false);
+      }
+      errMsg = tr(StringId::TRADE_FAILED);
+      return false;
+    }
+    journal.push_back(op);
+  }
+
+  for (auto player : players) {
+    player->endItemBatch(/*commit=*/true);
+  }
+  _cart.clear();
+  return true;
+}
+
+int TradeSession::getAmountInCart(const Character* owner, const string& itemJsonFileName) const {
+  int amount = 0;
+  for (const auto& entry : _cart) {
+    if (entry.owner == owner && entry.itemJsonFileName == itemJsonFileName) {
+      amount += entry.amount;
+    }
+  }
+  return amount;
+}
+
+int TradeSession::getNetPrice() const {
+  int netPrice = 0;
+  for (const auto& entry : _cart) {
+    const int price = entry.unitPrice * entry.amount;
+    netPrice += (entry.owner == _b) ? price : -price;
+  }
+  return netPrice;
+}
+
+Character* TradeSession::getCounterparty(const Character* c) const {
+  return (c == _a) ? _b : _a;
+}
+
+bool TradeSession::apply(const Operation& op) {
+  if (op.amount > 0) {
+    return op.owner->addItem(Item::create(op.itemJsonFileName), op.amount);
+  }
+
+  Item* item = op.owner->getItem(op.itemJsonFileName);
+  if (!item || item->getAmount() < -op.amount) {
+    VGLOG(LOG_ERR, "Failed to remove [%s] x%d from [%s].", op.itemJsonFileName.c_str(),
+          -op.amount, op.owner->getCharacterProfile().name.c_str());
+    return false;
+  }
+  return op.owner->removeItem(item, -op.amount);
+}
+
+void TradeSession::rollback(const vector<Operation>& journal) {
+  for (auto it = journal.rbegin(); it != journal.rend(); it++) {
+    if (!apply({it->owner, it->itemJsonFileName, -it->amount})) {
+      VGLOG(LOG_ERR, "Failed to roll back [%s] x%d for [%s].", it->itemJsonFileName.c_str(),
+            it->amount, it->owner->getCharacterProfile().name.c_str());
+    }
+  }
+}
+
+}  // namespace vigilante
@@ -0,0 +1,64 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_TRADE_SESSION_H_
+#define VIGILANTE_TRADE_SESSION_H_
+
+#include <string>
+#include <vector>
+
+namespace vigilante {
+
+class Character;
+class Item;
+
+// A TradeSession collects the items both parties want to give away in a cart,
+// and then commits all of them (along with the gold) as a single transaction.
+// If any part of it fails, everything applied so far is rolled back.
+class TradeSession final {
+ public:
+  struct CartEntry final {
+    Character* owner;  // the one who gives this item away
+    std::string itemJsonFileName;
+    std::string itemName;
+    int unitPrice;
+    int amount;
+  };
+
+  TradeSession(Character* a, Character* b, const bool isFree);
+
+  // Adds up to `amount` of `item` from `owner` to the cart.
+  // Returns the amount which was actually added.
+  int addToCart(Character* owner, Item* item, const int amount);
+  void clearCart();
+
+  // Commits all the trades in the cart. On failure, `errMsg` is set
+  // and both parties are left with the same items as before, although
+  // the stacks which were rolled back are new objects.
+  bool commit(std::string& errMsg);
+
+  int getAmountInCart(const Character* owner, const std::string& itemJsonFileName) const;
+  // The amount of gold `a` pays to `b`. Negative if `b` pays `a`.
+  int getNetPrice() const;
+  inline const std::vector<TradeSession::CartEntry>& getCart() const { return _cart; }
+  inline bool isCartEmpty() const { return _cart.empty(); }
+
+ private:
+  // A single inventory change: `amount` > 0 adds items, `amount` < 0 removes them.
+  struct Operation final {
+    Character* owner;
+    std::string itemJsonFileName;
+    int amount;
+  };
+
+  Character* getCounterparty(const Character* c) const;
+  bool apply(const TradeSession::Operation& op);
+  void rollback(const std::vector<TradeSession::Operation>& journal);
+
+  Character* _a;
+  Character* _b;
+  const bool _isFree;  // e.g., trading with an ally
+  std::vector<TradeSession::CartEntry> _cart;
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_TRADE_SESSION_H_
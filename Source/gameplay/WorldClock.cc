@@ -0,0 +1,31 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "WorldClock.h"
+
+#include "Localization.h"
+#include "util/StringUtil.h"
+
+using namespace std;
+
+namespace vigilante {
+
+WorldClock& WorldClock::the() {
+  static WorldClock instance;
+  return instance;
+}
+
+void WorldClock::update(const float delta) {
+  _time += delta * kMinutesPerSecond;
+}
+
+void WorldClock::reset() {
+  _time = kNewGameTime;
+}
+
+string WorldClock::toString() const {
+  const int minuteOfDay = getMinuteOfDay();
+  return tr(StringId::WORLD_CLOCK, getDay(),
+            string_util::format("%02d", minuteOfDay / kMinutesPerHour),
+            string_util::format("%02d", minuteOfDay % kMinutesPerHour));
+}
+
+}  // namespace vigilante
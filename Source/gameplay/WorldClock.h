@@ -0,0 +1,42 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_WORLD_CLOCK_H_
+#define VIGILANTE_WORLD_CLOCK_H_
+
+#include <string>
+
+namespace vigilante {
+
+// WorldClock keeps the in-game time of the world in minutes, which keeps
+// running regardless of which GameMap is loaded. It is advanced once per
+// frame with the game time and saved along with the game.
+class WorldClock final {
+ public:
+  static inline constexpr int kMinutesPerHour = 60;
+  static inline constexpr int kMinutesPerDay = 24 * kMinutesPerHour;
+  // How many in-game minutes pass per real second.
+  static inline constexpr double kMinutesPerSecond = 1.0;
+  // A new game begins at 08:00 on day 1.
+  static inline constexpr double kNewGameTime = 8 * kMinutesPerHour;
+
+  static WorldClock& the();
+
+  void update(const float delta);
+  void reset();
+
+  inline double getTime() const { return _time; }
+  inline void setTime(const double time) { _time = time; }
+  inline int getDay() const { return static_cast<int>(_time) / kMinutesPerDay + 1; }
+  inline int getMinuteOfDay() const { return static_cast<int>(_time) % kMinutesPerDay; }
+
+  // e.g., "Day 3, 07:45"
+  std::string toString() const;
+
+ private:
+  WorldClock() = default;
+
+  double _time{kNewGameTime};
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_WORLD_CLOCK_H_
@@ -0,0 +1,421 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "ActionMapper.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "input/HotkeyManager.h"
+#include "input/InputManager.h"
+#include "util/JsonUtil.h"
+#include "util/Logger.h"
+
+using namespace std;
+USING_NS_AX;
+
+namespace vigilante {
+
+namespace {
+
+constexpr array<const char*, ActionMapper::Action::SIZE> kActionNames{{
+  "moveLeft",
+  "moveRight",
+  "aimUp",
+  "crouch",
+  "jump",
+  "dodge",
+  "attack",
+  "block",
+  "interact",
+  "pickupItem",
+  "usePortal",
+  "hotkey1",
+  "hotkey2",
+  "hotkey3",
+  "hotkey4",
+  "hotkey5",
+  "worldMap",
+  "menuUp",
+  "menuDown",
+  "menuLeft",
+  "menuRight",
+  "menuConfirm",
+  "menuPrevTab",
+  "menuNextTab",
+  "menuCommit",
+  "pause",
+  "debugDraw",
+  "console",
+}};
+
+bool isGamepad(const ActionMapper::InputSource& source) {
+  return source.type != ActionMapper::InputSource::Type::KEYBOARD;
+}
+
+}  // namespace
+
+ActionMapper& ActionMapper::the() {
+  static ActionMapper instance;
+  return instance;
+}
+
+ActionMapper::ActionMapper() {
+  resetToDefaults();
+}
+
+ActionMapper::Group ActionMapper::getGroup(const Action action) {
+  return action < Action::MENU_UP ? Group::GAMEPLAY : Group::MENU;
+}
+
+void ActionMapper::update() {
+  ActionMask pressedActions = 0;
+  for (const auto& [action, source] : _activeSources) {
+    if (isSourceActive(source)) {
+      pressedActions |= toMask(action);
+    }
+  }
+
+  _lastPressedActions = _pressedActions;
+  _lastJustPressedActions = _justPressedActions;
+  setPressedActions(pressedActions);
+}
+
+void ActionMapper::overridePressedActions(const ActionMask pressedActions) {
+  setPressedActions(pressedActions);
+}
+
+void ActionMapper::setPressedActions(const ActionMask pressedActions) {
+  // The presses which haven't been consumed yet carry over while still held.
+  const ActionMask newlyPressedActions = pressedActions & ~_lastPressedActions;
+  _justPressedActions = (_lastJustPressedActions | newlyPressedActions) & pressedActions;
+  _pressedActions = pressedActions;
+}
+
+bool ActionMapper::load(const fs::path& bindingsFileName) {
+  if (!fs::exists(bindingsFileName)) {
+    return false;
+  }
+
+  rapidjson::Document json = json_util::parseJson(bindingsFileName);
+  if (!json.IsObject()) {
+    VGLOG(LOG_ERR, "Failed to load input bindings from [%s].", bindingsFileName.c_str());
+    return false;
+  }
+
+  // Actions which are missing from the file keep their default bindings,
+  // so that newly added actions still work with an old bindings file.
+  for (int i = 0; i < Action::SIZE; i++) {
+    if (!json.HasMember(kActionNames[i])) {
+      continue;
+    }
+
+    const rapidjson::Value& sourcesJson = json[kActionNames[i]];
+    if (!sourcesJson.IsArray()) {
+      VGLOG(LOG_ERR, "Invalid input bindings of [%s], expected an array.", kActionNames[i]);
+      continue;
+    }
+
+    _bindings[i].clear();
+    for (const auto& sourceJson : sourcesJson.GetArray()) {
+      if (!sourceJson.IsArray() || sourceJson.Size() != 3 ||
+          !sourceJson[0].IsInt() || !sourceJson[1].IsInt() || !sourceJson[2].IsInt()) {
+        VGLOG(LOG_ERR, "Invalid input binding of [%s], expected [type, code, axisSign].", kActionNames[i]);
+        continue;
+      }
+
+      const int type = sourceJson[0].GetInt();
+      const int axisSign = sourceJson[2].GetInt();
+      if (type < InputSource::Type::KEYBOARD || type > InputSource::Type::GAMEPAD_AXIS ||
+          (type == InputSource::Type::GAMEPAD_AXIS && axisSign != 1 && axisSign != -1)) {
+        VGLOG(LOG_ERR, "Invalid input binding of [%s]: type [%d], axisSign [%d].",
+              kActionNames[i], type, axisSign);
+        continue;
+      }
+      _bindings[i].push_back({static_cast<InputSource::Type>(type), sourceJson[1].GetInt(), axisSign});
+    }
+  }
+
+  rebuildActiveSources();
+  return true;
+}
+
+bool ActionMapper::save(const fs::path& bindingsFileName) const {
+  rapidjson::Document json;
+  json.SetObject();
+  rapidjson::Document::AllocatorType& allocator = json.GetAllocator();
+
+  for (int i = 0; i < Action::SIZE; i++) {
+    vector<vector<int>> sources;
+    for (const auto& source : _bindings[i]) {
+      sources.push_back({source.type, source.code, source.axisSign});
+    }
+    json.AddMember(rapidjson::StringRef(kActionNames[i]),
+                   json_util::makeJsonObject(allocator, sources),
+                   allocator);
+  }
+
+  json_util::saveToFile(bindingsFileName, json);
+  VGLOG(LOG_INFO, "Saved input bindings to [%s].", bindingsFileName.c_str());
+  return true;
+}
+
+void ActionMapper::resetToDefaults() {
+  using Key = EventKeyboard::KeyCode;
+
+  for (auto& sources : _bindings) {
+    sources.clear();
+  }
+
+  _bindings[Action::MOVE_LEFT] = {
+    keyboard(Key::KEY_LEFT_ARROW),
+    gamepadButton(Controller::Key::BUTTON_DPAD_LEFT),
+    gamepadAxis(Controller::Key::JOYSTICK_LEFT_X, -1)
+  };
+  _bindings[Action::MOVE_RIGHT] = {
+    keyboard(Key::KEY_RIGHT_ARROW),
+    gamepadButton(Controller::Key::BUTTON_DPAD_RIGHT),
+    gamepadAxis(Controller::Key::JOYSTICK_LEFT_X, 1)
+  };
+  _bindings[Action::AIM_UP] = {
+    keyboard(Key::KEY_UP_ARROW),
+    gamepadButton(Controller::Key::BUTTON_DPAD_UP),
+    gamepadAxis(Controller::Key::JOYSTICK_LEFT_Y, -1)
+  };
+  _bindings[Action::CROUCH] = {
+    keyboard(Key::KEY_DOWN_ARROW),
+    gamepadButton(Controller::Key::BUTTON_DPAD_DOWN),
+    gamepadAxis(Controller::Key::JOYSTICK_LEFT_Y, 1)
+  };
+  _bindings[Action::JUMP] = {
+    keyboard(Key::KEY_LEFT_ALT),
+    gamepadButton(Controller::Key::BUTTON_A)
+  };
+  _bindings[Action::DODGE] = {
+    keyboard(Key::KEY_X),
+    gamepadButton(Controller::Key::BUTTON_B)
+  };
+  _bindings[Action::ATTACK] = {
+    keyboard(Key::KEY_LEFT_CTRL),
+    gamepadButton(Controller::Key::BUTTON_X)
+  };
+  _bindings[Action::BLOCK] = {
+    keyboard(Key::KEY_Q),
+    gamepadButton(Controller::Key::BUTTON_LEFT_SHOULDER)
+  };
+  _bindings[Action::INTERACT] = {
+    keyboard(Key::KEY_E),
+    gamepadButton(Controller::Key::BUTTON_Y)
+  };
+  _bindings[Action::PICKUP_ITEM] = {
+    keyboard(Key::KEY_Z),
+    gamepadAxis(Controller::Key::AXIS_RIGHT_TRIGGER, 1)
+  };
+  _bindings[Action::USE_PORTAL] = {
+    keyboard(Key::KEY_F),
+    gamepadButton(Controller::Key::BUTTON_RIGHT_SHOULDER)
+  };
+
+  // Hotkey slots share their default keys with HotkeyManager, since Keybindable
+  // items and skills remember which slot they are bound to by its key code.
+  // These keys must not be used by any other gameplay action.
+  for (size_t i = 0; i < kHotkeyActions.size(); i++) {
+    _bindings[kHotkeyActions[i]] = {keyboard(HotkeyManager::kBindableKeys[i])};
+  }
+  _bindings[Action::WORLD_MAP] = {
+    keyboard(Key::KEY_M),
+    gamepadButton(Controller::Key::BUTTON_SELECT)
+  };
+
+  _bindings[Action::MENU_UP] = {
+    keyboard(Key::KEY_UP_ARROW),
+    gamepadButton(Controller::Key::BUTTON_DPAD_UP)
+  };
+  _bindings[Action::MENU_DOWN] = {
+    keyboard(Key::KEY_DOWN_ARROW),
+    gamepadButton(Controller::Key::BUTTON_DPAD_DOWN)
+  };
+  _bindings[Action::MENU_LEFT] = {
+    keyboard(Key::KEY_LEFT_ARROW),
+    gamepadButton(Controller::Key::BUTTON_DPAD_LEFT)
+  };
+  _bindings[Action::MENU_RIGHT] = {
+    keyboard(Key::KEY_RIGHT_ARROW),
+    gamepadButton(Controller::Key::BUTTON_DPAD_RIGHT)
+  };
+  _bindings[Action::MENU_CONFIRM] = {
+    keyboard(Key::KEY_ENTER),
+    gamepadButton(Controller::Key::BUTTON_A)
+  };
+  _bindings[Action::MENU_PREV_TAB] = {
+    keyboard(Key::KEY_Q),
+    gamepadButton(Controller::Key::BUTTON_LEFT_SHOULDER)
+  };
+  _bindings[Action::MENU_NEXT_TAB] = {
+    keyboard(Key::KEY_E),
+    gamepadButton(Controller::Key::BUTTON_RIGHT_SHOULDER)
+  };
+  // Not BUTTON_Y, which opens the trade window as INTERACT.
+  _bindings[Action::MENU_COMMIT] = {
+    keyboard(Key::KEY_C),
+    gamepadAxis(Controller::Key::AXIS_LEFT_TRIGGER, 1)
+  };
+  _bindings[Action::PAUSE] = {
+    keyboard(Key::KEY_ESCAPE),
+    gamepadButton(Controller::Key::BUTTON_START)
+  };
+  _bindings[Action::DEBUG_DRAW] = {keyboard(Key::KEY_0)};
+  _bindings[Action::CONSOLE] = {keyboard(Key::KEY_GRAVE)};
+
+  for (const auto& [a, b] : findAllConflicts()) {
+    VGLOG(LOG_ERR, "Default input bindings of [%s] and [%s] conflict.", kActionNames[a], kActionNames[b]);
+  }
+  rebuildActiveSources();
+}
+
+bool ActionMapper::bind(const Action action, const InputSource& source, const bool overrideConflict) {
+  if (std::find(_bindings[action].begin(), _bindings[action].end(), source) != _bindings[action].end()) {
+    return true;
+  }
+
+  if (const optional<Action> conflict = findConflict(action, source)) {
+    if (!overrideConflict) {
+      VGLOG(LOG_WARN, "Failed to bind [%s]: input already bound to [%s].",
+            kActionNames[action], kActionNames[*conflict]);
+      return false;
+    }
+    unbind(*conflict, source);
+  }
+
+  _bindings[action].push_back(source);
+  rebuildActiveSources();
+  return true;
+}
+
+bool ActionMapper::unbind(const Action action, const InputSource& source) {
+  auto& sources = _bindings[action];
+  auto it = std::find(sources.begin(), sources.end(), source);
+  if (it == sources.end()) {
+    return false;
+  }
+
+  sources.erase(it);
+  rebuildActiveSources();
+  return true;
+}
+
+optional<ActionMapper::Action>
+ActionMapper::findConflict(const Action action, const InputSource& source) const {
+  for (int i = 0; i < Action::SIZE; i++) {
+    const Action other = static_cast<Action>(i);
+    if (other == action || getGroup(other) != getGroup(action)) {
+      continue;
+    }
+    const auto& sources = _bindings[other];
+    if (std::find(sources.begin(), sources.end(), source) != sources.end()) {
+      return other;
+    }
+  }
+  return nullopt;
+}
+
+vector<pair<ActionMapper::Action, ActionMapper::Action>> ActionMapper::findAllConflicts() const {
+  vector<pair<Action, Action>> conflicts;
+  for (int i = 0; i < Action::SIZE; i++) {
+    for (int j = i + 1; j < Action::SIZE; j++) {
+      const Action a = static_cast<Action>(i);
+      const Action b = static_cast<Action>(j);
+      if (getGroup(a) != getGroup(b)) {
+        continue;
+      }
+      for (const auto& source : _bindings[b]) {
+        if (std::find(_bindings[a].begin(), _bindings[a].end(), source) != _bindings[a].end()) {
+          conflicts.push_back({a, b});
+          break;
+        }
+      }
+    }
+  }
+  return conflicts;
+}
+
+bool ActionMapper::rebind(const Action action, const InputSource& source, const bool overrideConflict) {
+  if (const optional<Action> conflict = findConflict(action, source)) {
+    if (!overrideConflict) {
+      return false;
+    }
+    unbind(*conflict, source);
+  }
+
+  std::erase_if(_bindings[action], [&source](const InputSource& s) {
+    return isGamepad(s) == isGamepad(source);
+  });
+  _bindings[action].push_back(source);
+  rebuildActiveSources();
+  return save(kBindingsFileName);
+}
+
+void ActionMapper::promptBinding(const Action action,
+                                 const function<void (bool)>& onFinished,
+                                 const function<void (const InputSource&, Action)>& onConflict) {
+  auto onInput = [=](const InputSource& source, const bool isCancelled) {
+    if (isCancelled) {
+      onFinished(false);
+    } else if (const optional<Action> conflict = findConflict(action, source)) {
+      onConflict(source, *conflict);
+    } else {
+      onFinished(rebind(action, source));
+    }
+
+    // Everything done. Now it is safe to clear both functors.
+    InputManager::the().clearSpecialOnKeyPressed();
+  };
+
+  auto onKeyPressedEvLstnr = [=](EventKeyboard::KeyCode keyCode, Event*) {
+    onInput(keyboard(keyCode), keyCode == EventKeyboard::KeyCode::KEY_ESCAPE);
+  };
+
+  auto onGamepadPressedEvLstnr = [=](int key, bool isAxis, float value) {
+    if (!isAxis) {
+      onInput(gamepadButton(static_cast<Controller::Key>(key)), key == Controller::Key::BUTTON_START);
+    } else if (std::abs(value) > kAxisDeadZone) {
+      onInput(gamepadAxis(static_cast<Controller::Key>(key), value > 0 ? 1 : -1), false);
+    }
+  };
+
+  InputManager::the().setSpecialOnKeyPressed(onKeyPressedEvLstnr);
+  InputManager::the().setSpecialOnGamepadPressed(onGamepadPressedEvLstnr);
+}
+
+bool ActionMapper::isSourceActive(const InputSource& source) const {
+  const InputManager& inputMgr = InputManager::the();
+
+  switch (source.type) {
+    case InputSource::Type::KEYBOARD:
+      return inputMgr.isKeyPressed(static_cast<EventKeyboard::KeyCode>(source.code));
+    case InputSource::Type::GAMEPAD_BUTTON:
+      return inputMgr.isGamepadButtonPressed(source.code);
+    case InputSource::Type::GAMEPAD_AXIS:
+      return inputMgr.getGamepadAxisValue(source.code) * source.axisSign > kAxisDeadZone;
+    default:
+      return false;
+  }
+}
+
+void ActionMapper::rebuildActiveSources() {
+  _activeSources.clear();
+
+  for (int i = 0; i < Action::SIZE; i++) {
+    const Action action = static_cast<Action>(i);
+    for (const auto& source : _bindings[action]) {
+      const bool isShadowed = std::any_of(_activeSources.begin(), _activeSources.end(),
+          [action, &source](const pair<Action, InputSource>& entry) {
+        return getGroup(entry.first) == getGroup(action) && entry.second == source;
+      });
+
+      if (!isShadowed) {
+        _activeSources.push_back({action, source});
+      }
+    }
+  }
+}
+
+}  // namespace vigilante
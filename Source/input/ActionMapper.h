@@ -0,0 +1,195 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_ACTION_MAPPER_H_
+#define VIGILANTE_ACTION_MAPPER_H_
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <axmol.h>
+
+#define IS_ACTION_PRESSED(action) \
+  ActionMapper::the().isActionPressed(action)
+
+#define IS_ACTION_JUST_PRESSED(action) \
+  ActionMapper::the().isActionJustPressed(action)
+
+namespace fs = std::filesystem;
+
+namespace vigilante {
+
+using ActionMask = uint32_t;
+
+// ActionMapper resolves physical inputs (keyboard keys, gamepad buttons
+// and gamepad axes) into logical actions exactly once per frame.
+// Gameplay code, UI and the combo system should query actions
+// instead of raw key codes, so that the bindings can be changed
+// at runtime and persisted without touching any code.
+class ActionMapper final {
+ public:
+  enum Action {
+    // Gameplay
+    MOVE_LEFT,
+    MOVE_RIGHT,
+    AIM_UP,
+    CROUCH,
+    JUMP,
+    DODGE,
+    ATTACK,
+    BLOCK,
+    INTERACT,
+    PICKUP_ITEM,
+    USE_PORTAL,
+    HOTKEY_1,
+    HOTKEY_2,
+    HOTKEY_3,
+    HOTKEY_4,
+    HOTKEY_5,
+    WORLD_MAP,
+    // Menu
+    MENU_UP,
+    MENU_DOWN,
+    MENU_LEFT,
+    MENU_RIGHT,
+    MENU_CONFIRM,
+    MENU_PREV_TAB,
+    MENU_NEXT_TAB,
+    MENU_COMMIT,
+    PAUSE,
+    DEBUG_DRAW,
+    CONSOLE,
+    SIZE
+  };
+
+  // Actions within the same group are active at the same time,
+  // so they must not share a physical input. Actions from different
+  // groups may share inputs (e.g., Q blocks in game and switches tabs in menus).
+  enum Group {
+    GAMEPLAY,
+    MENU
+  };
+
+  struct InputSource final {
+    enum Type {
+      KEYBOARD,
+      GAMEPAD_BUTTON,
+      GAMEPAD_AXIS
+    };
+
+    bool operator==(const InputSource& other) const = default;
+
+    InputSource::Type type;
+    int code;
+    int axisSign;  // only used by GAMEPAD_AXIS, either 1 or -1.
+  };
+
+  static_assert(Action::SIZE <= sizeof(ActionMask) * 8, "ActionMask is too small.");
+
+  static inline constexpr char kBindingsFileName[] = "input_bindings.json";
+  static inline constexpr float kAxisDeadZone = 0.5f;
+  static inline constexpr std::array<Action, 5> kHotkeyActions{{
+    Action::HOTKEY_1,
+    Action::HOTKEY_2,
+    Action::HOTKEY_3,
+    Action::HOTKEY_4,
+    Action::HOTKEY_5
+  }};
+
+  static ActionMapper& the();
+
+  static constexpr ActionMask toMask(const Action action) {
+    return static_cast<ActionMask>(1) << action;
+  }
+
+  static InputSource keyboard(const ax::EventKeyboard::KeyCode keyCode) {
+    return {InputSource::Type::KEYBOARD, static_cast<int>(keyCode), 0};
+  }
+
+  static InputSource gamepadButton(const ax::Controller::Key key) {
+    return {InputSource::Type::GAMEPAD_BUTTON, static_cast<int>(key), 0};
+  }
+
+  static InputSource gamepadAxis(const ax::Controller::Key axis, const int axisSign) {
+    return {InputSource::Type::GAMEPAD_AXIS, static_cast<int>(axis), axisSign};
+  }
+
+  static Group getGroup(const Action action);
+
+  // Samples InputManager and rebuilds this frame's action bitmasks.
+  // Must be called once per frame before any input handling.
+  void update();
+  // Replaces this frame's actions, e.g., with the ones replayed by DeterminismChecker.
+  void overridePressedActions(const ActionMask pressedActions);
+
+  bool load(const fs::path& bindingsFileName);
+  bool save(const fs::path& bindingsFileName) const;
+  void resetToDefaults();
+
+  // Returns false if `source` is already bound to another action of the same group,
+  // unless `overrideConflict` is true, in which case the other binding is removed.
+  bool bind(const Action action, const InputSource& source, const bool overrideConflict = false);
+  bool unbind(const Action action, const InputSource& source);
+  std::optional<Action> findConflict(const Action action, const InputSource& source) const;
+  std::vector<std::pair<Action, Action>> findAllConflicts() const;
+
+  // Replaces the bindings of `action` on the same device as `source` (the keyboard
+  // or the gamepad) with `source`, then saves the bindings. Fails like bind()
+  // if `source` is bound to another action of the same group.
+  bool rebind(const Action action, const InputSource& source, const bool overrideConflict = false);
+
+  // Rebinds `action` to the next key, gamepad button or gamepad axis pressed,
+  // or cancels if it is ESC or the start button. If that input is bound to another
+  // action of the same group, nothing is bound and `onConflict` is called instead,
+  // so that the player may be asked whether to take it over with rebind(action, source, true).
+  void promptBinding(const Action action,
+                     const std::function<void (bool)>& onFinished,
+                     const std::function<void (const InputSource&, Action)>& onConflict);
+
+  inline bool isActionPressed(const Action action) const {
+    return _pressedActions & toMask(action);
+  }
+
+  // A press is reported until a handler consumes it by calling this, or until the
+  // action is released. So it is handled exactly once per press, even if the handler
+  // can't take it right away (e.g., an attack pressed in the middle of another one).
+  inline bool isActionJustPressed(const Action action) {
+    if (!(_justPressedActions & toMask(action))) {
+      return false;
+    }
+    _justPressedActions &= ~toMask(action);
+    return true;
+  }
+
+  inline ActionMask getPressedActions() const { return _pressedActions; }
+  inline ActionMask getJustPressedActions() const { return _justPressedActions; }
+  inline const std::vector<InputSource>& getBindings(const Action action) const {
+    return _bindings[action];
+  }
+
+ private:
+  ActionMapper();
+
+  void setPressedActions(const ActionMask pressedActions);
+  bool isSourceActive(const InputSource& source) const;
+  void rebuildActiveSources();
+
+  std::array<std::vector<InputSource>, Action::SIZE> _bindings;
+
+  // Flattened list of (action, source) pairs sampled by update(). If two actions
+  // of the same group still share a source (e.g., from a hand-edited bindings file),
+  // only the action that comes first in Action receives it.
+  std::vector<std::pair<Action, InputSource>> _activeSources;
+
+  ActionMask _pressedActions{};
+  ActionMask _justPressedActions{};
+  ActionMask _lastPressedActions{};
+  ActionMask _lastJustPressedActions{};
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_ACTION_MAPPER_H_
@@ -17,8 +17,8 @@ class HotkeyManager final {
  public:
   enum BindableKeys {
     LEFT_SHIFT,
-    LEFT_CTRL,
-    X,
+    A,
+    S,
     C,
     V,
     SIZE
@@ -26,8 +26,8 @@ class HotkeyManager final {
 
   static inline const std::array<ax::EventKeyboard::KeyCode, BindableKeys::SIZE> kBindableKeys{{
     ax::EventKeyboard::KeyCode::KEY_LEFT_SHIFT,
-    ax::EventKeyboard::KeyCode::KEY_LEFT_CTRL,
-    ax::EventKeyboard::KeyCode::KEY_X,
+    ax::EventKeyboard::KeyCode::KEY_A,
+    ax::EventKeyboard::KeyCode::KEY_S,
     ax::EventKeyboard::KeyCode::KEY_C,
     ax::EventKeyboard::KeyCode::KEY_V
   }};
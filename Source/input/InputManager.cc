@@ -41,6 +41,39 @@ void InputManager::activate(Scene* scene) {
   };
 
   _scene->getEventDispatcher()->addEventListenerWithSceneGraphPriority(_keyboardEvLstnr, scene);
+
+  _controllerEvLstnr = EventListenerController::create();
+
+  _controllerEvLstnr->onKeyDown = [this](Controller*, int key, Event*) {
+    if (_specialOnGamepadPressed) {
+      _specialOnGamepadPressed(key, false, 1.0f);
+      return;
+    }
+    if (_specialOnKeyPressed) {
+      return;
+    }
+    _pressedGamepadButtons.insert(key);
+  };
+
+  _controllerEvLstnr->onKeyUp = [this](Controller*, int key, Event*) {
+    _pressedGamepadButtons.erase(key);
+  };
+
+  _controllerEvLstnr->onAxisEvent = [this](Controller* controller, int axis, Event*) {
+    const float value = controller->getKeyStatus(axis).value;
+    _gamepadAxisValues[axis] = value;
+    if (_specialOnGamepadPressed) {
+      _specialOnGamepadPressed(axis, true, value);
+    }
+  };
+
+  _controllerEvLstnr->onDisconnected = [this](Controller*, Event*) {
+    _pressedGamepadButtons.clear();
+    _gamepadAxisValues.clear();
+  };
+
+  _scene->getEventDispatcher()->addEventListenerWithSceneGraphPriority(_controllerEvLstnr, scene);
+  Controller::startDiscoveryController();
 }
 
 void InputManager::deactivate() {
@@ -49,10 +82,15 @@ void InputManager::deactivate() {
   }
 
   _scene->getEventDispatcher()->removeEventListener(_keyboardEvLstnr);
+  _scene->getEventDispatcher()->removeEventListener(_controllerEvLstnr);
   _keyboardEvLstnr = nullptr;
+  _controllerEvLstnr = nullptr;
   _scene = nullptr;
   _specialOnKeyPressed = nullptr;
+  _specialOnGamepadPressed = nullptr;
   _pressedKeys.clear();
+  _pressedGamepadButtons.clear();
+  _gamepadAxisValues.clear();
 }
 
 }  // namespace vigilante
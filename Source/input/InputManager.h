@@ -4,6 +4,7 @@
 
 #include <functional>
 #include <stack>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <axmol.h>
@@ -21,6 +22,8 @@ namespace vigilante {
 class InputManager final {
  public:
   using OnKeyPressedEvLstnr = std::function<void (ax::EventKeyboard::KeyCode, ax::Event*)>;
+  // `key` is an ax::Controller::Key. For axes, `value` is the new value of the axis.
+  using OnGamepadPressedEvLstnr = std::function<void (int key, bool isAxis, float value)>;
 
   static InputManager& the();
 
@@ -39,6 +42,15 @@ class InputManager final {
     return _pressedKeys.erase(keyCode) > 0;
   }
 
+  inline bool isGamepadButtonPressed(int key) const {
+    return _pressedGamepadButtons.find(key) != _pressedGamepadButtons.end();
+  }
+
+  inline float getGamepadAxisValue(int axis) const {
+    auto it = _gamepadAxisValues.find(axis);
+    return it != _gamepadAxisValues.end() ? it->second : 0.0f;
+  }
+
   inline bool isCapsLocked() const {
     return _isCapsLocked;
   }
@@ -48,7 +60,7 @@ class InputManager final {
   }
 
   inline bool hasSpecialOnKeyPressed() const {
-    return static_cast<bool>(_specialOnKeyPressed);
+    return static_cast<bool>(_specialOnKeyPressed) || static_cast<bool>(_specialOnGamepadPressed);
   }
 
   inline void setSpecialOnKeyPressed(const OnKeyPressedEvLstnr& onKeyPressed) {
@@ -57,6 +69,13 @@ class InputManager final {
 
   inline void clearSpecialOnKeyPressed() {
     _specialOnKeyPressed = nullptr;
+    _specialOnGamepadPressed = nullptr;
+  }
+
+  // Like setSpecialOnKeyPressed(), but for gamepad buttons and axes.
+  // It is cleared by clearSpecialOnKeyPressed() as well.
+  inline void setSpecialOnGamepadPressed(const OnGamepadPressedEvLstnr& onGamepadPressed) {
+    _specialOnGamepadPressed = onGamepadPressed;
   }
 
  private:
@@ -64,6 +83,7 @@ class InputManager final {
 
   ax::Scene* _scene{};
   ax::EventListenerKeyboard* _keyboardEvLstnr{};
+  ax::EventListenerController* _controllerEvLstnr{};
 
   bool _isCapsLocked{};
 
@@ -71,7 +91,13 @@ class InputManager final {
   // Relevant method: isKeyPressed(), isKeyJustPressed()
   std::unordered_set<ax::EventKeyboard::KeyCode> _pressedKeys;
 
+  // Gamepad state, keyed by ax::Controller::Key.
+  // Relevant method: isGamepadButtonPressed(), getGamepadAxisValue()
+  std::unordered_set<int> _pressedGamepadButtons;
+  std::unordered_map<int, float> _gamepadAxisValues;
+
   OnKeyPressedEvLstnr _specialOnKeyPressed{};
+  OnGamepadPressedEvLstnr _specialOnGamepadPressed{};
 };
 
 }  // namespace vigilante
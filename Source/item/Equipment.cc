@@ -46,6 +46,13 @@ Equipment::Profile::Profile(const string& jsonFileName) {
 
   bonusMoveSpeed = json["bonusMoveSpeed"].GetInt();
   bonusJumpHeight = json["bonusJumpHeight"].GetInt();
+
+  if (json.HasMember("statusEffect")) {
+    statusEffect = json["statusEffect"].GetString();
+  }
+
+  hitboxProfile.load(json);
+  hitImpactProfile.load(json);
 }
 
 }  // namespace vigilante
@@ -6,6 +6,8 @@
 #include <string>
 
 #include "Item.h"
+#include "combat/Hitbox.h"
+#include "combat/HitImpact.h"
 
 namespace vigilante {
 
@@ -54,6 +56,10 @@ class Equipment : public Item {
 
     int bonusMoveSpeed;
     int bonusJumpHeight;
+
+    std::string statusEffect;  // applied on hit, optional
+    HitboxProfile hitboxProfile;  // overrides the wielder's hitboxes, optional
+    HitImpactProfile hitImpactProfile;  // overrides the wielder's hit impacts, optional
   };
 
   explicit Equipment(const std::string& jsonFileName);
@@ -3,13 +3,14 @@
 
 #include "Assets.h"
 #include "Constants.h"
+#include "Localization.h"
 #include "item/Equipment.h"
 #include "item/Consumable.h"
 #include "item/MiscItem.h"
 #include "item/Key.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
-#include "util/B2BodyBuilder.h"
+#include "util/B2BodyTemplate.h"
 #include "util/JsonUtil.h"
 #include "util/Logger.h"
 
@@ -27,6 +28,25 @@ constexpr int kItemNumFixtures = 2;
 constexpr auto kItemCategoryBits = kItem;
 constexpr auto kItemMaskBits = kGround | kPlatform | kWall;
 
+// All items share the same body.
+const B2BodyTemplate& getItemBodyTemplate() {
+  static const B2BodyTemplate bodyTemplate = []() {
+    B2BodyTemplate bodyTemplate{b2BodyType::b2_dynamicBody};
+    bodyTemplate.newRectangleFixture(kIconSize / 2, kIconSize / 2, kPpm)
+      .categoryBits(kItemCategoryBits)
+      .maskBits(kItemMaskBits | kFeet)  // Enable collision detection with feet fixtures
+      .setSensor(true)
+      .addFixture();
+    bodyTemplate.newRectangleFixture(kIconSize / 2, kIconSize / 2, kPpm)
+      .categoryBits(kItemCategoryBits)
+      .maskBits(kItemMaskBits)
+      .density(kDensity)
+      .addFixture();
+    return bodyTemplate;
+  }();
+  return bodyTemplate;
+}
+
 }  // namespace
 
 unique_ptr<Item> Item::create(const string& jsonFileName) {
@@ -58,9 +78,7 @@ bool Item::showOnMap(float x, float y) {
 
   _isShownOnMap = true;
 
-  defineBody(b2BodyType::b2_dynamicBody, x, y,
-             kItemCategoryBits,
-             kItemMaskBits);
+  defineBody(x, y);
 
   _bodySprite = Sprite::create(getIconPath());
   _bodySprite->getTexture()->setAliasTexParameters();
@@ -77,31 +95,9 @@ void Item::import(const string& jsonFileName) {
   _itemProfile = Item::Profile{jsonFileName};
 }
 
-void Item::defineBody(b2BodyType bodyType,
-                      float x,
-                      float y,
-                      short categoryBits,
-                      short maskBits) {
+void Item::defineBody(float x, float y) {
   auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
-  B2BodyBuilder bodyBuilder(gmMgr->getWorld());
-
-  _body = bodyBuilder.type(bodyType)
-    .position(x, y, kPpm)
-    .buildBody();
-
-  bodyBuilder.newRectangleFixture(kIconSize / 2, kIconSize / 2, kPpm)
-    .categoryBits(categoryBits)
-    .maskBits(maskBits | kFeet)  // Enable collision detection with feet fixtures
-    .setSensor(true)
-    .setUserData(this)
-    .buildFixture();
-
-  bodyBuilder.newRectangleFixture(kIconSize / 2, kIconSize / 2, kPpm)
-    .categoryBits(categoryBits)
-    .maskBits(maskBits)
-    .density(kDensity)
-    .setUserData(this)
-    .buildFixture();
+  _body = getItemBodyTemplate().instantiate(gmMgr->getWorld(), x, y, kPpm, this);
 }
 
 string Item::getIconPath() const {
@@ -117,8 +113,9 @@ Item::Profile::Profile(const string& jsonFileName) : jsonFileName(jsonFileName)
 
   itemType = static_cast<Item::Type>(json["itemType"].GetInt());
   textureResDir = json["textureResDir"].GetString();
-  name = json["name"].GetString();
-  desc = json["desc"].GetString();
+  name = Localization::the().localize(json["name"].GetString());
+  desc = Localization::the().localize(json["desc"].GetString());
+  lootCounterId = Statistics::the().internSubject(Statistics::Event::ITEM_LOOTED, jsonFileName);
 }
 
 }  // namespace vigilante
@@ -10,6 +10,7 @@
 
 #include "DynamicActor.h"
 #include "Importable.h"
+#include "gameplay/Statistics.h"
 
 namespace vigilante {
 
@@ -30,6 +31,8 @@ class Item : public DynamicActor, public Importable {
     std::string textureResDir;
     std::string name;
     std::string desc;
+    // The Statistics counter of this item as a subject, interned once.
+    Statistics::CounterId lootCounterId{Statistics::kInvalidCounterId};
   };
 
   // Create an item by automatically deducing its concrete type
@@ -54,11 +57,7 @@ class Item : public DynamicActor, public Importable {
  protected:
   explicit Item(const std::string& jsonFileName);
 
-  void defineBody(b2BodyType bodyType,
-                  float x,
-                  float y,
-                  short categoryBits,
-                  short maskBits);
+  void defineBody(float x, float y);
 
   Item::Profile _itemProfile;
   int _amount{1};
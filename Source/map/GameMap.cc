@@ -5,20 +5,27 @@
 #include <cmath>
 #include <filesystem>
 #include <numbers>
+#include <optional>
 #include <thread>
 
 #include "Assets.h"
 #include "Audio.h"
 #include "CallbackManager.h"
 #include "Constants.h"
+#include "Localization.h"
 #include "character/Character.h"
 #include "character/Player.h"
 #include "character/Npc.h"
 #include "character/Party.h"
+#include "gameplay/StatusEffectSystem.h"
+#include "gameplay/TimeScale.h"
 #include "item/Equipment.h"
 #include "item/Consumable.h"
 #include "item/Key.h"
 #include "map/object/Chest.h"
+#include "map/NpcPool.h"
+#include "map/NpcResidencyCache.h"
+#include "map/object/InteractableObject.h"
 #include "map/object/StaticObject.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
@@ -26,6 +33,7 @@
 #include "util/B2BodyBuilder.h"
 #include "util/Logger.h"
 #include "util/MathUtil.h"
+#include "util/MemoryTracker.h"
 #include "util/StringUtil.h"
 #include "util/RandUtil.h"
 
@@ -36,13 +44,33 @@ USING_NS_AX;
 
 namespace vigilante {
 
+namespace {
+
+// The max number of alive Npcs in the world, including the ones
+// placed in the .tmx map and the player's allies.
+constexpr int kMaxAliveNpcs = 32;
+constexpr int kDefaultNpcSpawnerBudget = 12;
+
+int64_t getTrackedBytes() {
+  int64_t bytes = 0;
+  for (size_t i = 0; i < static_cast<size_t>(MemoryTag::SIZE); i++) {
+    bytes += MemoryTracker::the().getUsage(static_cast<MemoryTag>(i)).currentBytes;
+  }
+  return bytes;
+}
+
+}  // namespace
+
 GameMap::GameMap(b2World* world, const string& tmxMapFileName)
     : _world{world},
       _tmxTiledMap{TMXTiledMap::create(tmxMapFileName)},
       _tmxTiledMapFileName{tmxMapFileName},
       _bgmFileName{_tmxTiledMap->getProperty("bgm").asString()},
       _parallaxBackground{std::make_unique<ParallaxBackground>()},
-      _pathFinder{std::make_unique<SimplePathFinder>()} {}
+      _pathFinder{std::make_unique<SimplePathFinder>()} {
+  const Value npcSpawnerBudgetProperty = _tmxTiledMap->getProperty("npcSpawnerBudget");
+  _npcSpawnerBudget = npcSpawnerBudgetProperty.isNull() ? kDefaultNpcSpawnerBudget : npcSpawnerBudgetProperty.asInt();
+}
 
 GameMap::~GameMap() {
   for (auto body : _tmxTiledMapBodies) {
@@ -62,8 +90,10 @@ void GameMap::update(const float delta) {
   _parallaxBackground->update(delta);
 
   for (auto& actor : _dynamicActors) {
-    actor->update(delta);
+    actor->update(delta * TimeScale::the().getActorScale(actor.get()));
   }
+
+  updateNpcSpawners(delta);
 }
 
 void GameMap::createObjects() {
@@ -89,7 +119,9 @@ void GameMap::createObjects() {
   createTriggers();
   createPortals();
   createChests();
+  createInteractableObjects();
   createNpcs();
+  createNpcSpawners();
   createAnimatedObjects();
   createParallaxBackground();
 }
@@ -224,6 +256,13 @@ void GameMap::createTriggers() {
     bool canBeTriggeredOnlyOnce = valMap.at("canBeTriggeredOnlyOnce").asBool();
     bool canBeTriggeredOnlyByPlayer = valMap.at("canBeTriggeredOnlyByPlayer").asBool();
     int damage = valMap.at("damage").asInt();
+    // e.g., a poison swamp or a fire pit.
+    string statusEffect = valMap.contains("statusEffect") ? valMap.at("statusEffect").asString() : "";
+    // e.g., "metTheKing && !hasTriggeredAmbush"
+    Expression condition;
+    if (valMap.contains("condition")) {
+      condition.compile(valMap.at("condition").asString());
+    }
 
     B2BodyBuilder bodyBuilder(_world);
     b2Body* body = bodyBuilder.type(b2BodyType::b2_staticBody)
@@ -231,7 +270,7 @@ void GameMap::createTriggers() {
       .buildBody();
 
     auto trigger = std::make_unique<GameMap::Trigger>(
-        cmds, canBeTriggeredOnlyOnce, canBeTriggeredOnlyByPlayer, damage, body);
+        cmds, canBeTriggeredOnlyOnce, canBeTriggeredOnlyByPlayer, damage, statusEffect, condition, body);
     auto trigger_raw_ptr = trigger.get();
     _triggers.emplace_back(std::move(trigger));
 
@@ -255,6 +294,10 @@ void GameMap::createPortals() {
     int destPortalId = valMap.at("destPortalID").asInt();
     bool willInteractOnContact = valMap.at("willInteractOnContact").asBool();
     bool isLocked = valMap.at("isLocked").asBool();
+    Expression condition;
+    if (valMap.contains("condition")) {
+      condition.compile(valMap.at("condition").asString());
+    }
 
     B2BodyBuilder bodyBuilder(_world);
     b2Body* body = bodyBuilder.type(b2BodyType::b2_staticBody)
@@ -262,7 +305,7 @@ void GameMap::createPortals() {
       .buildBody();
 
     auto portal = std::make_unique<GameMap::Portal>(
-        destTmxMapFilePath, destPortalId, willInteractOnContact, isLocked, body);
+        destTmxMapFilePath, destPortalId, willInteractOnContact, isLocked, condition, body);
     auto portal_raw_ptr = portal.get();
     _portals.emplace_back(std::move(portal));
 
@@ -278,21 +321,38 @@ void GameMap::createPortals() {
 void GameMap::createNpcs() {
   auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
 
-  for (const auto& rectObj : getObjects("Npcs")) {
-    const auto& valMap = rectObj.asValueMap();
+  auto npcResidencyCache = gmMgr->getNpcResidencyCache();
+
+  ax::ValueVector objects = getObjects("Npcs");
+  for (int i = 0; i < objects.size(); i++) {
+    const auto& valMap = objects[i].asValueMap();
     float x = valMap.at("x").asFloat();
     float y = valMap.at("y").asFloat();
     string json = valMap.at("json").asString();
 
+    // If this Npc is still parked since the last visit, bring it back as is.
+    optional<NpcResidencyCache::Entry> parked = npcResidencyCache->unpark(_tmxTiledMapFileName, i);
+
     if (!gmMgr->isNpcAllowedToSpawn(json)) {
       continue;
     }
 
+    if (parked) {
+      Npc* npc = showDynamicActor<Npc>(std::move(parked->npc), parked->x, parked->y);
+      _placedNpcs.push_back({i, npc, parked->footprint});
+      continue;
+    }
+
+    const int64_t trackedBytes = getTrackedBytes();
     auto npc = std::make_shared<Npc>(json);
     if (auto it = valMap.find("isFacingRight"); it != valMap.end()) {
       npc->setFacingRight(it->second.asBool());
     }
-    showDynamicActor(std::move(npc), x, y);
+    Npc* rawNpc = showDynamicActor<Npc>(std::move(npc), x, y);
+
+    const size_t footprint = MemoryTracker::isEnabled() ?
+      std::max<int64_t>(getTrackedBytes() - trackedBytes, 0) : NpcResidencyCache::kEstimatedFootprint;
+    _placedNpcs.push_back({i, rawNpc, footprint});
   }
 
   auto player = gmMgr->getPlayer();
@@ -315,6 +375,75 @@ void GameMap::createNpcs() {
   }
 }
 
+void GameMap::createNpcSpawners() {
+  for (const auto& rectObj : getObjects("NpcSpawners")) {
+    const auto& valMap = rectObj.asValueMap();
+    float x = valMap.at("x").asFloat();
+    float y = valMap.at("y").asFloat();
+    float w = valMap.contains("width") ? valMap.at("width").asFloat() : 0;
+
+    _npcSpawners.emplace_back(std::make_unique<NpcSpawner>(valMap, x, y, w));
+  }
+}
+
+void GameMap::updateNpcSpawners(const float delta) {
+  if (_npcSpawners.empty()) {
+    return;
+  }
+
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+
+  // The player's allies count once each, whether or not they are among the actors of this map.
+  const auto allies = gmMgr->getPlayer() ? gmMgr->getPlayer()->getAllies() : unordered_set<Character*>{};
+  int numAliveNpcs = static_cast<int>(allies.size());
+  for (const auto& actor : _dynamicActors) {
+    auto npc = dynamic_cast<Npc*>(actor.get());
+    if (npc && !npc->isKilled() && !allies.contains(npc)) {
+      numAliveNpcs++;
+    }
+  }
+
+  int numSpawnedNpcs = 0;
+  for (const auto& spawner : _npcSpawners) {
+    numSpawnedNpcs += spawner->getAliveCount();
+  }
+
+  int budget = std::min(_npcSpawnerBudget - numSpawnedNpcs, kMaxAliveNpcs - numAliveNpcs);
+  for (auto& spawner : _npcSpawners) {
+    budget -= spawner->update(delta, *this, *gmMgr->getNpcPool(), budget);
+  }
+}
+
+void GameMap::parkPlacedNpcs(NpcResidencyCache& npcResidencyCache) {
+  for (const auto& placedNpc : _placedNpcs) {
+    Npc* npc = placedNpc.npc;
+
+    // Skip the ones which have been killed, or have left this map
+    // (e.g., recruited by the player).
+    shared_ptr<DynamicActor> key{shared_ptr<DynamicActor>(), npc};
+    if (!_dynamicActors.contains(key) || npc->isKilled() || npc->getParty()) {
+      continue;
+    }
+
+    const b2Vec2& pos = npc->getBody()->GetPosition();
+    const float x = pos.x * kPpm;
+    const float y = pos.y * kPpm;
+
+    // Its body is about to be destroyed, so its status effects mustn't tick while parked.
+    StatusEffectSystem::the().forget(npc);
+    npc->onMapChanged();
+    shared_ptr<Npc> parkedNpc = removeDynamicActor<Npc>(npc);
+    npcResidencyCache.park(_tmxTiledMapFileName, placedNpc.spawnId, {std::move(parkedNpc), x, y, placedNpc.footprint});
+  }
+  _placedNpcs.clear();
+}
+
+void GameMap::despawnSpawnedNpcs(NpcPool& npcPool) {
+  for (auto& spawner : _npcSpawners) {
+    spawner->despawnAll(*this, npcPool);
+  }
+}
+
 void GameMap::createChests() {
   ax::ValueVector objects = getObjects("Chest");
   for (int i = 0; i < objects.size(); i++) {
@@ -328,6 +457,30 @@ void GameMap::createChests() {
   }
 }
 
+void GameMap::createInteractableObjects() {
+  ax::ValueVector objects = getObjects("InteractableObjects");
+  for (int i = 0; i < objects.size(); i++) {
+    const auto& valMap = objects[i].asValueMap();
+    float x = valMap.at("x").asFloat();
+    float y = valMap.at("y").asFloat();
+    float w = valMap.at("width").asFloat();
+    float h = valMap.at("height").asFloat();
+
+    auto object = std::make_shared<InteractableObject>(_tmxTiledMapFileName, i, valMap, w, h);
+    auto rawObject = showStaticActor<InteractableObject>(std::move(object), x, y);
+
+    const string& id = rawObject->getProfile().id;
+    if (!id.empty() && !_interactableObjects.emplace(id, rawObject).second) {
+      VGLOG(LOG_ERR, "Duplicated interactable object id [%s] in [%s].", id.c_str(), _tmxTiledMapFileName.c_str());
+    }
+  }
+}
+
+InteractableObject* GameMap::getInteractableObject(const string& id) const {
+  auto it = _interactableObjects.find(id);
+  return (it != _interactableObjects.end()) ? it->second : nullptr;
+}
+
 void GameMap::createAnimatedObjects() {
   ax::ValueVector objects = getObjects("AnimatedObjects");
   for (int i = 0; i < objects.size(); i++) {
@@ -368,11 +521,15 @@ GameMap::Trigger::Trigger(const vector<string>& cmds,
                           const bool canBeTriggeredOnlyOnce,
                           const bool canBeTriggeredOnlyByPlayer,
                           const int damage,
+                          const string& statusEffect,
+                          const Expression& condition,
                           b2Body* body)
     : _cmds{cmds},
       _canBeTriggeredOnlyOnce{canBeTriggeredOnlyOnce},
       _canBeTriggeredOnlyByPlayer{canBeTriggeredOnlyByPlayer},
       _damage{damage},
+      _statusEffect{statusEffect},
+      _condition{condition},
       _body{body} {}
 
 GameMap::Trigger::~Trigger() {
@@ -388,6 +545,10 @@ void GameMap::Trigger::onInteract(Character* user) {
     return;
   }
 
+  if (!_condition.evaluate()) {
+    return;
+  }
+
   _hasTriggered = true;
 
   auto console = SceneManager::the().getCurrentScene<GameScene>()->getConsole();
@@ -397,11 +558,13 @@ void GameMap::Trigger::onInteract(Character* user) {
 }
 
 GameMap::Portal::Portal(const string& destTmxMapFileName, int destPortalId,
-                        bool willInteractOnContact, bool isLocked, b2Body* body)
+                        bool willInteractOnContact, bool isLocked,
+                        const Expression& condition, b2Body* body)
     : _destTmxMapFileName{destTmxMapFileName},
       _destPortalId{destPortalId},
       _willInteractOnContact{willInteractOnContact},
       _isLocked{isLocked},
+      _condition{condition},
       _body{body} {
   auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
   constexpr auto kType = OpenableObjectType::PORTAL;
@@ -415,6 +578,10 @@ GameMap::Portal::~Portal() {
 }
 
 void GameMap::Portal::onInteract(Character* user) {
+  if (isSealed()) {
+    return;
+  }
+
   maybeUnlockPortalAs(user);
 
   if (_isLocked) {
@@ -431,6 +598,9 @@ void GameMap::Portal::onInteract(Character* user) {
 
     const auto& portalPos = portals[destPortalId]->_body->GetPosition();
     user->setPosition(portalPos.x, portalPos.y);
+    if (auto party = user->getParty()) {
+      party->getFormation().reset(portalPos);
+    }
 
     for (auto ally : user->getAllies()) {
       if (!ally->isWaitingForPartyLeader()) {
@@ -452,12 +622,12 @@ bool GameMap::Portal::willInteractOnContact() const {
 void GameMap::Portal::showHintUI() {
   //createHintBubbleFx();
 
-  string text = "Open";
+  string text = tr(StringId::HINT_OPEN);
   Color4B textColor = colorscheme::kWhite;
 
   auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
-  if (_isLocked && !canBeUnlockedBy(gmMgr->getPlayer())) {
-    text += " (Locked)";
+  if (isSealed() || (_isLocked && !canBeUnlockedBy(gmMgr->getPlayer()))) {
+    text = tr(StringId::PORTAL_LOCKED, text);
     textColor = colorscheme::kRed;
   }
 
@@ -498,10 +668,10 @@ void GameMap::Portal::maybeUnlockPortalAs(Character *user) {
 
   auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
   if (!canBeUnlockedBy(user)) {
-    notifications->show("This door is locked.");
+    notifications->show(tr(StringId::DOOR_LOCKED));
     Audio::the().playSfx(kSfxDoorLocked);
   } else {
-    notifications->show("Door unlocked.");
+    notifications->show(tr(StringId::DOOR_UNLOCKED));
     Audio::the().playSfx(kSfxDoorUnlocked);
     unlock();
   }
@@ -5,6 +5,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -14,7 +15,9 @@
 
 #include "DynamicActor.h"
 #include "Interactable.h"
+#include "gameplay/Expression.h"
 #include "item/Item.h"
+#include "map/NpcSpawner.h"
 #include "map/ParallaxBackground.h"
 #include "map/PathFinder.h"
 #include "util/Logger.h"
@@ -22,6 +25,10 @@
 namespace vigilante {
 
 class Character;
+class InteractableObject;
+class Npc;
+class NpcPool;
+class NpcResidencyCache;
 class Player;
 
 class GameMap final {
@@ -38,6 +45,7 @@ class GameMap final {
   enum class OpenableObjectType {
     PORTAL,
     CHEST,
+    INTERACTABLE_OBJECT,
     SIZE
   };
 
@@ -47,19 +55,25 @@ class GameMap final {
             const bool canBeTriggeredOnlyOnce,
             const bool canBeTriggeredOnlyByPlayer,
             const int damage,
+            const std::string& statusEffect,
+            const Expression& condition,
             b2Body* body);
     virtual ~Trigger();
 
     // Executes certain commands via ui/console/Console.cc
-    // when the player's body collides with `this->_body`
+    // when the player's body collides with `this->_body`,
+    // as long as its condition holds.
     virtual void onInteract(Character* user) override;  // Interactable
     virtual bool willInteractOnContact() const override { return true; }  // Interactable
     virtual void showHintUI() override {}  // Interactable
     virtual void hideHintUI() override {}  // Interactable
+    virtual const b2Body* getInteractionBody() const override { return _body; }  // Interactable
 
     inline bool canBeTriggeredOnlyOnce() const { return _canBeTriggeredOnlyOnce; }
     inline bool canBeTriggeredOnlyByPlayer() const { return _canBeTriggeredOnlyByPlayer; }
     inline int getDamage() const { return _damage; }
+    inline const std::string& getStatusEffect() const { return _statusEffect; }
+    inline const Expression& getCondition() const { return _condition; }
     inline bool hasTriggered() const { return _hasTriggered; }
     inline void setTriggered(bool triggered) { _hasTriggered = triggered; }
 
@@ -71,6 +85,8 @@ class GameMap final {
     bool _canBeTriggeredOnlyOnce{};
     bool _canBeTriggeredOnlyByPlayer{};
     int _damage{};
+    std::string _statusEffect;
+    Expression _condition;
 
     bool _hasTriggered{};
     b2Body* _body{};
@@ -82,6 +98,7 @@ class GameMap final {
            int targetPortalId,
            bool willInteractOnContact,
            bool isLocked,
+           const Expression& condition,
            b2Body* body);
     virtual ~Portal();
 
@@ -89,9 +106,12 @@ class GameMap final {
     virtual bool willInteractOnContact() const override;  // Interactable
     virtual void showHintUI() override;  // Interactable
     virtual void hideHintUI() override;  // Interactable
+    virtual const b2Body* getInteractionBody() const override { return _body; }  // Interactable
 
     bool canBeUnlockedBy(Character* user) const;
     inline bool isLocked() const { return _isLocked; }
+    // A portal whose condition doesn't hold can't be used, even with a key.
+    inline bool isSealed() const { return !_condition.evaluate(); }
     void lock();
     void unlock();
 
@@ -114,6 +134,7 @@ class GameMap final {
     int _destPortalId{};  // the portal id in the new (destination) map
     bool _willInteractOnContact{};  // interact with the portal on contact?
     bool _isLocked{};
+    Expression _condition;
     b2Body* _body{};
     ax::Sprite* _hintBubbleFxSprite{};
   };
@@ -124,6 +145,10 @@ class GameMap final {
   void update(const float delta);
 
   void createObjects();
+  // Returns the Npcs spawned by NpcSpawners to `npcPool`.
+  void despawnSpawnedNpcs(NpcPool& npcPool);
+  // Moves the alive Npcs placed in the .tmx map into `npcResidencyCache`.
+  void parkPlacedNpcs(NpcResidencyCache& npcResidencyCache);
   std::unique_ptr<Player> createPlayer() const;
   Item* createItem(const std::string& itemJson, float x, float y, int amount=1);
 
@@ -145,11 +170,21 @@ class GameMap final {
   inline PathFinder* getPathFinder() const { return _pathFinder.get(); }
   inline const std::unordered_set<std::shared_ptr<DynamicActor>>& getDynamicActors() const { return _dynamicActors; }
   inline const std::list<b2Body*> getTmxTiledMapPlatformBodies() const { return _tmxTiledMapPlatformBodies; }
+  inline const std::list<b2Body*>& getTmxTiledMapBodies() const { return _tmxTiledMapBodies; }
+  inline const std::vector<std::unique_ptr<GameMap::Portal>>& getPortals() const { return _portals; }
+  InteractableObject* getInteractableObject(const std::string& id) const;
 
   float getWidth() const;
   float getHeight() const;
 
  private:
+  // An Npc placed in the "Npcs" object layer.
+  struct PlacedNpc final {
+    int spawnId;  // the index of the object in the "Npcs" layer
+    Npc* npc;
+    size_t footprint;  // bytes
+  };
+
   ax::ValueVector getObjects(const std::string& layerName);
   std::list<b2Body*> createRectangles(const std::string& layerName, const short categoryBits,
                                       const bool collidable, const float defaultFriction);
@@ -159,7 +194,10 @@ class GameMap final {
   void createTriggers();
   void createPortals();
   void createNpcs();
+  void createNpcSpawners();
+  void updateNpcSpawners(const float delta);
   void createChests();
+  void createInteractableObjects();
   void createAnimatedObjects();
   void createParallaxBackground();
 
@@ -173,6 +211,10 @@ class GameMap final {
   std::unordered_set<std::shared_ptr<DynamicActor>> _dynamicActors;
   std::vector<std::unique_ptr<GameMap::Trigger>> _triggers;
   std::vector<std::unique_ptr<GameMap::Portal>> _portals;
+  std::vector<GameMap::PlacedNpc> _placedNpcs;
+  std::vector<std::unique_ptr<NpcSpawner>> _npcSpawners;
+  std::unordered_map<std::string, InteractableObject*> _interactableObjects;  // by id
+  int _npcSpawnerBudget{};  // max alive Npcs from all NpcSpawners on this map
   std::unique_ptr<ParallaxBackground> _parallaxBackground;
   std::unique_ptr<PathFinder> _pathFinder;
 
@@ -9,6 +9,10 @@
 #include "Audio.h"
 #include "CallbackManager.h"
 #include "Constants.h"
+#include "gameplay/EffectScheduler.h"
+#include "gameplay/StatusEffectSystem.h"
+#include "gameplay/TimeScale.h"
+#include "gameplay/WorldClock.h"
 #include "character/Npc.h"
 #include "character/Player.h"
 #include "item/Equipment.h"
@@ -17,6 +21,7 @@
 #include "skill/MagicalMissile.h"
 #include "util/B2BodyBuilder.h"
 #include "util/B2RayCastUtil.h"
+#include "util/MemoryTracker.h"
 #include "util/StringUtil.h"
 
 using namespace std;
@@ -28,7 +33,12 @@ GameMapManager::GameMapManager(const b2Vec2& gravity)
     : _layer{Layer::create()},
       _parallaxLayer{Layer::create()},
       _worldContactListener{std::make_unique<WorldContactListener>()},
-      _world{std::make_unique<b2World>(gravity)} {
+      _world{std::make_unique<b2World>(gravity)},
+      _perceptionSystem{std::make_unique<PerceptionSystem>()},
+      _npcPool{std::make_unique<NpcPool>()},
+      _npcResidencyCache{std::make_unique<NpcResidencyCache>()},
+      _worldSimulation{std::make_unique<WorldSimulation>(*_npcResidencyCache)},
+      _mapExploration{std::make_unique<MapExploration>()} {
   _world->SetAllowSleeping(true);
   _world->SetContinuousPhysics(true);
   _world->SetContactListener(_worldContactListener.get());
@@ -38,14 +48,24 @@ void GameMapManager::update(const float delta) {
   if (!_gameMap) {
     return;
   }
+  EffectScheduler::the().update(delta);
+  StatusEffectSystem::the().update(delta);
+  WorldClock::the().update(delta);
+  _worldSimulation->update(_gameMap.get());
   _gameMap->update(delta);
 
   if (_player) {
-    _player->update(delta);
+    _player->update(delta * TimeScale::the().getActorScale(_player.get()));
+    _player->getParty()->updateFormation();
     for (const auto& ally : _player->getAllies()) {
-      ally->update(delta);
+      ally->update(delta * TimeScale::the().getActorScale(ally));
     }
+
+    const b2Vec2& pos = _player->getBody()->GetPosition();
+    _mapExploration->update(pos.x * kPpm, pos.y * kPpm);
   }
+
+  _perceptionSystem->update(delta);
 }
 
 void GameMapManager::loadGameMap(const string& tmxMapFileName,
@@ -65,6 +85,7 @@ void GameMapManager::loadGameMap(const string& tmxMapFileName,
 
 void GameMapManager::destroyGameMap() {
   setNpcsAllowedToAct(false);
+  _perceptionSystem->clear();
 
   if (_player) {
     for (auto ally : _player->getAllies()) {
@@ -73,6 +94,9 @@ void GameMapManager::destroyGameMap() {
   }
 
   if (_gameMap) {
+    _worldSimulation->onGameMapUnloading(*_gameMap);
+    _gameMap->despawnSpawnedNpcs(*_npcPool);
+    _gameMap->parkPlacedNpcs(*_npcResidencyCache);
     _parallaxLayer->removeAllChildren();
     _layer->removeChild(_gameMap->getTmxTiledMap());
     _gameMap.reset();
@@ -81,10 +105,16 @@ void GameMapManager::destroyGameMap() {
 
 GameMap* GameMapManager::doLoadGameMap(const string& tmxMapFileName) {
   const string oldBgmFileName = (_gameMap) ? _gameMap->getBgmFileName() : "";
+  const string oldTmxMapFileName = (_gameMap) ? _gameMap->getTmxTiledMapFileName() : "";
 
   destroyGameMap();
+  MemoryTracker::the().reportMapTransition(oldTmxMapFileName);
+
+  ScopedMemoryTag memoryTag{MemoryTag::ACTORS};
   _gameMap = std::make_unique<GameMap>(_world.get(), tmxMapFileName);
   _gameMap->createObjects();
+  _worldSimulation->onGameMapLoaded(*_gameMap);
+  _mapExploration->onGameMapLoaded(*_gameMap);
   _layer->addChild(_gameMap->getTmxTiledMap(), graphical_layers::kTmxTiledMap);
 
   if (!_player) {
@@ -170,6 +200,9 @@ string GameMapManager::getOpenableObjectQueryKey(const string& tmxMapFileName,
     case GameMap::OpenableObjectType::CHEST:
       typeStr = "c";
       break;
+    case GameMap::OpenableObjectType::INTERACTABLE_OBJECT:
+      typeStr = "i";
+      break;
     default:
       break;
   }
@@ -17,7 +17,12 @@
 #include "character/Player.h"
 #include "item/Item.h"
 #include "map/GameMap.h"
+#include "map/MapExploration.h"
+#include "map/NpcPool.h"
+#include "map/NpcResidencyCache.h"
+#include "map/PerceptionSystem.h"
 #include "map/WorldContactListener.h"
+#include "map/WorldSimulation.h"
 
 namespace vigilante {
 
@@ -60,6 +65,11 @@ class GameMapManager final {
   inline b2World* getWorld() const { return _world.get(); }
   inline GameMap* getGameMap() const { return _gameMap.get(); }
   inline Player* getPlayer() const { return _player.get(); }
+  inline PerceptionSystem* getPerceptionSystem() const { return _perceptionSystem.get(); }
+  inline NpcPool* getNpcPool() const { return _npcPool.get(); }
+  inline NpcResidencyCache* getNpcResidencyCache() const { return _npcResidencyCache.get(); }
+  inline WorldSimulation* getWorldSimulation() const { return _worldSimulation.get(); }
+  inline MapExploration* getMapExploration() const { return _mapExploration.get(); }
 
  private:
   GameMap* doLoadGameMap(const std::string& tmxMapFileName);
@@ -73,6 +83,11 @@ class GameMapManager final {
   std::unique_ptr<b2World> _world;
   std::unique_ptr<GameMap> _gameMap;
   std::unique_ptr<Player> _player;
+  std::unique_ptr<PerceptionSystem> _perceptionSystem;
+  std::unique_ptr<NpcPool> _npcPool;
+  std::unique_ptr<NpcResidencyCache> _npcResidencyCache;
+  std::unique_ptr<WorldSimulation> _worldSimulation;
+  std::unique_ptr<MapExploration> _mapExploration;
 
   std::unordered_set<std::string> _npcSpawningBlacklist;
   std::atomic<bool> _areNpcsAllowedToAct{true};
@@ -0,0 +1,97 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "MapExploration.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Constants.h"
+#include "map/GameMap.h"
+
+using namespace std;
+
+namespace vigilante {
+
+bool MapExploration::Record::isExplored(const int col, const int row) const {
+  const size_t i = static_cast<size_t>(row) * cols + col;
+  return (exploredCells[i / 64] >> (i % 64)) & 1;
+}
+
+void MapExploration::Record::setExplored(const int col, const int row) {
+  const size_t i = static_cast<size_t>(row) * cols + col;
+  exploredCells[i / 64] |= uint64_t{1} << (i % 64);
+}
+
+void MapExploration::update(const float x, const float y) {
+  if (!_currentRecord) {
+    return;
+  }
+
+  const int col = std::clamp(static_cast<int>(x / kCellSize), 0, _currentRecord->cols - 1);
+  const int row = std::clamp(static_cast<int>(y / kCellSize), 0, _currentRecord->rows - 1);
+  if (col == _lastCol && row == _lastRow) {
+    return;
+  }
+  _lastCol = col;
+  _lastRow = row;
+
+  bool hasExploredNewCells = false;
+  for (int r = std::max(row - kRevealRadius, 0); r <= std::min(row + kRevealRadius, _currentRecord->rows - 1); r++) {
+    for (int c = std::max(col - kRevealRadius, 0); c <= std::min(col + kRevealRadius, _currentRecord->cols - 1); c++) {
+      if ((c - col) * (c - col) + (r - row) * (r - row) > kRevealRadius * kRevealRadius) {
+        continue;
+      }
+      if (!_currentRecord->isExplored(c, r)) {
+        _currentRecord->setExplored(c, r);
+        hasExploredNewCells = true;
+      }
+    }
+  }
+
+  if (hasExploredNewCells) {
+    _revision++;
+  }
+}
+
+void MapExploration::reset() {
+  _records.clear();
+  _currentTmxMapFileName.clear();
+  _currentRecord = nullptr;
+  _lastCol = -1;
+  _lastRow = -1;
+  _revision++;
+}
+
+void MapExploration::onGameMapLoaded(const GameMap& gameMap) {
+  const int cols = std::max(static_cast<int>(std::ceil(gameMap.getWidth() / kCellSize)), 1);
+  const int rows = std::max(static_cast<int>(std::ceil(gameMap.getHeight() / kCellSize)), 1);
+
+  _currentTmxMapFileName = gameMap.getTmxTiledMapFileName();
+  _currentRecord = &_records[_currentTmxMapFileName];
+  _lastCol = -1;
+  _lastRow = -1;
+  _revision++;
+
+  // The map may have been resized since the record was saved,
+  // in which case the explored cells no longer line up.
+  Record& record = *_currentRecord;
+  if (record.cols != cols || record.rows != rows) {
+    record.cols = cols;
+    record.rows = rows;
+    record.exploredCells.assign((static_cast<size_t>(cols) * rows + 63) / 64, 0);
+  }
+  record.width = gameMap.getWidth();
+  record.height = gameMap.getHeight();
+
+  record.connections.clear();
+  for (const auto& portal : gameMap.getPortals()) {
+    const b2Vec2& pos = portal->getInteractionBody()->GetPosition();
+    record.connections.push_back({portal->getDestTmxMapFileName(), pos.x * kPpm, pos.y * kPpm});
+  }
+}
+
+const MapExploration::Record* MapExploration::getRecord(const string& tmxMapFileName) const {
+  auto it = _records.find(tmxMapFileName);
+  return it != _records.end() ? &it->second : nullptr;
+}
+
+}  // namespace vigilante
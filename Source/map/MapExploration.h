@@ -0,0 +1,73 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_MAP_EXPLORATION_H_
+#define VIGILANTE_MAP_EXPLORATION_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vigilante {
+
+class GameMap;
+
+// MapExploration remembers which parts of each GameMap the player has
+// explored (the fog of war of the minimap and the world map), and how the
+// explored maps are connected to each other via portals.
+//
+// Each map is divided into square cells, and the explored cells are kept
+// in a bitset, which is only touched when the player enters another cell.
+class MapExploration final {
+ public:
+  static inline constexpr float kCellSize = 64.0f;  // pixels
+  static inline constexpr int kRevealRadius = 3;  // cells
+
+  struct Connection final {
+    std::string destTmxMapFileName;
+    float x{};  // pixels, the center of the portal
+    float y{};  // pixels, the center of the portal
+  };
+
+  struct Record final {
+    bool isExplored(const int col, const int row) const;
+    void setExplored(const int col, const int row);
+
+    int cols{};
+    int rows{};
+    float width{};  // pixels
+    float height{};  // pixels
+    std::vector<uint64_t> exploredCells;  // bitset, row-major
+    std::vector<MapExploration::Connection> connections;
+  };
+
+  MapExploration() = default;
+
+  // Marks the cells around (x, y) of the current map explored.
+  void update(const float x, const float y);
+  void reset();
+
+  // Creates the record of `gameMap` if it is the first visit,
+  // and updates its portal connections.
+  void onGameMapLoaded(const GameMap& gameMap);
+
+  const MapExploration::Record* getRecord(const std::string& tmxMapFileName) const;
+  inline const std::unordered_map<std::string, MapExploration::Record>& getRecords() const { return _records; }
+  inline const std::string& getCurrentTmxMapFileName() const { return _currentTmxMapFileName; }
+  // Bumped whenever a cell is explored, so that
+  // the views know when to update their fog of war.
+  inline uint32_t getRevision() const { return _revision; }
+
+ private:
+  std::unordered_map<std::string, MapExploration::Record> _records;
+  std::string _currentTmxMapFileName;
+  MapExploration::Record* _currentRecord{};
+  int _lastCol{-1};
+  int _lastRow{-1};
+  uint32_t _revision{};
+
+  friend class GameState;
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_MAP_EXPLORATION_H_
@@ -0,0 +1,58 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "NpcPool.h"
+
+#include "character/Npc.h"
+#include "gameplay/StatusEffectSystem.h"
+#include "util/Logger.h"
+
+using namespace std;
+
+namespace vigilante {
+
+shared_ptr<Npc> NpcPool::acquire(const string& jsonFileName) {
+  auto it = _pooledNpcs.find(jsonFileName);
+  if (it == _pooledNpcs.end() || it->second.empty()) {
+    return std::make_shared<Npc>(jsonFileName);
+  }
+
+  shared_ptr<Npc> npc = std::move(it->second.back());
+  it->second.pop_back();
+  npc->revive();
+  return npc;
+}
+
+void NpcPool::release(shared_ptr<Npc> npc) {
+  if (!npc) {
+    return;
+  }
+
+  if (npc->isShownOnMap()) {
+    VGLOG(LOG_ERR, "Failed to release [%s] to the pool, it is still shown on the map.",
+          npc->getCharacterProfile().jsonFileName.c_str());
+    return;
+  }
+
+  // Its body is gone, so its status effects mustn't tick anymore.
+  // They are reset upon being revived by acquire().
+  StatusEffectSystem::the().forget(npc.get());
+
+  auto& pooledNpcs = _pooledNpcs[npc->getCharacterProfile().jsonFileName];
+  if (pooledNpcs.size() >= kMaxPooledNpcsPerProfile) {
+    return;
+  }
+  pooledNpcs.push_back(std::move(npc));
+}
+
+void NpcPool::clear() {
+  _pooledNpcs.clear();
+}
+
+size_t NpcPool::getSize() const {
+  size_t size = 0;
+  for (const auto& [_, pooledNpcs] : _pooledNpcs) {
+    size += pooledNpcs.size();
+  }
+  return size;
+}
+
+}  // namespace vigilante
@@ -0,0 +1,35 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_NPC_POOL_H_
+#define VIGILANTE_NPC_POOL_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vigilante {
+
+class Npc;
+
+// NpcPool keeps the Npcs which have been despawned, so that they can be
+// reused by the next spawn of the same profile instead of parsing the
+// profile and loading all the animations again.
+class NpcPool final {
+ public:
+  // Returns a pooled Npc if there is one, otherwise a new Npc is created.
+  std::shared_ptr<Npc> acquire(const std::string& jsonFileName);
+  // `npc` must have been removed from the map. Its status effects are dropped.
+  void release(std::shared_ptr<Npc> npc);
+  void clear();
+
+  size_t getSize() const;
+
+ private:
+  static inline constexpr size_t kMaxPooledNpcsPerProfile = 8;
+
+  std::unordered_map<std::string, std::vector<std::shared_ptr<Npc>>> _pooledNpcs;
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_NPC_POOL_H_
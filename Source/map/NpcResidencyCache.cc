@@ -0,0 +1,56 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "NpcResidencyCache.h"
+
+#include "character/Npc.h"
+#include "util/Logger.h"
+#include "util/StringUtil.h"
+
+using namespace std;
+
+namespace vigilante {
+
+void NpcResidencyCache::park(const string& tmxMapFileName, const int spawnId,
+                             NpcResidencyCache::Entry entry) {
+  if (unpark(tmxMapFileName, spawnId)) {
+    VGLOG(LOG_WARN, "Replacing parked Npc [%d] of [%s].", spawnId, tmxMapFileName.c_str());
+  }
+
+  string key = getKey(tmxMapFileName, spawnId);
+  _totalFootprint += entry.footprint;
+  _entries.emplace_front(key, std::move(entry));
+  _index.emplace(std::move(key), _entries.begin());
+
+  while (_totalFootprint > kBudget && !_entries.empty()) {
+    const auto& [evictedKey, evictedEntry] = _entries.back();
+    VGLOG(LOG_INFO, "Evicting parked Npc [%s].", evictedKey.c_str());
+    _totalFootprint -= evictedEntry.footprint;
+    _index.erase(evictedKey);
+    _entries.pop_back();
+  }
+}
+
+optional<NpcResidencyCache::Entry> NpcResidencyCache::unpark(const string& tmxMapFileName,
+                                                             const int spawnId) {
+  auto it = _index.find(getKey(tmxMapFileName, spawnId));
+  if (it == _index.end()) {
+    return std::nullopt;
+  }
+
+  NpcResidencyCache::Entry entry = std::move(it->second->second);
+  _totalFootprint -= entry.footprint;
+  _entries.erase(it->second);
+  _index.erase(it);
+  return entry;
+}
+
+void NpcResidencyCache::clear() {
+  _index.clear();
+  _entries.clear();
+  _totalFootprint = 0;
+}
+
+string NpcResidencyCache::getKey(const string& tmxMapFileName, const int spawnId) {
+  return string_util::format("%s#%d", tmxMapFileName.c_str(), spawnId);
+}
+
+}  // namespace vigilante
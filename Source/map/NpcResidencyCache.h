@@ -0,0 +1,57 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_NPC_RESIDENCY_CACHE_H_
+#define VIGILANTE_NPC_RESIDENCY_CACHE_H_
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace vigilante {
+
+class Npc;
+
+// NpcResidencyCache parks the Npcs placed in a .tmx map when the map is
+// unloaded, so that revisiting the map brings back the same instances with
+// their runtime state (health, position, inventory, ...) intact, instead of
+// creating them from scratch.
+//
+// Parked Npcs are detached from the scene and have no b2Body. Once the
+// estimated memory footprint of the parked Npcs exceeds the budget, the least
+// recently parked ones are evicted, and they'll be recreated from the .tmx map.
+class NpcResidencyCache final {
+ public:
+  struct Entry final {
+    std::shared_ptr<Npc> npc;
+    float x;  // pixels
+    float y;  // pixels
+    size_t footprint;  // bytes
+  };
+
+  // Used as the footprint of an Npc when it can't be measured,
+  // e.g., MemoryTracker is disabled.
+  static inline constexpr size_t kEstimatedFootprint = 512 * 1024;
+
+  void park(const std::string& tmxMapFileName, const int spawnId, NpcResidencyCache::Entry entry);
+  std::optional<NpcResidencyCache::Entry> unpark(const std::string& tmxMapFileName, const int spawnId);
+  void clear();
+
+  inline size_t getSize() const { return _entries.size(); }
+  inline size_t getTotalFootprint() const { return _totalFootprint; }
+
+ private:
+  static inline constexpr size_t kBudget = 32 * 1024 * 1024;
+
+  static std::string getKey(const std::string& tmxMapFileName, const int spawnId);
+
+  // The most recently parked entries are at the front.
+  std::list<std::pair<std::string, NpcResidencyCache::Entry>> _entries;
+  std::unordered_map<std::string, decltype(_entries)::iterator> _index;
+  size_t _totalFootprint{};
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_NPC_RESIDENCY_CACHE_H_
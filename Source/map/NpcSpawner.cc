@@ -0,0 +1,199 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "NpcSpawner.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <type_traits>
+
+#include "Constants.h"
+#include "character/Npc.h"
+#include "character/Player.h"
+#include "map/GameMap.h"
+#include "map/NpcPool.h"
+#include "scene/GameScene.h"
+#include "scene/SceneManager.h"
+#include "util/Logger.h"
+#include "util/RandUtil.h"
+#include "util/StringUtil.h"
+
+using namespace std;
+USING_NS_AX;
+
+namespace vigilante {
+
+namespace {
+
+constexpr float kDefaultRespawnInterval = 30.0f;
+constexpr int kDefaultMaxAlive = 1;
+constexpr float kDefaultActivationRadius = 400.0f;
+constexpr int kDefaultWaveSize = 1;
+constexpr int kDefaultNumWaves = 0;
+
+template <typename T>
+T getProperty(const ValueMap& valMap, const string& key, const T defaultValue) {
+  auto it = valMap.find(key);
+  if (it == valMap.end()) {
+    return defaultValue;
+  }
+
+  if constexpr (std::is_same_v<T, int>) {
+    return it->second.asInt();
+  } else {
+    return it->second.asFloat();
+  }
+}
+
+}  // namespace
+
+NpcSpawner::Profile::Profile(const ValueMap& valMap)
+    : respawnInterval{getProperty(valMap, "respawnInterval", kDefaultRespawnInterval)},
+      maxAlive{getProperty(valMap, "maxAlive", kDefaultMaxAlive)},
+      activationRadius{getProperty(valMap, "activationRadius", kDefaultActivationRadius)},
+      waveSize{getProperty(valMap, "waveSize", kDefaultWaveSize)},
+      numWaves{getProperty(valMap, "waves", kDefaultNumWaves)} {
+  // e.g., "Resources/Database/character/wolf.json:3;Resources/Database/character/bat.json:1"
+  for (const auto& entry : string_util::split(valMap.at("spawnTable").asString(), ';')) {
+    vector<string> tokens = string_util::split(entry, ':');
+    if (tokens.empty()) {
+      continue;
+    }
+    const int weight = (tokens.size() > 1) ? std::atoi(tokens[1].c_str()) : 1;
+    spawnTable.emplace_back(std::move(tokens[0]), std::max(weight, 1));
+  }
+
+  if (waveSize > maxAlive) {
+    VGLOG(LOG_WARN, "waveSize (%d) exceeds maxAlive (%d), clamping.", waveSize, maxAlive);
+    waveSize = maxAlive;
+  }
+}
+
+NpcSpawner::NpcSpawner(const ValueMap& valMap, const float x, const float y, const float width)
+    : _profile{valMap},
+      _position{x / kPpm, y / kPpm},
+      _width{width / kPpm} {}
+
+int NpcSpawner::update(const float delta, GameMap& gameMap, NpcPool& npcPool, const int budget) {
+  // Recycle the Npcs which have been killed for a while.
+  for (size_t i = 0; i < _spawnedNpcs.size();) {
+    SpawnedNpc& spawnedNpc = _spawnedNpcs[i];
+    if (spawnedNpc.npc->isKilled() && (spawnedNpc.corpseTimer += delta) >= kCorpseLingerTime) {
+      despawn(spawnedNpc.npc, gameMap, npcPool);
+      std::swap(spawnedNpc, _spawnedNpcs.back());
+      _spawnedNpcs.pop_back();
+      continue;
+    }
+    i++;
+  }
+
+  if (isExhausted() || !isActive()) {
+    return 0;
+  }
+
+  // The next wave is due only after there's enough room for all of it.
+  const int aliveCount = getAliveCount();
+  if (aliveCount + _profile.waveSize > _profile.maxAlive) {
+    _respawnTimer = _profile.respawnInterval;
+    return 0;
+  }
+  if ((_respawnTimer -= delta) > 0 || budget < _profile.waveSize) {
+    return 0;
+  }
+
+  int numSpawned = 0;
+  for (int i = 0; i < _profile.waveSize; i++) {
+    const string* jsonFileName = pickFromSpawnTable();
+    if (!jsonFileName) {
+      break;
+    }
+
+    const float x = (_position.x + rand_util::randFloat(0, _width)) * kPpm;
+    const float y = _position.y * kPpm;
+    shared_ptr<Npc> npc = npcPool.acquire(*jsonFileName);
+    Npc* rawNpc = npc.get();
+    if (!gameMap.showDynamicActor<Npc>(std::move(npc), x, y)) {
+      continue;
+    }
+    _spawnedNpcs.push_back({rawNpc, 0});
+    numSpawned++;
+  }
+
+  // A wave of which nothing could be spawned doesn't count.
+  if (numSpawned > 0) {
+    _numWavesSpawned++;
+  }
+  _respawnTimer = _profile.respawnInterval;
+  return numSpawned;
+}
+
+void NpcSpawner::despawnAll(GameMap& gameMap, NpcPool& npcPool) {
+  for (const auto& spawnedNpc : _spawnedNpcs) {
+    despawn(spawnedNpc.npc, gameMap, npcPool);
+  }
+  _spawnedNpcs.clear();
+}
+
+int NpcSpawner::getAliveCount() const {
+  return std::count_if(_spawnedNpcs.begin(), _spawnedNpcs.end(), [](const SpawnedNpc& s) {
+    return !s.npc->isKilled();
+  });
+}
+
+bool NpcSpawner::isActive() const {
+  auto player = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager()->getPlayer();
+  if (!player || !player->getBody()) {
+    return false;
+  }
+
+  const b2Vec2 center{_position.x + _width / 2, _position.y};
+  const float radius = _profile.activationRadius / kPpm;
+  return (player->getBody()->GetPosition() - center).LengthSquared() <= radius * radius;
+}
+
+const string* NpcSpawner::pickFromSpawnTable() const {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+
+  int totalWeight = 0;
+  for (const auto& [jsonFileName, weight] : _profile.spawnTable) {
+    if (gmMgr->isNpcAllowedToSpawn(jsonFileName)) {
+      totalWeight += weight;
+    }
+  }
+  if (totalWeight == 0) {
+    return nullptr;
+  }
+
+  int n = rand_util::randInt(1, totalWeight);
+  for (const auto& [jsonFileName, weight] : _profile.spawnTable) {
+    if (!gmMgr->isNpcAllowedToSpawn(jsonFileName)) {
+      continue;
+    }
+    if ((n -= weight) <= 0) {
+      return &jsonFileName;
+    }
+  }
+  return nullptr;
+}
+
+void NpcSpawner::despawn(Npc* npc, GameMap& gameMap, NpcPool& npcPool) {
+  // The pooled Npc will be reused, so nobody should keep referring to it.
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  if (auto player = gmMgr->getPlayer()) {
+    player->getInRangeTargets().erase(npc);
+    if (player->getLockedOnTarget() == npc) {
+      player->setLockedOnTarget(nullptr);
+    }
+  }
+  for (const auto& actor : gameMap.getDynamicActors()) {
+    if (auto other = dynamic_cast<Npc*>(actor.get()); other && other != npc) {
+      other->getPerception().forget(npc);
+      other->getInRangeTargets().erase(npc);
+      if (other->getLockedOnTarget() == npc) {
+        other->setLockedOnTarget(nullptr);
+      }
+    }
+  }
+
+  npcPool.release(gameMap.removeDynamicActor<Npc>(npc));
+}
+
+}  // namespace vigilante
@@ -0,0 +1,76 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_NPC_SPAWNER_H_
+#define VIGILANTE_NPC_SPAWNER_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <axmol.h>
+
+#include <box2d/box2d.h>
+
+namespace vigilante {
+
+class GameMap;
+class Npc;
+class NpcPool;
+
+// An NpcSpawner is placed in the "NpcSpawners" object layer of a .tmx map.
+// Once the player gets within its activation radius, it spawns waves of Npcs
+// picked from its spawn table, and respawns them after they've been killed.
+//
+// Killed Npcs are left on the map for a while, and then returned to
+// the NpcPool so that the next spawn can reuse them.
+//
+// Note that non-respawnable Npc profiles will be blacklisted once killed
+// (see Npc::onKilled()), after which the spawner won't spawn them anymore.
+class NpcSpawner final {
+ public:
+  struct Profile final {
+    explicit Profile(const ax::ValueMap& valMap);
+
+    // <json, weight>
+    std::vector<std::pair<std::string, int>> spawnTable;
+    float respawnInterval;  // seconds
+    int maxAlive;
+    float activationRadius;  // pixels
+    int waveSize;  // the number of Npcs spawned at once
+    int numWaves;  // 0 means unlimited
+  };
+
+  NpcSpawner(const ax::ValueMap& valMap, const float x, const float y, const float width);
+
+  // Spawns at most `budget` Npcs on `gameMap`.
+  // @return: the number of Npcs which have been spawned.
+  int update(const float delta, GameMap& gameMap, NpcPool& npcPool, const int budget);
+
+  // Removes all the Npcs spawned by this spawner from `gameMap`.
+  void despawnAll(GameMap& gameMap, NpcPool& npcPool);
+
+  int getAliveCount() const;
+  inline bool isExhausted() const { return _profile.numWaves > 0 && _numWavesSpawned >= _profile.numWaves; }
+
+ private:
+  static inline constexpr float kCorpseLingerTime = 5.0f;
+
+  struct SpawnedNpc final {
+    Npc* npc;
+    float corpseTimer;
+  };
+
+  bool isActive() const;
+  const std::string* pickFromSpawnTable() const;
+  void despawn(Npc* npc, GameMap& gameMap, NpcPool& npcPool);
+
+  const NpcSpawner::Profile _profile;
+  const b2Vec2 _position;  // the left end, in meters
+  const float _width;  // in meters
+  std::vector<NpcSpawner::SpawnedNpc> _spawnedNpcs;
+  float _respawnTimer{};
+  int _numWavesSpawned{};
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_NPC_SPAWNER_H_
@@ -1,6 +1,7 @@
 // Copyright (c) 2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
 #include "ParallaxBackground.h"
 
+#include "Options.h"
 #include "scene/SceneManager.h"
 
 namespace fs = std::filesystem;
@@ -97,8 +98,21 @@ bool ParallaxBackground::load(const fs::path& bgDirPath, const float bgScale) {
     return false;
   }
 
-  constexpr int kMax = 10;
-  for (int i = 0; i < kMax; i++) {
+  // The layers are ordered from the farthest, which doesn't scroll,
+  // so lower quality keeps the farthest ones.
+  int maxLayerCount = 10;
+  switch (Options::the().getEffectQuality()) {
+    case Options::EffectQuality::LOW:
+      maxLayerCount = 1;
+      break;
+    case Options::EffectQuality::MEDIUM:
+      maxLayerCount = Options::kMediumParallaxLayerCount;
+      break;
+    default:
+      break;
+  }
+
+  for (int i = 0; i < maxLayerCount; i++) {
     const string bgFileName = std::to_string(i) + ".png";
     const fs::path bgPath = bgDirPath / bgFileName;
     if (!fs::exists(bgPath, ec)) {
@@ -0,0 +1,244 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "PerceptionSystem.h"
+
+#include <cmath>
+
+#include "Constants.h"
+#include "character/Npc.h"
+#include "character/Player.h"
+#include "scene/GameScene.h"
+#include "scene/SceneManager.h"
+
+using namespace std;
+using namespace vigilante::category_bits;
+
+namespace vigilante {
+
+namespace {
+
+constexpr float kCellSize = 2.0f;
+constexpr float kEvaluationInterval = .25f;
+constexpr float kNoiseDuration = .5f;
+constexpr int kMaxEvaluationsPerFrame = 8;
+constexpr int kMaxRayCastsPerFrame = 16;
+constexpr short kLineOfSightBlockingCategoryBits = kGround | kWall;
+
+}  // namespace
+
+void PerceptionSystem::update(const float delta) {
+  _time += delta;
+
+  std::erase_if(_transientStimuli, [this](const Stimulus& s) {
+    return s.expiryTime < _time;
+  });
+
+  collectStimuli();
+  rebuildGrid();
+
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  if (!gmMgr->areNpcsAllowedToAct() || _perceivers.empty()) {
+    return;
+  }
+
+  // Evaluate the Npcs in a round-robin fashion, so that the cost of perception
+  // per frame stays bounded no matter how many Npcs are on the map.
+  const size_t numPerceivers = _perceivers.size();
+  int numEvaluations = 0;
+  int rayCastBudget = kMaxRayCastsPerFrame;
+  size_t i = 0;
+
+  for (; i < numPerceivers && numEvaluations < kMaxEvaluationsPerFrame && rayCastBudget > 0; i++) {
+    Npc* npc = _perceivers[(_evaluationCursor + i) % numPerceivers];
+    if (!npc->getPerception().isEvaluationDue(_time)) {
+      continue;
+    }
+    evaluate(npc, rayCastBudget);
+    npc->getPerception().setNextEvaluationTime(_time + kEvaluationInterval);
+    numEvaluations++;
+  }
+
+  _evaluationCursor = (_evaluationCursor + i) % numPerceivers;
+}
+
+void PerceptionSystem::clear() {
+  _transientStimuli.clear();
+  _stimuli.clear();
+  _grid.clear();
+  _perceivables.clear();
+  _perceivers.clear();
+  _evaluationCursor = 0;
+}
+
+void PerceptionSystem::publishNoise(Character* source, const float radius) {
+  if (!source || !source->getBody()) {
+    return;
+  }
+
+  _transientStimuli.push_back(Stimulus{
+    Perception::Sense::HEARING, source, source->getBody()->GetPosition(), radius, _time + kNoiseDuration
+  });
+}
+
+void PerceptionSystem::publishDamage(Character* victim, Character* source) {
+  if (!source || !source->getBody()) {
+    return;
+  }
+
+  const b2Vec2& sourcePos = source->getBody()->GetPosition();
+
+  // The victim always knows who hurt it, whereas the others nearby
+  // only notice the commotion when they evaluate their surroundings.
+  if (Npc* npc = dynamic_cast<Npc*>(victim)) {
+    npc->getPerception().sense(source, sourcePos, Perception::Sense::DAMAGE, _time);
+    npc->wake();
+  }
+
+  _transientStimuli.push_back(Stimulus{
+    Perception::Sense::DAMAGE, source, sourcePos, kDamageNoiseRadius, _time + kNoiseDuration
+  });
+}
+
+void PerceptionSystem::collectStimuli() {
+  _stimuli.clear();
+  _perceivables.clear();
+  _perceivers.clear();
+
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  if (!gmMgr->getGameMap()) {
+    return;
+  }
+
+  if (Player* player = gmMgr->getPlayer()) {
+    addCharacter(player);
+    for (auto ally : player->getAllies()) {
+      addCharacter(ally);
+    }
+  }
+
+  for (const auto& actor : gmMgr->getGameMap()->getDynamicActors()) {
+    if (Npc* npc = dynamic_cast<Npc*>(actor.get())) {
+      addCharacter(npc);
+    }
+  }
+
+  for (const auto& stimulus : _transientStimuli) {
+    if (_perceivables.contains(stimulus.source)) {
+      _stimuli.push_back(stimulus);
+    }
+  }
+}
+
+void PerceptionSystem::addCharacter(Character* c) {
+  if (!c->getBody() || c->isSetToKill() || c->isKilled()) {
+    return;
+  }
+
+  if (!_perceivables.insert(c).second) {
+    return;
+  }
+
+  _stimuli.push_back(Stimulus{
+    Perception::Sense::SIGHT, c, c->getBody()->GetPosition(), 0.0f, _time
+  });
+
+  Npc* npc = dynamic_cast<Npc*>(c);
+  if (npc && isPerceiver(npc)) {
+    _perceivers.push_back(npc);
+  }
+}
+
+void PerceptionSystem::rebuildGrid() {
+  for (auto& [_, cell] : _grid) {
+    cell.clear();
+  }
+
+  for (size_t i = 0; i < _stimuli.size(); i++) {
+    const Stimulus& s = _stimuli[i];
+
+    // A sound is registered in every cell it can be heard from,
+    // whereas sight stimuli only occupy the cell they are in.
+    const float radius = (s.sense == Perception::Sense::SIGHT) ? 0.0f : s.radius;
+    for (int x = toCell(s.position.x - radius); x <= toCell(s.position.x + radius); x++) {
+      for (int y = toCell(s.position.y - radius); y <= toCell(s.position.y + radius); y++) {
+        _grid[getCellKey(x, y)].push_back(i);
+      }
+    }
+  }
+}
+
+void PerceptionSystem::evaluate(Npc* npc, int& rayCastBudget) {
+  Perception& perception = npc->getPerception();
+  const b2Vec2& pos = npc->getBody()->GetPosition();
+  const float facing = npc->isFacingRight() ? 1.0f : -1.0f;
+  const int ownCellX = toCell(pos.x);
+  const int ownCellY = toCell(pos.y);
+
+  for (int x = toCell(pos.x - kSightRange); x <= toCell(pos.x + kSightRange); x++) {
+    for (int y = toCell(pos.y - kSightRange); y <= toCell(pos.y + kSightRange); y++) {
+      auto it = _grid.find(getCellKey(x, y));
+      if (it == _grid.end()) {
+        continue;
+      }
+
+      const bool isOwnCell = x == ownCellX && y == ownCellY;
+      for (const size_t i : it->second) {
+        const Stimulus& s = _stimuli[i];
+        if (s.source == npc || !isHostile(npc, s.source)) {
+          continue;
+        }
+
+        const float dx = s.position.x - pos.x;
+        const float dist = std::hypotf(dx, s.position.y - pos.y);
+
+        if (s.sense != Perception::Sense::SIGHT) {
+          // Sounds are registered in every cell they cover,
+          // so only check them once from the Npc's own cell.
+          if (isOwnCell && dist <= s.radius) {
+            perception.sense(s.source, s.position, s.sense, _time);
+            npc->wake();
+          }
+          continue;
+        }
+
+        if (dist > kSightRange || (dist > kProximityRange && dx * facing < 0)) {
+          continue;
+        }
+        if (rayCastBudget <= 0) {
+          return;
+        }
+        rayCastBudget--;
+        if (hasLineOfSight(pos, s.position)) {
+          perception.sense(s.source, s.position, Perception::Sense::SIGHT, _time);
+          npc->wake();
+        }
+      }
+    }
+  }
+}
+
+bool PerceptionSystem::isPerceiver(const Npc* npc) const {
+  // Neutral townsfolk don't look for fights.
+  return npc->getDisposition() == Npc::Disposition::ENEMY || npc->getParty();
+}
+
+bool PerceptionSystem::isHostile(const Npc* npc, const Character* target) const {
+  if (const Npc* targetNpc = dynamic_cast<const Npc*>(target)) {
+    return npc->getDisposition() != targetNpc->getDisposition();
+  }
+  return npc->getDisposition() == Npc::Disposition::ENEMY;
+}
+
+bool PerceptionSystem::hasLineOfSight(const b2Vec2& src, const b2Vec2& dst) const {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  return !gmMgr->rayCast(src, dst, kLineOfSightBlockingCategoryBits);
+}
+
+int PerceptionSystem::toCell(const float x) {
+  return static_cast<int>(std::floor(x / kCellSize));
+}
+
+PerceptionSystem::CellKey PerceptionSystem::getCellKey(const int cellX, const int cellY) {
+  return (static_cast<CellKey>(static_cast<uint32_t>(cellX)) << 32) | static_cast<uint32_t>(cellY);
+}
+
+}  // namespace vigilante
@@ -0,0 +1,78 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_PERCEPTION_SYSTEM_H_
+#define VIGILANTE_PERCEPTION_SYSTEM_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <box2d/box2d.h>
+
+#include "character/Perception.h"
+
+namespace vigilante {
+
+class Character;
+class Npc;
+
+// PerceptionSystem collects stimuli (sight, noise, damage) into a uniform grid
+// once per frame, and lets a bounded number of Npcs evaluate the stimuli around
+// them. Sight requires a line of sight against the static map geometry, and the
+// results are stored in each Npc's Perception memory.
+class PerceptionSystem final {
+ public:
+  struct Stimulus final {
+    Perception::Sense sense;
+    Character* source;
+    b2Vec2 position;
+    float radius;  // unused by SIGHT
+    float expiryTime;
+  };
+
+  static inline constexpr float kSightRange = 4.0f;
+  static inline constexpr float kProximityRange = .75f;
+  static inline constexpr float kAttackNoiseRadius = 2.5f;
+  static inline constexpr float kDamageNoiseRadius = 3.5f;
+
+  void update(const float delta);
+  void clear();
+
+  void publishNoise(Character* source, const float radius);
+  void publishDamage(Character* victim, Character* source);
+
+  // Whether `c` is still on the current map and alive. NpcController uses this
+  // to validate the targets in its Perception memory before dereferencing them.
+  inline bool isPerceivable(const Character* c) const { return _perceivables.contains(c); }
+  inline float getTime() const { return _time; }
+  bool isPerceiver(const Npc* npc) const;
+
+ private:
+  using CellKey = uint64_t;
+
+  void collectStimuli();
+  void addCharacter(Character* c);
+  void rebuildGrid();
+  void evaluate(Npc* npc, int& rayCastBudget);
+  bool isHostile(const Npc* npc, const Character* target) const;
+  bool hasLineOfSight(const b2Vec2& src, const b2Vec2& dst) const;
+
+  static int toCell(const float x);
+  static CellKey getCellKey(const int cellX, const int cellY);
+
+  float _time{};
+
+  // Noise and damage stimuli live for a short while,
+  // whereas sight stimuli are regenerated every frame.
+  std::vector<Stimulus> _transientStimuli;
+  std::vector<Stimulus> _stimuli;
+  std::unordered_map<CellKey, std::vector<size_t>> _grid;
+
+  std::unordered_set<const Character*> _perceivables;
+  std::vector<Npc*> _perceivers;
+  size_t _evaluationCursor{};
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_PERCEPTION_SYSTEM_H_
@@ -200,15 +200,9 @@ void WorldContactListener::BeginContact(b2Contact* contact) {
           }, .1f);
         }
 
-        unordered_set<Interactable*>& interactables = c->getInRangeInteractables();
-        if (interactables.size()) {
-          (*interactables.begin())->hideHintUI();
-        }
-        interactables.insert(i);
-
-        if (dynamic_cast<Player*>(c)) {
-          (*interactables.begin())->showHintUI();
-        }
+        // The player's hints are shown by its InteractionResolver.
+        c->getInRangeInteractables().insert(i);
+        i->onContactBegin(c);
       }
       break;
     }
@@ -348,7 +342,10 @@ void WorldContactListener::EndContact(b2Contact* contact) {
         Character* c = reinterpret_cast<Character*>(feetFixture->GetUserData().pointer);
         Interactable* i = reinterpret_cast<Interactable*>(interactableFixture->GetUserData().pointer);
         c->getInRangeInteractables().erase(i);
-        i->hideHintUI();
+        if (auto player = dynamic_cast<Player*>(c)) {
+          player->getInteractionResolver().onOutOfRange(i);
+        }
+        i->onContactEnd(c);
       }
       break;
     }
@@ -0,0 +1,357 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "WorldSimulation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <optional>
+
+#include "Assets.h"
+#include "Constants.h"
+#include "character/Npc.h"
+#include "gameplay/StatusEffectSystem.h"
+#include "gameplay/WorldClock.h"
+#include "item/Item.h"
+#include "map/GameMap.h"
+#include "map/NpcResidencyCache.h"
+#include "scene/GameScene.h"
+#include "scene/SceneManager.h"
+#include "util/JsonUtil.h"
+#include "util/Logger.h"
+
+using namespace std;
+USING_NS_AX;
+
+namespace vigilante {
+
+namespace {
+
+// The parked actors of the records share a single key in NpcResidencyCache,
+// with the record id as the spawn id.
+constexpr char kResidencyCacheKey[] = "WorldSimulation";
+
+// How far (in pixels) beyond the edges of the screen
+// an Npc has to be for it to be out of sight.
+constexpr float kNpcOutOfSightMargin = 32.0f;
+
+optional<WorldSimulation::Activity> parseActivity(const string& activity) {
+  if (activity == "idle") {
+    return WorldSimulation::Activity::IDLE;
+  } else if (activity == "work") {
+    return WorldSimulation::Activity::WORK;
+  } else if (activity == "sleep") {
+    return WorldSimulation::Activity::SLEEP;
+  }
+  return nullopt;
+}
+
+void restock(Npc& npc) {
+  for (const auto& [itemJsonFileName, amount] : npc.getCharacterProfile().defaultInventory) {
+    const int missingAmount = amount - npc.getItemAmount(itemJsonFileName);
+    if (missingAmount > 0) {
+      npc.addItem(Item::create(itemJsonFileName), missingAmount);
+    }
+  }
+}
+
+}  // namespace
+
+WorldSimulation::WorldSimulation(NpcResidencyCache& npcResidencyCache)
+    : _npcResidencyCache{npcResidencyCache} {
+  loadDefinitions(assets::kWorldNpcsJson);
+}
+
+void WorldSimulation::update(GameMap* gameMap) {
+  if (_records.empty()) {
+    return;
+  }
+
+  const double time = WorldClock::the().getTime();
+  const size_t n = std::min(kRecordsPerTick, _records.size());
+  for (size_t i = 0; i < n; i++) {
+    _cursor = (_cursor + 1) % _records.size();
+    simulate(_cursor, time, gameMap);
+  }
+}
+
+void WorldSimulation::reset() {
+  const double time = WorldClock::the().getTime();
+
+  _records.clear();
+  _cursor = 0;
+  for (uint16_t i = 0; i < _definitions.size(); i++) {
+    _records.push_back(makeRecord(i, time));
+  }
+}
+
+void WorldSimulation::onGameMapLoaded(GameMap& gameMap) {
+  auto it = _mapIds.find(gameMap.getTmxTiledMapFileName());
+  _loadedMapId = (it != _mapIds.end()) ? it->second : kNoMapId;
+
+  const double time = WorldClock::the().getTime();
+  for (size_t i = 0; i < _records.size(); i++) {
+    simulate(i, time, &gameMap);
+  }
+}
+
+void WorldSimulation::onGameMapUnloading(GameMap& gameMap) {
+  const double time = WorldClock::the().getTime();
+
+  for (size_t i = 0; i < _records.size(); i++) {
+    Record& record = _records[i];
+    if (!record.npc) {
+      continue;
+    }
+
+    shared_ptr<DynamicActor> key{shared_ptr<DynamicActor>(), record.npc};
+    if (!gameMap.getDynamicActors().contains(key) || record.npc->getParty()) {
+      record.npc = nullptr;
+      record.hasLeft = true;
+    } else if (record.npc->isKilled()) {
+      record.npc = nullptr;
+      record.isKilled = true;
+      record.respawnTime = time + _definitions[record.definitionId].respawnTime;
+    } else {
+      despawn(i, gameMap);
+      if (record.activity == Activity::TRAVEL) {
+        record.arrivalTime = time + kTravelTime;
+      }
+    }
+  }
+
+  _loadedMapId = kNoMapId;
+}
+
+void WorldSimulation::loadDefinitions(const fs::path& jsonFileName) {
+  rapidjson::Document json = json_util::parseJson(jsonFileName);
+  if (json.HasParseError() || !json.IsObject() ||
+      !json.HasMember("schedules") || !json.HasMember("npcs")) {
+    VGLOG(LOG_ERR, "Failed to load world Npcs from [%s].", jsonFileName.c_str());
+    return;
+  }
+
+  unordered_map<string, vector<ScheduleEntry>> schedules;
+  for (const auto& scheduleJson : json["schedules"].GetObject()) {
+    const string scheduleName = scheduleJson.name.GetString();
+    vector<ScheduleEntry> schedule;
+
+    for (const auto& entryJson : scheduleJson.value.GetArray()) {
+      int hour = 0;
+      int minute = 0;
+      if (std::sscanf(entryJson["from"].GetString(), "%d:%d", &hour, &minute) != 2) {
+        VGLOG(LOG_ERR, "Invalid time [%s] in schedule [%s].",
+              entryJson["from"].GetString(), scheduleName.c_str());
+        continue;
+      }
+
+      optional<Activity> activity = parseActivity(entryJson["activity"].GetString());
+      if (!activity) {
+        VGLOG(LOG_ERR, "Invalid activity [%s] in schedule [%s].",
+              entryJson["activity"].GetString(), scheduleName.c_str());
+        continue;
+      }
+
+      schedule.push_back({
+        hour * WorldClock::kMinutesPerHour + minute,
+        *activity,
+        internMapName(entryJson["tmxMapFileName"].GetString()),
+        entryJson["x"].GetFloat(),
+        entryJson["y"].GetFloat()
+      });
+    }
+
+    std::sort(schedule.begin(), schedule.end(), [](const ScheduleEntry& e1, const ScheduleEntry& e2) {
+      return e1.from < e2.from;
+    });
+    schedules.emplace(scheduleName, std::move(schedule));
+  }
+
+  for (const auto& npcJson : json["npcs"].GetArray()) {
+    if (_definitions.size() >= numeric_limits<uint16_t>::max()) {
+      VGLOG(LOG_ERR, "Too many world Npcs in [%s].", jsonFileName.c_str());
+      break;
+    }
+
+    const string scheduleName = npcJson["schedule"].GetString();
+    auto it = schedules.find(scheduleName);
+    if (it == schedules.end() || it->second.empty()) {
+      VGLOG(LOG_ERR, "Npc [%s] has no schedule [%s].",
+            npcJson["json"].GetString(), scheduleName.c_str());
+      continue;
+    }
+
+    _definitions.push_back({
+      npcJson["json"].GetString(),
+      it->second,
+      npcJson["respawnTime"].GetDouble(),
+      npcJson["restockInterval"].GetDouble()
+    });
+    _definitionIds.emplace(_definitions.back().jsonFileName,
+                           static_cast<uint16_t>(_definitions.size() - 1));
+  }
+}
+
+uint16_t WorldSimulation::internMapName(const string& tmxMapFileName) {
+  auto [it, inserted] = _mapIds.emplace(tmxMapFileName, static_cast<uint16_t>(_mapNames.size()));
+  if (inserted) {
+    _mapNames.push_back(tmxMapFileName);
+  }
+  return it->second;
+}
+
+int WorldSimulation::findDefinition(const string& jsonFileName) const {
+  auto it = _definitionIds.find(jsonFileName);
+  return (it != _definitionIds.end()) ? it->second : -1;
+}
+
+WorldSimulation::Record WorldSimulation::makeRecord(const uint16_t definitionId, const double time) const {
+  const Definition& definition = _definitions[definitionId];
+  const ScheduleEntry& entry = getScheduleEntry(definition, time);
+
+  Record record{};
+  record.definitionId = definitionId;
+  record.mapId = entry.mapId;
+  record.activity = entry.activity;
+  record.x = entry.x;
+  record.y = entry.y;
+  record.restockTime = time + definition.restockInterval;
+  return record;
+}
+
+const WorldSimulation::ScheduleEntry& WorldSimulation::getScheduleEntry(const Definition& definition,
+                                                                        const double time) const {
+  const int minuteOfDay = static_cast<int>(std::fmod(time, WorldClock::kMinutesPerDay));
+
+  // Before the first entry of the day, the last entry of the previous day still applies.
+  auto it = std::upper_bound(definition.schedule.begin(), definition.schedule.end(), minuteOfDay,
+                             [](const int minute, const ScheduleEntry& e) { return minute < e.from; });
+  return (it == definition.schedule.begin()) ? definition.schedule.back() : *std::prev(it);
+}
+
+void WorldSimulation::simulate(const size_t recordId, const double time, GameMap* gameMap) {
+  Record& record = _records[recordId];
+  const Definition& definition = _definitions[record.definitionId];
+
+  if (record.hasLeft) {
+    return;
+  }
+
+  // The record has been spawned, so it's the actor who is being simulated.
+  if (record.npc) {
+    shared_ptr<DynamicActor> key{shared_ptr<DynamicActor>(), record.npc};
+    if (!gameMap || !gameMap->getDynamicActors().contains(key) || record.npc->getParty()) {
+      record.npc = nullptr;
+      record.hasLeft = true;
+      return;
+    }
+
+    // The corpse stays on the map until the map is unloaded.
+    if (record.npc->isKilled()) {
+      record.npc = nullptr;
+      record.isKilled = true;
+      record.respawnTime = time + definition.respawnTime;
+      return;
+    }
+
+    // A spawned record which is traveling is walking off the map, and it's
+    // only despawned once it's out of sight (or it has taken too long).
+    if (record.activity == Activity::TRAVEL) {
+      const b2Vec2& pos = record.npc->getBody()->GetPosition();
+      const Vec2& cameraPos = SceneManager::the().getCurrentScene<GameScene>()->getGameCamera()->getPosition();
+      const Size& winSize = Director::getInstance()->getWinSize();
+      const bool isInSight = std::abs(pos.x * kPpm - cameraPos.x) < winSize.width / 2 + kNpcOutOfSightMargin &&
+                             std::abs(pos.y * kPpm - cameraPos.y) < winSize.height / 2 + kNpcOutOfSightMargin;
+      if (!isInSight || time >= record.arrivalTime) {
+        despawn(recordId, *gameMap);
+        record.arrivalTime = time + kTravelTime;
+      }
+      return;
+    }
+
+    const ScheduleEntry& entry = getScheduleEntry(definition, time);
+    if (entry.mapId != record.mapId) {
+      leave(recordId, time, *gameMap);
+    } else if (entry.activity != record.activity) {
+      record.activity = entry.activity;
+      record.npc->setTravelDest({entry.x / kPpm, entry.y / kPpm});
+    }
+    return;
+  }
+
+  if (record.isKilled && time < record.respawnTime) {
+    return;
+  }
+  if (record.activity == Activity::TRAVEL && time < record.arrivalTime) {
+    return;
+  }
+
+  const ScheduleEntry& entry = getScheduleEntry(definition, time);
+  if (!record.isKilled && record.activity != Activity::TRAVEL && entry.mapId != record.mapId) {
+    record.activity = Activity::TRAVEL;
+    record.arrivalTime = time + kTravelTime;
+    return;
+  }
+
+  record.isKilled = false;
+  record.mapId = entry.mapId;
+  record.activity = entry.activity;
+  record.x = entry.x;
+  record.y = entry.y;
+
+  if (gameMap && record.mapId == _loadedMapId) {
+    spawn(recordId, time, *gameMap);
+  }
+}
+
+void WorldSimulation::spawn(const size_t recordId, const double time, GameMap& gameMap) {
+  Record& record = _records[recordId];
+  const Definition& definition = _definitions[record.definitionId];
+
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  if (!gmMgr->isNpcAllowedToSpawn(definition.jsonFileName)) {
+    return;
+  }
+
+  // Bring back the same instance if it's still parked, so that its
+  // inventory (e.g., what the player has sold to it) persists.
+  optional<NpcResidencyCache::Entry> parked = _npcResidencyCache.unpark(kResidencyCacheKey, static_cast<int>(recordId));
+  shared_ptr<Npc> npc = parked ? std::move(parked->npc) : std::make_shared<Npc>(definition.jsonFileName);
+
+  if (time >= record.restockTime) {
+    restock(*npc);
+    record.restockTime = time + definition.restockInterval;
+  }
+
+  record.npc = gameMap.showDynamicActor<Npc>(std::move(npc), record.x, record.y);
+}
+
+void WorldSimulation::leave(const size_t recordId, const double time, GameMap& gameMap) {
+  Record& record = _records[recordId];
+  record.activity = Activity::TRAVEL;
+  record.arrivalTime = time + kMaxLeavingTime;
+
+  // Head for the nearer edge of the map.
+  const b2Vec2& pos = record.npc->getBody()->GetPosition();
+  const float mapWidth = gameMap.getWidth() / kPpm;
+  record.npc->setTravelDest({(pos.x < mapWidth / 2) ? 0 : mapWidth, pos.y});
+}
+
+void WorldSimulation::despawn(const size_t recordId, GameMap& gameMap) {
+  Record& record = _records[recordId];
+  Npc* npc = record.npc;
+
+  const b2Vec2& pos = npc->getBody()->GetPosition();
+  record.x = pos.x * kPpm;
+  record.y = pos.y * kPpm;
+  record.npc = nullptr;
+
+  StatusEffectSystem::the().forget(npc);
+  npc->onMapChanged();
+  shared_ptr<Npc> parkedNpc = gameMap.removeDynamicActor<Npc>(npc);
+  _npcResidencyCache.park(kResidencyCacheKey, static_cast<int>(recordId),
+                          {std::move(parkedNpc), record.x, record.y, NpcResidencyCache::kEstimatedFootprint});
+}
+
+}  // namespace vigilante
@@ -0,0 +1,112 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_WORLD_SIMULATION_H_
+#define VIGILANTE_WORLD_SIMULATION_H_
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace vigilante {
+
+class GameMap;
+class Npc;
+class NpcResidencyCache;
+
+// WorldSimulation keeps the Npcs with daily schedules (e.g., shopkeepers
+// who go home at night) living their lives while they are not on the
+// loaded GameMap.
+//
+// Off-map, each Npc is reduced to a compact Record which only knows where
+// the Npc is and what it is doing. Records are advanced with WorldClock in
+// a round-robin fashion, a few per frame, and they only turn into actors
+// when they are on the loaded GameMap.
+class WorldSimulation final {
+ public:
+  enum class Activity : uint8_t {
+    IDLE,
+    WORK,
+    SLEEP,
+    TRAVEL,
+    SIZE
+  };
+
+  explicit WorldSimulation(NpcResidencyCache& npcResidencyCache);
+
+  // `gameMap` is the loaded GameMap, or nullptr if there isn't one.
+  void update(GameMap* gameMap);
+  // Places every Npc where its schedule says it should be right now.
+  void reset();
+
+  // Catches up all the records, and spawns the ones on `gameMap`.
+  void onGameMapLoaded(GameMap& gameMap);
+  // Writes back the state of the spawned Npcs, and parks them.
+  void onGameMapUnloading(GameMap& gameMap);
+
+  inline size_t getRecordCount() const { return _records.size(); }
+
+ private:
+  static inline constexpr size_t kRecordsPerTick = 32;
+  static inline constexpr double kTravelTime = 60.0;  // minutes
+  static inline constexpr double kMaxLeavingTime = 10.0;  // minutes
+  static inline constexpr int kNoMapId = -1;
+
+  struct ScheduleEntry final {
+    int from;  // minute of the day
+    WorldSimulation::Activity activity;
+    uint16_t mapId;
+    float x;  // pixels
+    float y;  // pixels
+  };
+
+  struct Definition final {
+    std::string jsonFileName;
+    std::vector<WorldSimulation::ScheduleEntry> schedule;  // sorted by `from`
+    double respawnTime;  // minutes
+    double restockInterval;  // minutes
+  };
+
+  struct Record final {
+    uint16_t definitionId;
+    uint16_t mapId;
+    WorldSimulation::Activity activity;
+    bool isKilled;
+    bool hasLeft;  // e.g., recruited by the player
+    float x;  // pixels
+    float y;  // pixels
+    double arrivalTime;  // minutes, while traveling (or leaving, if spawned)
+    double respawnTime;  // minutes, while killed
+    double restockTime;  // minutes
+    Npc* npc;  // the actor, while this record is on the loaded GameMap
+  };
+
+  void loadDefinitions(const fs::path& jsonFileName);
+  uint16_t internMapName(const std::string& tmxMapFileName);
+  int findDefinition(const std::string& jsonFileName) const;
+  WorldSimulation::Record makeRecord(const uint16_t definitionId, const double time) const;
+
+  const WorldSimulation::ScheduleEntry& getScheduleEntry(const WorldSimulation::Definition& definition,
+                                                         const double time) const;
+  void simulate(const size_t recordId, const double time, GameMap* gameMap);
+  void spawn(const size_t recordId, const double time, GameMap& gameMap);
+  void leave(const size_t recordId, const double time, GameMap& gameMap);
+  void despawn(const size_t recordId, GameMap& gameMap);
+
+  NpcResidencyCache& _npcResidencyCache;
+  std::vector<WorldSimulation::Definition> _definitions;
+  std::unordered_map<std::string, uint16_t> _definitionIds;
+  std::vector<std::string> _mapNames;
+  std::unordered_map<std::string, uint16_t> _mapIds;
+  std::vector<WorldSimulation::Record> _records;
+  size_t _cursor{};
+  int _loadedMapId{kNoMapId};
+
+  friend class GameState;
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_WORLD_SIMULATION_H_
@@ -4,9 +4,10 @@
 #include "Assets.h"
 #include "Audio.h"
 #include "Constants.h"
+#include "Localization.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
-#include "util/B2BodyBuilder.h"
+#include "util/B2BodyTemplate.h"
 #include "util/JsonUtil.h"
 #include "util/StringUtil.h"
 
@@ -25,6 +26,27 @@ constexpr int kChestNumFixtures = 2;
 constexpr auto kItemCategoryBits = kInteractable;
 constexpr auto kItemMaskBits = kGround | kPlatform | kWall;
 
+// The solid part of a chest, and its interactable area.
+constexpr size_t kChestBodyFixture = 0;
+constexpr size_t kChestInteractableAreaFixture = 1;
+
+const B2BodyTemplate& getChestBodyTemplate() {
+  static const B2BodyTemplate bodyTemplate = []() {
+    B2BodyTemplate bodyTemplate{b2BodyType::b2_dynamicBody};
+    bodyTemplate.newRectangleFixture(16 / 2, 16 / 2, kPpm)
+      .categoryBits(kItemCategoryBits)
+      .maskBits(kItemMaskBits)
+      .addFixture();
+    bodyTemplate.newRectangleFixture(16 / 2, 16 / 2, kPpm)
+      .categoryBits(kInteractable)
+      .maskBits(kFeet)
+      .setSensor(true)
+      .addFixture();
+    return bodyTemplate;
+  }();
+  return bodyTemplate;
+}
+
 }  // namespace
 
 Chest::Chest(const string& tmxMapFileName,
@@ -46,9 +68,7 @@ bool Chest::showOnMap(float x, float y) {
 
   _isShownOnMap = true;
 
-  defineBody(b2BodyType::b2_dynamicBody, x, y,
-             kItemCategoryBits,
-             kItemMaskBits);
+  defineBody(x, y);
 
   if (!_isOpened) {
     _bodySprite = Sprite::create("Texture/interactable_object/chest/chest_close.png");
@@ -65,30 +85,13 @@ bool Chest::showOnMap(float x, float y) {
   return true;
 }
 
-void Chest::defineBody(b2BodyType bodyType,
-                       float x,
-                       float y,
-                       short categoryBits,
-                       short maskBits) {
+void Chest::defineBody(float x, float y) {
   auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
-  B2BodyBuilder bodyBuilder(gmMgr->getWorld());
-
-  _body = bodyBuilder.type(bodyType)
-    .position(x, y, kPpm)
-    .buildBody();
-
-  bodyBuilder.newRectangleFixture(16 / 2, 16 / 2, kPpm)
-    .categoryBits(categoryBits)
-    .maskBits(maskBits)
-    .setUserData(this)
-    .buildFixture();
-
-  bodyBuilder.newRectangleFixture(16 / 2, 16 / 2, kPpm)
-    .categoryBits(kInteractable)
-    .maskBits(kFeet)
-    .setSensor(true)
-    .setUserData(static_cast<Interactable*>(this))
-    .buildFixture();
+  const B2BodyTemplate& bodyTemplate = getChestBodyTemplate();
+
+  _body = bodyTemplate.instantiate(gmMgr->getWorld(), x, y, kPpm);
+  bodyTemplate.instantiateFixture(_body, kChestBodyFixture, this);
+  bodyTemplate.instantiateFixture(_body, kChestInteractableAreaFixture, static_cast<Interactable*>(this));
 }
 
 void Chest::onInteract(Character*) {
@@ -121,7 +124,7 @@ void Chest::showHintUI() {
   createHintBubbleFx();
 
   auto controlHints = SceneManager::the().getCurrentScene<GameScene>()->getControlHints();
-  controlHints->insert({EventKeyboard::KeyCode::KEY_CAPITAL_E}, "Open");
+  controlHints->insert({EventKeyboard::KeyCode::KEY_CAPITAL_E}, tr(StringId::HINT_OPEN));
 }
 
 void Chest::hideHintUI() {
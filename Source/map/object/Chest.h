@@ -25,16 +25,16 @@ class Chest : public DynamicActor, public Interactable {
   virtual bool willInteractOnContact() const override { return false; }  // Interactable
   virtual void showHintUI() override;  // Interactable
   virtual void hideHintUI() override;  // Interactable
+  virtual const b2Body* getInteractionBody() const override { return _body; }  // Interactable
+  virtual int getInteractionPriority() const override { return _isOpened ? 0 : 1; }  // Interactable
+
+  inline bool isOpened() const { return _isOpened; }
 
  protected:
   virtual void createHintBubbleFx() override;  // Interactable
   virtual void removeHintBubbleFx() override;  // Interactable
 
-  void defineBody(b2BodyType bodyType,
-                  float x,
-                  float y,
-                  short categoryBits,
-                  short maskBits);
+  void defineBody(float x, float y);
 
   const std::string _tmxMapFileName;
   const int _chestId{};
@@ -0,0 +1,446 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "InteractableObject.h"
+
+#include <algorithm>
+
+#include "Assets.h"
+#include "Audio.h"
+#include "CallbackManager.h"
+#include "Constants.h"
+#include "Localization.h"
+#include "character/Player.h"
+#include "quest/Quest.h"
+#include "scene/GameScene.h"
+#include "scene/SceneManager.h"
+#include "util/B2BodyBuilder.h"
+#include "util/Logger.h"
+#include "util/StringUtil.h"
+
+using namespace std;
+using namespace vigilante::category_bits;
+USING_NS_AX;
+
+namespace vigilante {
+
+namespace {
+
+constexpr int kNumAnimations = 2;
+constexpr float kDefaultFrameInterval = 10.0f;
+// CallbackManager runs a callback with no delay right away, which would
+// still be within the contact callback of b2World::Step().
+constexpr float kContactToggleDelay = .01f;
+
+string getString(const ValueMap& valMap, const string& key, const string& defaultValue="") {
+  return valMap.contains(key) ? valMap.at(key).asString() : defaultValue;
+}
+
+bool getBool(const ValueMap& valMap, const string& key, const bool defaultValue) {
+  return valMap.contains(key) ? valMap.at(key).asBool() : defaultValue;
+}
+
+// e.g., "chest_close.png;chest_open.png" -> {"chest_close.png", "chest_open.png"}
+array<string, 2> getPerStateStrings(const ValueMap& valMap, const string& key) {
+  array<string, 2> values;
+  if (!valMap.contains(key)) {
+    return values;
+  }
+
+  const vector<string> tokens = string_util::split(valMap.at(key).asString(), ';');
+  for (size_t i = 0; i < std::min(tokens.size(), values.size()); i++) {
+    values[i] = tokens[i];
+  }
+  return values;
+}
+
+InteractableObject::Activation parseActivation(const string& activation) {
+  if (activation == "contact") {
+    return InteractableObject::Activation::CONTACT;
+  } else if (activation == "none") {
+    return InteractableObject::Activation::NONE;
+  }
+  return InteractableObject::Activation::INTERACT;
+}
+
+// e.g., "gate1:mirror;gate2:toggle"
+vector<InteractableObject::Output> parseOutputs(const string& outputs) {
+  vector<InteractableObject::Output> ret;
+  for (const auto& output : string_util::split(outputs, ';')) {
+    const vector<string> tokens = string_util::split(output, ':');
+    if (tokens.empty()) {
+      continue;
+    }
+
+    const string action = (tokens.size() >= 2) ? tokens[1] : "toggle";
+    if (action == "toggle") {
+      ret.push_back({tokens[0], InteractableObject::OutputAction::TOGGLE});
+    } else if (action == "on") {
+      ret.push_back({tokens[0], InteractableObject::OutputAction::ON});
+    } else if (action == "off") {
+      ret.push_back({tokens[0], InteractableObject::OutputAction::OFF});
+    } else if (action == "mirror") {
+      ret.push_back({tokens[0], InteractableObject::OutputAction::MIRROR});
+    } else {
+      VGLOG(LOG_ERR, "Invalid output action [%s] of [%s].", action.c_str(), output.c_str());
+    }
+  }
+  return ret;
+}
+
+}  // namespace
+
+InteractableObject::Profile::Profile(const ValueMap& valMap)
+    : id{getString(valMap, "id")},
+      activation{parseActivation(getString(valMap, "activation", "interact"))},
+      isOneShot{getBool(valMap, "isOneShot", false)},
+      isPersistent{getBool(valMap, "isPersistent", activation != Activation::CONTACT)},
+      isInitiallyOn{getBool(valMap, "isOn", false)},
+      hint{Localization::the().localize(getString(valMap, "hint", tr(StringId::DIALOG_USE)))},
+      sprites{getPerStateStrings(valMap, "sprites")},
+      textureResDir{getString(valMap, "textureResDir")},
+      framesNames{getPerStateStrings(valMap, "framesNames")},
+      frameInterval{valMap.contains("frameInterval") ? valMap.at("frameInterval").asFloat() : kDefaultFrameInterval},
+      isSolid{getBool(valMap, "isSolidWhenOff", false), getBool(valMap, "isSolidWhenOn", false)},
+      requiredItem{getString(valMap, "requiredItem")},
+      consumesRequiredItem{getBool(valMap, "consumesRequiredItem", false)},
+      requiredQuest{getString(valMap, "requiredQuest")},
+      requiredQuestStage{valMap.contains("requiredQuestStage") ? valMap.at("requiredQuestStage").asInt() : 0},
+      lockedMessage{Localization::the().localize(getString(valMap, "lockedMessage", tr(StringId::NOTHING_HAPPENS)))},
+      outputs{parseOutputs(getString(valMap, "outputs"))},
+      cmds{string_util::split(getString(valMap, "offCmds"), ';'),
+           string_util::split(getString(valMap, "onCmds"), ';')} {}
+
+InteractableObject::InteractableObject(const string& tmxMapFileName,
+                                       const int objectId,
+                                       const ValueMap& valMap,
+                                       const float width,
+                                       const float height)
+    : StaticActor{kNumAnimations},
+      _tmxMapFileName{tmxMapFileName},
+      _objectId{objectId},
+      _profile{valMap},
+      _width{width},
+      _height{height},
+      _isOn{_profile.isInitiallyOn} {
+  constexpr auto kType = GameMap::OpenableObjectType::INTERACTABLE_OBJECT;
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  if (_profile.isPersistent && gmMgr->hasSavedOpenedClosedState(tmxMapFileName, kType, objectId)) {
+    _isOn = gmMgr->isOpened(tmxMapFileName, kType, objectId);
+  }
+}
+
+bool InteractableObject::showOnMap(float x, float y) {
+  if (_isShownOnMap) {
+    return false;
+  }
+
+  _isShownOnMap = true;
+
+  // (x, y) is the bottom left corner of the object in the .tmx map.
+  const float centerX = x + _width / 2;
+  const float centerY = y + _height / 2;
+  defineBody(centerX, centerY);
+  defineTexture(centerX, centerY);
+  updateAppearance();
+
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  gmMgr->getLayer()->addChild(_node, graphical_layers::kStaticObjects);
+
+  return true;
+}
+
+bool InteractableObject::removeFromMap() {
+  if (!StaticActor::removeFromMap()) {
+    return false;
+  }
+
+  removeHintBubbleFx();
+
+  // Destroying the body ends all of its contacts, which must not
+  // turn off a pressure plate (see onContactEnd()).
+  _body->GetWorld()->DestroyBody(_body);
+  _body = nullptr;
+  _solidFixture = nullptr;
+  _numContacts = 0;
+
+  if (_contactToggleCallbackId) {
+    CallbackManager::the().cancel(_contactToggleCallbackId);
+    _contactToggleCallbackId = 0;
+  }
+
+  for (auto animation : _bodyAnimations) {
+    if (animation) {
+      animation->release();
+    }
+  }
+  std::fill(_bodyAnimations.begin(), _bodyAnimations.end(), nullptr);
+  return true;
+}
+
+void InteractableObject::onInteract(Character* user) {
+  if (_profile.activation != Activation::INTERACT) {
+    return;
+  }
+
+  if (_isOn && _profile.isOneShot) {
+    return;
+  }
+
+  if (!areConditionsMetBy(user)) {
+    if (dynamic_cast<Player*>(user)) {
+      auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
+      notifications->show(_profile.lockedMessage);
+      Audio::the().playSfx(assets::kSfxDoorLocked);
+    }
+    return;
+  }
+
+  if (_profile.consumesRequiredItem && !_profile.requiredItem.empty()) {
+    user->removeItem(user->getItem(_profile.requiredItem));
+  }
+
+  setOn(!_isOn);
+}
+
+bool InteractableObject::isFocusable() const {
+  // Objects which can't be interacted with should never be focused on.
+  return _profile.activation == Activation::INTERACT;
+}
+
+void InteractableObject::onContactBegin(Character*) {
+  if (!_isShownOnMap || _profile.activation != Activation::CONTACT) {
+    return;
+  }
+
+  if (++_numContacts == 1) {
+    scheduleContactToggle();
+  }
+}
+
+void InteractableObject::onContactEnd(Character*) {
+  if (!_isShownOnMap || _profile.activation != Activation::CONTACT || _numContacts == 0) {
+    return;
+  }
+
+  if (--_numContacts == 0) {
+    scheduleContactToggle();
+  }
+}
+
+void InteractableObject::showHintUI() {
+  if (_profile.activation != Activation::INTERACT || (_isOn && _profile.isOneShot)) {
+    return;
+  }
+
+  createHintBubbleFx();
+
+  auto controlHints = SceneManager::the().getCurrentScene<GameScene>()->getControlHints();
+  controlHints->insert({EventKeyboard::KeyCode::KEY_CAPITAL_E}, _profile.hint);
+}
+
+void InteractableObject::hideHintUI() {
+  removeHintBubbleFx();
+
+  auto controlHints = SceneManager::the().getCurrentScene<GameScene>()->getControlHints();
+  controlHints->remove({EventKeyboard::KeyCode::KEY_CAPITAL_E});
+}
+
+int InteractableObject::getInteractionPriority() const {
+  return (_isOn && _profile.isOneShot) ? 0 : 1;
+}
+
+void InteractableObject::onInput(const OutputAction action, const bool isSourceOn, const int depth) {
+  if (depth > kMaxOutputDepth) {
+    VGLOG(LOG_ERR, "Interactable objects are wired in a loop, id: [%s].", _profile.id.c_str());
+    return;
+  }
+
+  switch (action) {
+    case OutputAction::TOGGLE:
+      setOn(!_isOn, depth);
+      break;
+    case OutputAction::ON:
+      setOn(true, depth);
+      break;
+    case OutputAction::OFF:
+      setOn(false, depth);
+      break;
+    case OutputAction::MIRROR:
+      setOn(isSourceOn, depth);
+      break;
+    default:
+      break;
+  }
+}
+
+void InteractableObject::setOn(const bool isOn, const int depth) {
+  if (_isOn == isOn) {
+    return;
+  }
+
+  _isOn = isOn;
+  updateAppearance();
+
+  auto gameScene = SceneManager::the().getCurrentScene<GameScene>();
+  auto gmMgr = gameScene->getGameMapManager();
+  if (_profile.isPersistent) {
+    constexpr auto kType = GameMap::OpenableObjectType::INTERACTABLE_OBJECT;
+    gmMgr->setOpened(_tmxMapFileName, kType, _objectId, _isOn);
+  }
+
+  for (const auto& cmd : _profile.cmds[_isOn]) {
+    gameScene->getConsole()->executeCmd(cmd);
+  }
+
+  for (const auto& output : _profile.outputs) {
+    InteractableObject* target = gmMgr->getGameMap()->getInteractableObject(output.targetId);
+    if (!target) {
+      VGLOG(LOG_ERR, "Unable to find interactable object [%s].", output.targetId.c_str());
+      continue;
+    }
+    target->onInput(output.action, _isOn, depth + 1);
+  }
+}
+
+void InteractableObject::scheduleContactToggle() {
+  if (_contactToggleCallbackId) {
+    return;
+  }
+
+  // Toggling the state changes fixtures and runs console commands, neither
+  // of which may happen while the world is locked, so it is deferred until
+  // after the step. By then, it follows whether anything is still on it.
+  _contactToggleCallbackId = CallbackManager::the().runAfter([this](const CallbackManager::CallbackId) {
+    _contactToggleCallbackId = 0;
+    if (_numContacts > 0) {
+      setOn(true);
+    } else if (!_profile.isOneShot) {
+      setOn(false);
+    }
+  }, kContactToggleDelay);
+}
+
+void InteractableObject::createHintBubbleFx() {
+  if (_hintBubbleFxSprite) {
+    removeHintBubbleFx();
+  }
+
+  auto fxMgr = SceneManager::the().getCurrentScene<GameScene>()->getFxManager();
+  _hintBubbleFxSprite = fxMgr->createHintBubbleFx(_body, "dialogue_available");
+}
+
+void InteractableObject::removeHintBubbleFx() {
+  if (!_hintBubbleFxSprite) {
+    return;
+  }
+
+  auto fxMgr = SceneManager::the().getCurrentScene<GameScene>()->getFxManager();
+  fxMgr->removeFx(_hintBubbleFxSprite);
+  _hintBubbleFxSprite = nullptr;
+}
+
+bool InteractableObject::areConditionsMetBy(Character* user) const {
+  if (!_profile.requiredItem.empty() && !user->getItem(_profile.requiredItem)) {
+    return false;
+  }
+
+  if (_profile.requiredQuest.empty()) {
+    return true;
+  }
+
+  auto player = dynamic_cast<Player*>(user);
+  if (!player) {
+    return false;
+  }
+
+  const QuestBook& questBook = player->getQuestBook();
+  const auto isRequiredQuest = [this](const Quest* q) {
+    return q->getQuestProfile().jsonFileName == _profile.requiredQuest;
+  };
+
+  const auto& completedQuests = questBook.getCompletedQuests();
+  if (std::any_of(completedQuests.begin(), completedQuests.end(), isRequiredQuest)) {
+    return true;
+  }
+
+  const auto& inProgressQuests = questBook.getInProgressQuests();
+  auto it = std::find_if(inProgressQuests.begin(), inProgressQuests.end(), isRequiredQuest);
+  return it != inProgressQuests.end() && (*it)->getCurrentStageIdx() >= _profile.requiredQuestStage;
+}
+
+void InteractableObject::defineBody(const float x, const float y) {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  B2BodyBuilder bodyBuilder(gmMgr->getWorld());
+
+  _body = bodyBuilder.type(b2BodyType::b2_staticBody)
+    .position(x, y, kPpm)
+    .buildBody();
+
+  bodyBuilder.newRectangleFixture(_width / 2, _height / 2, kPpm)
+    .categoryBits(kInteractable)
+    .maskBits(kFeet)
+    .setSensor(true)
+    .friction(0)
+    .setUserData(static_cast<Interactable*>(this))
+    .buildFixture();
+
+  // The solid part only collides while the current state is solid,
+  // and is turned into a sensor otherwise (see updateAppearance()).
+  if (_profile.isSolid[0] || _profile.isSolid[1]) {
+    _solidFixture = bodyBuilder.newRectangleFixture(_width / 2, _height / 2, kPpm)
+      .categoryBits(kWall)
+      .friction(0)
+      .buildFixture();
+  }
+}
+
+void InteractableObject::defineTexture(const float x, const float y) {
+  if (_profile.textureResDir.empty()) {
+    _bodySprite = Sprite::create(_profile.sprites[_isOn]);
+    _bodySprite->getTexture()->setAliasTexParameters();
+    _bodySprite->setPosition(x, y);
+    _node->addChild(_bodySprite);
+    return;
+  }
+
+  // Texture/interactable_object/lever/lever_on/0.png
+  // |______________________________| |__| |__|
+  //           textureResDir            |  framesName
+  //                            framesNamePrefix
+  const string framesNamePrefix = StaticActor::getLastDirName(_profile.textureResDir);
+  const string& framesName = _profile.framesNames[_isOn];
+  _bodySprite = Sprite::createWithSpriteFrameName(framesNamePrefix + "_" + framesName + "/0.png");
+
+  const string spritesheetFileName = StaticActor::getSpritesheetFileName(_profile.textureResDir);
+  _bodySpritesheet = SpriteBatchNode::create(spritesheetFileName);
+  _bodySpritesheet->addChild(_bodySprite);
+  _bodySpritesheet->getTexture()->setAliasTexParameters();
+  _bodySprite->setPosition(x, y);
+  _node->addChild(_bodySpritesheet);
+
+  for (size_t i = 0; i < _bodyAnimations.size(); i++) {
+    _bodyAnimations[i] = StaticActor::createAnimation(_profile.textureResDir,
+                                                      _profile.framesNames[i],
+                                                      _profile.frameInterval / kPpm);
+  }
+}
+
+void InteractableObject::updateAppearance() {
+  if (!_isShownOnMap) {
+    return;
+  }
+
+  if (_solidFixture) {
+    _solidFixture->SetSensor(!_profile.isSolid[_isOn]);
+  }
+
+  if (_profile.textureResDir.empty()) {
+    _bodySprite->setTexture(_profile.sprites[_isOn]);
+    _bodySprite->getTexture()->setAliasTexParameters();
+    return;
+  }
+
+  _bodySprite->stopAllActions();
+  _bodySprite->runAction(RepeatForever::create(Animate::create(_bodyAnimations[_isOn])));
+}
+
+}  // namespace vigilante
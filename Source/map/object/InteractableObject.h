@@ -0,0 +1,132 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_INTERACTABLE_OBJECT_H_
+#define VIGILANTE_INTERACTABLE_OBJECT_H_
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <axmol.h>
+
+#include <box2d/box2d.h>
+
+#include "CallbackManager.h"
+#include "Interactable.h"
+#include "StaticActor.h"
+
+namespace vigilante {
+
+// InteractableObject is a generic on/off object configured by the properties
+// of an object in the "InteractableObjects" layer of a .tmx map, e.g., levers,
+// doors, switches and pressure plates, so that puzzles and gates can be built
+// without writing a new class for each of them.
+//
+// Its state changes when it is interacted with (or stood on), provided that
+// its conditions are met, and the change is forwarded to the objects wired
+// to it by id. Each state has its own sprite or animation and can be solid
+// (e.g., a closed door). It is never updated per frame, only upon these events.
+class InteractableObject : public StaticActor, public Interactable {
+ public:
+  enum class Activation {
+    INTERACT,  // e.g., levers, switches
+    CONTACT,   // e.g., pressure plates
+    NONE,      // e.g., doors, which are only driven by other objects
+  };
+
+  enum class OutputAction {
+    TOGGLE,
+    ON,
+    OFF,
+    MIRROR,  // follows the state of the source object
+  };
+
+  struct Output final {
+    std::string targetId;
+    InteractableObject::OutputAction action;
+  };
+
+  struct Profile final {
+    explicit Profile(const ax::ValueMap& valMap);
+
+    std::string id;
+    InteractableObject::Activation activation;
+    bool isOneShot;  // cannot be turned off once it's on
+    bool isPersistent;
+    bool isInitiallyOn;
+    std::string hint;
+
+    // Appearance per state (off, on). Either static sprites, or
+    // animations from `textureResDir` (see StaticObject).
+    std::array<std::string, 2> sprites;
+    std::string textureResDir;
+    std::array<std::string, 2> framesNames;
+    float frameInterval;
+    std::array<bool, 2> isSolid;
+
+    std::string requiredItem;
+    bool consumesRequiredItem;
+    std::string requiredQuest;
+    int requiredQuestStage;
+    std::string lockedMessage;
+
+    std::vector<InteractableObject::Output> outputs;
+    // The commands to execute upon entering each state (off, on).
+    std::array<std::vector<std::string>, 2> cmds;
+  };
+
+  InteractableObject(const std::string& tmxMapFileName,
+                     const int objectId,
+                     const ax::ValueMap& valMap,
+                     const float width,
+                     const float height);
+  virtual ~InteractableObject() override = default;
+
+  virtual bool showOnMap(float x, float y) override;  // StaticActor
+  virtual bool removeFromMap() override;  // StaticActor
+
+  virtual void onInteract(Character* user) override;  // Interactable
+  virtual bool willInteractOnContact() const override { return false; }  // Interactable
+  virtual bool isFocusable() const override;  // Interactable
+  virtual void onContactBegin(Character* user) override;  // Interactable
+  virtual void onContactEnd(Character* user) override;  // Interactable
+  virtual void showHintUI() override;  // Interactable
+  virtual void hideHintUI() override;  // Interactable
+  virtual const b2Body* getInteractionBody() const override { return _body; }  // Interactable
+  virtual int getInteractionPriority() const override;  // Interactable
+
+  // Called by the objects wired to this one.
+  void onInput(const InteractableObject::OutputAction action, const bool isSourceOn, const int depth);
+  void setOn(const bool isOn, const int depth=0);
+
+  inline bool isOn() const { return _isOn; }
+  inline const InteractableObject::Profile& getProfile() const { return _profile; }
+
+ protected:
+  virtual void createHintBubbleFx() override;  // Interactable
+  virtual void removeHintBubbleFx() override;  // Interactable
+
+  void scheduleContactToggle();
+  bool areConditionsMetBy(Character* user) const;
+  void defineBody(const float x, const float y);
+  void defineTexture(const float x, const float y);
+  void updateAppearance();
+
+  static inline constexpr int kMaxOutputDepth = 8;
+
+  const std::string _tmxMapFileName;
+  const int _objectId;
+  const InteractableObject::Profile _profile;
+  const float _width;
+  const float _height;
+
+  bool _isOn{};
+  int _numContacts{};
+  CallbackManager::CallbackId _contactToggleCallbackId{};
+  b2Body* _body{};
+  b2Fixture* _solidFixture{};
+  ax::Sprite* _hintBubbleFxSprite{};
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_INTERACTABLE_OBJECT_H_
@@ -0,0 +1,29 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_CONDITION_OBJECTIVE_H_
+#define VIGILANTE_CONDITION_OBJECTIVE_H_
+
+#include <string>
+
+#include "Quest.h"
+#include "gameplay/Expression.h"
+
+namespace vigilante {
+
+// This type of quest objective is completed as soon as its condition
+// on the Blackboard holds, e.g., "wolvesKilled >= 3 && metTheHunter".
+class ConditionObjective : public Quest::Objective {
+ public:
+  ConditionObjective(const std::string& desc, const std::string& condition)
+      : Quest::Objective{Quest::Objective::Type::CONDITION, desc} {
+    _condition.compile(condition);
+  }
+
+  virtual bool isCompleted() const override { return _condition.evaluate(); }
+
+ private:
+  Expression _condition;
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_CONDITION_OBJECTIVE_H_
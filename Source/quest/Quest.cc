@@ -3,7 +3,9 @@
 
 #include <algorithm>
 
+#include "Localization.h"
 #include "quest/CollectItemObjective.h"
+#include "quest/ConditionObjective.h"
 #include "quest/GeneralObjective.h"
 #include "quest/InteractWithTargetObjective.h"
 #include "quest/KillTargetObjective.h"
@@ -11,7 +13,6 @@
 #include "scene/SceneManager.h"
 #include "ui/console/Console.h"
 #include "util/JsonUtil.h"
-#include "util/StringUtil.h"
 
 using namespace std;
 
@@ -52,14 +53,12 @@ string Quest::Stage::getHint() const {
     }
     case Quest::Objective::Type::KILL: {
       auto o = dynamic_cast<KillTargetObjective*>(objective.get());
-      return string_util::format("Eliminate: %s (%d/%d)",
-          o->getCharacterName().c_str(), o->getCurrentAmount(), o->getTargetAmount());
+      return tr(StringId::QUEST_ELIMINATE, o->getCharacterName(), o->getCurrentAmount(), o->getTargetAmount());
     }
     case Quest::Objective::Type::COLLECT: {
       auto o = dynamic_cast<CollectItemObjective*>(objective.get());
       // FIXME: show the actual amount of items collected
-      return string_util::format("Collect: %s (%d/%d)",
-          o->getItemJsonFileName().c_str(), 0, o->getAmount());
+      return tr(StringId::QUEST_COLLECT, o->getItemJsonFileName(), 0, o->getAmount());
     }
     /*
     case Quest::Objective::Type::ESCORT:
@@ -69,8 +68,10 @@ string Quest::Stage::getHint() const {
     */
     case Quest::Objective::Type::INTERACT_WITH: {
       auto o = dynamic_cast<InteractWithTargetObjective*>(objective.get());
-      return string_util::format("Talk to %s", o->getTargetProfileJsonFileName().c_str());
+      return tr(StringId::QUEST_TALK_TO, o->getTargetProfileJsonFileName());
     }
+    case Quest::Objective::Type::CONDITION:
+      return objective->getDesc();
     default:
       return "";
   }
@@ -78,13 +79,13 @@ string Quest::Stage::getHint() const {
 
 Quest::Profile::Profile(const string& jsonFileName) : jsonFileName(jsonFileName) {
   rapidjson::Document json = json_util::parseJson(jsonFileName);
-  title = json["title"].GetString();
-  desc = json["desc"].GetString();
+  title = Localization::the().localize(json["title"].GetString());
+  desc = Localization::the().localize(json["desc"].GetString());
 
   for (const auto& stageJson : json["stages"].GetArray()) {
     Stage stage;
     const auto objectiveType = static_cast<Quest::Objective::Type>(stageJson["objective"]["objectiveType"].GetInt());
-    const auto objectiveDesc = stageJson["objective"]["desc"].GetString();
+    const string objectiveDesc = Localization::the().localize(stageJson["objective"]["desc"].GetString());
     switch (objectiveType) {
       case Quest::Objective::Type::GENERAL: {
         stage.objective = std::make_unique<GeneralObjective>(objectiveDesc);
@@ -113,13 +114,18 @@ Quest::Profile::Profile(const string& jsonFileName) : jsonFileName(jsonFileName)
         stage.objective = std::make_unique<InteractWithTargetObjective>(objectiveDesc, targetJsonFileName);
         break;
       }
+      case Quest::Objective::Type::CONDITION: {
+        const string condition = stageJson["objective"]["condition"].GetString();
+        stage.objective = std::make_unique<ConditionObjective>(objectiveDesc, condition);
+        break;
+      }
       default: {
         break;
       }
     }
 
     if (stageJson.HasMember("questDesc")) {
-      stage.questDesc = stageJson["questDesc"].GetString();;
+      stage.questDesc = Localization::the().localize(stageJson["questDesc"].GetString());
     }
 
     for (const auto& cmd : stageJson["exec"].GetArray()) {
@@ -27,6 +27,7 @@ class Quest : public Importable {
       ESCORT,
       DELIVERY,
       INTERACT_WITH,
+      CONDITION,
     };
 
     virtual bool isCompleted() const = 0;
@@ -5,6 +5,7 @@
 #include <fstream>
 #include <stdexcept>
 
+#include "Localization.h"
 #include "quest/KillTargetObjective.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
@@ -35,7 +36,9 @@ void QuestBook::update(Quest::Objective::Type objectiveType) {
   auto questHints = SceneManager::the().getCurrentScene<GameScene>()->getQuestHints();
 
   VGLOG(LOG_INFO, "Updating quests");
-  for (const auto quest : _inProgressQuests) {
+  // Completed quests are removed from `_inProgressQuests` along the way.
+  const vector<Quest*> inProgressQuests = _inProgressQuests;
+  for (const auto quest : inProgressQuests) {
     if (quest->getCurrentStage().objective->getObjectiveType() != objectiveType) {
       continue;
     }
@@ -77,9 +80,11 @@ bool QuestBook::startQuest(Quest* quest) {
   quest->advanceStage();
 
   auto questHints = SceneManager::the().getCurrentScene<GameScene>()->getQuestHints();
-  questHints->show("Started: " + quest->getQuestProfile().title);
+  questHints->show(tr(StringId::QUEST_STARTED, quest->getQuestProfile().title));
   questHints->show(quest->getCurrentStage().objective->getDesc());
 
+  // The condition of the first stage may already hold.
+  update(Quest::Objective::Type::CONDITION);
   return true;
 }
 
@@ -109,9 +114,11 @@ bool QuestBook::setStage(Quest* quest, const int stageIdx) {
 
   auto questHints = SceneManager::the().getCurrentScene<GameScene>()->getQuestHints();
   quest->setCurrentStageIdx(stageIdx);
-  questHints->show("Completed: " + prevStage.objective->getDesc());
+  questHints->show(tr(StringId::QUEST_COMPLETED, prevStage.objective->getDesc()));
   questHints->show(quest->getCurrentStage().objective->getDesc());
 
+  // The condition of the new stage may already hold.
+  update(Quest::Objective::Type::CONDITION);
   return true;
 }
 
@@ -127,7 +134,7 @@ bool QuestBook::markCompleted(Quest* quest) {
   _completedQuests.push_back(quest);
 
   auto questHints = SceneManager::the().getCurrentScene<GameScene>()->getQuestHints();
-  questHints->show("Completed: " + quest->getQuestProfile().title);
+  questHints->show(tr(StringId::QUEST_COMPLETED, quest->getQuestProfile().title));
 
   return true;
 }
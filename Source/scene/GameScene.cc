@@ -1,13 +1,24 @@
 // Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
 #include "GameScene.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "Assets.h"
 #include "CallbackManager.h"
 #include "Constants.h"
+#include "FrameLimiter.h"
 #include "character/Player.h"
+#include "combat/ImpulseQueue.h"
+#include "gameplay/Blackboard.h"
+#include "gameplay/DeterminismChecker.h"
 #include "gameplay/ExpPointTable.h"
 #include "gameplay/GameState.h"
 #include "gameplay/ItemPriceTable.h"
+#include "gameplay/Statistics.h"
+#include "gameplay/TimeScale.h"
+#include "gameplay/WorldClock.h"
+#include "input/ActionMapper.h"
 #include "scene/SceneManager.h"
 #include "skill/Skill.h"
 #include "quest/Quest.h"
@@ -36,6 +47,9 @@ bool GameScene::init() {
   // Initialize vigilante's item price table.
   item_price_table::import(kItemPriceTable);
 
+  // Initialize vigilante's achievements.
+  Statistics::the().loadAchievements(kAchievementsJson);
+
   // Initialize InputManager.
   // InputManager keep tracks of which keys are pressed.
   InputManager::the().activate(this);
@@ -44,7 +58,8 @@ bool GameScene::init() {
   _hotkeyManager = std::make_unique<HotkeyManager>();
 
   // Initialize CallbackManager.
-  CallbackManager::the().setScene(this);
+  CallbackManager::the().reset();
+  TimeScale::the().reset();
 
   // Initialize Vigilante's utils.
   vigilante::keycode_util::init();
@@ -92,6 +107,25 @@ bool GameScene::init() {
   _hud->getLayer()->setCameraMask(static_cast<uint16_t>(CameraFlag::USER1));
   addChild(_hud->getLayer(), graphical_layers::kHud);
 
+  // Initialize memory overlay.
+  _memoryOverlay = std::make_unique<MemoryOverlay>();
+  _memoryOverlay->getLayer()->setCameraMask(static_cast<uint16_t>(CameraFlag::USER1));
+  addChild(_memoryOverlay->getLayer(), graphical_layers::kHud);
+
+  // Initialize frame time graph.
+  _frameTimeGraph = std::make_unique<FrameTimeGraph>();
+  _frameTimeGraph->getLayer()->setCameraMask(static_cast<uint16_t>(CameraFlag::USER1));
+  addChild(_frameTimeGraph->getLayer(), graphical_layers::kHud);
+
+  // Initialize minimap and world map.
+  _minimap = std::make_unique<Minimap>();
+  _minimap->getLayer()->setCameraMask(static_cast<uint16_t>(CameraFlag::USER1));
+  addChild(_minimap->getLayer(), graphical_layers::kHud);
+
+  _worldMap = std::make_unique<WorldMap>(*_minimap);
+  _worldMap->getLayer()->setCameraMask(static_cast<uint16_t>(CameraFlag::USER1));
+  addChild(_worldMap->getLayer(), graphical_layers::kWorldMap);
+
   // Initialize console.
   _console = std::make_unique<Console>();
   _console->getLayer()->setCameraMask(static_cast<uint16_t>(CameraFlag::USER1));
@@ -181,25 +215,65 @@ void GameScene::update(const float delta) {
     return;
   }
 
+  ActionMapper::the().update();
+  DeterminismChecker::the().update();
+  if (DeterminismChecker::the().isRestoring()) {
+    return;
+  }
   handleInput();
 
-  if (_pauseMenu->isVisible()) {
+  if (_pauseMenu->isVisible() || _windowManager->isPausingGame() || _worldMap->isVisible()) {
     return;
   }
 
-  // If there are no ongoing GameMap transitions, then step the box2d world.
-  if (_shade->getImageView()->getNumberOfRunningActions() == 0) {
-    _gameMapManager->getWorld()->Step(1.0f / kFps, kVelocityIterations, kPositionIterations);
+  _playTime += delta;
+
+  // While checking determinism, the simulation advances by a fixed timestep
+  // so that the same input yields the same sequence of world states.
+  // Otherwise the frame time is snapped to the frame rate cap to hide the
+  // pacing jitter, and clamped so that a hitch doesn't launch the actors.
+  // The UI below keeps running on real time, but the simulation runs on game time.
+  const float frameDelta = DeterminismChecker::the().isActive() ?
+      1.0f / kFps : std::min(FrameLimiter::the().snapDelta(delta), _kMaxFrameDelta);
+  const float tickDelta = TimeScale::the().update(frameDelta);
+
+  // If there are no ongoing GameMap transitions, then step the box2d world,
+  // in substeps no longer than 1 / kFps, so that it runs at the same speed
+  // at any frame rate. The knockback impulses raised since the last substep,
+  // including the ones from the contact callbacks, are applied in between.
+  const float timeScale = TimeScale::the().getScale();
+  if (_shade->getImageView()->getNumberOfRunningActions() == 0 && timeScale > 0) {
+    const int numSteps = std::max(static_cast<int>(std::ceil(frameDelta * kFps - .01f)), 1);
+    const float timeStep = timeScale * frameDelta / numSteps;
+    for (int i = 0; i < numSteps; i++) {
+      ImpulseQueue::the().flush();
+      _gameMapManager->getWorld()->Step(timeStep, kVelocityIterations, kPositionIterations);
+    }
   }
 
-  _gameMapManager->update(delta);
-  _afterImageFxManager->update(delta);
-  _floatingDamages->update(delta);
+  CallbackManager::the().update(tickDelta);
+  _gameMapManager->update(tickDelta);
+
+  // The condition objectives are re-evaluated whenever a story variable changes,
+  // e.g., by a dialogue, a trigger, the console or loading a save.
+  if (Blackboard::the().consumeChanges() && _gameMapManager->getPlayer()) {
+    _gameMapManager->getPlayer()->getQuestBook().update(Quest::Objective::Type::CONDITION);
+  }
+
+  Statistics::the().update(delta);
+  _hud->updateSkillCooldowns();
+  _afterImageFxManager->update(tickDelta);
+  _floatingDamages->update(tickDelta);
   _notifications->update(delta);
   _questHints->update(delta);
   _dialogueManager->update(delta);
   _console->update(delta);
   _windowManager->update(delta);
+  _memoryOverlay->update(delta);
+  _frameTimeGraph->update(delta);
+  _minimap->update(delta);
+
+  DeterminismChecker::the().tick();
 
   if (_drawBox2D->isVisible()) {
     _drawBox2D->clear();
@@ -218,14 +292,22 @@ void GameScene::handleInput() {
     return;
   }
 
-  if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_0)) {
+  if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::DEBUG_DRAW)) {
     bool isVisible = !_drawBox2D->isVisible();
     _drawBox2D->setVisible(isVisible);
     _notifications->show(string("Debug Mode: ") + ((isVisible) ? "on" : "off"));
     return;
   }
 
-  if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_ESCAPE)) {
+  if (_worldMap->isVisible()) {
+    if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::WORLD_MAP) ||
+        IS_ACTION_JUST_PRESSED(ActionMapper::Action::PAUSE)) {
+      _worldMap->setVisible(false);
+    }
+    return;
+  }
+
+  if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::PAUSE)) {
     if (!_windowManager->isEmpty()) {
       _windowManager->pop();
       return;
@@ -237,7 +319,7 @@ void GameScene::handleInput() {
     return;
   }
 
-  if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_GRAVE)) {
+  if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::CONSOLE)) {
     _console->setVisible(true);
     return;
   }
@@ -258,16 +340,33 @@ void GameScene::handleInput() {
     return;
   }
 
+  if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::WORLD_MAP)) {
+    _worldMap->setVisible(true);
+    return;
+  }
+
   if (_gameMapManager->getPlayer()) {
     _gameMapManager->getPlayer()->handleInput();
   }
 }
 
 void GameScene::startNewGame() {
+  TimeScale::the().reset();
+  WorldClock::the().reset();
+  Blackboard::the().reset();
+  Statistics::the().reset();
+  _gameMapManager->getWorldSimulation()->reset();
+  _gameMapManager->getMapExploration()->reset();
   _gameMapManager->loadGameMap(kNewGameInitialMap);
 }
 
 void GameScene::loadGame(const string& gameSaveFilePath) {
+  TimeScale::the().reset();
+  WorldClock::the().reset();
+  Blackboard::the().reset();
+  Statistics::the().reset();
+  _gameMapManager->getWorldSimulation()->reset();
+  _gameMapManager->getMapExploration()->reset();
   _gameMapManager->loadGameMap(kNewGameInitialMap, [gameSaveFilePath]() {
     GameState(gameSaveFilePath).load();
   });
@@ -21,8 +21,12 @@
 #include "ui/dialogue/DialogueManager.h"
 #include "ui/hud/ControlHints.h"
 #include "ui/hud/FloatingDamages.h"
+#include "ui/hud/FrameTimeGraph.h"
 #include "ui/hud/Hud.h"
+#include "ui/hud/MemoryOverlay.h"
+#include "ui/hud/Minimap.h"
 #include "ui/hud/Notifications.h"
+#include "ui/hud/WorldMap.h"
 #include "ui/pause_menu/PauseMenu.h"
 #include "ui/quest_hints/QuestHints.h"
 #include "ui/Shade.h"
@@ -46,6 +50,8 @@ class GameScene : public ax::Scene, public Controllable {
 
   inline bool isRunning() const { return _isRunning; }
   inline void setRunning(bool running) { _isRunning = running; }
+  inline float getPlayTime() const { return _playTime; }
+  inline void setPlayTime(float playTime) { _playTime = playTime; }
 
   inline ax::Camera* getGameCamera() const { return _gameCamera; }
 
@@ -63,10 +69,17 @@ class GameScene : public ax::Scene, public Controllable {
   inline FxManager* getFxManager() const { return _fxManager.get(); }
   inline AfterImageFxManager* getAfterImageFxManager() const { return _afterImageFxManager.get(); }
   inline HotkeyManager* getHotkeyManager() const { return _hotkeyManager.get(); }
+  inline MemoryOverlay* getMemoryOverlay() const { return _memoryOverlay.get(); }
+  inline FrameTimeGraph* getFrameTimeGraph() const { return _frameTimeGraph.get(); }
+  inline Minimap* getMinimap() const { return _minimap.get(); }
+  inline WorldMap* getWorldMap() const { return _worldMap.get(); }
 
  private:
+  static inline constexpr float _kMaxFrameDelta = .1f;
+
   bool _isRunning;
   bool _isTerminating;
+  float _playTime{};  // seconds, excluding the time spent in the pause menu
 
   ax::Camera* _parallaxCamera;
   ax::Camera* _gameCamera;
@@ -88,6 +101,10 @@ class GameScene : public ax::Scene, public Controllable {
   std::unique_ptr<FxManager> _fxManager;
   std::unique_ptr<AfterImageFxManager> _afterImageFxManager;
   std::unique_ptr<PauseMenu> _pauseMenu;
+  std::unique_ptr<MemoryOverlay> _memoryOverlay;
+  std::unique_ptr<FrameTimeGraph> _frameTimeGraph;
+  std::unique_ptr<Minimap> _minimap;
+  std::unique_ptr<WorldMap> _worldMap;
 };
 
 }  // namespace vigilante
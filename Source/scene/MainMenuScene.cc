@@ -5,6 +5,8 @@
 
 #include "Assets.h"
 #include "Audio.h"
+#include "gameplay/GameState.h"
+#include "input/ActionMapper.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
 #include "ui/Colorscheme.h"
@@ -28,7 +30,7 @@ bool MainMenuScene::init() {
 
   // Initialize labels.
   for (int i = 0; i < static_cast<int>(Option::SIZE); i++) {
-    Label* label = Label::createWithTTF(string(_kOptionStr[i]), string{assets::kBoldFont}, assets::kRegularFontSize);
+    Label* label = Label::createWithTTF(tr(_kOptionStringIds[i]), string{assets::kBoldFont}, assets::kRegularFontSize);
     label->getFontAtlas()->setAliasTexParameters();
     label->setPosition(winSize.width / 2, winSize.height / 2 - _kMenuOptionGap * (i + 1));
     addChild(label);
@@ -59,23 +61,24 @@ bool MainMenuScene::init() {
 }
 
 void MainMenuScene::update(float) {
+  ActionMapper::the().update();
   handleInput();
 }
 
 void MainMenuScene::handleInput() {
-  if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_UP_ARROW)) {
+  if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_UP)) {
     if (_current == 0) {
       return;
     }
     _labels[_current--]->setTextColor(vigilante::colorscheme::kWhite);
     _labels[_current]->setTextColor(vigilante::colorscheme::kRed);
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_DOWN_ARROW)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_DOWN)) {
     if (_current == static_cast<int>(Option::SIZE) - 1) {
       return;
     }
     _labels[_current++]->setTextColor(vigilante::colorscheme::kWhite);
     _labels[_current]->setTextColor(vigilante::colorscheme::kRed);
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_ENTER)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_CONFIRM)) {
     switch (static_cast<Option>(_current)) {
       case Option::NEW_GAME: {
         Audio::the().stopBgm();
@@ -85,10 +88,15 @@ void MainMenuScene::handleInput() {
         break;
       }
       case Option::LOAD_GAME: {
+        // Continue from the most recent save.
+        const fs::path saveFilePath = GameState::getMostRecentSaveFilePath();
+        if (saveFilePath.empty()) {
+          break;
+        }
         Audio::the().stopBgm();
         InputManager::the().deactivate();
         SceneManager::the().pushScene(GameScene::create());
-        SceneManager::the().getCurrentScene<GameScene>()->loadGame("quicksave.vgs");
+        SceneManager::the().getCurrentScene<GameScene>()->loadGame(saveFilePath.string());
         break;
       }
       case Option::OPTIONS:
@@ -4,7 +4,6 @@
 
 #include <array>
 #include <string>
-#include <string_view>
 #include <vector>
 
 #include <axmol.h>
@@ -12,6 +11,7 @@
 #include <ui/UIImageView.h>
 
 #include "Controllable.h"
+#include "Localization.h"
 #include "input/InputManager.h"
 
 namespace vigilante {
@@ -34,11 +34,11 @@ class MainMenuScene : public ax::Scene, public Controllable {
     SIZE
   };
 
-  static inline constexpr std::array<std::string_view, MainMenuScene::Option::SIZE> _kOptionStr = {{
-    "New Game",
-    "Load Game",
-    "Options",
-    "Exit",
+  static inline constexpr std::array<StringId, MainMenuScene::Option::SIZE> _kOptionStringIds = {{
+    StringId::MAIN_MENU_NEW_GAME,
+    StringId::MAIN_MENU_LOAD_GAME,
+    StringId::MAIN_MENU_OPTIONS,
+    StringId::MAIN_MENU_EXIT,
   }};
   static inline constexpr const char* _kCopyrightStr = "© 2018-2023 Aesophor Softworks";
   static inline constexpr const char* _kVersionStr = "0.1.0";
@@ -0,0 +1,134 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "CooldownTracker.h"
+
+#include <algorithm>
+
+#include "character/Character.h"
+#include "gameplay/EffectScheduler.h"
+#include "skill/Skill.h"
+#include "util/Logger.h"
+
+using namespace std;
+
+namespace vigilante {
+
+void CooldownTracker::addSkill(Skill* skill) {
+  if (!skill || findSlot(skill).has_value()) {
+    return;
+  }
+
+  const int maxCharges = std::max(1, skill->getSkillProfile().charges);
+  Slot slot{skill, maxCharges, maxCharges, 0.0f};
+
+  // Reuse a free slot if there's one.
+  auto it = std::find_if(_slots.begin(), _slots.end(), [](const Slot& s) { return !s.skill; });
+  if (it != _slots.end()) {
+    *it = slot;
+  } else {
+    _slots.push_back(slot);
+  }
+}
+
+void CooldownTracker::removeSkill(Skill* skill) {
+  if (const optional<size_t> i = findSlot(skill)) {
+    _slots[*i].skill = nullptr;
+  }
+}
+
+bool CooldownTracker::isReady(Skill* skill) const {
+  return getRemainingTime(skill) <= 0.0f;
+}
+
+bool CooldownTracker::trigger(Skill* skill) {
+  const optional<size_t> i = findSlot(skill);
+  if (!i.has_value()) {
+    VGLOG(LOG_ERR, "Failed to trigger the cooldown of an untracked skill.");
+    return false;
+  }
+
+  if (!isReady(skill)) {
+    return false;
+  }
+
+  const float now = EffectScheduler::the().getTime();
+  Slot& slot = _slots[*i];
+  // If the skill was fully charged, its next charge starts cooling down now.
+  if (slot.charges == slot.maxCharges) {
+    slot.nextChargeTime = now + getCooldown(skill);
+  }
+  slot.charges--;
+  _globalCooldownEndTime = now + kGlobalCooldown;
+  return true;
+}
+
+void CooldownTracker::resetAll() {
+  for (auto& slot : _slots) {
+    slot.charges = slot.maxCharges;
+  }
+  _globalCooldownEndTime = 0.0f;
+}
+
+float CooldownTracker::getRemainingTime(Skill* skill) const {
+  const optional<size_t> i = findSlot(skill);
+  if (!i.has_value()) {
+    return 0.0f;
+  }
+
+  Slot& slot = _slots[*i];
+  refill(slot);
+
+  const float now = EffectScheduler::the().getTime();
+  const float remainingChargeTime = (slot.charges > 0) ? 0.0f : slot.nextChargeTime - now;
+  return std::max({0.0f, remainingChargeTime, getRemainingGlobalCooldown()});
+}
+
+float CooldownTracker::getRemainingGlobalCooldown() const {
+  return std::max(0.0f, _globalCooldownEndTime - EffectScheduler::the().getTime());
+}
+
+int CooldownTracker::getCharges(Skill* skill) const {
+  const optional<size_t> i = findSlot(skill);
+  if (!i.has_value()) {
+    return 0;
+  }
+
+  Slot& slot = _slots[*i];
+  refill(slot);
+  return slot.charges;
+}
+
+int CooldownTracker::getMaxCharges(Skill* skill) const {
+  const optional<size_t> i = findSlot(skill);
+  return i.has_value() ? _slots[*i].maxCharges : 0;
+}
+
+optional<size_t> CooldownTracker::findSlot(Skill* skill) const {
+  if (!skill) {
+    return nullopt;
+  }
+
+  for (size_t i = 0; i < _slots.size(); i++) {
+    if (_slots[i].skill == skill) {
+      return i;
+    }
+  }
+  return nullopt;
+}
+
+void CooldownTracker::refill(CooldownTracker::Slot& slot) const {
+  const float now = EffectScheduler::the().getTime();
+
+  while (slot.charges < slot.maxCharges && slot.nextChargeTime <= now) {
+    slot.charges++;
+    // The next charge (if any) starts cooling down right after this one.
+    slot.nextChargeTime += getCooldown(slot.skill);
+  }
+}
+
+float CooldownTracker::getCooldown(Skill* skill) const {
+  const float cooldown = skill->getSkillProfile().cooldown;
+  const float reduction = _owner.getStatModifiers().get(StatModifierStack::Stat::COOLDOWN_REDUCTION);
+  return cooldown * (1.0f - std::min(reduction, kMaxCooldownReduction));
+}
+
+}  // namespace vigilante
@@ -0,0 +1,63 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_COOLDOWN_TRACKER_H_
+#define VIGILANTE_COOLDOWN_TRACKER_H_
+
+#include <optional>
+#include <vector>
+
+namespace vigilante {
+
+class Character;
+class Skill;
+
+// The skill cooldowns of a Character. Each skill is assigned a slot in a flat
+// array which stores the time its next charge becomes ready. All times are
+// measured with the game clock of EffectScheduler, so nothing has to be
+// updated per character, and no timers are involved.
+class CooldownTracker final {
+ public:
+  // The minimum delay between any two skill activations.
+  static inline constexpr float kGlobalCooldown = .25f;
+  static inline constexpr float kMaxCooldownReduction = .6f;
+
+  explicit CooldownTracker(Character& owner) : _owner{owner} {}
+
+  void addSkill(Skill* skill);
+  void removeSkill(Skill* skill);
+
+  bool isReady(Skill* skill) const;
+  // Consumes a charge of `skill` and starts its cooldown, as well as
+  // the global cooldown. Returns false if `skill` is not ready.
+  bool trigger(Skill* skill);
+  void resetAll();
+
+  // The time until `skill` has at least one charge and the
+  // global cooldown has passed, or 0 if it is ready.
+  float getRemainingTime(Skill* skill) const;
+  float getRemainingGlobalCooldown() const;
+  int getCharges(Skill* skill) const;
+  int getMaxCharges(Skill* skill) const;
+
+ private:
+  struct Slot final {
+    Skill* skill;  // nullptr if this slot is free
+    int maxCharges;
+    int charges;
+    float nextChargeTime;  // only valid while charges < maxCharges
+  };
+
+  std::optional<size_t> findSlot(Skill* skill) const;
+  // Grants the charges which have finished cooling down since the last query.
+  void refill(CooldownTracker::Slot& slot) const;
+  float getCooldown(Skill* skill) const;
+
+  Character& _owner;
+  // A character only has a handful of skills,
+  // so a linear scan beats hashing here.
+  mutable std::vector<CooldownTracker::Slot> _slots;
+  float _globalCooldownEndTime{};
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_COOLDOWN_TRACKER_H_
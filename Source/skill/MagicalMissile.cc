@@ -8,9 +8,10 @@
 #include "CallbackManager.h"
 #include "Constants.h"
 #include "character/Character.h"
+#include "gameplay/StatusEffectSystem.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
-#include "util/B2BodyBuilder.h"
+#include "util/B2BodyTemplate.h"
 #include "util/Logger.h"
 
 using namespace std;
@@ -27,6 +28,26 @@ constexpr int kMagicalMissleNumFixtures = 1;
 constexpr auto kMagicalMissleCategoryBits = kProjectile;
 constexpr auto kMagicalMissleMaskBits = kPlayer | kEnemy | kWall;
 
+const B2BodyTemplate& getMagicalMissileBodyTemplate() {
+  static const B2BodyTemplate bodyTemplate = []() {
+    const float scaleFactor = Director::getInstance()->getContentScaleFactor();
+    const b2Vec2 vertices[] = {
+      {-10.0f / scaleFactor,  0.0f / scaleFactor},
+      {  0.0f / scaleFactor, -2.0f / scaleFactor},
+      { 10.0f / scaleFactor,  0.0f / scaleFactor},
+      {  0.0f / scaleFactor,  2.0f / scaleFactor}
+    };
+
+    B2BodyTemplate bodyTemplate{b2BodyType::b2_kinematicBody};
+    bodyTemplate.newPolygonFixture(vertices, 4, kPpm)
+      .categoryBits(kMagicalMissleCategoryBits)
+      .maskBits(kMagicalMissleMaskBits)
+      .addFixture();
+    return bodyTemplate;
+  }();
+  return bodyTemplate;
+}
+
 }  // namespace
 
 MagicalMissile::MagicalMissile(const string& jsonFileName, Character* user, const bool onGround)
@@ -42,9 +63,7 @@ bool MagicalMissile::showOnMap(float x, float y) {
 
   _isShownOnMap = true;
 
-  defineBody(b2BodyType::b2_kinematicBody, x, y,
-             kMagicalMissleCategoryBits,
-             kMagicalMissleMaskBits);
+  defineBody(x, y);
 
   defineTexture(_skillProfile.textureResDir, x, y);
 
@@ -98,15 +117,20 @@ void MagicalMissile::onHit(Character* target) {
 
   if (target) {
     const bool isFacingRight = _body->GetLinearVelocity().x > 0;
-    const float knockBackForceX = isFacingRight ? 3.5f : -3.5f;
-    const float knockBackForceY = 1.0f;
-    _user->knockBack(target, knockBackForceX, knockBackForceY);
+    const HitImpact hitImpact = _skillProfile.hitImpact.value_or(HitImpact{HitImpact::kDefaultStagger, {3.5f, 1.0f}, false});
+    const HitReaction::Result result = target->receiveHitImpact(_user, hitImpact, isFacingRight ? 1.0f : -1.0f);
     _user->inflictDamage(target, getDamage());
+    if (!_skillProfile.statusEffect.empty()) {
+      StatusEffectSystem::the().apply(target, _skillProfile.statusEffect);
+    }
 
-    target->setStunned(true);
-    CallbackManager::the().runAfter([target](const CallbackManager::CallbackId) {
-      target->setStunned(false);
-    }, 2.0f);
+    // Only a missile which staggers the target stuns it.
+    if (result != HitReaction::Result::ABSORBED) {
+      target->setStunned(true);
+      CallbackManager::the().runAfter([target](const CallbackManager::CallbackId) {
+        target->setStunned(false);
+      }, 2.0f);
+    }
   }
 
   // Play sound effect.
@@ -174,33 +198,12 @@ string MagicalMissile::getIconPath() const {
   return _skillProfile.textureResDir + "/icon.png";
 }
 
-void MagicalMissile::defineBody(b2BodyType bodyType,
-                                float x,
-                                float y,
-                                short categoryBits,
-                                short maskBits) {
+void MagicalMissile::defineBody(float x, float y) {
   float spellOffset = _user->getCharacterProfile().attackRange / kPpm;
   spellOffset = (_user->isFacingRight()) ? spellOffset : -spellOffset;
 
   b2World* world = _user->getBody()->GetWorld();
-  B2BodyBuilder bodyBuilder(world);
-  _body = bodyBuilder.type(bodyType)
-    .position(x + spellOffset, y, 1)
-    .buildBody();
-
-  float scaleFactor = Director::getInstance()->getContentScaleFactor();
-  b2Vec2 vertices[] = {
-    {-10.0f / scaleFactor,  0.0f / scaleFactor},
-    {  0.0f / scaleFactor, -2.0f / scaleFactor},
-    { 10.0f / scaleFactor,  0.0f / scaleFactor},
-    {  0.0f / scaleFactor,  2.0f / scaleFactor}
-  };
-
-  _fixtures[0] = bodyBuilder.newPolygonFixture(vertices, 4, kPpm)
-    .categoryBits(categoryBits)
-    .maskBits(maskBits)
-    .setUserData(this)
-    .buildFixture();
+  _body = getMagicalMissileBodyTemplate().instantiate(world, x + spellOffset, y, 1, this, _fixtures.data());
 }
 
 void MagicalMissile::defineTexture(const string& textureResDir, float x, float y) {
@@ -47,11 +47,7 @@ class MagicalMissile : public DynamicActor, public Skill, public Projectile {
   virtual std::string getIconPath() const override;  // Skill
   
  private:
-  virtual void defineBody(b2BodyType bodyType,
-                          float x,
-                          float y,
-                          short categoryBits,
-                          short maskBits);
+  virtual void defineBody(float x, float y);
 
   virtual void defineTexture(const std::string& textureResPath, float x, float y);
 
@@ -53,6 +53,7 @@ Skill::Profile::Profile(const string& jsonFileName) : jsonFileName(jsonFileName)
   shouldForkInstance = json["shouldForkInstance"].GetBool();
   requiredLevel = json["requiredLevel"].GetInt();
   cooldown = json["cooldown"].GetFloat();
+  charges = json.HasMember("charges") ? json["charges"].GetInt() : 1;
 
   physicalDamage = json["physicalDamage"].GetInt();
   magicalDamage = json["magicalDamage"].GetInt();
@@ -61,6 +62,12 @@ Skill::Profile::Profile(const string& jsonFileName) : jsonFileName(jsonFileName)
   deltaStamina = json["deltaStamina"].GetInt();
   numTimesInflictDamage = json["numTimesInflictDamage"].GetInt();
   damageInflictionInterval = json["damageInflictionInterval"].GetFloat();
+  if (json.HasMember("statusEffect")) {
+    statusEffect = json["statusEffect"].GetString();
+  }
+  if (json.HasMember("hitImpact")) {
+    hitImpact = HitImpact::load(json["hitImpact"]);
+  }
 
   sfxActivate = json["sfxActivate"].GetString();
   sfxHit = json["sfxHit"].GetString();
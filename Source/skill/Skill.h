@@ -3,11 +3,13 @@
 #define VIGILANTE_SKILL_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include <axmol.h>
 
 #include "Importable.h"
+#include "combat/HitImpact.h"
 #include "input/Keybindable.h"
 
 namespace vigilante {
@@ -47,6 +49,7 @@ class Skill : public Importable, public Keybindable, public std::enable_shared_f
     bool shouldForkInstance;
     int requiredLevel;
     float cooldown;
+    int charges;  // the number of uses which can be stored up
 
     int physicalDamage;
     int magicalDamage;
@@ -55,6 +58,8 @@ class Skill : public Importable, public Keybindable, public std::enable_shared_f
     int deltaStamina;
     int numTimesInflictDamage;
     float damageInflictionInterval;
+    std::string statusEffect;  // applied on hit, optional
+    std::optional<HitImpact> hitImpact;  // optional, see HitImpact
 
     std::string sfxActivate;
     std::string sfxHit;
@@ -4,6 +4,7 @@
 #include "Audio.h"
 #include "CallbackManager.h"
 #include "character/Character.h"
+#include "gameplay/TimeScale.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
 #include "util/CameraUtil.h"
@@ -15,6 +16,10 @@ namespace vigilante {
 
 namespace {
 
+// The world slows down for a moment as the user reappears next to the target.
+constexpr float kSlowMotionDuration = .3f;
+constexpr float kSlowMotionScale = .3f;
+
 bool isTargetFarEnoughFromWall(Character* target, const float minDistRequired, const bool checkBehind) {
   const b2Vec2& targetPos = target->getBody()->GetPosition();
   const float bodyFixtureWidthInHalf = target->getCharacterProfile().bodyWidth / kPpm / 2;
@@ -92,6 +97,7 @@ void TeleportStrike::activate() {
 
     const b2Vec2 thisPos = _user->getBody()->GetPosition();
     _user->setFacingRight(thisPos.x < targetPos.x);
+    TimeScale::the().pushHitStop(kSlowMotionDuration, kSlowMotionScale);
 
     CallbackManager::the().runAfter([this, target](const CallbackManager::CallbackId) {
       _user->stopMotion();
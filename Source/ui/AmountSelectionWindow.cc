@@ -2,6 +2,7 @@
 #include "AmountSelectionWindow.h"
 
 #include "Assets.h"
+#include "Localization.h"
 #include "character/Player.h"
 #include "input/InputManager.h"
 #include "util/StringUtil.h"
@@ -22,7 +23,7 @@ AmountSelectionWindow::AmountSelectionWindow()
       _contentBackground(ui::ImageView::create(string{kTextFieldBg})),
       _textField("1") {
 
-  setTitle("How many?");
+  setTitle(tr(StringId::AMOUNT_PROMPT));
   Size windowSize = _titleLabel->getContentSize();
   windowSize.width = std::max(windowSize.width, _contentBackground->getContentSize().width);
   windowSize.height += _contentBackground->getContentSize().height;
@@ -17,6 +17,7 @@
 #include "Assets.h"
 #include "Constants.h"
 #include "ui/TableLayout.h"
+#include "util/MemoryTracker.h"
 #include "util/ds/SetVector.h"
 
 namespace vigilante {
@@ -125,6 +126,7 @@ ListView<T>::ListView(int visibleItemCount, float width, float height, float ite
       _firstVisibleIndex(),
       _current(),
       _showScrollBar(true) {
+  ScopedMemoryTag memoryTag{MemoryTag::UI};
   _scrollBar->setPosition({width, 0});
   _scrollBar->setAnchorPoint({0, 1});
   _scrollBar->setScaleY(height);
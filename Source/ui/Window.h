@@ -2,6 +2,7 @@
 #ifndef VIGILANTE_WINDOW_H_
 #define VIGILANTE_WINDOW_H_
 
+#include <functional>
 #include <string>
 
 #include <axmol.h>
@@ -37,6 +38,14 @@ class Window : public Controllable {
   void setTitle(const std::string& title);
   void setVisible(bool visible);
 
+  // The game stays paused while a window which pauses it is open.
+  inline bool isPausingGame() const { return _isPausingGame; }
+  inline void setPausingGame(bool pausingGame) { _isPausingGame = pausingGame; }
+
+  // Called by WindowManager after this window has been popped.
+  inline const std::function<void ()>& getOnClosed() const { return _onClosed; }
+  inline void setOnClosed(const std::function<void ()>& onClosed) { _onClosed = onClosed; }
+
  protected:
   // Place the window at the center, and place `_titleLabel` as well as
   // `_contentLayout` at the correct position.
@@ -62,8 +71,10 @@ class Window : public Controllable {
   ax::ui::ImageView* _bottomBg;
   
   bool _isVisible;
+  bool _isPausingGame{};
   ax::Vec2 _position;
   ax::Size _size;
+  std::function<void ()> _onClosed;
 };
 
 }  // namespace vigilante
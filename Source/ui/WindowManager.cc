@@ -1,6 +1,8 @@
 // Copyright (c) 2018-2021 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
 #include "WindowManager.h"
 
+#include <algorithm>
+
 #include "Constants.h"
 #include "util/Logger.h"
 
@@ -53,7 +55,16 @@ unique_ptr<Window> WindowManager::pop() {
   removedWindow->setVisible(false);
   _scene->removeChild(removedWindow->getLayer());
 
+  if (removedWindow->getOnClosed()) {
+    removedWindow->getOnClosed()();
+  }
   return removedWindow;
 }
 
+bool WindowManager::isPausingGame() const {
+  return std::any_of(_windows.begin(), _windows.end(), [](const unique_ptr<Window>& w) {
+    return w->isPausingGame();
+  });
+}
+
 }  // namespace vigilante
@@ -23,6 +23,9 @@ class WindowManager final {
   // Pop the top window off the internal window stack and unrender it.
   std::unique_ptr<Window> pop();
 
+  // Whether any of the windows pauses the game, see Window::isPausingGame().
+  bool isPausingGame() const;
+
   inline Window* top() const { return isEmpty() ? nullptr : _windows.back().get(); }
   inline bool isEmpty() const { return _windows.empty(); }
   inline int getSize() const { return _windows.size(); }
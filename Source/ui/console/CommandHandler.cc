@@ -1,12 +1,24 @@
 // Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
 #include "CommandHandler.h"
 
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <limits>
 #include <memory>
 
+#include "Constants.h"
+#include "Localization.h"
 #include "character/Player.h"
 #include "character/Npc.h"
+#include "gameplay/Blackboard.h"
+#include "gameplay/DeterminismChecker.h"
 #include "gameplay/DialogueTree.h"
+#include "gameplay/Statistics.h"
+#include "gameplay/TimeScale.h"
+#include "gameplay/WorldClock.h"
 #include "item/Item.h"
+#include "map/object/InteractableObject.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
 #include "util/StringUtil.h"
@@ -14,6 +26,7 @@
 
 #define DEFAULT_ERR_MSG "unable to parse this line"
 
+namespace fs = std::filesystem;
 using namespace std;
 
 namespace vigilante {
@@ -46,7 +59,23 @@ bool CommandHandler::handle(const string& cmd, bool showNotification) {
     {"tradeWithPlayer",         &CommandHandler::tradeWithPlayer        },
     {"killCurrentTarget",       &CommandHandler::killCurrentTarget      },
     {"interact",                &CommandHandler::interact               },
+    {"setObjectState",          &CommandHandler::setObjectState         },
     {"narrate",                 &CommandHandler::narrate               },
+    {"determinism",             &CommandHandler::determinism            },
+    {"toggleMemoryOverlay",     &CommandHandler::toggleMemoryOverlay    },
+    {"toggleFrameTimeGraph",    &CommandHandler::toggleFrameTimeGraph   },
+    {"advanceTime",             &CommandHandler::advanceTime            },
+    {"setTimeScale",            &CommandHandler::setTimeScale           },
+    {"setPlayerTimeScale",      &CommandHandler::setPlayerTimeScale     },
+    {"inspectNpc",              &CommandHandler::inspectNpc             },
+    {"setVar",                  &CommandHandler::setVar                 },
+    {"addVar",                  &CommandHandler::addVar                 },
+    {"printVar",                &CommandHandler::printVar               },
+    {"printStat",               &CommandHandler::printStat              },
+    {"benchmarkSpawn",          &CommandHandler::benchmarkSpawn         },
+    {"setLanguage",             &CommandHandler::setLanguage            },
+    {"compileStrings",          &CommandHandler::compileStrings         },
+    {"exportStrings",           &CommandHandler::exportStrings          },
   };
 
   // Execute the corresponding command handler from _cmdTable.
@@ -317,15 +346,30 @@ void CommandHandler::interact(const vector<string>&) {
     return;
   }
 
-  const unordered_set<Interactable*>& interactables = player->getInRangeInteractables();
-  if (interactables.empty()) {
+  Interactable* target = player->getInteractionResolver().getFocusedTarget();
+  if (!target) {
     setError("No nearby interactable objects.");
     return;
   }
 
-  for (auto interactable : interactables) {
-    player->interact(interactable);
+  player->interact(target);
+  setSuccess();
+}
+
+void CommandHandler::setObjectState(const vector<string>& args) {
+  if (args.size() < 3 || (args[2] != "on" && args[2] != "off")) {
+    setError("usage: setObjectState <id> <on|off>");
+    return;
+  }
+
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  InteractableObject* object = gmMgr->getGameMap()->getInteractableObject(args[1]);
+  if (!object) {
+    setError("No interactable object with this id.");
+    return;
   }
+
+  object->setOn(args[2] == "on");
   setSuccess();
 }
 
@@ -346,4 +390,411 @@ void CommandHandler::narrate(const vector<string>& args) {
   setSuccess();
 }
 
+void CommandHandler::determinism(const vector<string>& args) {
+  constexpr char kUsage[] = "usage: determinism <record|verify|stop> [traceFile] [seed]";
+  if (args.size() < 2) {
+    setError(kUsage);
+    return;
+  }
+
+  if (args[1] == "stop") {
+    DeterminismChecker::the().stop();
+    setSuccess();
+    return;
+  }
+
+  if (args.size() < 3) {
+    setError(kUsage);
+    return;
+  }
+
+  if (args[1] == "verify") {
+    if (!DeterminismChecker::the().startVerifying(args[2])) {
+      setError("failed to load trace file");
+      return;
+    }
+    setSuccess();
+    return;
+  }
+
+  if (args[1] != "record") {
+    setError(kUsage);
+    return;
+  }
+
+  unsigned int seed = DeterminismChecker::kDefaultSeed;
+  if (args.size() >= 4) {
+    try {
+      seed = static_cast<unsigned int>(std::stoul(args[3]));
+    } catch (const invalid_argument& ex) {
+      setError("invalid argument `seed`");
+      return;
+    } catch (const out_of_range& ex) {
+      setError("`seed` is too large");
+      return;
+    } catch (...) {
+      setError("unknown error");
+      return;
+    }
+  }
+
+  if (!DeterminismChecker::the().startRecording(args[2], seed)) {
+    setError("failed to start recording");
+    return;
+  }
+  setSuccess();
+}
+
+void CommandHandler::toggleMemoryOverlay(const vector<string>&) {
+  auto memoryOverlay = SceneManager::the().getCurrentScene<GameScene>()->getMemoryOverlay();
+  memoryOverlay->setVisible(!memoryOverlay->isVisible());
+  setSuccess();
+}
+
+void CommandHandler::toggleFrameTimeGraph(const vector<string>&) {
+  auto frameTimeGraph = SceneManager::the().getCurrentScene<GameScene>()->getFrameTimeGraph();
+  frameTimeGraph->setVisible(!frameTimeGraph->isVisible());
+  setSuccess();
+}
+
+void CommandHandler::advanceTime(const vector<string>& args) {
+  if (args.size() < 2) {
+    setError("usage: advanceTime <minutes>");
+    return;
+  }
+
+  int minutes = 0;
+  try {
+    minutes = std::stoi(args[1]);
+  } catch (const invalid_argument& ex) {
+    setError("invalid argument `minutes`");
+    return;
+  } catch (const out_of_range& ex) {
+    setError("`minutes` is too large");
+    return;
+  } catch (...) {
+    setError("unknown error");
+    return;
+  }
+
+  if (minutes <= 0) {
+    setError("`minutes` must be positive");
+    return;
+  }
+
+  // The world Npcs will catch up with the new time on their own.
+  WorldClock::the().setTime(WorldClock::the().getTime() + minutes);
+  VGLOG(LOG_INFO, "World time: %s.", WorldClock::the().toString().c_str());
+  setSuccess();
+}
+
+void CommandHandler::setTimeScale(const vector<string>& args) {
+  if (args.size() < 2) {
+    setError("usage: setTimeScale <scale>");
+    return;
+  }
+
+  float scale = 0;
+  try {
+    scale = std::stof(args[1]);
+  } catch (const invalid_argument& ex) {
+    setError("invalid argument `scale`");
+    return;
+  } catch (const out_of_range& ex) {
+    setError("`scale` is out of range");
+    return;
+  } catch (...) {
+    setError("unknown error");
+    return;
+  }
+
+  if (scale < 0) {
+    setError("`scale` must not be negative");
+    return;
+  }
+
+  TimeScale::the().setGlobalScale(scale);
+  setSuccess();
+}
+
+void CommandHandler::setPlayerTimeScale(const vector<string>& args) {
+  if (args.size() < 2) {
+    setError("usage: setPlayerTimeScale <scale>");
+    return;
+  }
+
+  float scale = 0;
+  try {
+    scale = std::stof(args[1]);
+  } catch (const invalid_argument& ex) {
+    setError("invalid argument `scale`");
+    return;
+  } catch (const out_of_range& ex) {
+    setError("`scale` is out of range");
+    return;
+  } catch (...) {
+    setError("unknown error");
+    return;
+  }
+
+  if (scale <= 0) {
+    setError("`scale` must be positive");
+    return;
+  }
+
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  Player* player = gmMgr->getPlayer();
+  if (!player) {
+    setError("No player.");
+    return;
+  }
+
+  // Overridden by the player's time dilation effects (if any) when they change.
+  TimeScale::the().setActorScale(player, scale);
+  setSuccess();
+}
+
+void CommandHandler::inspectNpc(const vector<string>&) {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  const b2Vec2& playerPos = gmMgr->getPlayer()->getBody()->GetPosition();
+
+  // Inspect the Npc closest to the player.
+  Npc* npc = nullptr;
+  float minDist = std::numeric_limits<float>::max();
+  for (const auto& actor : gmMgr->getGameMap()->getDynamicActors()) {
+    Npc* candidate = dynamic_cast<Npc*>(actor.get());
+    if (!candidate || !candidate->getBody()) {
+      continue;
+    }
+    const b2Vec2& pos = candidate->getBody()->GetPosition();
+    const float dist = std::hypotf(pos.x - playerPos.x, pos.y - playerPos.y);
+    if (dist < minDist) {
+      minDist = dist;
+      npc = candidate;
+    }
+  }
+
+  if (!npc) {
+    setError("There are no Npcs on this map.");
+    return;
+  }
+
+  const NpcController& controller = npc->getNpcController();
+  const BehaviorTree* behaviorTree = controller.getBehaviorTree();
+  if (!behaviorTree) {
+    setError(npc->getCharacterProfile().name + " has no behavior tree yet.");
+    return;
+  }
+
+  const BehaviorTree::Blackboard& blackboard = controller.getBlackboard();
+  const string state = !blackboard.isAwake ? "asleep" : blackboard.isRunning ? "running" : "done";
+  const string msg = npc->getCharacterProfile().name + " [" + behaviorTree->getName() + "]: " +
+                     behaviorTree->describe(blackboard.activeNode) + " (" + state + ")";
+
+  VGLOG(LOG_INFO, "%s", msg.c_str());
+  auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
+  notifications->show(msg);
+  setSuccess();
+}
+
+void CommandHandler::setVar(const vector<string>& args) {
+  if (args.size() < 3) {
+    setError("usage: setVar <name> <value>");
+    return;
+  }
+
+  // The type of the value is inferred, e.g., `true` is a bool,
+  // `3` is an int, and anything else is a string.
+  Blackboard& blackboard = Blackboard::the();
+  const Blackboard::VarId id = blackboard.intern(args[1]);
+  bool ok = false;
+  if (args[2] == "true" || args[2] == "false") {
+    ok = blackboard.setBool(id, args[2] == "true");
+  } else {
+    size_t pos = 0;
+    int value = 0;
+    try {
+      value = std::stoi(args[2], &pos);
+    } catch (...) {
+      pos = 0;
+    }
+    ok = (pos == args[2].size()) ? blackboard.setInt(id, value) : blackboard.setString(id, args[2]);
+  }
+
+  if (!ok) {
+    setError("`" + args[1] + "` is a " + Blackboard::kTypeStr[static_cast<size_t>(blackboard.getType(id))]);
+    return;
+  }
+
+  setSuccess();
+}
+
+void CommandHandler::addVar(const vector<string>& args) {
+  if (args.size() < 2) {
+    setError("usage: addVar <name> [amount]");
+    return;
+  }
+
+  int amount = 1;
+  if (args.size() >= 3) {
+    try {
+      amount = std::stoi(args[2]);
+    } catch (const invalid_argument& ex) {
+      setError("invalid argument `amount`");
+      return;
+    } catch (const out_of_range& ex) {
+      setError("`amount` is too large");
+      return;
+    } catch (...) {
+      setError("unknown error");
+      return;
+    }
+  }
+
+  Blackboard& blackboard = Blackboard::the();
+  const Blackboard::VarId id = blackboard.intern(args[1]);
+  if (!blackboard.setInt(id, blackboard.getInt(id) + amount)) {
+    setError("`" + args[1] + "` is not an int");
+    return;
+  }
+
+  setSuccess();
+}
+
+void CommandHandler::printVar(const vector<string>& args) {
+  if (args.size() < 2) {
+    setError("usage: printVar <name>");
+    return;
+  }
+
+  Blackboard& blackboard = Blackboard::the();
+  const string msg = blackboard.toString(blackboard.intern(args[1]));
+  VGLOG(LOG_INFO, "%s", msg.c_str());
+  auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
+  notifications->show(msg);
+  setSuccess();
+}
+
+void CommandHandler::printStat(const vector<string>& args) {
+  if (args.size() < 2) {
+    setError("usage: printStat <counter>");
+    return;
+  }
+
+  // A counter which has never been interned has never been counted either.
+  const Statistics& statistics = Statistics::the();
+  const Statistics::CounterId id = statistics.find(args[1]);
+  const int64_t count = (id != Statistics::kInvalidCounterId) ? statistics.getCount(id) : 0;
+
+  const string msg = args[1] + " = " + std::to_string(count);
+  VGLOG(LOG_INFO, "%s", msg.c_str());
+  auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
+  notifications->show(msg);
+  setSuccess();
+}
+
+void CommandHandler::benchmarkSpawn(const vector<string>& args) {
+  if (args.size() < 2) {
+    setError("usage: benchmarkSpawn <npcJson> [count]");
+    return;
+  }
+
+  int count = 100;
+  if (args.size() >= 3) {
+    try {
+      count = std::stoi(args[2]);
+    } catch (const invalid_argument& ex) {
+      setError("invalid argument `count`");
+      return;
+    } catch (const out_of_range& ex) {
+      setError("`count` is too large");
+      return;
+    } catch (...) {
+      setError("unknown error");
+      return;
+    }
+  }
+
+  if (count <= 0) {
+    setError("`count` must be positive");
+    return;
+  }
+
+  if (!fs::exists(args[1])) {
+    setError("no such npc: " + args[1]);
+    return;
+  }
+
+  // The npcs are spawned on the player and removed again before the world is
+  // stepped, through the same showOnMap() and removeFromMap() as NpcSpawner.
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  const b2Vec2& pos = gmMgr->getPlayer()->getBody()->GetPosition();
+
+  vector<shared_ptr<Npc>> npcs;
+  npcs.reserve(count);
+
+  const auto begin = chrono::steady_clock::now();
+  for (int i = 0; i < count; i++) {
+    npcs.push_back(std::make_shared<Npc>(args[1]));
+  }
+  const auto constructed = chrono::steady_clock::now();
+  for (auto& npc : npcs) {
+    npc->showOnMap(pos.x * kPpm, pos.y * kPpm);
+  }
+  const auto shown = chrono::steady_clock::now();
+  for (auto& npc : npcs) {
+    npc->removeFromMap();
+  }
+  const auto removed = chrono::steady_clock::now();
+
+  auto microsPerNpc = [count](const chrono::steady_clock::duration& d) {
+    return chrono::duration<double, micro>(d).count() / count;
+  };
+  const string msg = string_util::format("%s: %.2f us/npc to construct, %.2f us/npc to show, %.2f us/npc to remove",
+                                         npcs.front()->getCharacterProfile().name.c_str(),
+                                         microsPerNpc(constructed - begin),
+                                         microsPerNpc(shown - constructed),
+                                         microsPerNpc(removed - shown));
+  VGLOG(LOG_INFO, "%s", msg.c_str());
+  auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
+  notifications->show(msg);
+  setSuccess();
+}
+
+void CommandHandler::setLanguage(const vector<string>& args) {
+  if (args.size() < 2) {
+    setError("usage: setLanguage <language>");
+    return;
+  }
+
+  // The strings already shown (e.g., the pause menu) keep their old language.
+  if (!Localization::the().load(args[1])) {
+    setError("failed to load language: " + args[1]);
+    return;
+  }
+  Localization::the().preloadGlyphs();
+  setSuccess();
+}
+
+void CommandHandler::compileStrings(const vector<string>& args) {
+  if (args.size() < 2) {
+    setError("usage: compileStrings <language>");
+    return;
+  }
+
+  if (!Localization::compile(args[1])) {
+    setError("failed to compile language: " + args[1]);
+    return;
+  }
+  setSuccess();
+}
+
+void CommandHandler::exportStrings(const vector<string>&) {
+  if (!Localization::exportDefaults()) {
+    setError("failed to export strings");
+    return;
+  }
+  setSuccess();
+}
+
 }  // namespace vigilante
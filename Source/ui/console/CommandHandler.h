@@ -29,7 +29,23 @@ class CommandHandler final {
   void tradeWithPlayer(const std::vector<std::string>& args);
   void killCurrentTarget(const std::vector<std::string>& args);
   void interact(const std::vector<std::string>& args);
+  void setObjectState(const std::vector<std::string>& args);
   void narrate(const std::vector<std::string>& args);
+  void determinism(const std::vector<std::string>& args);
+  void toggleMemoryOverlay(const std::vector<std::string>& args);
+  void toggleFrameTimeGraph(const std::vector<std::string>& args);
+  void advanceTime(const std::vector<std::string>& args);
+  void setTimeScale(const std::vector<std::string>& args);
+  void setPlayerTimeScale(const std::vector<std::string>& args);
+  void inspectNpc(const std::vector<std::string>& args);
+  void setVar(const std::vector<std::string>& args);
+  void addVar(const std::vector<std::string>& args);
+  void printVar(const std::vector<std::string>& args);
+  void printStat(const std::vector<std::string>& args);
+  void benchmarkSpawn(const std::vector<std::string>& args);
+  void setLanguage(const std::vector<std::string>& args);
+  void compileStrings(const std::vector<std::string>& args);
+  void exportStrings(const std::vector<std::string>& args);
 
   bool _success{};
   std::string _errMsg;
@@ -43,11 +43,13 @@ void DialogueListView::confirm() {
     console->executeCmd(cmd);
   }
 
-  if (getSelectedObject()->getChildren().empty()) {
+  // The Npc replies with the first of the children whose condition holds.
+  const vector<Dialogue*> children = getSelectedObject()->getChildren();
+  if (children.empty()) {
     subtitles->endSubtitles();
     dialogueMgr->getTargetNpc()->getDialogueTree().resetCurrentNode();
   } else {
-    Dialogue* nextDialogue = getSelectedObject()->getChildren().front();
+    Dialogue* nextDialogue = children.front();
     for (const auto& line : nextDialogue->getLines()) {
       subtitles->addSubtitle(line);
     }
@@ -3,7 +3,7 @@
 
 #include "Assets.h"
 #include "character/Npc.h"
-#include "input/InputManager.h"
+#include "input/ActionMapper.h"
 #include "ui/dialogue/DialogueManager.h"
 
 // The positionX of DialogueMenu will be updated dynamically in runtime.
@@ -32,11 +32,11 @@ DialogueMenu::DialogueMenu()
 }
 
 void DialogueMenu::handleInput() {
-  if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_UP_ARROW)) {
+  if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_UP)) {
     _dialogueListView->selectUp();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_DOWN_ARROW)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_DOWN)) {
     _dialogueListView->selectDown();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_ENTER)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_CONFIRM)) {
     _dialogueListView->confirm();
   }
 }
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "Assets.h"
+#include "input/ActionMapper.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
 #include "util/ds/Algorithm.h"
@@ -70,7 +71,7 @@ void Subtitles::update(const float delta) {
 }
 
 void Subtitles::handleInput() {
-  if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_ENTER)) {
+  if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_CONFIRM)) {
     showNextSubtitle();
   }
 }
@@ -7,6 +7,7 @@
 #include "character/Player.h"
 #include "character/Npc.h"
 #include "ui/Colorscheme.h"
+#include "util/MemoryTracker.h"
 
 using namespace std;
 using namespace vigilante::assets;
@@ -51,6 +52,8 @@ void FloatingDamages::update(const float delta) {
 }
 
 void FloatingDamages::show(Character* character, int damage) {
+  ScopedMemoryTag memoryTag{MemoryTag::UI};
+
   // If _damageMap does not have a deque of FloatingDamage objects for this character,
   // then initialize it.
   if (_damageMap.find(character) == _damageMap.end()) {
@@ -0,0 +1,104 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "FrameTimeGraph.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Assets.h"
+#include "FrameLimiter.h"
+#include "util/StringUtil.h"
+
+#define GRAPH_X (ax::Director::getInstance()->getWinSize().width - FrameLimiter::kFrameTimeHistorySize) / 2
+#define GRAPH_Y ax::Director::getInstance()->getWinSize().height - _kHeight - 10
+
+using namespace std;
+using namespace vigilante::assets;
+USING_NS_AX;
+
+namespace vigilante {
+
+namespace {
+
+const Color4F kBackgroundColor{0, 0, 0, .5f};
+const Color4F kOnTimeColor{.3f, .9f, .3f, 1.0f};
+const Color4F kLateColor{1.0f, .8f, .2f, 1.0f};
+const Color4F kDroppedColor{1.0f, .25f, .25f, 1.0f};
+const Color4F kTargetLineColor{1.0f, 1.0f, 1.0f, .6f};
+
+}  // namespace
+
+FrameTimeGraph::FrameTimeGraph()
+    : _layer{Layer::create()},
+      _drawNode{DrawNode::create()},
+      _label{Label::createWithTTF("", string{kRegularFont}, kRegularFontSize)} {
+  _label->getFontAtlas()->setAliasTexParameters();
+  _label->setAnchorPoint({0, 1});
+  _label->setPositionY(-2);
+
+  _layer->setPosition(GRAPH_X, GRAPH_Y);
+  _layer->addChild(_drawNode);
+  _layer->addChild(_label);
+  _layer->setVisible(false);
+}
+
+void FrameTimeGraph::update(const float delta) {
+  if (!_layer->isVisible()) {
+    return;
+  }
+
+  redraw();
+
+  _refreshTimer += delta;
+  if (_refreshTimer >= _kRefreshInterval) {
+    refreshLabel();
+    _refreshTimer = 0;
+  }
+}
+
+void FrameTimeGraph::redraw() {
+  const FrameLimiter& frameLimiter = FrameLimiter::the();
+  const auto& frameTimes = frameLimiter.getFrameTimes();
+  const size_t n = frameTimes.size();
+  const int targetFps = frameLimiter.getTargetFps();
+  const float periodMs = 1000.0f / ((targetFps > 0) ? targetFps : 60);
+
+  _drawNode->clear();
+  _drawNode->drawSolidRect({0, 0}, {static_cast<float>(n), _kHeight}, kBackgroundColor);
+
+  // Oldest on the left.
+  for (size_t i = 0; i < n; i++) {
+    const float ms = frameTimes[(frameLimiter.getLatestFrameTimeIndex() + 1 + i) % n] * 1000.0f;
+    const float h = std::min(ms * _kPixelsPerMs, _kHeight);
+    const Color4F& color = (ms <= periodMs * 1.1f) ? kOnTimeColor :
+                           (ms <= periodMs * 1.9f) ? kLateColor : kDroppedColor;
+    _drawNode->drawLine({static_cast<float>(i), 0}, {static_cast<float>(i), h}, color);
+  }
+
+  const float targetY = std::min(periodMs * _kPixelsPerMs, _kHeight);
+  _drawNode->drawLine({0, targetY}, {static_cast<float>(n), targetY}, kTargetLineColor);
+}
+
+void FrameTimeGraph::refreshLabel() {
+  const auto& frameTimes = FrameLimiter::the().getFrameTimes();
+
+  float sum = 0;
+  float max = 0;
+  for (const float t : frameTimes) {
+    sum += t;
+    max = std::max(max, t);
+  }
+  const float avg = sum / frameTimes.size();
+
+  // The standard deviation tells the jitter apart from a low but steady frame rate.
+  float variance = 0;
+  for (const float t : frameTimes) {
+    variance += (t - avg) * (t - avg);
+  }
+  const float stddev = std::sqrt(variance / frameTimes.size());
+
+  _label->setString(string_util::format("%.1f fps  avg %.2f ms  max %.2f ms  dev %.2f ms",
+                                        (avg > 0) ? 1.0f / avg : 0.0f,
+                                        avg * 1000.0f, max * 1000.0f, stddev * 1000.0f));
+}
+
+}  // namespace vigilante
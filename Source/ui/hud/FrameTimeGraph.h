@@ -0,0 +1,39 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_FRAME_TIME_GRAPH_H_
+#define VIGILANTE_FRAME_TIME_GRAPH_H_
+
+#include <axmol.h>
+#include <2d/Label.h>
+
+namespace vigilante {
+
+// Plots the time between the recent frames recorded by the FrameLimiter,
+// one bar per frame, against the period of the frame rate cap.
+// A well paced game shows a flat line.
+class FrameTimeGraph final {
+ public:
+  FrameTimeGraph();
+
+  void update(const float delta);
+
+  inline bool isVisible() const { return _layer->isVisible(); }
+  inline void setVisible(bool visible) { _layer->setVisible(visible); }
+  inline ax::Layer* getLayer() const { return _layer; }
+
+ private:
+  static inline constexpr float _kHeight = 60.0f;
+  static inline constexpr float _kPixelsPerMs = 2.0f;
+  static inline constexpr float _kRefreshInterval = .5f;  // of the label
+
+  void redraw();
+  void refreshLabel();
+
+  ax::Layer* _layer;
+  ax::DrawNode* _drawNode;
+  ax::Label* _label;
+  float _refreshTimer{};
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_FRAME_TIME_GRAPH_H_
@@ -7,6 +7,7 @@
 #include "item/Equipment.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
+#include "util/StringUtil.h"
 
 #define HUD_X 75
 #define HUD_Y ax::Director::getInstance()->getWinSize().height - 40
@@ -25,7 +26,8 @@ Hud::Hud()
       _equippedWeaponBg(ui::ImageView::create(string{kEquippedWeaponBg})),
       _equippedWeapon(ui::ImageView::create()),
       _equippedWeaponDescBg(ui::ImageView::create(string{kEquippedWeaponDescBg})),
-      _equippedWeaponDesc(Label::createWithTTF("", string{kRegularFont}, kRegularFontSize)) {
+      _equippedWeaponDesc(Label::createWithTTF("", string{kRegularFont}, kRegularFontSize)),
+      _skillCooldowns(Label::createWithTTF("", string{kRegularFont}, kRegularFontSize)) {
   _equippedWeaponBg->setPosition({-20, -15});
   _equippedWeaponDescBg->setPosition({33, -25});
 
@@ -33,6 +35,10 @@ Hud::Hud()
   _equippedWeaponDesc->setAnchorPoint({0, 0});
   _equippedWeaponDesc->setPosition({5.0f, -30.f});
 
+  _skillCooldowns->getFontAtlas()->setAliasTexParameters();
+  _skillCooldowns->setAnchorPoint({0, 1});
+  _skillCooldowns->setPosition({-35.0f, -45.0f});
+
   _magickaBar->getLayout()->setPositionY(_magickaBar->getLayout()->getPositionY() - 6.0f);
   _staminaBar->getLayout()->setPositionY(_staminaBar->getLayout()->getPositionY() - 12.0f);
 
@@ -44,6 +50,7 @@ Hud::Hud()
   _layer->addChild(_staminaBar->getLayout());
   _layer->addChild(_equippedWeaponDescBg);
   _layer->addChild(_equippedWeaponDesc);
+  _layer->addChild(_skillCooldowns);
 }
 
 void Hud::updateEquippedWeapon() {
@@ -72,4 +79,35 @@ void Hud::updateStatusBars() {
   _staminaBar->update(profile.stamina, profile.fullStamina);
 }
 
+void Hud::updateSkillCooldowns() {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  Player* player = gmMgr->getPlayer();
+  if (!player) {
+    return;
+  }
+
+  const CooldownTracker& cooldowns = player->getSkillCooldowns();
+  string text;
+  for (const auto& skills : player->getSkillBook()) {
+    for (const auto skill : skills) {
+      if (!static_cast<bool>(skill->getHotkey())) {
+        continue;
+      }
+      // Don't flash every skill during the short global cooldown.
+      const float remainingTime = cooldowns.getRemainingTime(skill);
+      if (remainingTime <= cooldowns.getRemainingGlobalCooldown()) {
+        continue;
+      }
+      text += string_util::format("%s%s %.1f", text.empty() ? "" : "\n",
+                                  skill->getName().c_str(), remainingTime);
+    }
+  }
+
+  // Only touch the label when the text has changed, which
+  // avoids rebuilding its quads every frame.
+  if (_skillCooldowns->getString() != text) {
+    _skillCooldowns->setString(text);
+  }
+}
+
 }  // namespace vigilante
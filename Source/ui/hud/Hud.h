@@ -19,6 +19,8 @@ class Hud final {
 
   void updateEquippedWeapon();
   void updateStatusBars();
+  // Shows the remaining cooldowns of the player's hotkeyed skills.
+  void updateSkillCooldowns();
 
   inline ax::Layer* getLayer() const { return _layer; }
 
@@ -33,6 +35,7 @@ class Hud final {
   ax::ui::ImageView* _equippedWeapon;
   ax::ui::ImageView* _equippedWeaponDescBg;
   ax::Label* _equippedWeaponDesc;
+  ax::Label* _skillCooldowns;
 };
 
 }  // namespace vigilante
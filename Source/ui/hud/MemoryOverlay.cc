@@ -0,0 +1,72 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "MemoryOverlay.h"
+
+#include <string>
+
+#include "Assets.h"
+#include "util/MemoryTracker.h"
+#include "util/StringUtil.h"
+
+#define OVERLAY_X 10
+#define OVERLAY_Y ax::Director::getInstance()->getWinSize().height - 80
+
+using namespace std;
+using namespace vigilante::assets;
+USING_NS_AX;
+
+namespace vigilante {
+
+namespace {
+
+string formatBytes(const int64_t bytes) {
+  if (bytes >= 1024 * 1024) {
+    return string_util::format("%.1fM", bytes / (1024.0 * 1024.0));
+  }
+  return string_util::format("%.1fK", bytes / 1024.0);
+}
+
+}  // namespace
+
+MemoryOverlay::MemoryOverlay()
+    : _layer{Layer::create()},
+      _label{Label::createWithTTF("", string{kRegularFont}, kRegularFontSize)} {
+  _label->getFontAtlas()->setAliasTexParameters();
+  _label->setAnchorPoint({0, 1});
+
+  _layer->setPosition(OVERLAY_X, OVERLAY_Y);
+  _layer->addChild(_label);
+  _layer->setVisible(false);
+}
+
+void MemoryOverlay::update(const float delta) {
+  if (!_layer->isVisible()) {
+    return;
+  }
+
+  _refreshTimer += delta;
+  if (_refreshTimer >= _kRefreshInterval) {
+    refresh();
+    _refreshTimer = 0;
+  }
+}
+
+void MemoryOverlay::refresh() {
+  if (!MemoryTracker::isEnabled()) {
+    _label->setString("memory tracking disabled (build with VIGILANTE_MEMORY_TRACKING)");
+    return;
+  }
+
+  string text = "tag: current / peak (allocs)";
+  for (int i = 0; i < static_cast<int>(MemoryTag::SIZE); i++) {
+    const MemoryTag tag = static_cast<MemoryTag>(i);
+    const MemoryTracker::Usage usage = MemoryTracker::the().getUsage(tag);
+    text += string_util::format("\n%s: %s / %s (%lld)",
+                                MemoryTracker::getTagName(tag),
+                                formatBytes(usage.currentBytes).c_str(),
+                                formatBytes(usage.peakBytes).c_str(),
+                                static_cast<long long>(usage.numAllocations));
+  }
+  _label->setString(text);
+}
+
+}  // namespace vigilante
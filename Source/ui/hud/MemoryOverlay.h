@@ -0,0 +1,33 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_MEMORY_OVERLAY_H_
+#define VIGILANTE_MEMORY_OVERLAY_H_
+
+#include <axmol.h>
+#include <2d/Label.h>
+
+namespace vigilante {
+
+// Shows the current and peak bytes of each MemoryTag on screen.
+class MemoryOverlay final {
+ public:
+  MemoryOverlay();
+
+  void update(const float delta);
+
+  inline bool isVisible() const { return _layer->isVisible(); }
+  inline void setVisible(bool visible) { _layer->setVisible(visible); }
+  inline ax::Layer* getLayer() const { return _layer; }
+
+ private:
+  static inline constexpr float _kRefreshInterval = .5f;
+
+  void refresh();
+
+  ax::Layer* _layer;
+  ax::Label* _label;
+  float _refreshTimer{};
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_MEMORY_OVERLAY_H_
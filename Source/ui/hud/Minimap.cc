@@ -0,0 +1,373 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "Minimap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
+#include "Constants.h"
+#include "character/Npc.h"
+#include "character/Player.h"
+#include "map/GameMapManager.h"
+#include "map/object/Chest.h"
+#include "quest/InteractWithTargetObjective.h"
+#include "quest/KillTargetObjective.h"
+#include "scene/GameScene.h"
+#include "scene/SceneManager.h"
+#include "util/Logger.h"
+
+#define MINIMAP_X ax::Director::getInstance()->getWinSize().width - _kWidth - 10
+#define MINIMAP_Y ax::Director::getInstance()->getWinSize().height - _kHeight - 10
+
+using namespace std;
+USING_NS_AX;
+
+namespace vigilante {
+
+namespace {
+
+struct Rgba final {
+  uint8_t r, g, b, a;
+};
+
+constexpr Rgba kBackgroundColor{0, 0, 0, 96};
+constexpr Rgba kGroundColor{210, 210, 210, 255};
+constexpr Rgba kWallColor{150, 150, 150, 255};
+constexpr Rgba kPlatformColor{120, 160, 200, 255};
+constexpr Rgba kFogColor{16, 16, 20, 230};
+
+const Color4F kPortalIconColor{.4f, .8f, 1.0f, 1.0f};
+const Color4F kChestIconColor{1.0f, .8f, .2f, 1.0f};
+const Color4F kQuestTargetIconColor{1.0f, .3f, .3f, 1.0f};
+const Color4F kPartyMemberIconColor{.4f, 1.0f, .4f, 1.0f};
+const Color4F kPlayerIconColor{1.0f, 1.0f, 1.0f, 1.0f};
+const Color4F kFrameColor{1.0f, 1.0f, 1.0f, .6f};
+
+// An RGBA image whose row 0 is the top row, as textures expect,
+// whereas (x, y) are in texels with y pointing up, as in the map.
+class Raster final {
+ public:
+  Raster(const int width, const int height)
+      : _width{width},
+        _height{height},
+        _pixels(static_cast<size_t>(width) * height * 4) {
+    for (size_t i = 0; i < _pixels.size(); i += 4) {
+      _pixels[i] = kBackgroundColor.r;
+      _pixels[i + 1] = kBackgroundColor.g;
+      _pixels[i + 2] = kBackgroundColor.b;
+      _pixels[i + 3] = kBackgroundColor.a;
+    }
+  }
+
+  void plot(const int x, const int y, const Rgba& color) {
+    if (x < 0 || x >= _width || y < 0 || y >= _height) {
+      return;
+    }
+    const size_t i = (static_cast<size_t>(_height - 1 - y) * _width + x) * 4;
+    _pixels[i] = color.r;
+    _pixels[i + 1] = color.g;
+    _pixels[i + 2] = color.b;
+    _pixels[i + 3] = color.a;
+  }
+
+  // Bresenham's line algorithm.
+  void drawLine(int x0, int y0, const int x1, const int y1, const Rgba& color) {
+    const int dx = std::abs(x1 - x0);
+    const int dy = -std::abs(y1 - y0);
+    const int sx = x0 < x1 ? 1 : -1;
+    const int sy = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+    while (true) {
+      plot(x0, y0, color);
+      if (x0 == x1 && y0 == y1) {
+        break;
+      }
+      const int e2 = 2 * err;
+      if (e2 >= dy) {
+        err += dy;
+        x0 += sx;
+      }
+      if (e2 <= dx) {
+        err += dx;
+        y0 += sy;
+      }
+    }
+  }
+
+  void fillRect(const int x0, const int y0, const int x1, const int y1, const Rgba& color) {
+    for (int y = y0; y <= y1; y++) {
+      for (int x = x0; x <= x1; x++) {
+        plot(x, y, color);
+      }
+    }
+  }
+
+  inline const vector<uint8_t>& getPixels() const { return _pixels; }
+
+ private:
+  const int _width;
+  const int _height;
+  vector<uint8_t> _pixels;
+};
+
+inline int toTexel(const float pixels) {
+  return static_cast<int>(std::floor(pixels / Minimap::kPixelsPerTexel));
+}
+
+Texture2D* createTexture(const vector<uint8_t>& pixels, const int width, const int height) {
+  auto texture = new Texture2D();
+  texture->initWithData(pixels.data(), static_cast<ssize_t>(pixels.size()),
+                        backend::PixelFormat::RGBA8, width, height);
+  return texture;
+}
+
+// Rasterizes the ground, walls and platforms of the .tmx map `tmxMapFileName`
+// from the same object layers which GameMap builds its bodies from, so that it
+// works for any map, loaded or not. The markers aren't collidable, so they are
+// left out.
+Texture2D* rasterize(const string& tmxMapFileName) {
+  TMXMapInfo* mapInfo = TMXMapInfo::create(tmxMapFileName);
+  if (!mapInfo) {
+    VGLOG(LOG_ERR, "Failed to rasterize [%s].", tmxMapFileName.c_str());
+    return nullptr;
+  }
+
+  const Size& mapSize = mapInfo->getMapSize();
+  const Size& tileSize = mapInfo->getTileSize();
+  const int width = std::max(static_cast<int>(std::ceil(mapSize.width * tileSize.width / Minimap::kPixelsPerTexel)), 1);
+  const int height = std::max(static_cast<int>(std::ceil(mapSize.height * tileSize.height / Minimap::kPixelsPerTexel)), 1);
+  Raster raster{width, height};
+
+  const float scaleFactor = Director::getInstance()->getContentScaleFactor();
+  for (const TMXObjectGroup* objectGroup : mapInfo->getObjectGroups()) {
+    const string& layerName = objectGroup->getGroupName();
+    Rgba color;
+    if (layerName == "Ground") {
+      color = kGroundColor;
+    } else if (layerName == "Wall") {
+      color = kWallColor;
+    } else if (layerName == "Platform") {
+      color = kPlatformColor;
+    } else {
+      continue;
+    }
+
+    for (const auto& obj : objectGroup->getObjects()) {
+      const auto& valMap = obj.asValueMap();
+      const float x = valMap.at("x").asFloat();
+      const float y = valMap.at("y").asFloat();
+
+      // See GameMap::createPolylines() and GameMap::createRectangles().
+      if (valMap.contains("polylinePoints")) {
+        const auto& points = valMap.at("polylinePoints").asValueVector();
+        for (size_t i = 1; i < points.size(); i++) {
+          const auto& p1 = points[i - 1].asValueMap();
+          const auto& p2 = points[i].asValueMap();
+          raster.drawLine(toTexel(x + p1.at("x").asFloat() / scaleFactor),
+                          toTexel(y - p1.at("y").asFloat() / scaleFactor),
+                          toTexel(x + p2.at("x").asFloat() / scaleFactor),
+                          toTexel(y - p2.at("y").asFloat() / scaleFactor), color);
+        }
+      } else if (valMap.contains("width") && valMap.contains("height")) {
+        raster.fillRect(toTexel(x), toTexel(y),
+                        toTexel(x + valMap.at("width").asFloat()),
+                        toTexel(y + valMap.at("height").asFloat()), color);
+      }
+    }
+  }
+
+  Texture2D* texture = createTexture(raster.getPixels(), width, height);
+  texture->setAliasTexParameters();
+  return texture;
+}
+
+}  // namespace
+
+Minimap::Minimap()
+    : _layer{Layer::create()},
+      _viewport{ClippingRectangleNode::create({0, 0, _kWidth, _kHeight})},
+      _content{Node::create()},
+      _geometry{Sprite::create()},
+      _fog{Sprite::create()},
+      _icons{DrawNode::create()},
+      _frame{DrawNode::create()} {
+  _geometry->setAnchorPoint({0, 0});
+  _fog->setAnchorPoint({0, 0});
+  _fog->setScale(MapExploration::kCellSize / kPixelsPerTexel);
+
+  _content->addChild(_geometry);
+  _content->addChild(_fog);
+  _content->addChild(_icons);
+  _viewport->addChild(_content);
+
+  // The player always stays at the center.
+  _frame->drawRect({0, 0}, {_kWidth, _kHeight}, kFrameColor);
+  _frame->drawDot({_kWidth / 2, _kHeight / 2}, 2.0f, kPlayerIconColor);
+
+  _layer->setPosition(MINIMAP_X, MINIMAP_Y);
+  _layer->addChild(_viewport);
+  _layer->addChild(_frame);
+}
+
+Minimap::~Minimap() {
+  for (auto& [tmxMapFileName, texture] : _textureCache) {
+    if (texture) {
+      texture->release();
+    }
+  }
+  if (_fogTexture) {
+    _fogTexture->release();
+  }
+}
+
+void Minimap::update(const float delta) {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  const GameMap* gameMap = gmMgr->getGameMap();
+  if (!gameMap || !gmMgr->getPlayer() || !_layer->isVisible()) {
+    return;
+  }
+
+  if (gameMap != _gameMap || gameMap->getTmxTiledMapFileName() != _tmxMapFileName) {
+    onGameMapChanged(*gameMap);
+  }
+
+  const b2Vec2& pos = gmMgr->getPlayer()->getBody()->GetPosition();
+  _content->setPosition(_kWidth / 2 - pos.x * kPpm / kPixelsPerTexel,
+                        _kHeight / 2 - pos.y * kPpm / kPixelsPerTexel);
+
+  if (_fogRevision != gmMgr->getMapExploration()->getRevision()) {
+    updateFog();
+  }
+
+  _refreshTimer += delta;
+  if (_refreshTimer >= _kRefreshInterval) {
+    refreshIcons(*gameMap);
+    _refreshTimer = 0;
+  }
+}
+
+Texture2D* Minimap::getTexture(const string& tmxMapFileName) const {
+  auto [it, inserted] = _textureCache.emplace(tmxMapFileName, nullptr);
+  if (inserted) {
+    it->second = rasterize(tmxMapFileName);
+  }
+  return it->second;
+}
+
+void Minimap::onGameMapChanged(const GameMap& gameMap) {
+  _gameMap = &gameMap;
+  _tmxMapFileName = gameMap.getTmxTiledMapFileName();
+
+  if (Texture2D* texture = getTexture(_tmxMapFileName)) {
+    _geometry->setTexture(texture);
+    _geometry->setTextureRect({0, 0, static_cast<float>(texture->getPixelsWide()),
+                                     static_cast<float>(texture->getPixelsHigh())});
+    _geometry->setVisible(true);
+  } else {
+    _geometry->setVisible(false);
+  }
+
+  // The fog texture is recreated on the next updateFog(),
+  // since its size depends on the map.
+  if (_fogTexture) {
+    _fogTexture->release();
+    _fogTexture = nullptr;
+  }
+  updateFog();
+  refreshIcons(gameMap);
+  _refreshTimer = 0;
+}
+
+void Minimap::updateFog() {
+  const MapExploration* mapExploration =
+    SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager()->getMapExploration();
+  _fogRevision = mapExploration->getRevision();
+
+  const MapExploration::Record* record = mapExploration->getRecord(_tmxMapFileName);
+  if (!record) {
+    _fog->setVisible(false);
+    return;
+  }
+
+  _fogPixels.resize(static_cast<size_t>(record->cols) * record->rows * 4);
+  for (int row = 0; row < record->rows; row++) {
+    for (int col = 0; col < record->cols; col++) {
+      const size_t i = (static_cast<size_t>(record->rows - 1 - row) * record->cols + col) * 4;
+      const bool isExplored = record->isExplored(col, row);
+      _fogPixels[i] = kFogColor.r;
+      _fogPixels[i + 1] = kFogColor.g;
+      _fogPixels[i + 2] = kFogColor.b;
+      _fogPixels[i + 3] = isExplored ? 0 : kFogColor.a;
+    }
+  }
+
+  if (!_fogTexture) {
+    _fogTexture = createTexture(_fogPixels, record->cols, record->rows);
+    _fog->setTexture(_fogTexture);
+    _fog->setTextureRect({0, 0, static_cast<float>(record->cols), static_cast<float>(record->rows)});
+  } else {
+    _fogTexture->updateWithSubData(_fogPixels.data(), 0, 0, record->cols, record->rows);
+  }
+  _fog->setVisible(true);
+}
+
+void Minimap::refreshIcons(const GameMap& gameMap) {
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  Player* player = gmMgr->getPlayer();
+
+  auto toContent = [](const b2Vec2& pos) {
+    return Vec2{pos.x * kPpm / kPixelsPerTexel, pos.y * kPpm / kPixelsPerTexel};
+  };
+
+  _icons->clear();
+
+  for (const auto& portal : gameMap.getPortals()) {
+    const Color4F color = portal->isSealed() ? Color4F::GRAY : kPortalIconColor;
+    _icons->drawDot(toContent(portal->getInteractionBody()->GetPosition()), 1.5f, color);
+  }
+
+  // The targets of the current stage of each quest in progress.
+  unordered_set<string> killTargetNames;
+  unordered_set<string> interactTargetJsonFileNames;
+  for (const auto quest : player->getQuestBook().getInProgressQuests()) {
+    const Quest::Objective* objective = quest->getCurrentStage().objective.get();
+    if (objective->isCompleted()) {
+      continue;
+    }
+    if (auto o = dynamic_cast<const KillTargetObjective*>(objective)) {
+      killTargetNames.insert(o->getCharacterName());
+    } else if (auto o = dynamic_cast<const InteractWithTargetObjective*>(objective)) {
+      interactTargetJsonFileNames.insert(o->getTargetProfileJsonFileName());
+    }
+  }
+
+  const unordered_set<Character*> allies = player->getAllies();
+  for (const auto& actor : gameMap.getDynamicActors()) {
+    if (!actor->getBody()) {
+      continue;
+    }
+
+    if (auto chest = dynamic_cast<Chest*>(actor.get())) {
+      if (!chest->isOpened()) {
+        _icons->drawDot(toContent(chest->getBody()->GetPosition()), 1.5f, kChestIconColor);
+      }
+    } else if (auto npc = dynamic_cast<Npc*>(actor.get())) {
+      if (npc->isKilled() || allies.contains(npc)) {
+        continue;
+      }
+      const Character::Profile& profile = npc->getCharacterProfile();
+      if (killTargetNames.contains(profile.name) ||
+          interactTargetJsonFileNames.contains(profile.jsonFileName)) {
+        _icons->drawDot(toContent(npc->getBody()->GetPosition()), 2.0f, kQuestTargetIconColor);
+      }
+    }
+  }
+
+  for (const auto ally : allies) {
+    if (ally->getBody()) {
+      _icons->drawDot(toContent(ally->getBody()->GetPosition()), 1.5f, kPartyMemberIconColor);
+    }
+  }
+}
+
+}  // namespace vigilante
@@ -0,0 +1,71 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_MINIMAP_H_
+#define VIGILANTE_MINIMAP_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <axmol.h>
+
+namespace vigilante {
+
+class GameMap;
+
+// The Minimap shows the collision geometry around the player.
+//
+// The geometry of each GameMap is rasterized from its .tmx file only once,
+// when it is first needed, into a texture which is cached for the rest of
+// the session. The world map reuses them too, including those of the maps
+// which were explored before the save was loaded. On top of it there's a fog of war texture
+// with one texel per MapExploration cell, and the icons of portals, chests,
+// quest targets and party members, which are refreshed at a low frequency.
+class Minimap final {
+ public:
+  static inline constexpr float kPixelsPerTexel = 16.0f;
+
+  Minimap();
+  ~Minimap();
+
+  void update(const float delta);
+
+  // Returns the rasterized collision geometry of the map, which is rasterized
+  // upon the first request, or nullptr if the map fails to load.
+  ax::Texture2D* getTexture(const std::string& tmxMapFileName) const;
+
+  inline bool isVisible() const { return _layer->isVisible(); }
+  inline void setVisible(bool visible) { _layer->setVisible(visible); }
+  inline ax::Layer* getLayer() const { return _layer; }
+
+ private:
+  static inline constexpr float _kRefreshInterval = .25f;
+  static inline constexpr float _kWidth = 120.0f;
+  static inline constexpr float _kHeight = 72.0f;
+
+  void onGameMapChanged(const GameMap& gameMap);
+  void updateFog();
+  void refreshIcons(const GameMap& gameMap);
+
+  ax::Layer* _layer;
+  ax::ClippingRectangleNode* _viewport;
+  ax::Node* _content;  // in texels, moved so that the player stays at the center
+  ax::Sprite* _geometry;
+  ax::Sprite* _fog;
+  ax::DrawNode* _icons;
+  ax::DrawNode* _frame;
+
+  // By tmx map file name. Those which fail to rasterize are kept as nullptr.
+  mutable std::unordered_map<std::string, ax::Texture2D*> _textureCache;
+  ax::Texture2D* _fogTexture{};
+  std::vector<uint8_t> _fogPixels;  // RGBA
+
+  const GameMap* _gameMap{};
+  std::string _tmxMapFileName;
+  uint32_t _fogRevision{};
+  float _refreshTimer{};
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_MINIMAP_H_
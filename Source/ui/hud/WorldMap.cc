@@ -0,0 +1,234 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "WorldMap.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <queue>
+
+#include "Assets.h"
+#include "Constants.h"
+#include "map/GameMapManager.h"
+#include "scene/GameScene.h"
+#include "scene/SceneManager.h"
+#include "ui/hud/Minimap.h"
+
+namespace fs = std::filesystem;
+
+using namespace std;
+using namespace vigilante::assets;
+USING_NS_AX;
+
+namespace vigilante {
+
+namespace {
+
+const Color4B kBackgroundColor{0, 0, 0, 200};
+const Color4F kMapColor{0, 0, 0, .5f};
+const Color4F kFogColor{.06f, .06f, .08f, .9f};
+const Color4F kFrameColor{.6f, .6f, .6f, 1.0f};
+const Color4F kCurrentMapFrameColor{1.0f, 1.0f, 1.0f, 1.0f};
+const Color4F kConnectionColor{.4f, .8f, 1.0f, .8f};
+const Color4F kPlayerIconColor{1.0f, 1.0f, 1.0f, 1.0f};
+
+inline float toTexels(const float pixels) {
+  return pixels / Minimap::kPixelsPerTexel;
+}
+
+// Returns the connection of `record` which leads to `tmxMapFileName`, if any.
+const MapExploration::Connection* findConnection(const MapExploration::Record& record,
+                                                 const string& tmxMapFileName) {
+  for (const auto& connection : record.connections) {
+    if (connection.destTmxMapFileName == tmxMapFileName) {
+      return &connection;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+WorldMap::WorldMap(const Minimap& minimap)
+    : _minimap{minimap},
+      _layer{Layer::create()},
+      _background{LayerColor::create(kBackgroundColor)},
+      _content{Node::create()},
+      _labels{Node::create()} {
+  _layer->addChild(_background);
+  _layer->addChild(_content);
+  _layer->addChild(_labels);
+  _layer->setVisible(false);
+}
+
+void WorldMap::setVisible(bool visible) {
+  if (visible) {
+    rebuild();
+  }
+  _layer->setVisible(visible);
+}
+
+unordered_map<string, Rect> WorldMap::layout(const MapExploration& mapExploration) const {
+  unordered_map<string, Rect> rects;
+
+  const string& rootTmxMapFileName = mapExploration.getCurrentTmxMapFileName();
+  const MapExploration::Record* rootRecord = mapExploration.getRecord(rootTmxMapFileName);
+  if (!rootRecord) {
+    return rects;
+  }
+
+  auto overlaps = [&rects](const Rect& rect) {
+    return std::any_of(rects.begin(), rects.end(), [&rect](const auto& entry) {
+      return entry.second.intersectsRect(rect);
+    });
+  };
+
+  rects.emplace(rootTmxMapFileName, Rect{0, 0, toTexels(rootRecord->width), toTexels(rootRecord->height)});
+  queue<string> q;
+  q.push(rootTmxMapFileName);
+
+  while (!q.empty()) {
+    const string tmxMapFileName = std::move(q.front());
+    q.pop();
+
+    const MapExploration::Record& record = *mapExploration.getRecord(tmxMapFileName);
+    const Rect rect = rects.at(tmxMapFileName);
+
+    for (const auto& connection : record.connections) {
+      const string& destTmxMapFileName = connection.destTmxMapFileName;
+      const MapExploration::Record* destRecord = mapExploration.getRecord(destTmxMapFileName);
+      if (!destRecord || rects.contains(destTmxMapFileName)) {
+        continue;
+      }
+
+      // Line up the portal with the one which leads back,
+      // or with the center of the destination if there isn't one.
+      const float w = toTexels(destRecord->width);
+      const float h = toTexels(destRecord->height);
+      const Vec2 from{rect.getMinX() + toTexels(connection.x), rect.getMinY() + toTexels(connection.y)};
+      const MapExploration::Connection* back = findConnection(*destRecord, tmxMapFileName);
+      const Vec2 to = back ? Vec2{toTexels(back->x), toTexels(back->y)} : Vec2{w / 2, h / 2};
+
+      Rect destRect{0, 0, w, h};
+      Vec2 step;
+      const float u = connection.x / record.width;
+      if (u < 1.0f / 3) {
+        destRect.origin = {rect.getMinX() - _kGap - w, from.y - to.y};
+        step = {-(w + _kGap), 0};
+      } else if (u > 2.0f / 3) {
+        destRect.origin = {rect.getMaxX() + _kGap, from.y - to.y};
+        step = {w + _kGap, 0};
+      } else {
+        destRect.origin = {from.x - to.x, rect.getMaxY() + _kGap};
+        step = {0, h + _kGap};
+      }
+
+      while (overlaps(destRect)) {
+        destRect.origin += step;
+      }
+      rects.emplace(destTmxMapFileName, destRect);
+      q.push(destTmxMapFileName);
+    }
+  }
+
+  return rects;
+}
+
+void WorldMap::rebuild() {
+  _content->removeAllChildren();
+  _labels->removeAllChildren();
+
+  auto gmMgr = SceneManager::the().getCurrentScene<GameScene>()->getGameMapManager();
+  const MapExploration& mapExploration = *gmMgr->getMapExploration();
+  const unordered_map<string, Rect> rects = layout(mapExploration);
+  if (rects.empty()) {
+    return;
+  }
+
+  Rect bounds = rects.begin()->second;
+  for (const auto& [tmxMapFileName, rect] : rects) {
+    bounds.merge(rect);
+  }
+
+  const Size winSize = Director::getInstance()->getWinSize();
+  const float scale = std::min({(winSize.width - 40) / bounds.size.width,
+                                (winSize.height - 60) / bounds.size.height,
+                                _kMaxScale});
+  const Vec2 offset{winSize.width / 2 - bounds.getMidX() * scale,
+                    winSize.height / 2 - bounds.getMidY() * scale};
+  _content->setScale(scale);
+  _content->setPosition(offset);
+
+  auto below = DrawNode::create();
+  auto above = DrawNode::create();
+  _content->addChild(below, 0);
+  _content->addChild(above, 2);
+
+  const float cellSize = MapExploration::kCellSize / Minimap::kPixelsPerTexel;
+  const string& currentTmxMapFileName = mapExploration.getCurrentTmxMapFileName();
+
+  for (const auto& [tmxMapFileName, rect] : rects) {
+    const MapExploration::Record& record = *mapExploration.getRecord(tmxMapFileName);
+    below->drawSolidRect(rect.origin, {rect.getMaxX(), rect.getMaxY()}, kMapColor);
+
+    if (Texture2D* texture = _minimap.getTexture(tmxMapFileName)) {
+      auto sprite = Sprite::createWithTexture(texture);
+      sprite->setAnchorPoint({0, 0});
+      sprite->setPosition(rect.origin);
+      _content->addChild(sprite, 1);
+    }
+
+    // Cover the unexplored cells of each row, a run at a time.
+    for (int row = 0; row < record.rows; row++) {
+      int col = 0;
+      while (col < record.cols) {
+        if (record.isExplored(col, row)) {
+          col++;
+          continue;
+        }
+        int end = col;
+        while (end < record.cols && !record.isExplored(end, row)) {
+          end++;
+        }
+        above->drawSolidRect({rect.getMinX() + col * cellSize, rect.getMinY() + row * cellSize},
+                             {std::min(rect.getMinX() + end * cellSize, rect.getMaxX()),
+                              std::min(rect.getMinY() + (row + 1) * cellSize, rect.getMaxY())},
+                             kFogColor);
+        col = end;
+      }
+    }
+
+    for (const auto& connection : record.connections) {
+      auto it = rects.find(connection.destTmxMapFileName);
+      if (it == rects.end()) {
+        continue;
+      }
+      const MapExploration::Record& destRecord = *mapExploration.getRecord(connection.destTmxMapFileName);
+      const MapExploration::Connection* back = findConnection(destRecord, tmxMapFileName);
+      const Vec2 from = rect.origin + Vec2{toTexels(connection.x), toTexels(connection.y)};
+      const Vec2 to = back ? it->second.origin + Vec2{toTexels(back->x), toTexels(back->y)} :
+                             Vec2{it->second.getMidX(), it->second.getMidY()};
+      above->drawLine(from, to, kConnectionColor);
+    }
+
+    const bool isCurrent = tmxMapFileName == currentTmxMapFileName;
+    above->drawRect(rect.origin, {rect.getMaxX(), rect.getMaxY()}, isCurrent ? kCurrentMapFrameColor : kFrameColor);
+
+    auto label = Label::createWithTTF(fs::path{tmxMapFileName}.stem().string(),
+                                      string{kRegularFont}, kRegularFontSize);
+    label->getFontAtlas()->setAliasTexParameters();
+    label->setAnchorPoint({.5f, 0});
+    label->setPosition(offset + Vec2{rect.getMidX(), rect.getMaxY()} * scale + Vec2{0, 2});
+    _labels->addChild(label);
+  }
+
+  if (Player* player = gmMgr->getPlayer()) {
+    const b2Vec2& pos = player->getBody()->GetPosition();
+    const Vec2 origin = rects.at(currentTmxMapFileName).origin;
+    above->drawDot(origin + Vec2{toTexels(pos.x * kPpm), toTexels(pos.y * kPpm)}, 3.0f / scale, kPlayerIconColor);
+  }
+
+  // The nodes created above don't have the camera mask of the layer yet.
+  _content->setCameraMask(_layer->getCameraMask());
+  _labels->setCameraMask(_layer->getCameraMask());
+}
+
+}  // namespace vigilante
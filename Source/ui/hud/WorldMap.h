@@ -0,0 +1,48 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_WORLD_MAP_H_
+#define VIGILANTE_WORLD_MAP_H_
+
+#include <string>
+#include <unordered_map>
+
+#include <axmol.h>
+
+#include "map/MapExploration.h"
+
+namespace vigilante {
+
+class Minimap;
+
+// The WorldMap stitches the explored GameMaps together via their portal
+// connections, starting from the current map. A portal near the left or
+// the right edge of a map leads to the map on that side, and the others
+// (e.g., doors into buildings) lead to the map above.
+//
+// It is laid out again whenever it is shown, reusing the textures
+// rasterized by the Minimap and the fog of war of MapExploration.
+class WorldMap final {
+ public:
+  explicit WorldMap(const Minimap& minimap);
+
+  inline bool isVisible() const { return _layer->isVisible(); }
+  void setVisible(bool visible);
+  inline ax::Layer* getLayer() const { return _layer; }
+
+ private:
+  static inline constexpr float _kGap = 8.0f;  // texels
+  static inline constexpr float _kMaxScale = 4.0f;
+
+  // Returns the rects of the explored maps reachable from the current one, in texels.
+  std::unordered_map<std::string, ax::Rect> layout(const MapExploration& mapExploration) const;
+  void rebuild();
+
+  const Minimap& _minimap;
+  ax::Layer* _layer;
+  ax::LayerColor* _background;
+  ax::Node* _content;  // in texels, scaled to fit the screen
+  ax::Node* _labels;  // in screen space, so that the text isn't scaled
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_WORLD_MAP_H_
@@ -0,0 +1,86 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "KeyBindingsListView.h"
+
+#include <string>
+
+#include "Localization.h"
+#include "ui/options/KeyBindingsWindow.h"
+#include "util/KeyCodeUtil.h"
+
+#define VISIBLE_ITEM_COUNT 5
+#define WIDTH 289.5
+#define HEIGHT 120
+#define ITEM_GAP_HEIGHT 25
+
+using namespace std;
+using namespace vigilante::assets;
+USING_NS_AX;
+
+namespace vigilante {
+
+static_assert(static_cast<int>(StringId::ACTION_CONSOLE) - static_cast<int>(StringId::ACTION_MOVE_LEFT) + 1 ==
+              ActionMapper::Action::SIZE, "Every action needs a StringId.");
+
+namespace {
+
+string getKeyNames(const ActionMapper::Action action) {
+  string keyNames;
+  for (const auto& source : ActionMapper::the().getBindings(action)) {
+    if (source.type != ActionMapper::InputSource::Type::KEYBOARD) {
+      continue;
+    }
+    if (!keyNames.empty()) {
+      keyNames += ", ";
+    }
+    keyNames += keycode_util::keyCodeToString(static_cast<EventKeyboard::KeyCode>(source.code));
+  }
+  return keyNames.empty() ? tr(StringId::KEY_BINDINGS_UNBOUND) : keyNames;
+}
+
+}  // namespace
+
+KeyBindingsListView::KeyBindingsListView(KeyBindingsWindow* keyBindingsWindow)
+    : ListView<KeyBindingsEntry*>(VISIBLE_ITEM_COUNT, WIDTH, HEIGHT, ITEM_GAP_HEIGHT, kItemRegular, kItemHighlighted),
+      _keyBindingsWindow{keyBindingsWindow} {
+  // _setObjectCallback is called at the end of ListView<T>::ListViewItem::setObject()
+  // see ui/ListView.h
+  _setObjectCallback = [this](ListViewItem* listViewItem, KeyBindingsEntry* entry) {
+    if (!entry->action) {
+      listViewItem->getLabel()->setString(tr(StringId::KEY_BINDINGS_RESET));
+      return;
+    }
+
+    const ActionMapper::Action action = *entry->action;
+    const auto actionNameId = static_cast<StringId>(static_cast<int>(StringId::ACTION_MOVE_LEFT) + action);
+    string text = tr(StringId::KEY_BINDINGS_ENTRY, tr(actionNameId), getKeyNames(action));
+    if (_conflicts & ActionMapper::toMask(action)) {
+      text = tr(StringId::KEY_BINDINGS_CONFLICT, text);
+    }
+    listViewItem->getLabel()->setString(text);
+  };
+}
+
+void KeyBindingsListView::confirm() {
+  KeyBindingsEntry* entry = getSelectedObject();
+  if (!entry) {
+    return;
+  }
+
+  if (entry->action) {
+    _keyBindingsWindow->promptBinding(*entry->action);
+  } else {
+    _keyBindingsWindow->resetToDefaults();
+  }
+}
+
+void KeyBindingsListView::refresh(const ActionMask conflicts) {
+  _conflicts = conflicts;
+
+  if (_objects.empty()) {
+    return;
+  }
+  showFrom(_firstVisibleIndex);
+  _listViewItems[_current - _firstVisibleIndex]->setSelected(true);
+}
+
+}  // namespace vigilante
@@ -0,0 +1,38 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_KEY_BINDINGS_LIST_VIEW_H_
+#define VIGILANTE_KEY_BINDINGS_LIST_VIEW_H_
+
+#include <optional>
+
+#include "input/ActionMapper.h"
+#include "ui/ListView.h"
+
+namespace vigilante {
+
+// Forward declaration
+class KeyBindingsWindow;
+
+// An entry of the KeyBindingsWindow, which is either an action
+// and its keys, or the option to reset all the bindings.
+struct KeyBindingsEntry final {
+  std::optional<ActionMapper::Action> action;
+};
+
+class KeyBindingsListView : public ListView<KeyBindingsEntry*> {
+ public:
+  explicit KeyBindingsListView(KeyBindingsWindow* keyBindingsWindow);
+  virtual ~KeyBindingsListView() = default;
+
+  virtual void confirm() override;  // ListView<KeyBindingsEntry*>
+
+  // Shows the current bindings, marking the actions in `conflicts`.
+  void refresh(const ActionMask conflicts);
+
+ private:
+  KeyBindingsWindow* _keyBindingsWindow;
+  ActionMask _conflicts{};
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_KEY_BINDINGS_LIST_VIEW_H_
@@ -0,0 +1,132 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "KeyBindingsWindow.h"
+
+#include <string>
+
+#include "Assets.h"
+#include "Localization.h"
+#include "util/KeyCodeUtil.h"
+
+#define KEY_BINDINGS_WINDOW_WIDTH 300
+#define KEY_BINDINGS_WINDOW_HEIGHT 185
+
+#define MESSAGE_LABEL_X 5
+#define MESSAGE_LABEL_Y -132
+
+using namespace std;
+USING_NS_AX;
+
+namespace vigilante {
+
+namespace {
+
+string getActionName(const ActionMapper::Action action) {
+  return tr(static_cast<StringId>(static_cast<int>(StringId::ACTION_MOVE_LEFT) + action));
+}
+
+string getSourceName(const ActionMapper::InputSource& source) {
+  switch (source.type) {
+    case ActionMapper::InputSource::Type::GAMEPAD_BUTTON:
+      return "button " + std::to_string(source.code);
+    case ActionMapper::InputSource::Type::GAMEPAD_AXIS:
+      return "axis " + std::to_string(source.code) + (source.axisSign > 0 ? "+" : "-");
+    default:
+      return keycode_util::keyCodeToString(static_cast<EventKeyboard::KeyCode>(source.code));
+  }
+}
+
+}  // namespace
+
+KeyBindingsWindow::KeyBindingsWindow()
+    : Window(),
+      _keyBindingsListView{std::make_unique<KeyBindingsListView>(this)},
+      _messageLabel{Label::createWithTTF("", string{assets::kRegularFont}, assets::kRegularFontSize)} {
+  resize(KEY_BINDINGS_WINDOW_WIDTH, KEY_BINDINGS_WINDOW_HEIGHT);
+  setTitle(tr(StringId::OPTION_KEY_BINDINGS));
+
+  _contentLayout->setLayoutType(ui::Layout::Type::ABSOLUTE);
+  _contentLayout->setAnchorPoint({0, 1});
+
+  // Place key bindings list view.
+  _keyBindingsListView->getLayout()->setPosition({5, -5});
+  _contentLayout->addChild(_keyBindingsListView->getLayout());
+
+  _messageLabel->getFontAtlas()->setAliasTexParameters();
+  _messageLabel->setAnchorPoint({0, 1});
+  _messageLabel->setPosition({MESSAGE_LABEL_X, MESSAGE_LABEL_Y});
+  _messageLabel->enableWrap(true);
+  _contentLayout->addChild(_messageLabel);
+
+  for (int i = 0; i < ActionMapper::Action::SIZE; i++) {
+    _entries.push_back({static_cast<ActionMapper::Action>(i)});
+  }
+  _entries.push_back({std::nullopt});
+
+  vector<KeyBindingsEntry*> entries;
+  for (auto& entry : _entries) {
+    entries.push_back(&entry);
+  }
+  _keyBindingsListView->setObjects(entries);
+  refresh();
+}
+
+void KeyBindingsWindow::update(const float) {
+
+}
+
+void KeyBindingsWindow::handleInput() {
+  if (_pendingTakeOver) {
+    const auto [action, source] = *_pendingTakeOver;
+    if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_CONFIRM)) {
+      _pendingTakeOver.reset();
+      _messageLabel->setString(ActionMapper::the().rebind(action, source, true) ?
+                               "" : tr(StringId::KEY_BINDINGS_SAVE_FAILED));
+      refresh();
+    } else if (ActionMapper::the().getJustPressedActions()) {
+      _pendingTakeOver.reset();
+      _messageLabel->setString("");
+    }
+    return;
+  }
+
+  if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_UP)) {
+    _keyBindingsListView->selectUp();
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_DOWN)) {
+    _keyBindingsListView->selectDown();
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_CONFIRM)) {
+    _keyBindingsListView->confirm();
+  }
+}
+
+void KeyBindingsWindow::promptBinding(const ActionMapper::Action action) {
+  _messageLabel->setString(tr(StringId::KEY_BINDINGS_PRESS_A_KEY, getActionName(action)));
+
+  auto onFinished = [this](const bool) {
+    _messageLabel->setString("");
+    refresh();
+  };
+
+  auto onConflict = [this, action](const ActionMapper::InputSource& source, const ActionMapper::Action other) {
+    _pendingTakeOver = {action, source};
+    _messageLabel->setString(tr(StringId::KEY_BINDINGS_TAKE_OVER, getSourceName(source), getActionName(other)));
+  };
+
+  ActionMapper::the().promptBinding(action, onFinished, onConflict);
+}
+
+void KeyBindingsWindow::resetToDefaults() {
+  ActionMapper::the().resetToDefaults();
+  const bool success = ActionMapper::the().save(ActionMapper::kBindingsFileName);
+  _messageLabel->setString(tr(success ? StringId::KEY_BINDINGS_RESET_DONE : StringId::KEY_BINDINGS_SAVE_FAILED));
+  refresh();
+}
+
+void KeyBindingsWindow::refresh() {
+  ActionMask conflicts = 0;
+  for (const auto& [a, b] : ActionMapper::the().findAllConflicts()) {
+    conflicts |= ActionMapper::toMask(a) | ActionMapper::toMask(b);
+  }
+  _keyBindingsListView->refresh(conflicts);
+}
+
+}  // namespace vigilante
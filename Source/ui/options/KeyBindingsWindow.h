@@ -0,0 +1,46 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_KEY_BINDINGS_WINDOW_H_
+#define VIGILANTE_KEY_BINDINGS_WINDOW_H_
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <axmol.h>
+#include <2d/Label.h>
+
+#include "input/ActionMapper.h"
+#include "ui/Window.h"
+#include "ui/options/KeyBindingsListView.h"
+
+namespace vigilante {
+
+// Lists the keyboard bindings of every action. Confirming an action rebinds it
+// to the next key pressed, and if that key is bound to another action of the
+// same group, the player is asked whether to take the key over from it.
+class KeyBindingsWindow : public Window {
+ public:
+  KeyBindingsWindow();
+  virtual ~KeyBindingsWindow() = default;
+
+  virtual void update(const float delta) override;  // Window
+  virtual void handleInput() override;  // Window
+
+  void promptBinding(const ActionMapper::Action action);
+  void resetToDefaults();
+
+ private:
+  void refresh();
+
+  std::vector<KeyBindingsEntry> _entries;
+  std::unique_ptr<KeyBindingsListView> _keyBindingsListView;
+  ax::Label* _messageLabel;
+
+  // The key which the player is asked to take over from another action.
+  std::optional<std::pair<ActionMapper::Action, ActionMapper::InputSource>> _pendingTakeOver;
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_KEY_BINDINGS_WINDOW_H_
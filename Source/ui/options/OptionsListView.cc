@@ -0,0 +1,44 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "OptionsListView.h"
+
+#include "Options.h"
+
+#define VISIBLE_ITEM_COUNT 6
+#define WIDTH 289.5
+#define HEIGHT 145
+#define ITEM_GAP_HEIGHT 25
+
+using namespace vigilante::assets;
+USING_NS_AX;
+
+namespace vigilante {
+
+OptionsListView::OptionsListView()
+    : ListView<OptionsEntry*>(VISIBLE_ITEM_COUNT, WIDTH, HEIGHT, ITEM_GAP_HEIGHT, kItemRegular, kItemHighlighted) {
+  // _setObjectCallback is called at the end of ListView<T>::ListViewItem::setObject()
+  // see ui/ListView.h
+  _setObjectCallback = [](ListViewItem* listViewItem, OptionsEntry* entry) {
+    listViewItem->getLabel()->setString(entry->toString());
+  };
+}
+
+void OptionsListView::confirm() {
+  step(1);
+}
+
+void OptionsListView::step(const int step) {
+  OptionsEntry* entry = getSelectedObject();
+  if (!entry) {
+    return;
+  }
+
+  entry->step(step);
+  Options::the().apply();
+  Options::the().save(Options::kOptionsFileName);
+
+  // Show the new value.
+  showFrom(_firstVisibleIndex);
+  _listViewItems[_current - _firstVisibleIndex]->setSelected(true);
+}
+
+}  // namespace vigilante
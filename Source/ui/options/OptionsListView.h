@@ -0,0 +1,32 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_OPTIONS_LIST_VIEW_H_
+#define VIGILANTE_OPTIONS_LIST_VIEW_H_
+
+#include <functional>
+#include <string>
+
+#include "ui/ListView.h"
+
+namespace vigilante {
+
+// An entry of the OptionsWindow, which shows the current value of an option
+// and steps it to the previous (-1) or the next (1) value.
+struct OptionsEntry final {
+  std::function<std::string ()> toString;
+  std::function<void (const int step)> step;
+};
+
+class OptionsListView : public ListView<OptionsEntry*> {
+ public:
+  OptionsListView();
+  virtual ~OptionsListView() = default;
+
+  virtual void confirm() override;  // ListView<OptionsEntry*>
+
+  // Steps the selected option, then applies and saves the options.
+  void step(const int step);
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_OPTIONS_LIST_VIEW_H_
@@ -0,0 +1,115 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "OptionsWindow.h"
+
+#include <algorithm>
+#include <string>
+
+#include "Localization.h"
+#include "Options.h"
+#include "input/ActionMapper.h"
+
+#define OPTIONS_WINDOW_WIDTH 300
+#define OPTIONS_WINDOW_HEIGHT 165
+
+using namespace std;
+USING_NS_AX;
+
+namespace vigilante {
+
+namespace {
+
+// Returns the value `step` away from `current` in `values`, wrapping around.
+template <typename Container, typename T>
+T stepThrough(const Container& values, const T& current, const int step) {
+  const int n = static_cast<int>(values.size());
+  auto it = std::find(values.begin(), values.end(), current);
+  const int i = (it != values.end()) ? static_cast<int>(it - values.begin()) : 0;
+  return values[((i + step) % n + n) % n];
+}
+
+string toOnOff(const bool on) {
+  return tr(on ? StringId::OPTIONS_ON : StringId::OPTIONS_OFF);
+}
+
+}  // namespace
+
+OptionsWindow::OptionsWindow()
+    : Window(),
+      _optionsListView{std::make_unique<OptionsListView>()} {
+  resize(OPTIONS_WINDOW_WIDTH, OPTIONS_WINDOW_HEIGHT);
+  setTitle(tr(StringId::OPTION_OPTIONS));
+
+  _contentLayout->setLayoutType(ui::Layout::Type::ABSOLUTE);
+  _contentLayout->setAnchorPoint({0, 1});
+
+  // Place options list view.
+  _optionsListView->getLayout()->setPosition({5, -5});
+  _contentLayout->addChild(_optionsListView->getLayout());
+
+  _entries = {
+    {[]() {
+       const int frameRateCap = Options::the().getFrameRateCap();
+       return tr(StringId::OPTIONS_FRAME_RATE_CAP,
+                 (frameRateCap > 0) ? std::to_string(frameRateCap) : tr(StringId::OPTIONS_UNLIMITED));
+     },
+     [](const int step) {
+       Options::the().setFrameRateCap(stepThrough(Options::kFrameRateCaps, Options::the().getFrameRateCap(), step));
+     }},
+    {[]() { return tr(StringId::OPTIONS_VSYNC, toOnOff(Options::the().isVSyncEnabled())); },
+     [](const int) { Options::the().setVSyncEnabled(!Options::the().isVSyncEnabled()); }},
+    {[]() { return tr(StringId::OPTIONS_RESOLUTION_SCALE, Options::the().getResolutionScale()); },
+     [](const int step) {
+       const int n = Options::kMaxResolutionScale;
+       Options::the().setResolutionScale(((Options::the().getResolutionScale() - 1 + step) % n + n) % n + 1);
+     }},
+    {[]() { return tr(StringId::OPTIONS_FULLSCREEN, toOnOff(Options::the().isFullscreen())); },
+     [](const int) { Options::the().setFullscreen(!Options::the().isFullscreen()); }},
+    {[]() {
+       static const array<StringId, static_cast<size_t>(Options::EffectQuality::SIZE)> kQualityNames{{
+         StringId::OPTIONS_QUALITY_LOW,
+         StringId::OPTIONS_QUALITY_MEDIUM,
+         StringId::OPTIONS_QUALITY_HIGH,
+       }};
+       const auto effectQuality = static_cast<size_t>(Options::the().getEffectQuality());
+       return tr(StringId::OPTIONS_EFFECT_QUALITY, tr(kQualityNames[effectQuality]));
+     },
+     [](const int step) {
+       const int n = static_cast<int>(Options::EffectQuality::SIZE);
+       const int effectQuality = static_cast<int>(Options::the().getEffectQuality());
+       Options::the().setEffectQuality(static_cast<Options::EffectQuality>(((effectQuality + step) % n + n) % n));
+     }},
+    // The text which is already shown keeps its language until it is shown again.
+    {[]() { return tr(StringId::OPTIONS_LANGUAGE, Options::the().getLanguage()); },
+     [](const int step) {
+       const string language = stepThrough(Localization::getAvailableLanguages(), Options::the().getLanguage(), step);
+       Options::the().setLanguage(language);
+       Localization::the().load(language);
+       Localization::the().preloadGlyphs();
+     }},
+  };
+
+  vector<OptionsEntry*> entries;
+  for (auto& entry : _entries) {
+    entries.push_back(&entry);
+  }
+  _optionsListView->setObjects(entries);
+}
+
+void OptionsWindow::update(const float) {
+
+}
+
+void OptionsWindow::handleInput() {
+  if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_UP)) {
+    _optionsListView->selectUp();
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_DOWN)) {
+    _optionsListView->selectDown();
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_LEFT)) {
+    _optionsListView->step(-1);
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_RIGHT) ||
+             IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_CONFIRM)) {
+    _optionsListView->step(1);
+  }
+}
+
+}  // namespace vigilante
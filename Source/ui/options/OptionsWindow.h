@@ -0,0 +1,28 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_OPTIONS_WINDOW_H_
+#define VIGILANTE_OPTIONS_WINDOW_H_
+
+#include <memory>
+#include <vector>
+
+#include "ui/Window.h"
+#include "ui/options/OptionsListView.h"
+
+namespace vigilante {
+
+class OptionsWindow : public Window {
+ public:
+  OptionsWindow();
+  virtual ~OptionsWindow() = default;
+
+  virtual void update(const float delta) override;  // Window
+  virtual void handleInput() override;  // Window
+
+ private:
+  std::vector<OptionsEntry> _entries;
+  std::unique_ptr<OptionsListView> _optionsListView;
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_OPTIONS_WINDOW_H_
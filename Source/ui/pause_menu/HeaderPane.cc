@@ -19,7 +19,7 @@ HeaderPane::HeaderPane(PauseMenu* pauseMenu)
 
   float nextX = 0;
   for (int i = 0; i < PauseMenu::Pane::SIZE; i++) {
-    Label* label = Label::createWithTTF(PauseMenu::_kPaneNames[i], string{kTitleFont}, kRegularFontSize);
+    Label* label = Label::createWithTTF(tr(PauseMenu::_kPaneNames[i]), string{kTitleFont}, kRegularFontSize);
     label->setTextColor(colorscheme::kGrey);
     label->setPositionX(nextX + _kOptionGap * i);
     label->getFontAtlas()->setAliasTexParameters();
@@ -3,7 +3,7 @@
 
 #include "Assets.h"
 #include "Audio.h"
-#include "input/InputManager.h"
+#include "input/ActionMapper.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
 #include "ui/pause_menu/equipment/EquipmentPane.h"
@@ -24,12 +24,12 @@ USING_NS_AX;
 
 namespace vigilante {
 
-const array<string, PauseMenu::Pane::SIZE> PauseMenu::_kPaneNames = {
-  "INVENTORY",
-  "EQUIPMENT",
-  "SKILLS",
-  "QUESTS",
-  "OPTIONS"
+const array<StringId, PauseMenu::Pane::SIZE> PauseMenu::_kPaneNames = {
+  StringId::PANE_INVENTORY,
+  StringId::PANE_EQUIPMENT,
+  StringId::PANE_SKILLS,
+  StringId::PANE_QUESTS,
+  StringId::PANE_OPTIONS
 };
 
 PauseMenu::PauseMenu()
@@ -96,7 +96,7 @@ void PauseMenu::handleInput() {
     return;
   }
 
-  if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_Q)) {
+  if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_PREV_TAB)) {
     getCurrentPane()->setVisible(false);
     _headerPane->selectPrev();
     getCurrentPane()->update();
@@ -105,7 +105,7 @@ void PauseMenu::handleInput() {
     auto controlHints = SceneManager::the().getCurrentScene<GameScene>()->getControlHints();
     controlHints->switchToProfile(static_cast<ControlHints::Profile>(_headerPane->getCurrentIndex()));
 
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_E)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_NEXT_TAB)) {
     getCurrentPane()->setVisible(false);
     _headerPane->selectNext();
     getCurrentPane()->update();
@@ -12,6 +12,7 @@
 #include <ui/UIImageView.h>
 
 #include "Controllable.h"
+#include "Localization.h"
 #include "ui/hud/ControlHints.h"
 #include "ui/pause_menu/HeaderPane.h"
 #include "ui/pause_menu/StatsPane.h"
@@ -29,7 +30,7 @@ class PauseMenuDialog;
 class PauseMenu : public Controllable {
  public:
   // To add a new pane to the pause menu, add it to the enum below,
-  // as well as the string literal to the following static const std::array.
+  // as well as the StringId of its name to the following static const std::array.
   enum Pane {
     INVENTORY,
     EQUIPMENT,
@@ -38,7 +39,7 @@ class PauseMenu : public Controllable {
     OPTIONS,
     SIZE
   };
-  static const std::array<std::string, PauseMenu::Pane::SIZE> _kPaneNames;
+  static const std::array<StringId, PauseMenu::Pane::SIZE> _kPaneNames;
 
   PauseMenu();
   virtual ~PauseMenu() override = default;
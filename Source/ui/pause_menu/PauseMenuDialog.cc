@@ -2,6 +2,7 @@
 #include "PauseMenuDialog.h"
 
 #include "Assets.h"
+#include "input/ActionMapper.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
 #include "ui/TableLayout.h"
@@ -46,11 +47,11 @@ void PauseMenuDialog::update() {
 }
 
 void PauseMenuDialog::handleInput() {
-  if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_LEFT_ARROW)) {
+  if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_LEFT)) {
     selectLeft();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_RIGHT_ARROW)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_RIGHT)) {
     selectRight();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_ENTER)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_CONFIRM)) {
     confirm();
   }
 }
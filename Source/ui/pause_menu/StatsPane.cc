@@ -2,6 +2,7 @@
 #include "StatsPane.h"
 
 #include "Assets.h"
+#include "Localization.h"
 #include "character/Player.h"
 #include "ui/Colorscheme.h"
 #include "ui/pause_menu/PauseMenu.h"
@@ -46,40 +47,44 @@ StatsPane::StatsPane(PauseMenu* pauseMenu)
   layout->align(TableLayout::Alignment::RIGHT)->padRight(_kPadRight)->padBottom(15.0f);
   layout->row(4.0f);
 
-  addEntry("HEALTH", _health);
-  addEntry("MAGICKA", _magicka);
-  addEntry("STAMINA", _stamina);
+  addEntry(tr(StringId::STATS_HEALTH), _health);
+  addEntry(tr(StringId::STATS_MAGICKA), _magicka);
+  addEntry(tr(StringId::STATS_STAMINA), _stamina);
   layout->row(_kSectionHeight);
 
-  addEntry("ATTACK RANGE", _attackRange);
-  addEntry("ATTACK SPEED", _attackSpeed);
-  addEntry("MOVE SPEED", _moveSpeed);
-  addEntry("JUMP HEIGHT", _jumpHeight);
+  addEntry(tr(StringId::STATS_ATTACK_RANGE), _attackRange);
+  addEntry(tr(StringId::STATS_ATTACK_SPEED), _attackSpeed);
+  addEntry(tr(StringId::STATS_MOVE_SPEED), _moveSpeed);
+  addEntry(tr(StringId::STATS_JUMP_HEIGHT), _jumpHeight);
   layout->row(_kSectionHeight);
 
-  addEntry("STR", _str);
-  addEntry("DEX", _dex);
-  addEntry("INT", _int);
-  addEntry("LUK", _luk);
+  addEntry(tr(StringId::STATS_STR), _str);
+  addEntry(tr(StringId::STATS_DEX), _dex);
+  addEntry(tr(StringId::STATS_INT), _int);
+  addEntry(tr(StringId::STATS_LUK), _luk);
 }
 
 void StatsPane::update() {
   Character::Profile& profile = _pauseMenu->getPlayer()->getCharacterProfile();
 
-  _level->setString(string_util::format("Level %d", profile.level));
+  _level->setString(tr(StringId::STATS_LEVEL, profile.level));
   _health->setString(string_util::format("%d / %d", profile.health, profile.fullHealth));
   _magicka->setString(string_util::format("%d / %d", profile.magicka, profile.fullMagicka));
   _stamina->setString(string_util::format("%d / %d", profile.stamina, profile.fullStamina));
 
   _attackRange->setString(string_util::format("%.2f", profile.attackRange));
   _attackSpeed->setString(string_util::format("%.2f", profile.attackTime));
-  _moveSpeed->setString(string_util::format("%.2f", profile.moveSpeed));
-  _jumpHeight->setString(string_util::format("%.2f", profile.jumpHeight));
 
-  _str->setString(string_util::format("%d", profile.strength));
-  _dex->setString(string_util::format("%d", profile.dexterity));
-  _int->setString(string_util::format("%d", profile.intelligence));
-  _luk->setString(string_util::format("%d", profile.luck));
+  // Show the effective values, i.e., with equipment bonuses and active buffs.
+  using Stat = StatModifierStack::Stat;
+  const StatModifierStack& stats = _pauseMenu->getPlayer()->getStatModifiers();
+  _moveSpeed->setString(string_util::format("%.2f", stats.get(Stat::MOVE_SPEED)));
+  _jumpHeight->setString(string_util::format("%.2f", stats.get(Stat::JUMP_HEIGHT)));
+
+  _str->setString(string_util::format("%d", stats.getInt(Stat::STRENGTH)));
+  _dex->setString(string_util::format("%d", stats.getInt(Stat::DEXTERITY)));
+  _int->setString(string_util::format("%d", stats.getInt(Stat::INTELLIGENCE)));
+  _luk->setString(string_util::format("%d", stats.getInt(Stat::LUCK)));
 }
 
 void StatsPane::handleInput() {
@@ -4,7 +4,7 @@
 #include "Assets.h"
 #include "Constants.h"
 #include "character/Player.h"
-#include "input/InputManager.h"
+#include "input/ActionMapper.h"
 #include "ui/pause_menu/PauseMenu.h"
 #include "ui/pause_menu/inventory/InventoryPane.h"
 
@@ -42,11 +42,11 @@ void EquipmentPane::update() {
 }
 
 void EquipmentPane::handleInput() {
-  if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_UP_ARROW)) {
+  if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_UP)) {
     selectUp();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_DOWN_ARROW)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_DOWN)) {
     selectDown();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_ENTER)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_CONFIRM)) {
     confirm();
   }
 }
@@ -4,7 +4,7 @@
 #include "Assets.h"
 #include "Constants.h"
 #include "character/Player.h"
-#include "input/InputManager.h"
+#include "input/ActionMapper.h"
 #include "map/GameMapManager.h"
 #include "ui/hud/ControlHints.h"
 #include "ui/pause_menu/PauseMenu.h"
@@ -46,17 +46,17 @@ void InventoryPane::update() {
 }
 
 void InventoryPane::handleInput() {
-  if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_LEFT_ARROW)) {
+  if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_LEFT)) {
     _tabView->selectPrev();
     update();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_RIGHT_ARROW)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_RIGHT)) {
     _tabView->selectNext();
     update();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_UP_ARROW)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_UP)) {
     _itemListView->selectUp();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_DOWN_ARROW)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_DOWN)) {
     _itemListView->selectDown();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_ENTER)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_CONFIRM)) {
     if (!_isSelectingEquipment) {
       _itemListView->confirm();
     } else {
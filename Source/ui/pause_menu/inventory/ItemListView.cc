@@ -3,6 +3,7 @@
 
 #include "Assets.h"
 #include "Constants.h"
+#include "Localization.h"
 #include "character/Player.h"
 #include "input/Keybindable.h"
 #include "item/Item.h"
@@ -78,17 +79,17 @@ void ItemListView::confirm() {
 
   PauseMenuDialog* dialog = _pauseMenu->getDialog();
   dialog->reset();
-  dialog->setMessage("What would you like to do with " + item->getName() + "?");
+  dialog->setMessage(tr(StringId::DIALOG_WHAT_TO_DO_WITH, item->getName()));
 
   switch (item->getItemProfile().itemType) {
     case Item::Type::EQUIPMENT:
-      dialog->setOption(0, true, "Equip", [=]() {
+      dialog->setOption(0, true, tr(StringId::DIALOG_EQUIP), [=]() {
         _pauseMenu->getPlayer()->equip(dynamic_cast<Equipment*>(item));
         _pauseMenu->update();
       });
       break;
     case Item::Type::CONSUMABLE:
-      dialog->setOption(0, true, "Use", [=]() {
+      dialog->setOption(0, true, tr(StringId::DIALOG_USE), [=]() {
         _pauseMenu->getPlayer()->useItem(dynamic_cast<Consumable*>(item));
         _pauseMenu->update();
       });
@@ -98,11 +99,11 @@ void ItemListView::confirm() {
       break;
   }
 
-  dialog->setOption(1, true, "Discard", [=]() {
+  dialog->setOption(1, true, tr(StringId::DIALOG_DISCARD), [=]() {
     _pauseMenu->getPlayer()->discardItem(item, 1);
     _pauseMenu->update();
   });
-  dialog->setOption(2, true, "Cancel");
+  dialog->setOption(2, true, tr(StringId::DIALOG_CANCEL));
   dialog->show();
 }
 
@@ -3,6 +3,7 @@
 
 #include <cassert>
 
+#include "Localization.h"
 #include "character/Player.h"
 #include "ui/pause_menu/PauseMenu.h"
 
@@ -34,13 +35,13 @@ void OptionListView::confirm() {
   const auto& optionHandler = getSelectedObject()->second;
   PauseMenuDialog* dialog = _pauseMenu->getDialog();
   dialog->reset();
-  dialog->setMessage("Are you sure?");
+  dialog->setMessage(tr(StringId::DIALOG_ARE_YOU_SURE));
 
-  dialog->setOption(1, true, "Confirm", [=]() {
+  dialog->setOption(1, true, tr(StringId::DIALOG_CONFIRM), [=]() {
     optionHandler();
     _pauseMenu->update();
   });
-  dialog->setOption(2, true, "Cancel");
+  dialog->setOption(2, true, tr(StringId::DIALOG_CANCEL));
   dialog->show();
 }
 
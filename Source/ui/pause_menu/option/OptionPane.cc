@@ -3,18 +3,42 @@
 
 #include <vector>
 
-#include "gameplay/GameState.h"
-#include "input/InputManager.h"
+#include "Localization.h"
+#include "input/ActionMapper.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
+#include "ui/WindowManager.h"
+#include "ui/options/KeyBindingsWindow.h"
+#include "ui/options/OptionsWindow.h"
+#include "ui/save_slot/SaveSlotWindow.h"
 
-#define OPTIONS_COUNT 4
+#define OPTIONS_COUNT 5
 
 using namespace std;
 USING_NS_AX;
 
 namespace vigilante {
 
+namespace {
+
+void showWindow(unique_ptr<Window> window) {
+  // Windows are rendered below the pause menu, so hide it first. The game
+  // stays paused while the window is open, and the pause menu is shown
+  // again once it's closed.
+  auto gameScene = SceneManager::the().getCurrentScene<GameScene>();
+  window->setPausingGame(true);
+  window->setOnClosed([]() {
+    auto pauseMenu = SceneManager::the().getCurrentScene<GameScene>()->getPauseMenu();
+    pauseMenu->setVisible(true);
+    pauseMenu->update();
+  });
+
+  gameScene->getPauseMenu()->setVisible(false);
+  gameScene->getWindowManager()->push(std::move(window));
+}
+
+}  // namespace
+
 OptionPane::OptionPane(PauseMenu* pauseMenu)
     : AbstractPane(pauseMenu),
       _options(OPTIONS_COUNT),
@@ -29,10 +53,11 @@ OptionPane::OptionPane(PauseMenu* pauseMenu)
 
   // Define available Options.
   _options = {{
-    {"Save Game", []() { GameState("quicksave.vgs").save(); }},
-    {"Load Game", []() { GameState("quicksave.vgs").load(); }},
-    {"Options",   []() {}},
-    {"Quit",      []() { SceneManager::the().getCurrentScene<GameScene>()->setRunning(false); }},
+    {tr(StringId::SAVE_GAME),           []() { showWindow(std::make_unique<SaveSlotWindow>(SaveSlotWindow::Mode::SAVE)); }},
+    {tr(StringId::LOAD_GAME),           []() { showWindow(std::make_unique<SaveSlotWindow>(SaveSlotWindow::Mode::LOAD)); }},
+    {tr(StringId::OPTION_OPTIONS),      []() { showWindow(std::make_unique<OptionsWindow>()); }},
+    {tr(StringId::OPTION_KEY_BINDINGS), []() { showWindow(std::make_unique<KeyBindingsWindow>()); }},
+    {tr(StringId::OPTION_QUIT),         []() { SceneManager::the().getCurrentScene<GameScene>()->setRunning(false); }},
   }};
 
   vector<Option*> options;
@@ -48,11 +73,11 @@ void OptionPane::update() {
 }
 
 void OptionPane::handleInput() {
-  if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_UP_ARROW)) {
+  if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_UP)) {
     _optionListView->selectUp();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_DOWN_ARROW)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_DOWN)) {
     _optionListView->selectDown();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_ENTER)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_CONFIRM)) {
     _optionListView->confirm();
   }
 }
@@ -8,7 +8,7 @@
 #include "ui/pause_menu/AbstractPane.h"
 #include "ui/pause_menu/option/OptionListView.h"
 
-#define OPTION_COUNT 4
+#define OPTION_COUNT 5
 
 namespace vigilante {
 
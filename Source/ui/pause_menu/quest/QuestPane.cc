@@ -2,7 +2,7 @@
 #include "QuestPane.h"
 
 #include "Assets.h"
-#include "input/InputManager.h"
+#include "input/ActionMapper.h"
 #include "util/Logger.h"
 
 using namespace std;
@@ -52,17 +52,17 @@ void QuestPane::update() {
 }
 
 void QuestPane::handleInput() {
-  if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_LEFT_ARROW)) {
+  if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_LEFT)) {
     _tabView->selectPrev();
     update();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_RIGHT_ARROW)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_RIGHT)) {
     _tabView->selectNext();
     update();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_UP_ARROW)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_UP)) {
     _questListView->selectUp();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_DOWN_ARROW)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_DOWN)) {
     _questListView->selectDown();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_ENTER)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_CONFIRM)) {
     _questListView->confirm();
   }
 }
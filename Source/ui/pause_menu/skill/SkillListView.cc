@@ -3,6 +3,7 @@
 
 #include <cassert>
 
+#include "Localization.h"
 #include "character/Player.h"
 #include "input/Keybindable.h"
 #include "scene/GameScene.h"
@@ -10,6 +11,7 @@
 #include "ui/pause_menu/PauseMenu.h"
 #include "ui/pause_menu/PauseMenuDialog.h"
 #include "util/KeyCodeUtil.h"
+#include "util/StringUtil.h"
 
 #define VISIBLE_ITEM_COUNT 5
 #define WIDTH 289.5
@@ -31,7 +33,7 @@ SkillListView::SkillListView(PauseMenu* pauseMenu)
       _descLabel(Label::createWithTTF("", string{kRegularFont}, kRegularFontSize)) {
   // _setObjectCallback is called at the end of ListView<T>::ListViewItem::setObject()
   // see ui/ListView.h
-  _setObjectCallback = [](ListViewItem* listViewItem, Skill* skill) {
+  _setObjectCallback = [this](ListViewItem* listViewItem, Skill* skill) {
     assert(skill != nullptr);
 
     ui::ImageView* icon = listViewItem->getIcon();
@@ -49,6 +51,14 @@ SkillListView::SkillListView(PauseMenu* pauseMenu)
       const string& hotkey = keycode_util::keyCodeToString(keybindable->getHotkey());
       label->setString(string{label->getString()} + " [" + hotkey + "]");
     }
+
+    // Dim the skills which are still cooling down.
+    const CooldownTracker& cooldowns = _pauseMenu->getPlayer()->getSkillCooldowns();
+    const float remainingTime = cooldowns.getRemainingTime(skill);
+    icon->setOpacity(remainingTime > 0.0f ? 100 : 255);
+    if (remainingTime > 0.0f) {
+      label->setString(string{label->getString()} + string_util::format(" (%.1fs)", remainingTime));
+    }
   };
 
   _descLabel->getFontAtlas()->setAliasTexParameters();
@@ -66,25 +76,25 @@ void SkillListView::confirm() {
 
   PauseMenuDialog* dialog = _pauseMenu->getDialog();
   dialog->reset();
-  dialog->setMessage("What would you like to do with " + skill->getName() + "?");
+  dialog->setMessage(tr(StringId::DIALOG_WHAT_TO_DO_WITH, skill->getName()));
 
   auto hotkeyMgr = SceneManager::the().getCurrentScene<GameScene>()->getHotkeyManager();
-  dialog->setOption(0, true, "Assign", [=]() {
+  dialog->setOption(0, true, tr(StringId::DIALOG_ASSIGN), [=]() {
     dialog->reset();
-    dialog->setMessage("Press a key to assign to...");
-    dialog->setOption(2, true, "Cancel");
+    dialog->setMessage(tr(StringId::DIALOG_PRESS_A_KEY));
+    dialog->setOption(2, true, tr(StringId::DIALOG_CANCEL));
     dialog->show();
     hotkeyMgr->promptHotkey(skill, dialog);
   });
 
   if (static_cast<bool>(skill->getHotkey())) {
-    dialog->setOption(1, true, "Clear", [=]() {
+    dialog->setOption(1, true, tr(StringId::DIALOG_CLEAR), [=]() {
       hotkeyMgr->clearHotkeyAction(skill->getHotkey());
       //showSkills();
     });
   }
 
-  dialog->setOption(2, true, "Cancel");
+  dialog->setOption(2, true, tr(StringId::DIALOG_CANCEL));
   dialog->show();
 }
 
@@ -2,7 +2,7 @@
 #include "SkillPane.h"
 
 #include "Assets.h"
-#include "input/InputManager.h"
+#include "input/ActionMapper.h"
 
 using namespace std;
 using namespace vigilante::assets;
@@ -41,17 +41,17 @@ void SkillPane::update() {
 }
 
 void SkillPane::handleInput() {
-  if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_LEFT_ARROW)) {
+  if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_LEFT)) {
     _tabView->selectPrev();
     update();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_RIGHT_ARROW)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_RIGHT)) {
     _tabView->selectNext();
     update();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_UP_ARROW)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_UP)) {
     _skillListView->selectUp();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_DOWN_ARROW)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_DOWN)) {
     _skillListView->selectDown();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_ENTER)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_CONFIRM)) {
     _skillListView->confirm();
   }
 }
@@ -0,0 +1,136 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "SaveSlotListView.h"
+
+#include <ctime>
+
+#include "Assets.h"
+#include "Localization.h"
+#include "scene/GameScene.h"
+#include "scene/SceneManager.h"
+#include "ui/WindowManager.h"
+#include "ui/hud/Notifications.h"
+#include "ui/save_slot/SaveSlotWindow.h"
+#include "util/StringUtil.h"
+
+#define VISIBLE_ITEM_COUNT 5
+#define WIDTH 289.5
+#define HEIGHT 120
+#define ITEM_GAP_HEIGHT 25
+
+#define DESC_LABEL_X 5
+#define DESC_LABEL_Y -132
+
+using namespace std;
+using namespace vigilante::assets;
+USING_NS_AX;
+
+namespace vigilante {
+
+namespace {
+
+string formatPlayTime(const float playTime) {
+  const int seconds = static_cast<int>(playTime);
+  return string_util::format("%02d:%02d:%02d", seconds / 3600, seconds / 60 % 60, seconds % 60);
+}
+
+string formatTimestamp(const int64_t timestamp) {
+  // Version 1 saves didn't record when they were written.
+  if (timestamp == 0) {
+    return "";
+  }
+
+  const time_t t = static_cast<time_t>(timestamp);
+  char buf[32]{};
+  std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M", std::localtime(&t));
+  return buf;
+}
+
+}  // namespace
+
+SaveSlotListView::SaveSlotListView(SaveSlotWindow* saveSlotWindow)
+    : ListView<GameState::SlotInfo*>(VISIBLE_ITEM_COUNT, WIDTH, HEIGHT, ITEM_GAP_HEIGHT, kItemRegular, kItemHighlighted),
+      _saveSlotWindow(saveSlotWindow),
+      _descLabel(Label::createWithTTF("", string{assets::kRegularFont}, assets::kRegularFontSize)) {
+  // _setObjectCallback is called at the end of ListView<T>::ListViewItem::setObject()
+  // see ui/ListView.h
+  _setObjectCallback = [](ListViewItem* listViewItem, GameState::SlotInfo* slotInfo) {
+    assert(slotInfo != nullptr);
+
+    const string slotName = (slotInfo->slot == 0) ?
+      tr(StringId::SAVE_QUICK_SAVE_SLOT) : tr(StringId::SAVE_SLOT, slotInfo->slot);
+
+    Label* label = listViewItem->getLabel();
+    if (slotInfo->isEmpty) {
+      label->setString(tr(StringId::SAVE_EMPTY_SLOT_ENTRY, slotName));
+    } else {
+      label->setString(tr(StringId::SAVE_SLOT_ENTRY,
+                          slotName, slotInfo->header.playerName, slotInfo->header.playerLevel));
+    }
+  };
+
+  _descLabel->getFontAtlas()->setAliasTexParameters();
+  _descLabel->setAnchorPoint({0, 1});
+  _descLabel->setPosition({DESC_LABEL_X, DESC_LABEL_Y});
+  _descLabel->enableWrap(true);
+  _layout->addChild(_descLabel);
+}
+
+void SaveSlotListView::confirm() {
+  GameState::SlotInfo* slotInfo = getSelectedObject();
+  if (!slotInfo) {
+    return;
+  }
+
+  auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
+  if (_saveSlotWindow->getMode() == SaveSlotWindow::Mode::LOAD && slotInfo->isEmpty) {
+    notifications->show(tr(StringId::SAVE_SLOT_EMPTY));
+    return;
+  }
+
+  // Close this window first. `w` keeps it (and this list view)
+  // alive until we return.
+  auto wm = SceneManager::the().getCurrentScene<GameScene>()->getWindowManager();
+  const unique_ptr<Window> w = wm->pop();
+
+  GameState gameState{slotInfo->saveFilePath};
+  if (_saveSlotWindow->getMode() == SaveSlotWindow::Mode::SAVE) {
+    notifications->show(tr(gameState.save() ? StringId::SAVE_SUCCEEDED : StringId::SAVE_FAILED));
+  } else if (!gameState.load()) {
+    notifications->show(tr(StringId::LOAD_FAILED));
+  }
+}
+
+void SaveSlotListView::selectUp() {
+  ListView<GameState::SlotInfo*>::selectUp();
+  updateDescLabel();
+}
+
+void SaveSlotListView::selectDown() {
+  ListView<GameState::SlotInfo*>::selectDown();
+  updateDescLabel();
+}
+
+void SaveSlotListView::showSlotInfos(vector<GameState::SlotInfo>& slotInfos) {
+  vector<GameState::SlotInfo*> objects;
+  objects.reserve(slotInfos.size());
+  for (auto& info : slotInfos) {
+    objects.push_back(&info);
+  }
+  setObjects(objects);
+  updateDescLabel();
+}
+
+void SaveSlotListView::updateDescLabel() {
+  if (_objects.empty() || _objects[_current]->isEmpty) {
+    _descLabel->setString("");
+    return;
+  }
+
+  const GameState::Header& header = _objects[_current]->header;
+  _descLabel->setString(string_util::format("%s  %s\n%s",
+                                            header.location.c_str(),
+                                            formatPlayTime(header.playTime).c_str(),
+                                            formatTimestamp(header.timestamp).c_str()));
+}
+
+}  // namespace vigilante
@@ -0,0 +1,33 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_SAVE_SLOT_LIST_VIEW_H_
+#define VIGILANTE_SAVE_SLOT_LIST_VIEW_H_
+
+#include "gameplay/GameState.h"
+#include "ui/ListView.h"
+
+namespace vigilante {
+
+// Forward declaration
+class SaveSlotWindow;
+
+class SaveSlotListView : public ListView<GameState::SlotInfo*> {
+ public:
+  explicit SaveSlotListView(SaveSlotWindow* saveSlotWindow);
+  virtual ~SaveSlotListView() = default;
+
+  virtual void confirm() override;  // ListView<GameState::SlotInfo*>
+  virtual void selectUp() override;  // ListView<GameState::SlotInfo*>
+  virtual void selectDown() override;  // ListView<GameState::SlotInfo*>
+
+  void showSlotInfos(std::vector<GameState::SlotInfo>& slotInfos);
+
+ private:
+  void updateDescLabel();
+
+  SaveSlotWindow* _saveSlotWindow;
+  ax::Label* _descLabel;
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_SAVE_SLOT_LIST_VIEW_H_
@@ -0,0 +1,47 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "SaveSlotWindow.h"
+
+#include "Localization.h"
+#include "input/ActionMapper.h"
+
+#define SAVE_SLOT_WINDOW_WIDTH 300
+#define SAVE_SLOT_WINDOW_HEIGHT 185
+
+using namespace std;
+USING_NS_AX;
+
+namespace vigilante {
+
+SaveSlotWindow::SaveSlotWindow(const SaveSlotWindow::Mode mode)
+    : Window(),
+      _mode{mode},
+      _slotInfos{GameState::getSlotInfos()},
+      _saveSlotListView{std::make_unique<SaveSlotListView>(this)} {
+  resize(SAVE_SLOT_WINDOW_WIDTH, SAVE_SLOT_WINDOW_HEIGHT);
+  setTitle(tr((_mode == Mode::SAVE) ? StringId::SAVE_GAME : StringId::LOAD_GAME));
+
+  _contentLayout->setLayoutType(ui::Layout::Type::ABSOLUTE);
+  _contentLayout->setAnchorPoint({0, 1});
+
+  // Place save slot list view.
+  _saveSlotListView->getLayout()->setPosition({5, -5});
+  _contentLayout->addChild(_saveSlotListView->getLayout());
+
+  _saveSlotListView->showSlotInfos(_slotInfos);
+}
+
+void SaveSlotWindow::update(const float) {
+
+}
+
+void SaveSlotWindow::handleInput() {
+  if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_UP)) {
+    _saveSlotListView->selectUp();
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_DOWN)) {
+    _saveSlotListView->selectDown();
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_CONFIRM)) {
+    _saveSlotListView->confirm();
+  }
+}
+
+}  // namespace vigilante
@@ -0,0 +1,38 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_SAVE_SLOT_WINDOW_H_
+#define VIGILANTE_SAVE_SLOT_WINDOW_H_
+
+#include <memory>
+#include <vector>
+
+#include "gameplay/GameState.h"
+#include "ui/Window.h"
+#include "ui/save_slot/SaveSlotListView.h"
+
+namespace vigilante {
+
+class SaveSlotWindow : public Window {
+ public:
+  enum class Mode {
+    SAVE,
+    LOAD
+  };
+
+  explicit SaveSlotWindow(const SaveSlotWindow::Mode mode);
+  virtual ~SaveSlotWindow() = default;
+
+  virtual void update(const float delta) override;  // Window
+  virtual void handleInput() override;  // Window
+
+  inline SaveSlotWindow::Mode getMode() const { return _mode; }
+
+ private:
+  const SaveSlotWindow::Mode _mode;
+  // Only the headers are read, so this stays cheap even with many slots.
+  std::vector<GameState::SlotInfo> _slotInfos;
+  std::unique_ptr<SaveSlotListView> _saveSlotListView;
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_SAVE_SLOT_WINDOW_H_
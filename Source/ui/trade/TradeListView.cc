@@ -4,6 +4,7 @@
 #include <memory>
 
 #include "Assets.h"
+#include "Localization.h"
 #include "gameplay/ItemPriceTable.h"
 #include "scene/GameScene.h"
 #include "scene/SceneManager.h"
@@ -71,17 +72,14 @@ void TradeListView::confirm() {
     return;
   }
 
-  Character* seller = _tradeWindow->getSeller();
-  Character* buyer = _tradeWindow->getBuyer();
-
   if (item->getAmount() == 1) {
-    doTrade(buyer, seller, item, 1);
+    _tradeWindow->addToCart(item, 1);
 
   } else {
     auto w = std::make_unique<AmountSelectionWindow>();
     AmountSelectionWindow* wRaw = w.get();
 
-    auto onSubmit = [wRaw, this, buyer, seller, item]() {
+    auto onSubmit = [wRaw, this, item]() {
       const string& buf = wRaw->getTextField()->getString();
       int amount = 0;
 
@@ -89,14 +87,16 @@ void TradeListView::confirm() {
       try {
         amount = std::stoi(buf);
       } catch (const std::invalid_argument& ex) {
-        notifications->show("Invalid amount");
+        notifications->show(tr(StringId::AMOUNT_INVALID));
       } catch (const std::out_of_range& ex) {
-        notifications->show("Amount too large or too small");
+        notifications->show(tr(StringId::AMOUNT_OUT_OF_RANGE));
       } catch (...) {
-        notifications->show("Unknown error while parsing amount");
+        notifications->show(tr(StringId::AMOUNT_UNKNOWN_ERROR));
       }
 
-      doTrade(buyer, seller, item, amount);
+      if (amount > 0) {
+        _tradeWindow->addToCart(item, amount);
+      }
     };
 
     auto onDismiss = []() {
@@ -147,38 +147,4 @@ void TradeListView::showCharactersItemByType(Character* owner, Item::Type itemTy
   _descLabel->setString((_objects.size() > 0) ? _objects[_current]->getDesc() : "");
 }
 
-void TradeListView::doTrade(Character* buyer,
-                            Character* seller,
-                            Item* item,
-                            const int amount) const {
-  if (amount <= 0) {
-    return;
-  }
-
-  auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
-  const int price = item_price_table::getPrice(item);
-
-  // Check if `amount` is valid.
-  if (amount > item->getAmount()) {
-    notifications->show("Invalid amount");
-    return;
-  }
-
-  if (!_tradeWindow->isTradingWithAlly()) {
-    if (buyer->getGoldBalance() < price * amount) {
-      notifications->show("The buyer doesn't have sufficient amount of gold.");
-      return;
-    }
-
-    if (!item->isGold()) {
-      buyer->removeGold(price * amount);
-      seller->addGold(price * amount);
-    }
-  }
-
-  // Transfer items
-  buyer->addItem(Item::create(item->getItemProfile().jsonFileName), amount);
-  seller->removeItem(item, amount);
-}
-
 }  // namespace vigilante
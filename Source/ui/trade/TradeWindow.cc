@@ -2,15 +2,21 @@
 #include "TradeWindow.h"
 
 #include "Assets.h"
+#include "Localization.h"
 #include "character/Player.h"
-#include "input/InputManager.h"
-#include "util/StringUtil.h"
+#include "input/ActionMapper.h"
+#include "scene/GameScene.h"
+#include "scene/SceneManager.h"
+#include "ui/hud/Notifications.h"
 
 #define TRADE_WINDOW_CONTENT_MARGIN_LEFT 10
 #define TRADE_WINDOW_CONTENT_MARGIN_RIGHT 10
 #define TRADE_WINDOW_CONTENT_MARGIN_TOP 30
 #define TRADE_WINDOW_CONTENT_MARGIN_BOTTOM 40
 
+#define CART_LABEL_X 5
+#define CART_LABEL_Y -175
+
 using namespace std;
 using namespace vigilante::assets;
 USING_NS_AX;
@@ -20,11 +26,13 @@ namespace vigilante {
 TradeWindow::TradeWindow(Character* buyer, Character* seller)
     : Window(),
       _contentBackground(ui::ImageView::create(string{kTradeBg})),
+      _cartLabel(Label::createWithTTF("", string{kRegularFont}, kRegularFontSize)),
       _tabView(make_unique<TabView>(kTabRegular, kTabHighlighted)),
       _tradeListView(make_unique<TradeListView>(this)),
       _isTradingWithAlly(seller->getAllies().find(buyer) != seller->getAllies().end()),
       _buyer(buyer),
-      _seller(seller) {
+      _seller(seller),
+      _tradeSession(buyer, seller, _isTradingWithAlly) {
   // Resize window: Make the window slightly larger than `_contentBackground`.
   auto tradeWindowSize = _contentBackground->getContentSize();
   tradeWindowSize.width += TRADE_WINDOW_CONTENT_MARGIN_LEFT + TRADE_WINDOW_CONTENT_MARGIN_RIGHT;
@@ -50,48 +58,117 @@ TradeWindow::TradeWindow(Character* buyer, Character* seller)
   _tradeListView->getLayout()->setPosition({5, -5});
   _contentLayout->addChild(_tradeListView->getLayout());
 
-  update(0);
+  // Place cart label.
+  _cartLabel->getFontAtlas()->setAliasTexParameters();
+  _cartLabel->setAnchorPoint({0, 1});
+  _cartLabel->setPosition({CART_LABEL_X, CART_LABEL_Y});
+  _contentLayout->addChild(_cartLabel);
+
+  updateTitle();
+  updateCartLabel();
+  showSellersItems();
 }
 
 void TradeWindow::update(float) {
-  if (_isTradingWithAlly) {
-    setTitle((dynamic_cast<Player*>(_buyer)) ?
-        string_util::format("Receiving from: %s", _seller->getCharacterProfile().name.c_str()) :
-        string_util::format("Giving to: %s", _buyer->getCharacterProfile().name.c_str())
-    );
-  } else {
-    setTitle((dynamic_cast<Player*>(_buyer)) ?
-        string_util::format("Buying from: %s", _seller->getCharacterProfile().name.c_str()) :
-        string_util::format("Selling to: %s", _buyer->getCharacterProfile().name.c_str())
-    );
-  }
-
-  Item::Type selectedItemType = static_cast<Item::Type>(_tabView->getSelectedTab()->getIndex());
-  _tradeListView->showCharactersItemByType(_seller, selectedItemType);
+  // Nothing changes between frames, everything is
+  // updated in response to input instead.
 }
 
 void TradeWindow::handleInput() {
-  if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_Q) ||
-      IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_E)) {
+  if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_PREV_TAB) ||
+      IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_NEXT_TAB)) {
     toggleBuySell();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_LEFT_ARROW)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_LEFT)) {
     _tabView->selectPrev();
-    update(0);
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_RIGHT_ARROW)) {
+    showSellersItems();
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_RIGHT)) {
     _tabView->selectNext();
-    update(0);
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_UP_ARROW)) {
+    showSellersItems();
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_UP)) {
     _tradeListView->selectUp();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_DOWN_ARROW)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_DOWN)) {
     _tradeListView->selectDown();
-  } else if (IS_KEY_JUST_PRESSED(EventKeyboard::KeyCode::KEY_ENTER)) {
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_CONFIRM)) {
     _tradeListView->confirm();
+  } else if (IS_ACTION_JUST_PRESSED(ActionMapper::Action::MENU_COMMIT)) {
+    commit();
   }
 }
 
 void TradeWindow::toggleBuySell() {
   std::swap(_buyer, _seller);
-  update(0);
+  updateTitle();
+  showSellersItems();
+}
+
+void TradeWindow::addToCart(Item* item, const int amount) {
+  const int addedAmount = _tradeSession.addToCart(_seller, item, amount);
+  if (addedAmount < amount) {
+    auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
+    notifications->show(tr(StringId::AMOUNT_INVALID));
+  }
+  if (addedAmount > 0) {
+    updateCartLabel();
+  }
+}
+
+void TradeWindow::commit() {
+  if (_tradeSession.isCartEmpty()) {
+    return;
+  }
+
+  const size_t numEntries = _tradeSession.getCart().size();
+  auto notifications = SceneManager::the().getCurrentScene<GameScene>()->getNotifications();
+
+  string errMsg;
+  const bool success = _tradeSession.commit(errMsg);
+  notifications->show(success ? tr(StringId::TRADE_TRADED, numEntries) : errMsg);
+
+  // Even a failed commit may have replaced the listed stacks while rolling back.
+  showSellersItems();
+  updateCartLabel();
+}
+
+void TradeWindow::updateTitle() {
+  if (_isTradingWithAlly) {
+    setTitle((dynamic_cast<Player*>(_buyer)) ?
+        tr(StringId::TRADE_RECEIVING_FROM, _seller->getCharacterProfile().name) :
+        tr(StringId::TRADE_GIVING_TO, _buyer->getCharacterProfile().name)
+    );
+  } else {
+    setTitle((dynamic_cast<Player*>(_buyer)) ?
+        tr(StringId::TRADE_BUYING_FROM, _seller->getCharacterProfile().name) :
+        tr(StringId::TRADE_SELLING_TO, _buyer->getCharacterProfile().name)
+    );
+  }
+}
+
+void TradeWindow::updateCartLabel() {
+  if (_tradeSession.isCartEmpty()) {
+    _cartLabel->setString("");
+    return;
+  }
+
+  int numItems = 0;
+  for (const auto& entry : _tradeSession.getCart()) {
+    numItems += entry.amount;
+  }
+
+  // The session was created with the player as its first party,
+  // so a positive net price is what the player pays.
+  const int netPrice = _tradeSession.getNetPrice();
+  string text = tr(StringId::TRADE_CART, numItems);
+  if (netPrice > 0) {
+    text += tr(StringId::TRADE_YOU_PAY, netPrice);
+  } else if (netPrice < 0) {
+    text += tr(StringId::TRADE_YOU_RECEIVE, -netPrice);
+  }
+  _cartLabel->setString(text);
+}
+
+void TradeWindow::showSellersItems() {
+  Item::Type selectedItemType = static_cast<Item::Type>(_tabView->getSelectedTab()->getIndex());
+  _tradeListView->showCharactersItemByType(_seller, selectedItemType);
 }
 
 }  // namespace vigilante
@@ -9,6 +9,7 @@
 #include <ui/UILayout.h>
 #include "ui/Window.h"
 #include "character/Character.h"
+#include "gameplay/TradeSession.h"
 #include "ui/TabView.h"
 #include "ui/trade/TradeListView.h"
 
@@ -23,19 +24,29 @@ class TradeWindow : public Window {
   virtual void handleInput() override;  // Window
 
   void toggleBuySell();
+  // Adds `amount` of the seller's `item` to the cart.
+  void addToCart(Item* item, const int amount);
+  void commit();
 
   inline bool isTradingWithAlly() const { return _isTradingWithAlly; }
   inline Character* getBuyer() const { return _buyer; }
   inline Character* getSeller() const { return _seller; }
+  inline const TradeSession& getTradeSession() const { return _tradeSession; }
 
  private:
+  void updateTitle();
+  void updateCartLabel();
+  void showSellersItems();
+
   ax::ui::ImageView* _contentBackground;
+  ax::Label* _cartLabel;
   std::unique_ptr<TabView> _tabView;
   std::unique_ptr<TradeListView> _tradeListView;
 
   bool _isTradingWithAlly;
   Character* _buyer;
   Character* _seller;
+  TradeSession _tradeSession;
 };
 
 }  // namespace vigilante
@@ -0,0 +1,122 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "B2BodyTemplate.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace vigilante {
+
+namespace {
+
+b2Fixture* createFixture(b2Body* body, const B2BodyTemplate::Fixture& fixture,
+                         const b2Filter& filter, void* userData) {
+  b2FixtureDef fdef = fixture.def;
+  fdef.shape = std::visit([](const auto& shape) -> const b2Shape* { return &shape; }, fixture.shape);
+  fdef.filter = filter;
+  fdef.userData.pointer = reinterpret_cast<uintptr_t>(userData);
+  return body->CreateFixture(&fdef);
+}
+
+}  // namespace
+
+B2BodyTemplate::B2BodyTemplate(b2BodyType bodyType) {
+  _bdef.type = bodyType;
+  _bdef.fixedRotation = true;
+}
+
+B2BodyTemplate& B2BodyTemplate::newRectangleFixture(float hw, float hh, float ppm) {
+  auto& shape = _fixture.shape.emplace<b2PolygonShape>();
+  shape.SetAsBox(hw / ppm, hh / ppm);
+  return *this;
+}
+
+B2BodyTemplate& B2BodyTemplate::newPolygonFixture(const b2Vec2* vertices, size_t count, float ppm) {
+  assert(count <= b2_maxPolygonVertices);
+
+  b2Vec2 scaledVertices[b2_maxPolygonVertices];
+  for (size_t i = 0; i < count; i++) {
+    scaledVertices[i] = {vertices[i].x / ppm, vertices[i].y / ppm};
+  }
+  auto& shape = _fixture.shape.emplace<b2PolygonShape>();
+  shape.Set(scaledVertices, static_cast<int32>(count));
+  return *this;
+}
+
+B2BodyTemplate& B2BodyTemplate::newEdgeShapeFixture(const b2Vec2& vertex1, const b2Vec2& vertex2, float ppm) {
+  auto& shape = _fixture.shape.emplace<b2EdgeShape>();
+  shape.SetTwoSided({vertex1.x / ppm, vertex1.y / ppm}, {vertex2.x / ppm, vertex2.y / ppm});
+  return *this;
+}
+
+B2BodyTemplate& B2BodyTemplate::newCircleFixture(const b2Vec2& centerPos, int radius, float ppm) {
+  auto& shape = _fixture.shape.emplace<b2CircleShape>();
+  shape.m_p.Set(centerPos.x / ppm, centerPos.y / ppm);
+  shape.m_radius = radius / ppm;
+  return *this;
+}
+
+B2BodyTemplate& B2BodyTemplate::categoryBits(short categoryBits) {
+  _fixture.def.filter.categoryBits = categoryBits;
+  return *this;
+}
+
+B2BodyTemplate& B2BodyTemplate::maskBits(short maskBits) {
+  _fixture.def.filter.maskBits = maskBits;
+  return *this;
+}
+
+B2BodyTemplate& B2BodyTemplate::setSensor(bool isSensor) {
+  _fixture.def.isSensor = isSensor;
+  return *this;
+}
+
+B2BodyTemplate& B2BodyTemplate::friction(float friction) {
+  _fixture.def.friction = friction;
+  return *this;
+}
+
+B2BodyTemplate& B2BodyTemplate::density(float density) {
+  _fixture.def.density = density;
+  return *this;
+}
+
+B2BodyTemplate& B2BodyTemplate::restitution(float restitution) {
+  _fixture.def.restitution = restitution;
+  return *this;
+}
+
+size_t B2BodyTemplate::addFixture() {
+  _fixtures.push_back(_fixture);
+  _fixture = Fixture{};
+  return _fixtures.size() - 1;
+}
+
+b2Body* B2BodyTemplate::instantiate(b2World* world, float x, float y, float ppm) const {
+  b2BodyDef bdef = _bdef;
+  bdef.position.Set(x / ppm, y / ppm);
+  return world->CreateBody(&bdef);
+}
+
+b2Body* B2BodyTemplate::instantiate(b2World* world, float x, float y, float ppm,
+                                    void* userData, b2Fixture** fixtures) const {
+  b2Body* body = instantiate(world, x, y, ppm);
+  for (size_t i = 0; i < _fixtures.size(); i++) {
+    b2Fixture* fixture = createFixture(body, _fixtures[i], _fixtures[i].def.filter, userData);
+    if (fixtures) {
+      fixtures[i] = fixture;
+    }
+  }
+  return body;
+}
+
+b2Fixture* B2BodyTemplate::instantiateFixture(b2Body* body, size_t fixtureIdx, void* userData) const {
+  return createFixture(body, _fixtures[fixtureIdx], _fixtures[fixtureIdx].def.filter, userData);
+}
+
+b2Fixture* B2BodyTemplate::instantiateFixture(b2Body* body, size_t fixtureIdx, void* userData,
+                                              const b2Filter& filter) const {
+  return createFixture(body, _fixtures[fixtureIdx], filter, userData);
+}
+
+}  // namespace vigilante
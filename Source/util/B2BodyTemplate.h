@@ -0,0 +1,68 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_B2_BODY_TEMPLATE_H_
+#define VIGILANTE_B2_BODY_TEMPLATE_H_
+
+#include <variant>
+#include <vector>
+
+#include <box2d/box2d.h>
+
+namespace vigilante {
+
+// A B2BodyTemplate is the immutable definition of a b2Body and its fixtures,
+// i.e., the body def plus the shape and the fixture def of each fixture.
+// It is defined once (e.g., per character profile) with the same interface
+// as B2BodyBuilder, and then shared by all the bodies instantiated from it,
+// so that spawning a body neither computes nor allocates any shape.
+//
+// Fixtures are instantiated one by one, since a body may only use some of
+// them at a time (e.g., the standing or the crouching variant of a fixture).
+class B2BodyTemplate final {
+ public:
+  using Shape = std::variant<b2PolygonShape, b2CircleShape, b2EdgeShape>;
+
+  struct Fixture final {
+    B2BodyTemplate::Shape shape;
+    b2FixtureDef def;  // `def.shape` is bound upon instantiation.
+  };
+
+  explicit B2BodyTemplate(b2BodyType bodyType);
+
+  B2BodyTemplate& newRectangleFixture(float hw, float hh, float ppm);
+  B2BodyTemplate& newPolygonFixture(const b2Vec2* vertices, size_t count, float ppm);
+  B2BodyTemplate& newEdgeShapeFixture(const b2Vec2& vertex1, const b2Vec2& vertex2, float ppm);
+  B2BodyTemplate& newCircleFixture(const b2Vec2& centerPos, int radius, float ppm);
+
+  B2BodyTemplate& categoryBits(short categoryBits);
+  B2BodyTemplate& maskBits(short maskBits);
+  B2BodyTemplate& setSensor(bool isSensor);
+  B2BodyTemplate& friction(float friction);
+  B2BodyTemplate& density(float density);
+  B2BodyTemplate& restitution(float restitution);
+  // Adds the fixture being defined, and returns its index.
+  size_t addFixture();
+
+  // Creates a body without any fixture.
+  b2Body* instantiate(b2World* world, float x, float y, float ppm) const;
+  // Creates a body with all the fixtures, which share the same user data.
+  // The created fixtures are written to `fixtures` if it isn't nullptr.
+  b2Body* instantiate(b2World* world, float x, float y, float ppm,
+                      void* userData, b2Fixture** fixtures=nullptr) const;
+
+  b2Fixture* instantiateFixture(b2Body* body, size_t fixtureIdx, void* userData) const;
+  // Same as above, but with the filter of this instance instead of the template's.
+  b2Fixture* instantiateFixture(b2Body* body, size_t fixtureIdx, void* userData,
+                                const b2Filter& filter) const;
+
+  inline size_t getFixtureCount() const { return _fixtures.size(); }
+  inline const B2BodyTemplate::Fixture& getFixture(size_t fixtureIdx) const { return _fixtures[fixtureIdx]; }
+
+ private:
+  b2BodyDef _bdef{};
+  std::vector<B2BodyTemplate::Fixture> _fixtures;
+  B2BodyTemplate::Fixture _fixture{};  // the fixture being defined
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_B2_BODY_TEMPLATE_H_
@@ -9,12 +9,14 @@
 #include <rapidjson/writer.h>
 
 #include "util/Logger.h"
+#include "util/MemoryTracker.h"
 
 using namespace std;
 
 namespace vigilante::json_util {
 
 rapidjson::Document parseJson(const fs::path& jsonFileName) {
+  ScopedMemoryTag memoryTag{MemoryTag::JSON};
   ifstream ifs(jsonFileName);
   if (!ifs.is_open()) {
     VGLOG(LOG_ERR, "Failed to load json: [%s].", jsonFileName.c_str());
@@ -93,6 +93,8 @@ T extractJsonObject(const rapidjson::Value& val) {
     return val.GetInt();
   } else if constexpr (std::is_same_v<T, float>) {
     return val.GetFloat();
+  } else if constexpr (std::is_same_v<T, double>) {
+    return val.GetDouble();
   } else if constexpr (std::is_same_v<T, std::string>) {
     return val.GetString();
   } else if constexpr (is_pair<T>) {
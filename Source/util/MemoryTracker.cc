@@ -0,0 +1,165 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#include "MemoryTracker.h"
+
+#include <cstdlib>
+#include <new>
+
+#include "util/Logger.h"
+
+using namespace std;
+
+namespace vigilante {
+
+namespace {
+
+constexpr array<const char*, static_cast<size_t>(MemoryTag::SIZE)> kTagNames{{
+  "untagged",
+  "textures",
+  "animations",
+  "json",
+  "actors",
+  "ui",
+}};
+
+// Growth below this is considered noise (e.g., a few more cached strings).
+constexpr int64_t kLeakReportThreshold = 256 * 1024;
+
+thread_local MemoryTag currentTag = MemoryTag::UNTAGGED;
+
+}  // namespace
+
+MemoryTracker& MemoryTracker::the() {
+  static MemoryTracker instance;
+  return instance;
+}
+
+bool MemoryTracker::isEnabled() {
+#ifdef VIGILANTE_MEMORY_TRACKING
+  return true;
+#else
+  return false;
+#endif
+}
+
+const char* MemoryTracker::getTagName(const MemoryTag tag) {
+  return kTagNames[static_cast<size_t>(tag)];
+}
+
+MemoryTag MemoryTracker::getCurrentTag() {
+  return currentTag;
+}
+
+void MemoryTracker::setCurrentTag(const MemoryTag tag) {
+  currentTag = tag;
+}
+
+void MemoryTracker::onAllocate(const MemoryTag tag, const size_t size) {
+  const size_t i = static_cast<size_t>(tag);
+  const int64_t bytes = static_cast<int64_t>(size);
+  const int64_t currentBytes = _currentBytes[i].fetch_add(bytes, memory_order_relaxed) + bytes;
+  _numAllocations[i].fetch_add(1, memory_order_relaxed);
+
+  int64_t peakBytes = _peakBytes[i].load(memory_order_relaxed);
+  while (currentBytes > peakBytes &&
+         !_peakBytes[i].compare_exchange_weak(peakBytes, currentBytes, memory_order_relaxed)) {}
+}
+
+void MemoryTracker::onDeallocate(const MemoryTag tag, const size_t size) {
+  const size_t i = static_cast<size_t>(tag);
+  _currentBytes[i].fetch_sub(static_cast<int64_t>(size), memory_order_relaxed);
+  _numAllocations[i].fetch_sub(1, memory_order_relaxed);
+}
+
+MemoryTracker::Usage MemoryTracker::getUsage(const MemoryTag tag) const {
+  const size_t i = static_cast<size_t>(tag);
+  return {
+    _currentBytes[i].load(memory_order_relaxed),
+    _peakBytes[i].load(memory_order_relaxed),
+    _numAllocations[i].load(memory_order_relaxed)
+  };
+}
+
+void MemoryTracker::reportMapTransition(const string& unloadedTmxMapFileName) {
+  if (!isEnabled()) {
+    return;
+  }
+
+  array<int64_t, kNumTags> currentBytes;
+  for (size_t i = 0; i < kNumTags; i++) {
+    currentBytes[i] = _currentBytes[i].load(memory_order_relaxed);
+  }
+
+  if (_hasBaseline) {
+    for (size_t i = 0; i < kNumTags; i++) {
+      const int64_t growth = currentBytes[i] - _baselineBytes[i];
+      if (growth > kLeakReportThreshold) {
+        VGLOG(LOG_WARN, "Memory tag [%s] did not return to baseline after unloading [%s]: +%lld bytes.",
+              kTagNames[i], unloadedTmxMapFileName.c_str(), static_cast<long long>(growth));
+      }
+    }
+  }
+
+  _baselineBytes = currentBytes;
+  _hasBaseline = true;
+}
+
+}  // namespace vigilante
+
+#ifdef VIGILANTE_MEMORY_TRACKING
+
+// Every allocation is prefixed with a small header recording its size and tag,
+// so that it can be uncharged from the right tag when it is freed.
+namespace {
+
+struct alignas(alignof(std::max_align_t)) AllocationHeader {
+  size_t size;
+  vigilante::MemoryTag tag;
+};
+
+void* trackedAlloc(const size_t size) noexcept {
+  void* p = std::malloc(sizeof(AllocationHeader) + size);
+  if (!p) {
+    return nullptr;
+  }
+
+  auto header = static_cast<AllocationHeader*>(p);
+  header->size = size;
+  header->tag = vigilante::MemoryTracker::getCurrentTag();
+  vigilante::MemoryTracker::the().onAllocate(header->tag, size);
+  return header + 1;
+}
+
+void trackedFree(void* p) noexcept {
+  if (!p) {
+    return;
+  }
+
+  auto header = static_cast<AllocationHeader*>(p) - 1;
+  vigilante::MemoryTracker::the().onDeallocate(header->tag, header->size);
+  std::free(header);
+}
+
+void* trackedAllocOrThrow(const size_t size) {
+  // operator new(0) must still return a unique pointer.
+  void* p = trackedAlloc(size ? size : 1);
+  if (!p) {
+    throw std::bad_alloc{};
+  }
+  return p;
+}
+
+}  // namespace
+
+void* operator new(size_t size) { return trackedAllocOrThrow(size); }
+void* operator new[](size_t size) { return trackedAllocOrThrow(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size ? size : 1); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size ? size : 1); }
+
+void operator delete(void* p) noexcept { trackedFree(p); }
+void operator delete[](void* p) noexcept { trackedFree(p); }
+void operator delete(void* p, size_t) noexcept { trackedFree(p); }
+void operator delete[](void* p, size_t) noexcept { trackedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { trackedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { trackedFree(p); }
+
+#endif  // VIGILANTE_MEMORY_TRACKING
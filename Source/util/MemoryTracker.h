@@ -0,0 +1,85 @@
+// Copyright (c) 2018-2023 Marco Wang <m.aesophor@gmail.com>. All rights reserved.
+#ifndef VIGILANTE_MEMORY_TRACKER_H_
+#define VIGILANTE_MEMORY_TRACKER_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace vigilante {
+
+// The subsystem an allocation is charged to.
+enum class MemoryTag : uint8_t {
+  UNTAGGED,
+  TEXTURES,
+  ANIMATIONS,
+  JSON,
+  ACTORS,
+  UI,
+  SIZE
+};
+
+// MemoryTracker keeps per-tag byte counts of heap allocations.
+//
+// When built with VIGILANTE_MEMORY_TRACKING, the global operator new/delete
+// are replaced (see MemoryTracker.cc), and every allocation is charged to
+// the tag of the innermost ScopedMemoryTag on the allocating thread.
+// Otherwise all counters stay at zero.
+class MemoryTracker final {
+ public:
+  struct Usage final {
+    int64_t currentBytes;
+    int64_t peakBytes;
+    int64_t numAllocations;
+  };
+
+  static MemoryTracker& the();
+
+  static bool isEnabled();
+  static const char* getTagName(const MemoryTag tag);
+  static MemoryTag getCurrentTag();
+  static void setCurrentTag(const MemoryTag tag);
+
+  void onAllocate(const MemoryTag tag, const size_t size);
+  void onDeallocate(const MemoryTag tag, const size_t size);
+  MemoryTracker::Usage getUsage(const MemoryTag tag) const;
+
+  // Should be called right after a GameMap has been unloaded. The usage is
+  // compared against the one recorded after the previous unload, and the tags
+  // which haven't returned to that baseline are reported.
+  void reportMapTransition(const std::string& unloadedTmxMapFileName);
+
+ private:
+  static inline constexpr size_t kNumTags = static_cast<size_t>(MemoryTag::SIZE);
+
+  constexpr MemoryTracker() = default;
+
+  std::array<std::atomic<int64_t>, kNumTags> _currentBytes{};
+  std::array<std::atomic<int64_t>, kNumTags> _peakBytes{};
+  std::array<std::atomic<int64_t>, kNumTags> _numAllocations{};
+
+  bool _hasBaseline{};
+  std::array<int64_t, kNumTags> _baselineBytes{};
+};
+
+// Charges the allocations made within its lifetime to `tag`.
+class ScopedMemoryTag final {
+ public:
+  explicit ScopedMemoryTag(const MemoryTag tag)
+      : _prevTag{MemoryTracker::getCurrentTag()} {
+    MemoryTracker::setCurrentTag(tag);
+  }
+  ~ScopedMemoryTag() { MemoryTracker::setCurrentTag(_prevTag); }
+
+  ScopedMemoryTag(const ScopedMemoryTag&) = delete;
+  ScopedMemoryTag& operator=(const ScopedMemoryTag&) = delete;
+
+ private:
+  const MemoryTag _prevTag;
+};
+
+}  // namespace vigilante
+
+#endif  // VIGILANTE_MEMORY_TRACKER_H_
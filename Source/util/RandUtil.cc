@@ -6,16 +6,33 @@
 
 namespace vigilante::rand_util {
 
+namespace {
+
+uint64_t numDraws;
+
+}  // namespace
+
 void init() {
   srand(time(nullptr));
 }
 
+void init(const unsigned int seed) {
+  srand(seed);
+  numDraws = 0;
+}
+
 int randInt(int min, int max) {
+  numDraws++;
   return (rand() % (max + 1 - min)) + min;
 }
 
 float randFloat(float min, float max) {
+  numDraws++;
   return (float(rand()) / (float(RAND_MAX) + 1.0)) * (max - min) + min;
 }
 
+uint64_t getNumDraws() {
+  return numDraws;
+}
+
 }  // namespace vigilante::rand_util
@@ -2,12 +2,19 @@
 #ifndef VIGILANTE_RAND_UTIL_H_
 #define VIGILANTE_RAND_UTIL_H_
 
+#include <cstdint>
+
 namespace vigilante::rand_util {
 
 void init();
+void init(const unsigned int seed);
 int randInt(int min=0, int max=1);
 float randFloat(float min=0.0f, float max=1.0f);
 
+// The number of random numbers drawn so far,
+// which is used by the determinism checker.
+uint64_t getNumDraws();
+
 }  // namespace vigilante::rand_util
 
 #endif  // VIGILANTE_RAND_UTIL_H_